@@ -1,6 +1,6 @@
 /* EEG.cpp
  *
- * Copyright (C) 2011-2023 Paul Boersma
+ * Copyright (C) 2011-2023,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -18,6 +18,7 @@
 
 #include "EEG.h"
 #include "Sound_and_Spectrum.h"
+#include "NUMFourier.h"
 
 #include "oo_DESTROY.h"
 #include "EEG_def.h"
@@ -92,338 +93,500 @@ integer EEG_getChannelNumber (EEG me, conststring32 channelName) {
 	return 0;
 }
 
-autoEEG EEG_readFromBdfFile (MelderFile file) {
-	try {
-		autofile f = Melder_fopen (file, "rb");
-		char buffer [81];
-		(void) fread (buffer, 1, 8, f);
-		buffer [8] = '\0';
-		const bool is24bit = ( buffer [0] == (char) 255 );
-		(void) fread (buffer, 1, 80, f);
-		buffer [80] = '\0';
-		trace (U"Local subject identification: \"", Melder_peek8to32 (buffer), U"\"");
+Thing_implement (LongEEG, Function, 0);
+
+void structLongEEG :: v1_info () {
+	structDaata :: v1_info ();
+	MelderInfo_writeLine (U"File name: ", MelderFile_peekPath (& our file));
+	MelderInfo_writeLine (U"File type: ", our is24bit ? U"BDF (24 bits)" : U"EDF (16 bits)");
+	MelderInfo_writeLine (U"Time domain:");
+	MelderInfo_writeLine (U"   Start time: ", our xmin, U" seconds");
+	MelderInfo_writeLine (U"   End time: ", our xmax, U" seconds");
+	MelderInfo_writeLine (U"   Total duration: ", our xmax - our xmin, U" seconds");
+	MelderInfo_writeLine (U"Time sampling of the signal:");
+	MelderInfo_writeLine (U"   Number of samples: ", our numberOfDataRecords * our numberOfSamplesPerDataRecord);
+	MelderInfo_writeLine (U"   Sampling frequency: ", Melder_single (our samplingFrequency), U" Hz");
+	MelderInfo_writeLine (U"   Number of data records: ", our numberOfDataRecords);
+	MelderInfo_writeLine (U"   Duration of a data record: ", our durationOfDataRecord, U" seconds");
+	MelderInfo_writeLine (U"Number of channels: ", our numberOfChannels);
+	MelderInfo_writeLine (U"Number of cap electrodes: ", EEG_getNumberOfCapElectrodes (our numberOfChannels));
+	MelderInfo_writeLine (U"Number of extra sensors: ", EEG_getNumberOfExtraSensors (our numberOfChannels));
+}
+
+void structLongEEG :: v1_copy (Daata thee_Daata) const {
+	LongEEG thee = static_cast <LongEEG> (thee_Daata);
+	LongEEG_Parent :: v1_copy (thee);
+	MelderFile_copy (& our file, & thy file);
+	thy is24bit = our is24bit;
+	thy hasLetters = our hasLetters;
+	thy numberOfChannels = our numberOfChannels;
+	thy channelNames = copy_STRVEC (our channelNames.get());
+	thy numberOfBytesInHeaderRecord = our numberOfBytesInHeaderRecord;
+	thy numberOfDataRecords = our numberOfDataRecords;
+	thy numberOfSamplesPerDataRecord = our numberOfSamplesPerDataRecord;
+	thy durationOfDataRecord = our durationOfDataRecord;
+	thy samplingFrequency = our samplingFrequency;
+	thy scalingFactors = copy_VEC (our scalingFactors.get());
+}
+
+static void setBiosemiChannelNames (autoSTRVEC& channelNames) {
+	if (EEG_getNumberOfCapElectrodes (channelNames.size) == 32) {
+		channelNames [1] = Melder_dup (U"Fp1");
+		channelNames [2] = Melder_dup (U"AF3");
+		channelNames [3] = Melder_dup (U"F7");
+		channelNames [4] = Melder_dup (U"F3");
+		channelNames [5] = Melder_dup (U"FC1");
+		channelNames [6] = Melder_dup (U"FC5");
+		channelNames [7] = Melder_dup (U"T7");
+		channelNames [8] = Melder_dup (U"C3");
+		channelNames [9] = Melder_dup (U"CP1");
+		channelNames [10] = Melder_dup (U"CP5");
+		channelNames [11] = Melder_dup (U"P7");
+		channelNames [12] = Melder_dup (U"P3");
+		channelNames [13] = Melder_dup (U"Pz");
+		channelNames [14] = Melder_dup (U"PO3");
+		channelNames [15] = Melder_dup (U"O1");
+		channelNames [16] = Melder_dup (U"Oz");
+		channelNames [17] = Melder_dup (U"O2");
+		channelNames [18] = Melder_dup (U"PO4");
+		channelNames [19] = Melder_dup (U"P4");
+		channelNames [20] = Melder_dup (U"P8");
+		channelNames [21] = Melder_dup (U"CP6");
+		channelNames [22] = Melder_dup (U"CP2");
+		channelNames [23] = Melder_dup (U"C4");
+		channelNames [24] = Melder_dup (U"T8");
+		channelNames [25] = Melder_dup (U"FC6");
+		channelNames [26] = Melder_dup (U"FC2");
+		channelNames [27] = Melder_dup (U"F4");
+		channelNames [28] = Melder_dup (U"F8");
+		channelNames [29] = Melder_dup (U"AF4");
+		channelNames [30] = Melder_dup (U"Fp2");
+		channelNames [31] = Melder_dup (U"Fz");
+		channelNames [32] = Melder_dup (U"Cz");
+	} else if (EEG_getNumberOfCapElectrodes (channelNames.size) == 64) {
+		channelNames [1] = Melder_dup (U"Fp1");
+		channelNames [2] = Melder_dup (U"AF7");
+		channelNames [3] = Melder_dup (U"AF3");
+		channelNames [4] = Melder_dup (U"F1");
+		channelNames [5] = Melder_dup (U"F3");
+		channelNames [6] = Melder_dup (U"F5");
+		channelNames [7] = Melder_dup (U"F7");
+		channelNames [8] = Melder_dup (U"FT7");
+		channelNames [9] = Melder_dup (U"FC5");
+		channelNames [10] = Melder_dup (U"FC3");
+		channelNames [11] = Melder_dup (U"FC1");
+		channelNames [12] = Melder_dup (U"C1");
+		channelNames [13] = Melder_dup (U"C3");
+		channelNames [14] = Melder_dup (U"C5");
+		channelNames [15] = Melder_dup (U"T7");
+		channelNames [16] = Melder_dup (U"TP7");
+		channelNames [17] = Melder_dup (U"CP5");
+		channelNames [18] = Melder_dup (U"CP3");
+		channelNames [19] = Melder_dup (U"CP1");
+		channelNames [20] = Melder_dup (U"P1");
+		channelNames [21] = Melder_dup (U"P3");
+		channelNames [22] = Melder_dup (U"P5");
+		channelNames [23] = Melder_dup (U"P7");
+		channelNames [24] = Melder_dup (U"P9");
+		channelNames [25] = Melder_dup (U"PO7");
+		channelNames [26] = Melder_dup (U"PO3");
+		channelNames [27] = Melder_dup (U"O1");
+		channelNames [28] = Melder_dup (U"Iz");
+		channelNames [29] = Melder_dup (U"Oz");
+		channelNames [30] = Melder_dup (U"POz");
+		channelNames [31] = Melder_dup (U"Pz");
+		channelNames [32] = Melder_dup (U"CPz");
+		channelNames [33] = Melder_dup (U"Fpz");
+		channelNames [34] = Melder_dup (U"Fp2");
+		channelNames [35] = Melder_dup (U"AF8");
+		channelNames [36] = Melder_dup (U"AF4");
+		channelNames [37] = Melder_dup (U"AFz");
+		channelNames [38] = Melder_dup (U"Fz");
+		channelNames [39] = Melder_dup (U"F2");
+		channelNames [40] = Melder_dup (U"F4");
+		channelNames [41] = Melder_dup (U"F6");
+		channelNames [42] = Melder_dup (U"F8");
+		channelNames [43] = Melder_dup (U"FT8");
+		channelNames [44] = Melder_dup (U"FC6");
+		channelNames [45] = Melder_dup (U"FC4");
+		channelNames [46] = Melder_dup (U"FC2");
+		channelNames [47] = Melder_dup (U"FCz");
+		channelNames [48] = Melder_dup (U"Cz");
+		channelNames [49] = Melder_dup (U"C2");
+		channelNames [50] = Melder_dup (U"C4");
+		channelNames [51] = Melder_dup (U"C6");
+		channelNames [52] = Melder_dup (U"T8");
+		channelNames [53] = Melder_dup (U"TP8");
+		channelNames [54] = Melder_dup (U"CP6");
+		channelNames [55] = Melder_dup (U"CP4");
+		channelNames [56] = Melder_dup (U"CP2");
+		channelNames [57] = Melder_dup (U"P2");
+		channelNames [58] = Melder_dup (U"P4");
+		channelNames [59] = Melder_dup (U"P6");
+		channelNames [60] = Melder_dup (U"P8");
+		channelNames [61] = Melder_dup (U"P10");
+		channelNames [62] = Melder_dup (U"PO8");
+		channelNames [63] = Melder_dup (U"PO4");
+		channelNames [64] = Melder_dup (U"O2");
+	}
+}
+
+static void LongEEG_readHeader (LongEEG me, FILE *f) {
+	char buffer [81];
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	my is24bit = ( buffer [0] == (char) 255 );
+	(void) fread (buffer, 1, 80, f);
+	buffer [80] = '\0';
+	trace (U"Local subject identification: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 80, f);
+	buffer [80] = '\0';
+	trace (U"Local recording identification: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	trace (U"Start date of recording: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	trace (U"Start time of recording: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	my numberOfBytesInHeaderRecord = atol (buffer);
+	trace (U"Number of bytes in header record: ", my numberOfBytesInHeaderRecord);
+	(void) fread (buffer, 1, 44, f);
+	buffer [44] = '\0';
+	trace (U"Version of data format: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	my numberOfDataRecords = strtol (buffer, nullptr, 10);
+	trace (U"Number of data records: ", my numberOfDataRecords);
+	(void) fread (buffer, 1, 8, f);
+	buffer [8] = '\0';
+	my durationOfDataRecord = atof (buffer);
+	trace (U"Duration of a data record: ", my durationOfDataRecord);
+	(void) fread (buffer, 1, 4, f);
+	buffer [4] = '\0';
+	const integer numberOfChannels = atol (buffer);
+	trace (U"Number of channels in data record: ", numberOfChannels);
+	Melder_require (numberOfChannels > 0,
+		U"The file contains no channels.");
+	if (my numberOfBytesInHeaderRecord != (numberOfChannels + 1) * 256)
+		Melder_throw (U"Number of bytes in header record (", my numberOfBytesInHeaderRecord,
+			U") doesn't match number of channels (", numberOfChannels, U").");
+	autoSTRVEC channelNames (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 16, f);
+		buffer [16] = '\0';   // labels of the channels
+		/*
+		 * Strip all final spaces.
+		 */
+		for (int i = 15; i >= 0; i --) {
+			if (buffer [i] == ' ')
+				buffer [i] = '\0';
+			else
+				break;
+		}
+		channelNames [ichannel] = Melder_8to32 (buffer);
+		trace (U"Channel <<", channelNames [ichannel].get(), U">>");
+	}
+	my hasLetters = str32equ (channelNames [numberOfChannels].get(), U"EDF Annotations");
+	double samplingFrequency = undefined;
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
 		(void) fread (buffer, 1, 80, f);
-		buffer [80] = '\0';
-		trace (U"Local recording identification: \"", Melder_peek8to32 (buffer), U"\"");
+		buffer [80] = '\0';   // transducer type
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
 		(void) fread (buffer, 1, 8, f);
-		buffer [8] = '\0';
-		trace (U"Start date of recording: \"", Melder_peek8to32 (buffer), U"\"");
+		buffer [8] = '\0';   // physical dimension of channels
+	}
+	autoVEC physicalMinimum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
 		(void) fread (buffer, 1, 8, f);
 		buffer [8] = '\0';
-		trace (U"Start time of recording: \"", Melder_peek8to32 (buffer), U"\"");
+		physicalMinimum [ichannel] = atof (buffer);
+	}
+	autoVEC physicalMaximum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
 		(void) fread (buffer, 1, 8, f);
 		buffer [8] = '\0';
-		const integer numberOfBytesInHeaderRecord = atol (buffer);
-		trace (U"Number of bytes in header record: ", numberOfBytesInHeaderRecord);
-		(void) fread (buffer, 1, 44, f);
-		buffer [44] = '\0';
-		trace (U"Version of data format: \"", Melder_peek8to32 (buffer), U"\"");
+		physicalMaximum [ichannel] = atof (buffer);
+	}
+	autoVEC digitalMinimum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
 		(void) fread (buffer, 1, 8, f);
 		buffer [8] = '\0';
-		const integer numberOfDataRecords = strtol (buffer, nullptr, 10);
-		trace (U"Number of data records: ", numberOfDataRecords);
+		digitalMinimum [ichannel] = atof (buffer);
+	}
+	autoVEC digitalMaximum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
 		(void) fread (buffer, 1, 8, f);
 		buffer [8] = '\0';
-		const double durationOfDataRecord = atof (buffer);
-		trace (U"Duration of a data record: ", durationOfDataRecord);
-		(void) fread (buffer, 1, 4, f);
-		buffer [4] = '\0';
-		const integer numberOfChannels = atol (buffer);
-		trace (U"Number of channels in data record: ", numberOfChannels);
-		if (numberOfBytesInHeaderRecord != (numberOfChannels + 1) * 256)
-			Melder_throw (U"Number of bytes in header record (", numberOfBytesInHeaderRecord,
-				U") doesn't match number of channels (", numberOfChannels, U").");
-		autoSTRVEC channelNames (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 16, f);
-			buffer [16] = '\0';   // labels of the channels
-			/*
-			 * Strip all final spaces.
-			 */
-			for (int i = 15; i >= 0; i --) {
-				if (buffer [i] == ' ')
-					buffer [i] = '\0';
-				else
-					break;
-			}
-			channelNames [ichannel] = Melder_8to32 (buffer);
-			trace (U"Channel <<", channelNames [ichannel].get(), U">>");
-		}
-		const bool hasLetters = str32equ (channelNames [numberOfChannels].get(), U"EDF Annotations");
-		double samplingFrequency = undefined;
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 80, f);
-			buffer [80] = '\0';   // transducer type
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';   // physical dimension of channels
-		}
-		autoVEC physicalMinimum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			physicalMinimum [ichannel] = atof (buffer);
-		}
-		autoVEC physicalMaximum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			physicalMaximum [ichannel] = atof (buffer);
-		}
-		autoVEC digitalMinimum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			digitalMinimum [ichannel] = atof (buffer);
-		}
-		autoVEC digitalMaximum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			digitalMaximum [ichannel] = atof (buffer);
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 80, f);
-			buffer [80] = '\0';   // prefiltering
-		}
-		integer numberOfSamplesPerDataRecord = 0;
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';   // number of samples in each data record
-			const integer numberOfSamplesInThisDataRecord = atol (buffer);
-			if (isundef (samplingFrequency)) {
-				numberOfSamplesPerDataRecord = numberOfSamplesInThisDataRecord;
-				samplingFrequency = numberOfSamplesInThisDataRecord / durationOfDataRecord;
-			}
-			if (numberOfSamplesInThisDataRecord / durationOfDataRecord != samplingFrequency)
-				Melder_throw (U"Number of samples per data record in channel ", channel,
-					U" (", numberOfSamplesInThisDataRecord,
-					U") doesn't match sampling frequency of channel 1 (", samplingFrequency, U").");
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 32, f);
-			buffer [32] = '\0';   // reserved
-		}
-		const double duration = numberOfDataRecords * durationOfDataRecord;
-		autoEEG him = EEG_create (0, duration);
-		his numberOfChannels = numberOfChannels;
-		autoSound me = Sound_createSimple (numberOfChannels, duration, samplingFrequency);
-		Melder_assert (my nx == numberOfSamplesPerDataRecord * numberOfDataRecords);
-		autoBYTEVEC dataBuffer = zero_BYTEVEC (3 * numberOfSamplesPerDataRecord);
-		for (integer record = 1; record <= numberOfDataRecords; record ++) {
-			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-				double factor = ( channel == numberOfChannels ? 1.0 : physicalMinimum [channel] / digitalMinimum [channel] );
-				if (channel < numberOfChannels - EEG_getNumberOfExtraSensors (him.get()))
-					factor /= 1000000.0;
-				if (is24bit) {
-					(void) fread (dataBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), 3, (size_t) numberOfSamplesPerDataRecord, f);
-					byte *p = & dataBuffer [1];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						const integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						const uint8 lowByte = *p ++, midByte = *p ++, highByte = *p ++;
-						uint32 externalValue = ((uint32) highByte << 16) | ((uint32) midByte << 8) | (uint32) lowByte;
-						if ((highByte & 128) != 0)   // is the 24-bit sign bit on?
-							externalValue |= 0xFF00'0000;   // extend negative sign to 32 bits
-						my z [channel] [sample] = (int32) externalValue * factor;
-					}
-				} else {
-					(void) fread (dataBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), 2, (size_t) numberOfSamplesPerDataRecord, f);
-					byte *p = & dataBuffer [1];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						const integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						const uint8 lowByte = *p ++, highByte = *p ++;
-						const uint16 externalValue = (uint16) ((uint16) highByte << 8) | (uint16) lowByte;
-						my z [channel] [sample] = (int16) externalValue * factor;
-					}
-				}
-			}
+		digitalMaximum [ichannel] = atof (buffer);
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 80, f);
+		buffer [80] = '\0';   // prefiltering
+	}
+	my numberOfSamplesPerDataRecord = 0;
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 8, f);
+		buffer [8] = '\0';   // number of samples in each data record
+		const integer numberOfSamplesInThisDataRecord = atol (buffer);
+		if (isundef (samplingFrequency)) {
+			my numberOfSamplesPerDataRecord = numberOfSamplesInThisDataRecord;
+			samplingFrequency = numberOfSamplesInThisDataRecord / my durationOfDataRecord;
 		}
-		int numberOfStatusBits = 8;
+		if (numberOfSamplesInThisDataRecord / my durationOfDataRecord != samplingFrequency)
+			Melder_throw (U"Number of samples per data record in channel ", channel,
+				U" (", numberOfSamplesInThisDataRecord,
+				U") doesn't match sampling frequency of channel 1 (", samplingFrequency, U").");
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 32, f);
+		buffer [32] = '\0';   // reserved
+	}
+	my numberOfChannels = numberOfChannels;
+	my samplingFrequency = samplingFrequency;
+	my xmin = 0.0;
+	my xmax = my numberOfDataRecords * my durationOfDataRecord;
+	my scalingFactors = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		double factor = ( ichannel == numberOfChannels ? 1.0 : physicalMinimum [ichannel] / digitalMinimum [ichannel] );
+		if (ichannel < numberOfChannels - EEG_getNumberOfExtraSensors (numberOfChannels))
+			factor /= 1000000.0;
+		my scalingFactors [ichannel] = factor;
+	}
+	setBiosemiChannelNames (channelNames);
+	my channelNames = std::move (channelNames);
+}
+
+autoLongEEG LongEEG_open (MelderFile file) {
+	try {
+		autoLongEEG me = Thing_new (LongEEG);
+		MelderFile_copy (file, & my file);
+		autofile f = Melder_fopen (file, "rb");
+		LongEEG_readHeader (me.get(), f);
+		f.close (file);
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"BDF file not opened.");
+	}
+}
+
+/*
+	The samples of a channel in a data record are consecutive little-endian integers;
+	the loops below have no branches, so that the compiler can vectorize them.
+*/
+static void decodeInt24 (const uint8 *bytes, integer numberOfSamples, double factor, double *out) {
+	for (integer i = 0; i < numberOfSamples; i ++) {
+		const uint32 shiftedValue = (uint32) bytes [3 * i] << 8 | (uint32) bytes [3 * i + 1] << 16 | (uint32) bytes [3 * i + 2] << 24;
+		out [i] = (double) ((int32) shiftedValue >> 8) * factor;   // the arithmetic shift extends the 24-bit sign
+	}
+}
+static void decodeInt16 (const uint8 *bytes, integer numberOfSamples, double factor, double *out) {
+	for (integer i = 0; i < numberOfSamples; i ++)
+		out [i] = (double) (int16) (uint16) ((uint16) bytes [2 * i] | (uint16) bytes [2 * i + 1] << 8) * factor;
+}
+
+static autoTextGrid TextGrid_createFromBdfStatus (Sound me, bool hasLetters, double annotationTimeOffset, bool startsAtBeginningOfRecording) {
+	int numberOfStatusBits = 8;
+	for (integer i = 1; i <= my nx; i ++) {
+		const uint32 value = (uint32) (int32) my z [my ny] [i];
+		if (value & 0x0000'FF00)
+			numberOfStatusBits = 16;
+	}
+	autoTextGrid thee;
+	if (hasLetters) {
+		thee = TextGrid_create (my xmin, my xmax, U"Mark Trigger", U"Mark Trigger");
+		auto insertPoint = [&] (integer tierNumber, double time, conststring32 text) {
+			if (time >= my xmin && time <= my xmax)   // only the marks in our part of the recording
+				TextGrid_insertPoint (thee.get(), tierNumber, time, text);
+		};
+		autoMelderString letters;
+		double time = undefined;
+		bool skippingIncompleteLabel = ! startsAtBeginningOfRecording;
 		for (integer i = 1; i <= my nx; i ++) {
-			const uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
-			if (value & 0x0000'FF00)
-				numberOfStatusBits = 16;
-		}
-		autoTextGrid thee;
-		if (hasLetters) {
-			thee = TextGrid_create (0, duration, U"Mark Trigger", U"Mark Trigger");
-			autoMelderString letters;
-			double time = undefined;
-			for (integer i = 1; i <= my nx; i ++) {
-				const uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
-				for (int ibyte = 1; ibyte <= numberOfStatusBits / 8; ibyte ++) {
-					const uint32 mask = ( ibyte == 1 ? 0x0000'00ff : 0x0000'ff00 );
-					const char32 kar = ( ibyte == 1 ? (value & mask) : (value & mask) >> 8 );
-					if (kar != U'\0' && kar != 20) {
-						MelderString_appendCharacter (& letters, kar);
-					} else if (letters.string [0] != U'\0') {
-						if (letters.string [0] == U'+') {
-							if (isdefined (time)) {
+			const uint32 value = (uint32) (int32) my z [my ny] [i];
+			for (int ibyte = 1; ibyte <= numberOfStatusBits / 8; ibyte ++) {
+				const uint32 mask = ( ibyte == 1 ? 0x0000'00ff : 0x0000'ff00 );
+				const char32 kar = ( ibyte == 1 ? (value & mask) : (value & mask) >> 8 );
+				if (kar != U'\0' && kar != 20) {
+					MelderString_appendCharacter (& letters, kar);
+				} else if (skippingIncompleteLabel) {
+					MelderString_empty (& letters);   // the rest of a label that started before our part of the recording
+					skippingIncompleteLabel = false;
+				} else if (letters.string [0] != U'\0') {
+					if (letters.string [0] == U'+') {
+						if (isdefined (time)) {
+							try {
+								insertPoint (1, time, U"");
+							} catch (MelderError) {
+								Melder_throw (U"Did not insert empty mark (", letters.string, U") on Mark tier.");
+							}
+							time = undefined;   // defensive
+						}
+						time = Melder_atof (& letters.string [1]) - annotationTimeOffset;
+						MelderString_empty (& letters);
+					} else {
+						if (isundef (time)) {
+							Melder_throw (U"Undefined time for label at sample ", i, U".");
+						}
+						try {
+							if (Melder_nequ (letters.string, U"Trigger-", 8)) {
 								try {
-									TextGrid_insertPoint (thee.get(), 1, time, U"");
+									insertPoint (2, time, & letters.string [8]);
 								} catch (MelderError) {
-									Melder_throw (U"Did not insert empty mark (", letters.string, U") on Mark tier.");
-								}
-								time = undefined;   // defensive
-							}
-							time = Melder_atof (& letters.string [1]);
-							MelderString_empty (& letters);
-						} else {
-							if (isundef (time)) {
-								Melder_throw (U"Undefined time for label at sample ", i, U".");
-							}
-							try {
-								if (Melder_nequ (letters.string, U"Trigger-", 8)) {
-									try {
-										TextGrid_insertPoint (thee.get(), 2, time, & letters.string [8]);
-									} catch (MelderError) {
-										Melder_clearError ();
-										trace (U"Duplicate trigger at ", time, U" seconds: ", & letters.string [8]);
-									}
-								} else {
-									TextGrid_insertPoint (thee.get(), 1, time, & letters.string [0]);
+									Melder_clearError ();
+									trace (U"Duplicate trigger at ", time, U" seconds: ", & letters.string [8]);
 								}
-							} catch (MelderError) {
-								Melder_throw (U"Did not insert mark (", letters.string, U") on Trigger tier.");
+							} else {
+								insertPoint (1, time, & letters.string [0]);
 							}
-							time = undefined;   // crucial
-							MelderString_empty (& letters);
+						} catch (MelderError) {
+							Melder_throw (U"Did not insert mark (", letters.string, U") on Trigger tier.");
 						}
+						time = undefined;   // crucial
+						MelderString_empty (& letters);
 					}
 				}
 			}
-			if (isdefined (time)) {
-				TextGrid_insertPoint (thee.get(), 1, time, U"");
-				time = undefined;   // defensive
+		}
+		if (isdefined (time)) {
+			insertPoint (1, time, U"");
+			time = undefined;   // defensive
+		}
+	} else {
+		thee = TextGrid_create (my xmin, my xmax,
+			numberOfStatusBits == 8 ? U"S1 S2 S3 S4 S5 S6 S7 S8" : U"S1 S2 S3 S4 S5 S6 S7 S8 S9 S10 S11 S12 S13 S14 S15 S16",
+			U""
+		);
+		for (int bit = 1; bit <= numberOfStatusBits; bit ++) {
+			const uint32 bitValue = 1 << (bit - 1);
+			IntervalTier tier = (IntervalTier) thy tiers->at [bit];
+			for (integer i = 1; i <= my nx; i ++) {
+				const uint32 previousValue = ( i == 1 ? 0 : (uint32) (int32) my z [my ny] [i - 1] );
+				const uint32 thisValue = (uint32) (int32) my z [my ny] [i];
+				if ((thisValue & bitValue) != (previousValue & bitValue)) {
+					if (i > 1)
+						TextGrid_insertBoundary (thee.get(), bit, my x1 + (i - 1.5) * my dx);
+					if ((thisValue & bitValue) != 0)
+						TextGrid_setIntervalText (thee.get(), bit, tier -> intervals.size, U"1");
+				}
 			}
-		} else {
-			thee = TextGrid_create (0.0, duration,
-				numberOfStatusBits == 8 ? U"S1 S2 S3 S4 S5 S6 S7 S8" : U"S1 S2 S3 S4 S5 S6 S7 S8 S9 S10 S11 S12 S13 S14 S15 S16",
-				U""
+		}
+	}
+	return thee;
+}
+
+static conststring32 channelRole (integer channelNumber, integer numberOfChannels) {
+	if (channelNumber <= EEG_getNumberOfCapElectrodes (numberOfChannels))
+		return U"a cap electrode";
+	if (channelNumber > numberOfChannels - EEG_getNumberOfExtraSensors (numberOfChannels))
+		return U"an extra sensor";
+	return U"an external electrode";
+}
+
+autoEEG LongEEG_extractPart (LongEEG me, double tmin, double tmax, constINTVECVU const& channelNumbers, bool preserveTimes) {
+	try {
+		Melder_require (tmin < tmax,
+			U"The end time should be greater than the start time.");
+		/*
+			The channels to read: the selected ones (or all), followed by the status channel.
+		*/
+		autoINTVEC allChannels;
+		if (channelNumbers.size == 0)
+			allChannels = to_INTVEC (my numberOfChannels);
+		const constINTVECVU selectedChannels = ( channelNumbers.size > 0 ? channelNumbers : constINTVECVU (allChannels.get()) );
+		autoINTVEC fileChannels = raw_INTVEC (selectedChannels.size + 1);
+		integer numberOfChannels = 0;
+		for (integer i = 1; i <= selectedChannels.size; i ++) {
+			const integer channelNumber = selectedChannels [i];
+			Melder_require (channelNumber >= 1 && channelNumber <= my numberOfChannels,
+				U"The channel numbers should be between 1 and ", my numberOfChannels, U".");
+			if (channelNumber != my numberOfChannels)
+				fileChannels [++ numberOfChannels] = channelNumber;
+		}
+		fileChannels [++ numberOfChannels] = my numberOfChannels;
+		fileChannels.resize (numberOfChannels);
+		/*
+			The EEG will tell the roles of its channels from their number only,
+			so each channel should get the same role as it has in the file.
+		*/
+		for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+			const integer fileChannel = fileChannels [ichan];
+			conststring32 roleInFile = channelRole (fileChannel, my numberOfChannels);
+			conststring32 roleInPart = channelRole (ichan, numberOfChannels);
+			Melder_require (str32equ (roleInPart, roleInFile),
+				U"Channel ", fileChannel, U" (", my channelNames [fileChannel].get(), U") is ", roleInFile,
+				U" in the file, but would count as ", roleInPart, U" in an EEG with ", numberOfChannels, U" channels. "
+				U"Choose all channels, or a selection that keeps the roles of the channels, such as all cap electrodes."
 			);
-			for (int bit = 1; bit <= numberOfStatusBits; bit ++) {
-				const uint32 bitValue = 1 << (bit - 1);
-				IntervalTier tier = (IntervalTier) thy tiers->at [bit];
-				for (integer i = 1; i <= my nx; i ++) {
-					const uint32 previousValue = ( i == 1 ? 0 : (uint32) (int32) my z [numberOfChannels] [i - 1] );
-					const uint32 thisValue = (uint32) (int32) my z [numberOfChannels] [i];
-					if ((thisValue & bitValue) != (previousValue & bitValue)) {
-						const double time = ( i == 1 ? 0.0 : my x1 + (i - 1.5) * my dx );
-						if (time != 0.0)
-							TextGrid_insertBoundary (thee.get(), bit, time);
-						if ((thisValue & bitValue) != 0)
-							TextGrid_setIntervalText (thee.get(), bit, tier -> intervals.size, U"1");
-					}
+		}
+		/*
+			The samples to read.
+		*/
+		const integer numberOfSamplesInFile = my numberOfDataRecords * my numberOfSamplesPerDataRecord;
+		const double dx = 1.0 / my samplingFrequency, x1 = 0.5 * dx;
+		const integer imin = std::max (1_integer, Melder_iroundUp ((tmin - x1) / dx) + 1);
+		const integer imax = std::min (numberOfSamplesInFile, Melder_iroundDown ((tmax - x1) / dx) + 1);
+		Melder_require (imax >= imin,
+			U"The time range from ", tmin, U" to ", tmax, U" seconds contains no samples.");
+		const double timeShift = ( preserveTimes ? 0.0 : tmin );
+		autoSound sound = Sound_create (numberOfChannels, tmin - timeShift, tmax - timeShift, imax - imin + 1,
+				dx, x1 + (imin - 1) * dx - timeShift);
+		/*
+			Read as many whole data records at a time as fit in a few megabytes.
+		*/
+		const integer numberOfBytesPerSample = ( my is24bit ? 3 : 2 );
+		const integer numberOfBytesPerChannelInRecord = numberOfBytesPerSample * my numberOfSamplesPerDataRecord;
+		const integer numberOfBytesPerRecord = numberOfBytesPerChannelInRecord * my numberOfChannels;
+		const integer firstRecord = (imin - 1) / my numberOfSamplesPerDataRecord + 1;
+		const integer lastRecord = (imax - 1) / my numberOfSamplesPerDataRecord + 1;
+		const integer numberOfRecordsPerBatch = Melder_clipped (1_integer, 4'000'000 / numberOfBytesPerRecord, lastRecord - firstRecord + 1);
+		autoBYTEVEC batch = raw_BYTEVEC (numberOfRecordsPerBatch * numberOfBytesPerRecord);
+		autofile f = Melder_fopen (& my file, "rb");
+		if (fseeko (f, (off_t) my numberOfBytesInHeaderRecord + (off_t) (firstRecord - 1) * numberOfBytesPerRecord, SEEK_SET) != 0)
+			Melder_throw (U"Cannot find data record ", firstRecord, U".");
+		for (integer firstRecordInBatch = firstRecord; firstRecordInBatch <= lastRecord; firstRecordInBatch += numberOfRecordsPerBatch) {
+			const integer numberOfRecordsInBatch = std::min (numberOfRecordsPerBatch, lastRecord - firstRecordInBatch + 1);
+			if (fread (batch.asArgumentToFunctionThatExpectsZeroBasedArray(), (size_t) numberOfBytesPerRecord,
+					(size_t) numberOfRecordsInBatch, f) != (size_t) numberOfRecordsInBatch)
+				Melder_throw (U"Data record ", firstRecordInBatch, U" or later is incomplete.");
+			for (integer irecord = 1; irecord <= numberOfRecordsInBatch; irecord ++) {
+				const integer record = firstRecordInBatch + irecord - 1;
+				const integer firstSampleInRecord = (record - 1) * my numberOfSamplesPerDataRecord + 1;
+				const integer ifirst = std::max (imin, firstSampleInRecord);
+				const integer ilast = std::min (imax, firstSampleInRecord + my numberOfSamplesPerDataRecord - 1);
+				for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+					const integer fileChannel = fileChannels [ichan];
+					const uint8 *bytes = & batch [1] + (irecord - 1) * numberOfBytesPerRecord + (fileChannel - 1) * numberOfBytesPerChannelInRecord
+							+ (ifirst - firstSampleInRecord) * numberOfBytesPerSample;
+					double *out = & sound -> z [ichan] [ifirst - imin + 1];
+					if (my is24bit)
+						decodeInt24 (bytes, ilast - ifirst + 1, my scalingFactors [fileChannel], out);
+					else
+						decodeInt16 (bytes, ilast - ifirst + 1, my scalingFactors [fileChannel], out);
 				}
 			}
 		}
-		f.close (file);
-		his channelNames = std::move (channelNames);
-		his sound = me.move();
-		his textgrid = thee.move();
-		if (EEG_getNumberOfCapElectrodes (him.get()) == 32) {
-			EEG_setChannelName (him.get(), 1, U"Fp1");
-			EEG_setChannelName (him.get(), 2, U"AF3");
-			EEG_setChannelName (him.get(), 3, U"F7");
-			EEG_setChannelName (him.get(), 4, U"F3");
-			EEG_setChannelName (him.get(), 5, U"FC1");
-			EEG_setChannelName (him.get(), 6, U"FC5");
-			EEG_setChannelName (him.get(), 7, U"T7");
-			EEG_setChannelName (him.get(), 8, U"C3");
-			EEG_setChannelName (him.get(), 9, U"CP1");
-			EEG_setChannelName (him.get(), 10, U"CP5");
-			EEG_setChannelName (him.get(), 11, U"P7");
-			EEG_setChannelName (him.get(), 12, U"P3");
-			EEG_setChannelName (him.get(), 13, U"Pz");
-			EEG_setChannelName (him.get(), 14, U"PO3");
-			EEG_setChannelName (him.get(), 15, U"O1");
-			EEG_setChannelName (him.get(), 16, U"Oz");
-			EEG_setChannelName (him.get(), 17, U"O2");
-			EEG_setChannelName (him.get(), 18, U"PO4");
-			EEG_setChannelName (him.get(), 19, U"P4");
-			EEG_setChannelName (him.get(), 20, U"P8");
-			EEG_setChannelName (him.get(), 21, U"CP6");
-			EEG_setChannelName (him.get(), 22, U"CP2");
-			EEG_setChannelName (him.get(), 23, U"C4");
-			EEG_setChannelName (him.get(), 24, U"T8");
-			EEG_setChannelName (him.get(), 25, U"FC6");
-			EEG_setChannelName (him.get(), 26, U"FC2");
-			EEG_setChannelName (him.get(), 27, U"F4");
-			EEG_setChannelName (him.get(), 28, U"F8");
-			EEG_setChannelName (him.get(), 29, U"AF4");
-			EEG_setChannelName (him.get(), 30, U"Fp2");
-			EEG_setChannelName (him.get(), 31, U"Fz");
-			EEG_setChannelName (him.get(), 32, U"Cz");
-		} else if (EEG_getNumberOfCapElectrodes (him.get()) == 64) {
-			EEG_setChannelName (him.get(), 1, U"Fp1");
-			EEG_setChannelName (him.get(), 2, U"AF7");
-			EEG_setChannelName (him.get(), 3, U"AF3");
-			EEG_setChannelName (him.get(), 4, U"F1");
-			EEG_setChannelName (him.get(), 5, U"F3");
-			EEG_setChannelName (him.get(), 6, U"F5");
-			EEG_setChannelName (him.get(), 7, U"F7");
-			EEG_setChannelName (him.get(), 8, U"FT7");
-			EEG_setChannelName (him.get(), 9, U"FC5");
-			EEG_setChannelName (him.get(), 10, U"FC3");
-			EEG_setChannelName (him.get(), 11, U"FC1");
-			EEG_setChannelName (him.get(), 12, U"C1");
-			EEG_setChannelName (him.get(), 13, U"C3");
-			EEG_setChannelName (him.get(), 14, U"C5");
-			EEG_setChannelName (him.get(), 15, U"T7");
-			EEG_setChannelName (him.get(), 16, U"TP7");
-			EEG_setChannelName (him.get(), 17, U"CP5");
-			EEG_setChannelName (him.get(), 18, U"CP3");
-			EEG_setChannelName (him.get(), 19, U"CP1");
-			EEG_setChannelName (him.get(), 20, U"P1");
-			EEG_setChannelName (him.get(), 21, U"P3");
-			EEG_setChannelName (him.get(), 22, U"P5");
-			EEG_setChannelName (him.get(), 23, U"P7");
-			EEG_setChannelName (him.get(), 24, U"P9");
-			EEG_setChannelName (him.get(), 25, U"PO7");
-			EEG_setChannelName (him.get(), 26, U"PO3");
-			EEG_setChannelName (him.get(), 27, U"O1");
-			EEG_setChannelName (him.get(), 28, U"Iz");
-			EEG_setChannelName (him.get(), 29, U"Oz");
-			EEG_setChannelName (him.get(), 30, U"POz");
-			EEG_setChannelName (him.get(), 31, U"Pz");
-			EEG_setChannelName (him.get(), 32, U"CPz");
-			EEG_setChannelName (him.get(), 33, U"Fpz");
-			EEG_setChannelName (him.get(), 34, U"Fp2");
-			EEG_setChannelName (him.get(), 35, U"AF8");
-			EEG_setChannelName (him.get(), 36, U"AF4");
-			EEG_setChannelName (him.get(), 37, U"AFz");
-			EEG_setChannelName (him.get(), 38, U"Fz");
-			EEG_setChannelName (him.get(), 39, U"F2");
-			EEG_setChannelName (him.get(), 40, U"F4");
-			EEG_setChannelName (him.get(), 41, U"F6");
-			EEG_setChannelName (him.get(), 42, U"F8");
-			EEG_setChannelName (him.get(), 43, U"FT8");
-			EEG_setChannelName (him.get(), 44, U"FC6");
-			EEG_setChannelName (him.get(), 45, U"FC4");
-			EEG_setChannelName (him.get(), 46, U"FC2");
-			EEG_setChannelName (him.get(), 47, U"FCz");
-			EEG_setChannelName (him.get(), 48, U"Cz");
-			EEG_setChannelName (him.get(), 49, U"C2");
-			EEG_setChannelName (him.get(), 50, U"C4");
-			EEG_setChannelName (him.get(), 51, U"C6");
-			EEG_setChannelName (him.get(), 52, U"T8");
-			EEG_setChannelName (him.get(), 53, U"TP8");
-			EEG_setChannelName (him.get(), 54, U"CP6");
-			EEG_setChannelName (him.get(), 55, U"CP4");
-			EEG_setChannelName (him.get(), 56, U"CP2");
-			EEG_setChannelName (him.get(), 57, U"P2");
-			EEG_setChannelName (him.get(), 58, U"P4");
-			EEG_setChannelName (him.get(), 59, U"P6");
-			EEG_setChannelName (him.get(), 60, U"P8");
-			EEG_setChannelName (him.get(), 61, U"P10");
-			EEG_setChannelName (him.get(), 62, U"PO8");
-			EEG_setChannelName (him.get(), 63, U"PO4");
-			EEG_setChannelName (him.get(), 64, U"O2");
-		}
+		f.close (& my file);
+		autoEEG him = EEG_create (sound -> xmin, sound -> xmax);
+		his numberOfChannels = numberOfChannels;
+		his channelNames = autoSTRVEC (numberOfChannels);
+		for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+			his channelNames [ichan] = Melder_dup (my channelNames [fileChannels [ichan]].get());
+		his textgrid = TextGrid_createFromBdfStatus (sound.get(), my hasLetters, timeShift, imin == 1);
+		his sound = sound.move();
 		return him;
+	} catch (MelderError) {
+		Melder_throw (me, U": part not extracted.");
+	}
+}
+
+autoEEG EEG_readFromBdfFile (MelderFile file) {
+	try {
+		autoLongEEG me = LongEEG_open (file);
+		autoINTVEC allChannels = to_INTVEC (my numberOfChannels);
+		return LongEEG_extractPart (me.get(), my xmin, my xmax, allChannels.get(), true);
 	} catch (MelderError) {
 		Melder_throw (U"BDF file not read.");
 	}
@@ -443,22 +606,106 @@ void EEG_detrend (EEG me) {
 
 void EEG_filter (EEG me, double lowFrequency, double lowWidth, double highFrequency, double highWidth, bool doNotch50Hz) {
 	try {
-/*
-	integer nsampFFT = 1;
-	while (nsampFFT < my sound -> nx)
-		nsampFFT *= 2;
-	autoNUMFourierTable fftTable = NUMFourierTable_create (nsampFFT);
-*/
-		for (integer ichan = 1; ichan <= my numberOfChannels - EEG_getNumberOfExtraSensors (me); ichan ++) {
-			autoSound channel = Sound_extractChannel (my sound.get(), ichan);
-			autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-			Spectrum_passHannBand (spec.get(), lowFrequency, 0.0, lowWidth);
-			Spectrum_passHannBand (spec.get(), 0.0, highFrequency, highWidth);
+		const integer numberOfSamples = my sound -> nx;
+		const double samplingPeriod = my sound -> dx, nyquistFrequency = 0.5 / samplingPeriod;
+		const double notchFrequency = 50.0, notchHalfWidth = 2.0, notchSmooth = 1.0;
+		auto gainAt = [&] (double frequency) -> double {
+			double gain = Spectrum_passHannBand_gain (frequency, nyquistFrequency, lowFrequency, 0.0, lowWidth) *
+					Spectrum_passHannBand_gain (frequency, nyquistFrequency, 0.0, highFrequency, highWidth);
 			if (doNotch50Hz)
-				Spectrum_stopHannBand (spec.get(), 48.0, 52.0, 1.0);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			my sound -> z.row (ichan)  <<=  his z.row (1).part (1, my sound -> nx);
+				gain *= Spectrum_stopHannBand_gain (frequency, nyquistFrequency,
+						notchFrequency - notchHalfWidth, notchFrequency + notchHalfWidth, notchSmooth);
+			return gain;
+		};
+		/*
+			The filter is a zero-phase FIR filter whose frequency response approximates
+			the product of the Hann bands, which is what filtering the spectrum of the whole recording would give.
+			Its length follows from the narrowest transition band that is in use;
+			only a transition band of zero width requires the whole recording.
+		*/
+		double narrowestSmooth = undefined;
+		if (lowFrequency > 0.0)
+			narrowestSmooth = lowWidth;
+		if (highFrequency != 0.0 && highFrequency < nyquistFrequency)
+			narrowestSmooth = ( isdefined (narrowestSmooth) ? std::min (narrowestSmooth, highWidth) : highWidth );
+		if (doNotch50Hz)
+			narrowestSmooth = ( isdefined (narrowestSmooth) ? std::min (narrowestSmooth, notchSmooth) : notchSmooth );
+		if (isundef (narrowestSmooth))
+			return;   // nothing to filter away
+		const double kernelHalfDuration = ( narrowestSmooth > 0.0 ? 8.0 / narrowestSmooth : undefined );
+		const integer kernelHalfLength = ( isdefined (kernelHalfDuration) && kernelHalfDuration / samplingPeriod < numberOfSamples ?
+				Melder_iroundUp (kernelHalfDuration / samplingPeriod) : numberOfSamples );
+		const integer blockSize = Melder_iroundUpToPowerOfTwo (std::max (4 * kernelHalfLength, 4096_integer));
+		const integer numberOfOutputsPerBlock = blockSize - 2 * kernelHalfLength;
+		/*
+			Design the kernel: sample the desired response, transform to the time domain,
+			taper to the kernel length, and transform back; the result is real and even,
+			so its spectrum consists of a single gain per frequency.
+			The taper is flat over the inner half of the kernel and falls off as a Hann window in the outer half;
+			tapering the whole kernel would widen each transition band by about 1/8 of its width,
+			with gain errors of up to 1e-3, whereas this taper keeps the gain within about 1e-4 of the Hann bands.
+		*/
+		autoVEC kernelGains = zero_VEC (blockSize / 2 + 1);
+		{// scope
+			autoNUMFourierTable fftTable = NUMFourierTable_create (blockSize);
+			autoVEC kernel = zero_VEC (blockSize);
+			const double frequencyStep = 1.0 / (blockSize * samplingPeriod);
+			kernel [1] = gainAt (0.0);
+			for (integer k = 1; k < blockSize / 2; k ++)
+				kernel [k + k] = gainAt (k * frequencyStep);
+			kernel [blockSize] = gainAt (nyquistFrequency);
+			NUMfft_backward (fftTable.get(), kernel.get());
+			kernel [1] /= blockSize;
+			for (integer lag = 1; lag <= blockSize / 2; lag ++) {
+				const double relativeLag = lag / (kernelHalfLength + 1.0);
+				const double taper = ( relativeLag < 0.5 ? 1.0 :
+						relativeLag < 1.0 ? 0.5 + 0.5 * cos (NUMpi * (2.0 * relativeLag - 1.0)) : 0.0 );
+				kernel [1 + lag] *= taper / blockSize;
+				if (lag < blockSize / 2)
+					kernel [1 + blockSize - lag] *= taper / blockSize;
+			}
+			NUMfft_forward (fftTable.get(), kernel.get());
+			kernelGains [1] = kernel [1] / blockSize;   // include the normalization of the backward transform of each block
+			for (integer k = 1; k < blockSize / 2; k ++)
+				kernelGains [1 + k] = kernel [k + k] / blockSize;
+			kernelGains [1 + blockSize / 2] = kernel [blockSize] / blockSize;
 		}
+		/*
+			Filter each channel in place, with overlap-save in blocks;
+			each thread needs memory for only one block.
+		*/
+		const integer numberOfChannelsToFilter = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
+		MelderThread_PARALLELIZE (numberOfChannelsToFilter, 1)
+
+		autoNUMFourierTable fftTable = NUMFourierTable_create (blockSize);
+		autoVEC block = raw_VEC (blockSize);
+		autoVEC history = raw_VEC (kernelHalfLength);   // the unfiltered samples just before the current block
+
+		MelderThread_FOR (ichan) {
+
+			const VEC channel = my sound -> z.row (ichan);
+			history.all()  <<=  0.0;
+			for (integer firstOutput = 1; firstOutput <= numberOfSamples; firstOutput += numberOfOutputsPerBlock) {
+				block.part (1, kernelHalfLength)  <<=  history.all();
+				for (integer i = 1; i <= blockSize - kernelHalfLength; i ++) {
+					const integer isamp = firstOutput - 1 + i;
+					block [kernelHalfLength + i] = ( isamp <= numberOfSamples ? channel [isamp] : 0.0 );
+				}
+				history.all()  <<=  block.part (numberOfOutputsPerBlock + 1, numberOfOutputsPerBlock + kernelHalfLength);
+				NUMfft_forward (fftTable.get(), block.get());
+				block [1] *= kernelGains [1];
+				for (integer k = 1; k < blockSize / 2; k ++) {
+					block [k + k] *= kernelGains [1 + k];
+					block [k + k + 1] *= kernelGains [1 + k];
+				}
+				block [blockSize] *= kernelGains [1 + blockSize / 2];
+				NUMfft_backward (fftTable.get(), block.get());
+				const integer numberOfOutputs = std::min (numberOfOutputsPerBlock, numberOfSamples - firstOutput + 1);
+				channel.part (firstOutput, firstOutput + numberOfOutputs - 1)  <<=
+						block.part (kernelHalfLength + 1, kernelHalfLength + numberOfOutputs);
+			}
+
+		} MelderThread_ENDFOR
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered.");
 	}
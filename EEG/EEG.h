@@ -2,7 +2,7 @@
 #define _EEG_h_
 /* EEG.h
  *
- * Copyright (C) 2011-2012,2014-2018 Paul Boersma
+ * Copyright (C) 2011-2012,2014-2018,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -33,11 +33,17 @@ autoEEG EEGs_concatenate (OrderedOf<structEEG>* me);
 void EEG_init (EEG me, double tmin, double tmax);
 integer EEG_getChannelNumber (EEG me, conststring32 channelName);
 void EEG_setChannelName (EEG me, integer channelNumber, conststring32 newName);
+static inline integer EEG_getNumberOfCapElectrodes (integer numberOfChannels) {
+	return (numberOfChannels - 1) & ~ 15L;   // BUG
+}
 static inline integer EEG_getNumberOfCapElectrodes (EEG me) {
-	return (my numberOfChannels - 1) & ~ 15L;   // BUG
+	return EEG_getNumberOfCapElectrodes (my numberOfChannels);
+}
+static inline integer EEG_getNumberOfExtraSensors (integer numberOfChannels) {
+	return numberOfChannels == 1 ? 0 : numberOfChannels & 1 ? 1 : 8;   // BUG
 }
 static inline integer EEG_getNumberOfExtraSensors (EEG me) {
-	return my numberOfChannels == 1 ? 0 : my numberOfChannels & 1 ? 1 : 8;   // BUG
+	return EEG_getNumberOfExtraSensors (my numberOfChannels);
 }
 static inline integer EEG_getNumberOfExternalElectrodes (EEG me) {
 	return my numberOfChannels - EEG_getNumberOfCapElectrodes (me) - EEG_getNumberOfExtraSensors (me);
@@ -68,5 +74,41 @@ autoMixingMatrix EEG_to_MixingMatrix (EEG me,
 autoEEG EEG_MixingMatrix_to_EEG_unmix (EEG me, MixingMatrix you);
 autoEEG EEG_MixingMatrix_to_EEG_mix (EEG me, MixingMatrix you);
 
+/*
+	A LongEEG is a BDF or EDF file on disk, of which only the header has been read.
+	Parts of it, with a selection of the channels, can be read into EEG objects
+	without ever having the whole recording in memory.
+*/
+Thing_define (LongEEG, Function) {
+	structMelderFile file;
+	bool is24bit, hasLetters;
+	integer numberOfChannels;
+	autoSTRVEC channelNames;
+	integer numberOfBytesInHeaderRecord, numberOfDataRecords, numberOfSamplesPerDataRecord;
+	double durationOfDataRecord, samplingFrequency;
+	autoVEC scalingFactors;   // from the digital value in the file to volts (except for the status channel)
+
+	void v1_info ()
+		override;
+	void v1_copy (Daata data_to) const
+		override;
+	bool v_writable ()
+		override { return false; }
+	int v_domainQuantity () const
+		override { return MelderQuantity_TIME_SECONDS; }
+};
+
+autoLongEEG LongEEG_open (MelderFile file);
+
+autoEEG LongEEG_extractPart (LongEEG me, double tmin, double tmax, constINTVECVU const& channelNumbers, bool preserveTimes);
+/*
+	Reads only the data records that overlap the time range, and only the selected channels from them.
+	An empty list of channel numbers stands for all channels.
+	The status channel (the last channel in the file) is always included, as the last channel of the EEG,
+	because the marks in the TextGrid of the EEG are derived from it.
+	An EEG does not store which of its channels are cap electrodes, external electrodes or extra sensors,
+	but derives this from its number of channels; a selection of channels for which this would go wrong is refused.
+*/
+
 /* End of file EEG.h */
 #endif
@@ -81,22 +81,33 @@ static autoERPTier EEG_PointProcess_to_ERPTier (EEG me, PointProcess events, dou
 		double soundPhysicalDuration = numberOfSamples * samplingPeriod;
 		double firstTime = midTime - 0.5 * soundPhysicalDuration + 0.5 * samplingPeriod;   // distribute the samples evenly over the time domain
 		for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
-			double eegEventTime = events -> t [ievent];
 			autoERPPoint event = Thing_new (ERPPoint);
-			event -> number = eegEventTime;
-			event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, samplingPeriod, firstTime);
-			double erpEventTime = 0.0;
-			double eegSample = 1 + (eegEventTime - my sound -> x1) / samplingPeriod;
-			double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
-			integer sampleDifference = Melder_iround (eegSample - erpSample);
-			for (integer ichannel = 1; ichannel <= thy numberOfChannels; ichannel ++) {
-				for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-					integer jsample = isample + sampleDifference;
-					event -> erp -> z [ichannel] [isample] = jsample < 1 || jsample > my sound -> nx ? 0.0 : my sound -> z [ichannel] [jsample];
-				}
-			}
+			event -> number = events -> t [ievent];
 			thy points. addItem_move (event.move());
 		}
+		Melder_assert (thy points.size == numberOfEvents);   // the event times in a PointProcess are unique
+		/*
+			The epochs are independent of each other, so they can be cut out in parallel.
+		*/
+		MelderThread_PARALLELIZE (numberOfEvents, 4)
+		MelderThread_FOR (ievent) {
+			ERPPoint event = thy points.at [ievent];
+			event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, samplingPeriod, firstTime);
+			const double erpEventTime = 0.0;
+			const double eegSample = 1 + (event -> number - my sound -> x1) / samplingPeriod;
+			const double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
+			const integer sampleDifference = Melder_iround (eegSample - erpSample);
+			/*
+				Samples outside the EEG stay zero.
+			*/
+			const integer firstSample = std::max (1_integer, 1 - sampleDifference);
+			const integer lastSample = std::min (numberOfSamples, my sound -> nx - sampleDifference);
+			if (firstSample > lastSample)
+				continue;
+			for (integer ichannel = 1; ichannel <= thy numberOfChannels; ichannel ++)
+				event -> erp -> z [ichannel].part (firstSample, lastSample)  <<=
+						my sound -> z [ichannel].part (firstSample + sampleDifference, lastSample + sampleDifference);
+		} MelderThread_ENDFOR
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": ERP analysis not performed.");
@@ -181,49 +192,47 @@ autoERPTier EEG_to_ERPTier_triggers_preceded (EEG me, double fromTime, double to
 }
 
 void ERPTier_subtractBaseline (ERPTier me, double tmin, double tmax) {
-	integer numberOfEvents = my points.size;
+	const integer numberOfEvents = my points.size;
 	if (numberOfEvents < 1)
 		return;   // nothing to do
-	ERPPoint firstEvent = my points.at [1];
-	integer numberOfChannels = firstEvent -> erp -> ny;
-	integer numberOfSamples = firstEvent -> erp -> nx;
-	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
+	MelderThread_PARALLELIZE (numberOfEvents, 4)
+	MelderThread_FOR (ievent) {
 		ERPPoint event = my points.at [ievent];
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			double mean = Vector_getMean (event -> erp.get(), tmin, tmax, ichannel);
-			VEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				channel [isample] -= mean;
-			}
+		for (integer ichannel = 1; ichannel <= event -> erp -> ny; ichannel ++) {
+			const double mean = Vector_getMean (event -> erp.get(), tmin, tmax, ichannel);
+			event -> erp -> z.row (ichannel)  -=  mean;
 		}
-	}
+	} MelderThread_ENDFOR
 }
 
 void ERPTier_rejectArtefacts (ERPTier me, double threshold) {
-	integer numberOfEvents = my points.size;
+	const integer numberOfEvents = my points.size;
 	if (numberOfEvents < 1)
 		return;   // nothing to do
 	ERPPoint firstEvent = my points.at [1];
-	integer numberOfChannels = firstEvent -> erp -> ny;
-	integer numberOfSamples = firstEvent -> erp -> nx;
+	const integer numberOfChannels = firstEvent -> erp -> ny;
+	const integer numberOfSamples = firstEvent -> erp -> nx;
 	if (numberOfSamples < 1)
 		return;   // nothing to do
-	for (integer ievent = numberOfEvents; ievent >= 1; ievent --) {   // cycle down because of removal
+	/*
+		First decide in parallel which events to reject, then remove them in one serial pass.
+	*/
+	autoBOOLVEC reject = zero_BOOLVEC (numberOfEvents);
+	MelderThread_PARALLELIZE (numberOfEvents, 4)
+	MelderThread_FOR (ievent) {
 		ERPPoint event = my points.at [ievent];
 		double minimum = event -> erp -> z [1] [1];
 		double maximum = minimum;
 		for (integer ichannel = 1; ichannel <= (numberOfChannels & ~ 15); ichannel ++) {
-			constVEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				double value = channel [isample];
-				if (value < minimum) minimum = value;
-				if (value > maximum) maximum = value;
-			}
+			const constVEC channel = event -> erp -> z.row (ichannel);
+			minimum = std::min (minimum, NUMmin_u (channel));
+			maximum = std::max (maximum, NUMmax_u (channel));
 		}
-		if (minimum < - threshold || maximum > threshold) {
+		reject [ievent] = ( minimum < - threshold || maximum > threshold );
+	} MelderThread_ENDFOR
+	for (integer ievent = numberOfEvents; ievent >= 1; ievent --)   // cycle down because of removal
+		if (reject [ievent])
 			my points. removeItem (ievent);
-		}
-	}
 }
 
 autoERP ERPTier_extractERP (ERPTier me, integer eventNumber) {
@@ -243,24 +252,82 @@ autoERP ERPTier_extractERP (ERPTier me, integer eventNumber) {
 	}
 }
 
+static autoERP ERPTier_to_ERP_mean_selected (ERPTier me, constINTVEC const& eventNumbers) {
+	const integer numberOfSelectedEvents = eventNumbers.size;
+	if (numberOfSelectedEvents < 1)
+		Melder_throw (U"No events.");
+	ERPPoint firstEvent = my points.at [eventNumbers [1]];
+	Melder_assert (firstEvent -> erp -> ny == my numberOfChannels);
+	autoERP mean = Thing_new (ERP);
+	firstEvent -> erp -> structSound :: v1_copy (mean.get());
+	Melder_assert (mean -> ny == my numberOfChannels);
+	/*
+		Each thread sums its own channels over all the selected events,
+		in the order of the events, so that the result does not depend on the number of threads.
+	*/
+	MelderThread_PARALLELIZE (my numberOfChannels, 2)
+	MelderThread_FOR (ichannel) {
+		const VEC sum = mean -> z.row (ichannel);
+		for (integer i = 2; i <= numberOfSelectedEvents; i ++) {
+			ERPPoint event = my points.at [eventNumbers [i]];
+			Melder_assert (event -> erp -> ny == my numberOfChannels);
+			sum  +=  event -> erp -> z.row (ichannel);
+		}
+		sum  *=  1.0 / numberOfSelectedEvents;
+	} MelderThread_ENDFOR
+	mean -> channelNames = copy_STRVEC (my channelNames.get());
+	return mean;
+}
+
 autoERP ERPTier_to_ERP_mean (ERPTier me) {
 	try {
-		integer numberOfEvents = my points.size;
-		if (numberOfEvents < 1)
-			Melder_throw (U"No events.");
-		ERPPoint firstEvent = my points.at [1];
-		Melder_assert (firstEvent -> erp -> ny == my numberOfChannels);
-		autoERP mean = Thing_new (ERP);
-		firstEvent -> erp -> structSound :: v1_copy (mean.get());
-		Melder_assert (mean -> ny == my numberOfChannels);
-		for (integer ievent = 2; ievent <= numberOfEvents; ievent ++) {
-			ERPPoint event = my points.at [ievent];
-			Melder_assert (event -> erp -> ny == my numberOfChannels);
-			mean -> z.all()  +=  event -> erp -> z.all();
+		autoINTVEC eventNumbers = to_INTVEC (my points.size);
+		return ERPTier_to_ERP_mean_selected (me, eventNumbers.get());
+	} catch (MelderError) {
+		Melder_throw (me, U": mean not computed.");
+	}
+}
+
+autoERP ERPTier_to_ERP_meanWhereColumn_number (ERPTier me, Table table, integer columnNumber, kMelder_number which, double criterion) {
+	try {
+		Table_checkSpecifiedColumnNumberWithinRange (table, columnNumber);
+		Table_numericize_a (table, columnNumber);
+		if (my points.size != table -> rows.size)
+			Melder_throw (me, U" & ", table, U": the number of rows in the table (", table -> rows.size,
+				U") doesn't match the number of events (", my points.size, U").");
+		autoINTVEC eventNumbers = raw_INTVEC (my points.size);
+		integer numberOfSelectedEvents = 0;
+		for (integer ievent = 1; ievent <= my points.size; ievent ++) {
+			TableRow row = table -> rows.at [ievent];
+			if (Melder_numberMatchesCriterion (row -> cells [columnNumber]. number, which, criterion))
+				eventNumbers [++ numberOfSelectedEvents] = ievent;
+		}
+		if (numberOfSelectedEvents == 0)
+			Melder_throw (U"No event matches criterion.");
+		return ERPTier_to_ERP_mean_selected (me, eventNumbers.part (1, numberOfSelectedEvents));
+	} catch (MelderError) {
+		Melder_throw (me, U": mean not computed.");
+	}
+}
+
+autoERP ERPTier_to_ERP_meanWhereColumn_string (ERPTier me, Table table,
+	integer columnNumber, kMelder_string which, conststring32 criterion)
+{
+	try {
+		Table_checkSpecifiedColumnNumberWithinRange (table, columnNumber);
+		if (my points.size != table -> rows.size)
+			Melder_throw (me, U" & ", table, U": the number of rows in the table (", table -> rows.size,
+				U") doesn't match the number of events (", my points.size, U").");
+		autoINTVEC eventNumbers = raw_INTVEC (my points.size);
+		integer numberOfSelectedEvents = 0;
+		for (integer ievent = 1; ievent <= my points.size; ievent ++) {
+			TableRow row = table -> rows.at [ievent];
+			if (Melder_stringMatchesCriterion (row -> cells [columnNumber]. string.get(), which, criterion, true))
+				eventNumbers [++ numberOfSelectedEvents] = ievent;
 		}
-		mean -> z.all()  *=  1.0 / numberOfEvents;
-		mean -> channelNames = copy_STRVEC (my channelNames.get());
-		return mean;
+		if (numberOfSelectedEvents == 0)
+			Melder_throw (U"No event matches criterion.");
+		return ERPTier_to_ERP_mean_selected (me, eventNumbers.part (1, numberOfSelectedEvents));
 	} catch (MelderError) {
 		Melder_throw (me, U": mean not computed.");
 	}
@@ -2,7 +2,7 @@
 #define _ERPTier_h_
 /* ERPTier.h
  *
- * Copyright (C) 2011,2012,2014-2018 Paul Boersma
+ * Copyright (C) 2011,2012,2014-2018,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -36,6 +36,12 @@ void ERPTier_subtractBaseline (ERPTier me, double tmin, double tmax);
 void ERPTier_rejectArtefacts (ERPTier me, double threshold);
 autoERP ERPTier_extractERP (ERPTier me, integer pointNumber);
 autoERP ERPTier_to_ERP_mean (ERPTier me);
+/*
+	The same as extracting the events and then computing the mean, but without copying the events.
+*/
+autoERP ERPTier_to_ERP_meanWhereColumn_number (ERPTier me, Table table, integer columnNumber, kMelder_number which, double criterion);
+autoERP ERPTier_to_ERP_meanWhereColumn_string (ERPTier me, Table table, integer columnNumber, kMelder_string which, conststring32 criterion);
+
 autoERPTier ERPTier_extractEventsWhereColumn_number (ERPTier me, Table table, integer columnNumber, kMelder_number which, double criterion);
 autoERPTier ERPTier_extractEventsWhereColumn_string (ERPTier me, Table table, integer columnNumber, kMelder_string which, conststring32 criterion);
 
@@ -1,6 +1,6 @@
 /* manual_EEG.cpp
  *
- * Copyright (C) 2012,2015,2016,2018,2019,2023,2025 Paul Boersma
+ * Copyright (C) 2012,2015,2016,2018,2019,2023,2025,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -21,7 +21,7 @@
 void manual_EEG_init (ManPages me);
 void manual_EEG_init (ManPages me) {
 
-MAN_BEGIN (U"EEG", U"ppgb", 20180329)
+MAN_BEGIN (U"EEG", U"ppgb", 20261019)
 INTRO (U"EEG means electro-encephalography: brain potentials recorded via e.g. 32 or 64 electrodes on the scalp. "
 	"In Praat, an EEG object looks like a combination of a Sound object with e.g. 32 or 64 channels "
 	"and a TextGrid object that marks the events.")
@@ -30,6 +30,9 @@ NORMAL (U"You typically create an EEG object in Praat by opening a BDF/EDF file
 	"Praat tries to read the whole file into memory, so you may want to work with a 64-bit edition of Praat "
 	"if you want to avoid “out of memory” messages.")
 NORMAL (U"After you do ##Read from file...#, an EEG object will appear in the list of objects.")
+NORMAL (U"If your recording is too long to fit into memory, or if you need only a few channels or a few minutes of it, "
+	"you can instead open the file with ##Open long EEG file...# from the #Open menu. "
+	"This creates a @LongEEG object, from which you can extract the EEG objects that you need.")
 ENTRY (U"2. How to look into an EEG object")
 NORMAL (U"Once you have an EEG object in the list, you can click ##View & Edit# to look into it. "
 	"You will typically see the first 8 channels, but you scroll to the other channels by clicking on the up and down arrows. "
@@ -64,7 +67,10 @@ NORMAL (U"##Subtracting a reference signal.# The voltage on the whole scalp may
 NORMAL (U"##Detrending.# With #Detrend, you subtract from each electrode channel a line in such a way that the first sample and the last sample become zero. "
 	"Detrending and reference subtraction can be performed in either order.")
 NORMAL (U"##Filtering.# With ##Filter...#, you band-pass filter each electrode channel. Filtering should be done after detrending, but "
-	"filtering and reference subtraction can be performed in either order.")
+	"filtering and reference subtraction can be performed in either order. "
+	"The pass band has Hann-shaped edges, as with @@Spectrum: Filter (pass Hann band)...@, "
+	"but the filter works on only a few seconds of the signal at a time, "
+	"so that long recordings with many channels are filtered quickly and without much memory.")
 ENTRY (U"4. How to do an ERP analysis")
 NORMAL (U"An ERP is an Event-Related Potential. Events are marked somewhere in S1, S2, ... S8. In the above example, "
 	"we extract all the “deviant” events by doing ##To ERPTier...#, setting ##From time# to -0.11 seconds, "
@@ -83,6 +89,10 @@ NORMAL (U"After you subtract the baseline, the part after the event contains the
 NORMAL (U"Once you have an ERPTier, you can extract each of the 150 ERPs from it with ##Extract ERP...#. "
 	"It is perhaps more interesting to compute the average of all those 150 ERPs with ##To ERP (mean)#. "
 	"These commands put a new ERP object in the list.")
+NORMAL (U"If you have a @Table with one row for each event in the ERPTier (e.g. the conditions of your experiment), "
+	"you can select the ERPTier and the Table together and choose ##To ERP (mean) where column (text)...# "
+	"or ##To ERP (mean) where column (number)...#. This averages only the events whose row in the Table matches your criterion, "
+	"without first extracting those events into a new ERPTier.")
 NORMAL (U"Once you have an ERP object, you can look into it with ##View & Edit#. "
 	"If you want to see in the ERP window the scalp distribution at the time of the cursor, or the average scalp distribution in the selected time stretch, "
 	"you have to switch on ##Show selection viewer# in the #Preferences window (available from the File menu).")
@@ -90,6 +100,30 @@ ENTRY (U"See also")
 LIST_ITEM (U"\\bu @@Independent Component Analysis on EEG@")
 MAN_END
 
+MAN_BEGIN (U"LongEEG", U"ppgb", 20261019)
+INTRO (U"One of the @@types of objects@ in Praat. "
+	"A LongEEG object gives you access to a BDF or EDF file that can be much longer than the available memory.")
+ENTRY (U"How to get a LongEEG object")
+NORMAL (U"Choose ##Open long EEG file...# from the #Open menu. "
+	"Praat reads only the header of the file, i.e. the sampling frequency, the number of samples "
+	"and the names of the channels; the samples themselves stay in the file.")
+ENTRY (U"How to get an EEG object from it")
+NORMAL (U"Select the LongEEG and choose ##Extract part...#. You specify a time range and the channels that you want; "
+	"Praat then reads from the file only the data records that cover the time range, "
+	"and decodes only the channels that you asked for. "
+	"The Status channel is always included (as the last channel), "
+	"so that the resulting @EEG contains the marks and triggers for the extracted part. "
+	"If you leave ##Channel numbers# empty, you get all the channels.")
+NORMAL (U"An EEG object does not remember which of its channels are cap electrodes, external electrodes or other sensors; "
+	"it derives this from its number of channels, the way it does for a whole BioSemi recording. "
+	"Praat therefore refuses a selection of channels that would change the role of any of them, "
+	"such as the first 9 cap electrodes; you can always choose all channels, or e.g. all cap electrodes.")
+NORMAL (U"If you switch on ##Preserve times#, the extracted EEG starts at the time of the first extracted sample; "
+	"otherwise, it starts at 0 seconds.")
+NORMAL (U"You cannot write a LongEEG to a Praat file, because it is only a link to the original BDF/EDF file, "
+	"which has to stay where it is as long as the LongEEG exists.")
+MAN_END
+
 MAN_BEGIN (U"Independent Component Analysis on EEG", U"ppgb", 20180502)
 INTRO (U"Independent Component Analysis (ICA) is often used to improve @EEG signals. "
 	"See @@blind source separation@ for the algorithm.")
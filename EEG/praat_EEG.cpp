@@ -1,6 +1,6 @@
 /* praat_EEG.cpp
  *
- * Copyright (C) 2011-2018,2020-2024 Paul Boersma
+ * Copyright (C) 2011-2018,2020-2024,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -337,6 +337,30 @@ DIRECT (MODIFY_EEG_TextGrid_replaceTextGrid) {
 	MODIFY_FIRST_OF_ONE_AND_ONE_END
 }
 
+// MARK: - LONGEEG
+
+FORM_READ (READ1_LongEEG_open, U"Open long EEG file", nullptr, true) {
+	READ_ONE
+		autoLongEEG result = LongEEG_open (file);
+	READ_ONE_END
+}
+
+DIRECT (HELP_LongEEG_help) {
+	HELP (U"LongEEG")
+}
+
+FORM (NEW_LongEEG_extractPart, U"LongEEG: Extract part", nullptr) {
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range (s)", U"10.0")
+	NATURALVECTOR (channels, U"Channel numbers (empty = all)", RANGES_, U"")
+	BOOLEAN (preserveTimes, U"Preserve times", true)
+	OK
+DO
+	CONVERT_EACH_TO_ONE (LongEEG)
+		autoEEG result = LongEEG_extractPart (me, fromTime, toTime, channels, preserveTimes);
+	CONVERT_EACH_TO_ONE_END (my name.get())
+}
+
 // MARK: - ERP
 
 // MARK: View & Edit
@@ -710,6 +734,30 @@ DO
 	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get())
 }
 
+FORM (NEW1_ERPTier_Table_to_ERP_meanWhereColumn_number, U"To ERP (mean) where column (number)", nullptr) {
+	WORD (averageAllEventsWhereColumn___, U"Average all events where column...", U"")
+	CHOICE_ENUM (kMelder_number, ___is___, U"...is...", kMelder_number::DEFAULT)
+	REAL (___theNumber, U"...the number", U"0.0")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_ONE (ERPTier, Table)
+		const integer columnNumber = Table_columnNameToNumber_e (you, averageAllEventsWhereColumn___);
+		autoERP result = ERPTier_to_ERP_meanWhereColumn_number (me, you, columnNumber, (kMelder_number) ___is___, ___theNumber);
+	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get(), U"_mean")
+}
+
+FORM (NEW1_ERPTier_Table_to_ERP_meanWhereColumn_text, U"To ERP (mean) where column (text)", nullptr) {
+	WORD (averageAllEventsWhereColumn___, U"Average all events where column...", U"")
+	OPTIONMENU_ENUM (kMelder_string, ___, U"...", kMelder_string::DEFAULT)
+	SENTENCE (___theText, U"...the text", U"hi")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_ONE (ERPTier, Table)
+		const integer columnNumber = Table_columnNameToNumber_e (you, averageAllEventsWhereColumn___);
+		autoERP result = ERPTier_to_ERP_meanWhereColumn_string (me, you, columnNumber, ___, ___theText);
+	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get(), U"_mean")
+}
+
 // MARK: - file recognizers
 
 static autoDaata bdfFileRecognizer (integer nread, const char [] /* header */, MelderFile file) {
@@ -726,10 +774,12 @@ static autoDaata bdfFileRecognizer (integer nread, const char [] /* header */, M
 void praat_EEG_init ();
 void praat_EEG_init () {
 
-	Thing_recognizeClassesByName (classEEG, classERPTier, classERP, nullptr);
+	Thing_recognizeClassesByName (classEEG, classERPTier, classERP, classLongEEG, nullptr);
 
 	Data_recognizeFileType (bdfFileRecognizer);
 
+	praat_addMenuCommand (U"Objects", U"Open", U"Open long EEG file...", nullptr, 0, READ1_LongEEG_open);
+
 	praat_addAction1 (classEEG, 0, U"EEG help", nullptr, 0, HELP_EEG_help);
 	praat_addAction1 (classEEG, 1, U"View & Edit", nullptr, GuiMenu_ATTRACTIVE, EDITOR_ONE_EEG_viewAndEdit);
 	praat_addAction1 (classEEG, 0, U"Query -", nullptr, 0, nullptr);
@@ -809,12 +859,18 @@ void praat_EEG_init () {
 		praat_addAction1 (classERPTier, 0, U"Extract ERP...", nullptr, 0, NEW_ERPTier_to_ERP);
 		praat_addAction1 (classERPTier, 0, U"To ERP (mean)", nullptr, 0, NEW_ERPTier_to_ERP_mean);
 
+	praat_addAction1 (classLongEEG, 0, U"LongEEG help", nullptr, 0, HELP_LongEEG_help);
+	praat_addAction1 (classLongEEG, 0, U"Extract part...", nullptr, 0, NEW_LongEEG_extractPart);
+
 	praat_addAction2 (classEEG, 1, classMixingMatrix, 1, U"To EEG (unmix)", nullptr, 0, NEW_EEG_MixingMatrix_to_EEG_unmix);
 	praat_addAction2 (classEEG, 1, classMixingMatrix, 1, U"To EEG (mix)", nullptr, 0, NEW_EEG_MixingMatrix_to_EEG_mix);
 	praat_addAction2 (classEEG, 1, classTextGrid, 1, U"Replace TextGrid", nullptr, 0, MODIFY_EEG_TextGrid_replaceTextGrid);
 	praat_addAction2 (classERPTier, 1, classTable, 1, U"Extract -", nullptr, 0, nullptr);
 	praat_addAction2 (classERPTier, 1, classTable, 1, U"Extract events where column (number)...", nullptr, 1, NEW1_ERPTier_Table_extractEventsWhereColumn_number);
 	praat_addAction2 (classERPTier, 1, classTable, 1, U"Extract events where column (text)...", nullptr, 1, NEW1_ERPTier_Table_extractEventsWhereColumn_text);
+	praat_addAction2 (classERPTier, 1, classTable, 1, U"Analyse", nullptr, 0, nullptr);
+	praat_addAction2 (classERPTier, 1, classTable, 1, U"To ERP (mean) where column (number)...", nullptr, 0, NEW1_ERPTier_Table_to_ERP_meanWhereColumn_number);
+	praat_addAction2 (classERPTier, 1, classTable, 1, U"To ERP (mean) where column (text)...", nullptr, 0, NEW1_ERPTier_Table_to_ERP_meanWhereColumn_text);
 
 	structEEGArea           :: f_preferences ();
 	structEEGAnalysisArea   :: f_preferences ();
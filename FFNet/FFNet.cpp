@@ -414,29 +414,207 @@ void FFNet_computeDerivative (FFNet me) {
 
 /******* end operation ******************************************************/
 
-integer FFNet_getWinningUnit (FFNet me, integer labeling) {
-	const integer k = my numberOfNodes - my numberOfOutputs;
+/***** BATCH OPERATION: *****************************************************/
+/*
+	The weights to the units of a layer are stored unit after unit, each with its bias last, i.e. they form
+	a [numberOfUnitsInLayer] x [numberOfUnitsInPreviousLayer + 1] matrix W inside my w.
+	With the patterns as the rows of A (0) = input, all patterns propagate through a layer as
+		A (layer) = f (A (layer - 1) . W' + bias),
+	the errors propagate back as
+		Delta (layer) = E (layer) * f' (layer),   E (layer - 1) = Delta (layer) . W,
+	and the derivative of the cost with respect to W is - Delta (layer)' . [A (layer - 1) | 1].
+	The matrix products are done by the (multithreaded) blocked matrix multiplication, the element-wise
+	parts are distributed over threads by rows. The patterns are processed in blocks of rows
+	to limit the memory that is needed.
+*/
+
+static constexpr integer FFNet_BATCH_NUMBER_OF_ROWS = 1024;
+
+static MATVU FFNet_getLayerWeights (FFNet me, VEC const& weights, integer layer) {
+	Melder_assert (weights.size == my numberOfWeights);
+	integer offset = 0, numberOfUnitsInPreviousLayer = my numberOfInputs;
+	for (integer ilayer = 1; ilayer < layer; ilayer ++) {
+		offset += my numberOfUnitsInLayer [ilayer] * (numberOfUnitsInPreviousLayer + 1);
+		numberOfUnitsInPreviousLayer = my numberOfUnitsInLayer [ilayer];
+	}
+	const integer numberOfColumns = numberOfUnitsInPreviousLayer + 1;
+	return MATVU (& weights [offset + 1], my numberOfUnitsInLayer [layer], numberOfColumns, numberOfColumns, 1);
+}
+
+struct FFNet_BatchWorkspace {
+	autoMAT activity [1 + 3], derivative [1 + 3], delta [1 + 3];   // per layer, one block of rows
+	autoVEC rowCosts;   // summed in a fixed order afterwards, so that the total does not depend on the number of threads
+
+	void init (FFNet net, integer numberOfRows, integer toLayer, bool wantDerivative) {
+		Melder_assert (toLayer <= 3);
+		for (integer ilayer = 1; ilayer <= toLayer; ilayer ++) {
+			const integer numberOfUnits = net -> numberOfUnitsInLayer [ilayer];
+			our activity [ilayer] = raw_MAT (numberOfRows, numberOfUnits);
+			if (wantDerivative) {
+				our derivative [ilayer] = raw_MAT (numberOfRows, numberOfUnits);
+				our delta [ilayer] = raw_MAT (numberOfRows, numberOfUnits);
+			}
+		}
+		our rowCosts = raw_VEC (numberOfRows);
+	}
+};
+
+static integer FFNet_thresholdNumberOfRowsPerThread (integer numberOfUnits) {
+	return std::max (1_integer, 10000 / numberOfUnits);
+}
+
+static void FFNet_propagateBlock (FFNet me, FFNet_BatchWorkspace *workspace, constMATVU const& input, integer toLayer, bool wantDerivative) {
+	const integer numberOfRows = input.nrow;
+	for (integer ilayer = 1; ilayer <= toLayer; ilayer ++) {
+		constMATVU weights = FFNet_getLayerWeights (me, my w.get(), ilayer);
+		const integer numberOfInputsToLayer = weights.ncol - 1;
+		constMATVU previous = ( ilayer == 1 ? input : workspace -> activity [ilayer - 1].horizontalBand (1, numberOfRows) );
+		MATVU activity = workspace -> activity [ilayer].horizontalBand (1, numberOfRows);
+		mul_fast_MAT_out (activity, previous, weights.verticalBand (1, numberOfInputsToLayer).transpose());
+		const bool isLinear = ( my outputsAreLinear && ilayer == my numberOfLayers );
+		std::atomic <bool> errorFlag = false;
+		MelderThread_run (& errorFlag, numberOfRows, FFNet_thresholdNumberOfRowsPerThread (activity.ncol),
+			[&] (integer /* threadNumber */, integer firstRow, integer lastRow) {
+				for (integer irow = firstRow; irow <= lastRow; irow ++) {
+					VECVU act = activity.row (irow);
+					for (integer iunit = 1; iunit <= act.size; iunit ++) {
+						const double x = act [iunit] + weights [iunit] [weights.ncol];
+						if (isLinear) {
+							act [iunit] = x;
+							if (wantDerivative)
+								workspace -> derivative [ilayer] [irow] [iunit] = 1.0;
+						} else
+							act [iunit] = my nonLinearity (me, x, ( wantDerivative ? & workspace -> derivative [ilayer] [irow] [iunit] : nullptr ));
+					}
+				}
+			}
+		);
+	}
+}
+
+void FFNet_propagate_batch (FFNet me, constMATVU const& input, MATVU const& activity, integer layer) {
+	Melder_require (layer > 0 && layer <= my numberOfLayers,
+		U"Layer should be in the range from 1 to ", my numberOfLayers, U".");
+	Melder_assert (input.nrow == activity.nrow);
+	Melder_assert (input.ncol == my numberOfInputs);
+	Melder_assert (activity.ncol == my numberOfUnitsInLayer [layer]);
+	const integer blockSize = std::min (input.nrow, FFNet_BATCH_NUMBER_OF_ROWS);
+	if (blockSize == 0)
+		return;
+	FFNet_BatchWorkspace workspace;
+	workspace.init (me, blockSize, layer, false);
+	for (integer firstRow = 1; firstRow <= input.nrow; firstRow += blockSize) {
+		const integer lastRow = std::min (firstRow + blockSize - 1, input.nrow);
+		FFNet_propagateBlock (me, & workspace, input.part (firstRow, lastRow, 1, input.ncol), layer, false);
+		activity.part (firstRow, lastRow, 1, activity.ncol)  <<=  workspace.activity [layer].horizontalBand (1, lastRow - firstRow + 1);
+	}
+}
+
+double FFNet_computeCostAndDerivative_batch (FFNet me, constMATVU const& input, constMATVU const& target, VEC const& dw) {
+	Melder_assert (input.nrow == target.nrow);
+	Melder_assert (input.ncol == my numberOfInputs);
+	Melder_assert (target.ncol == my numberOfOutputs);
+	const bool wantDerivative = ! NUMisEmpty (dw);
+	if (wantDerivative) {
+		Melder_assert (dw.size == my numberOfWeights);
+		dw  <<=  0.0;
+	}
+	const integer blockSize = std::min (input.nrow, FFNet_BATCH_NUMBER_OF_ROWS);
+	if (blockSize == 0)
+		return 0.0;
+	const integer numberOfLayers = my numberOfLayers;
+	const bool crossEntropy = ( my costFunctionType == 2 );
+	FFNet_BatchWorkspace workspace;
+	workspace.init (me, blockSize, numberOfLayers, wantDerivative);
+	longdouble cost = 0.0;
+	for (integer firstRow = 1; firstRow <= input.nrow; firstRow += blockSize) {
+		const integer lastRow = std::min (firstRow + blockSize - 1, input.nrow), numberOfRows = lastRow - firstRow + 1;
+		constMATVU inputBlock = input.part (firstRow, lastRow, 1, input.ncol);
+		FFNet_propagateBlock (me, & workspace, inputBlock, numberOfLayers, wantDerivative);
+		/*
+			The cost and the error at the output layer, as in minimumSquaredError and minimumCrossEntropy,
+			times the derivative of the activation function.
+		*/
+		constMATVU output = workspace.activity [numberOfLayers].horizontalBand (1, numberOfRows);
+		std::atomic <bool> errorFlag = false;
+		MelderThread_run (& errorFlag, numberOfRows, FFNet_thresholdNumberOfRowsPerThread (output.ncol),
+			[&] (integer /* threadNumber */, integer firstBlockRow, integer lastBlockRow) {
+				for (integer irow = firstBlockRow; irow <= lastBlockRow; irow ++) {
+					constVECVU t = target.row (firstRow - 1 + irow), o = output.row (irow);
+					double rowCost = 0.0;
+					for (integer i = 1; i <= o.size; i ++) {
+						double error;
+						if (crossEntropy) {
+							const double t1 = 1.0 - t [i], o1 = 1.0 - o [i];
+							rowCost -= t [i] * log (o [i]) + t1 * log (o1);
+							error = - t1 / o1 + t [i] / o [i];
+						} else {
+							error = t [i] - o [i];
+							rowCost += 0.5 * error * error;
+						}
+						if (wantDerivative)
+							workspace.delta [numberOfLayers] [irow] [i] = error * workspace.derivative [numberOfLayers] [irow] [i];
+					}
+					workspace.rowCosts [irow] = rowCost;
+				}
+			}
+		);
+		for (integer irow = 1; irow <= numberOfRows; irow ++)
+			cost += workspace.rowCosts [irow];
+		if (! wantDerivative)
+			continue;
+		for (integer ilayer = numberOfLayers; ilayer >= 1; ilayer --) {
+			constMATVU delta = workspace.delta [ilayer].horizontalBand (1, numberOfRows);
+			constMATVU weights = FFNet_getLayerWeights (me, my w.get(), ilayer);
+			const integer numberOfInputsToLayer = weights.ncol - 1;
+			constMATVU previous = ( ilayer == 1 ? inputBlock : workspace.activity [ilayer - 1].horizontalBand (1, numberOfRows) );
+			MATVU gradient = FFNet_getLayerWeights (me, dw, ilayer);
+			mulAdd_MAT_inout (gradient.verticalBand (1, numberOfInputsToLayer), delta.transpose(), previous, -1.0);
+			for (integer irow = 1; irow <= numberOfRows; irow ++)
+				gradient.column (gradient.ncol)  -=  delta.row (irow);
+			if (ilayer > 1) {
+				/*
+					Back to the previous layer; its delta is the propagated error times its derivative.
+				*/
+				MATVU previousDelta = workspace.delta [ilayer - 1].horizontalBand (1, numberOfRows);
+				mul_fast_MAT_out (previousDelta, delta, weights.verticalBand (1, numberOfInputsToLayer));
+				constMATVU previousDerivative = workspace.derivative [ilayer - 1].horizontalBand (1, numberOfRows);
+				previousDelta  *=  previousDerivative;
+			}
+		}
+	}
+	return (double) cost;
+}
+
+/******* end batch operation ************************************************/
+
+integer FFNet_getWinningOutput (constVECVU const& outputActivity, integer labeling) {
+	const integer numberOfOutputs = outputActivity.size;
 	integer winningUnit = 1;
 	if (labeling == 2) { /* stochastic */
 		double sum = 0.0;
-		for (integer ioutput = 1; ioutput <= my numberOfOutputs; ioutput ++)
-			sum += my activity [k + ioutput];
+		for (integer ioutput = 1; ioutput <= numberOfOutputs; ioutput ++)
+			sum += outputActivity [ioutput];
 
 		const double random = NUMrandomUniform (0.0, sum);
-		for (winningUnit = my numberOfOutputs; winningUnit >= 2; winningUnit--)
-			if (random > (sum -= my activity [k + winningUnit]))
+		for (winningUnit = numberOfOutputs; winningUnit >= 2; winningUnit--)
+			if (random > (sum -= outputActivity [winningUnit]))
 				break;
 	} else { /* winner-takes-all */
-		double max = my activity [k + 1];
-		for (integer ioutput = 2; ioutput <= my numberOfOutputs; ioutput ++)
-			if (my activity [k + ioutput] > max) {
-				max = my activity [k + ioutput];
+		double max = outputActivity [1];
+		for (integer ioutput = 2; ioutput <= numberOfOutputs; ioutput ++)
+			if (outputActivity [ioutput] > max) {
+				max = outputActivity [ioutput];
 				winningUnit = ioutput;
 			}
 	}
 	return winningUnit;
 }
 
+integer FFNet_getWinningUnit (FFNet me, integer labeling) {
+	return FFNet_getWinningOutput (my activity.part (my numberOfNodes - my numberOfOutputs + 1, my numberOfNodes), labeling);
+}
+
 void FFNet_propagateToLayer (FFNet me, constVEC input, VEC activity, integer layer) {
 	Melder_require (layer > 0,
 		U"Layer must be greater than zero.");
@@ -174,9 +174,20 @@ void FFNet_computeDerivative (FFNet me);
 /* step (4) compute derivative in my dwi */
 /* Precondition: step (3) */
 
+void FFNet_propagate_batch (FFNet me, constMATVU const& input, MATVU const& activity, integer layer);
+/* feed forward all rows of input at once; activity [i] receives the activities of the units in layer for input [i] */
+
+double FFNet_computeCostAndDerivative_batch (FFNet me, constMATVU const& input, constMATVU const& target, VEC const& dw);
+/* steps (1) to (4) for all rows of input and target at once: returns the total cost;
+ * if dw is not empty, it receives the derivative summed over all rows.
+ * my activity, error, deriv and dwi are not used.
+ */
+
 integer FFNet_getWinningUnit (FFNet me, integer labeling);
 /* labeling = 1 : winner-takes-all */
 /* labeling = 2 : stochastic */
+integer FFNet_getWinningOutput (constVECVU const& outputActivity, integer labeling);
+/* as FFNet_getWinningUnit, from the output activities of a pattern */
 
 void FFNet_selectAllWeights (FFNet me);
 
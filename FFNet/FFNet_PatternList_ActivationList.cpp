@@ -31,23 +31,15 @@ static double func (Daata object, VEC const& p) {
 	FFNet me = (FFNet) object;
 	const Minimizer thee = my minimizer.get();
 
-	for (integer j = 1, k = 1; k <= my numberOfWeights; k ++) {
-		my dw [k] = 0.0;
+	for (integer j = 1, k = 1; k <= my numberOfWeights; k ++)
 		if (my wSelected [k])
 			my w [k] = p [j ++];
-	}
-	longdouble fp = 0.0;
-	for (integer i = 1; i <= my numberOfPatterns; i ++) {
-		FFNet_propagate (me, my inputPattern.row (i), nullptr);
-		fp += FFNet_computeError (me, my targetActivation.row (i));
-		FFNet_computeDerivative (me);
-		/*
-			Derivative (cumulative)
-		*/
-		my dw.part (1, my numberOfWeights)  +=  my dwi.part (1, my numberOfWeights);
-	}
+	/*
+		All patterns at once; the derivative (cumulative) goes into my dw
+	*/
+	const double fp = FFNet_computeCostAndDerivative_batch (me, my inputPattern, my targetActivation, my dw.get());
 	thy numberOfFunctionCalls ++;
-	return (double) fp;
+	return fp;
 }
 
 static void dfunc_optimized (Daata object, VEC const& /* p */, VEC const& dp) {
@@ -153,12 +145,7 @@ double FFNet_PatternList_ActivationList_getCosts_total (FFNet me, PatternList p,
 		_FFNet_PatternList_ActivationList_checkDimensions (me, p, a);
 		FFNet_setCostFunction (me, costFunctionType);
 
-		double cost = 0.0;
-		for (integer i = 1; i <= p -> ny; i ++) {
-			FFNet_propagate (me, p -> z.row (i), nullptr);
-			cost += FFNet_computeError (me, a -> z.row (i));
-		}
-		return cost;
+		return FFNet_computeCostAndDerivative_batch (me, p -> z.get(), a -> z.get(), VEC ());
 	} catch (MelderError) {
 		return undefined;
 	}
@@ -180,8 +167,7 @@ autoActivationList FFNet_PatternList_to_ActivationList (FFNet me, PatternList p,
 		
 		const integer numberOfPatterns = p -> ny;
 		autoActivationList thee = ActivationList_create (numberOfPatterns, my numberOfUnitsInLayer [layer]);
-		for (integer i = 1; i <= numberOfPatterns; i ++)
-			FFNet_propagateToLayer (me, p -> z.row (i), thy z.row (i), layer);
+		FFNet_propagate_batch (me, p -> z.get(), thy z.get(), layer);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no ActivationList created.");
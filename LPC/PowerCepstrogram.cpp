@@ -166,8 +166,12 @@ autoTable PowerCepstrogram_to_Table_hillenbrand (PowerCepstrogram me, double pit
 	}
 }
 
-void PowerCepstrogram_into_Matrix_CPP (PowerCepstrogram me, mutableMatrix thee, bool trendSubtracted, double pitchFloor,
-	double pitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType, double qminFit, double qmaxFit,
+/*
+	If quefrencyAveragingWindow > 0.0, each frame is averaged across quefrencies (with running sums) just before its analysis.
+*/
+static void PowerCepstrogram_into_Matrix_CPP_smoothed (PowerCepstrogram me, mutableMatrix thee, bool trendSubtracted,
+	double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, double /* deltaF0 */,
+	kVector_peakInterpolation peakInterpolationType, double qminFit, double qmaxFit,
 	kCepstrum_trendType trendLineType, kCepstrum_trendFit fitMethod)
 {
 		SampledIntoSampled_assertEqualDomains (me, thee);
@@ -177,6 +181,8 @@ void PowerCepstrogram_into_Matrix_CPP (PowerCepstrogram me, mutableMatrix thee,
 		ws -> getPeakAndPosition = true;
 		ws -> subtractTrend = false;
 		ws -> trendSubtracted = trendSubtracted;
+		if (Melder_ifloor (quefrencyAveragingWindow / my dy) > 1)
+			ws -> quefrencyAveragingWindow = quefrencyAveragingWindow;
 		const double qminSearchInterval = 1.0 / pitchCeiling, qmaxSearchInterval = 1.0 / pitchFloor;
 		PowerCepstrumWorkspace_initPeakSearchPart (ws -> powerCepstrumWs.get(), qminSearchInterval, qmaxSearchInterval, peakInterpolationType);
 		autoPowerCepstrogramIntoMatrixStatus status =  PowerCepstrogramIntoMatrixStatus_create (thy nx);
@@ -184,6 +190,14 @@ void PowerCepstrogram_into_Matrix_CPP (PowerCepstrogram me, mutableMatrix thee,
 		SampledIntoSampled_analyseThreaded (sis.get());
 }
 
+void PowerCepstrogram_into_Matrix_CPP (PowerCepstrogram me, mutableMatrix thee, bool trendSubtracted, double pitchFloor,
+	double pitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType, double qminFit, double qmaxFit,
+	kCepstrum_trendType trendLineType, kCepstrum_trendFit fitMethod)
+{
+	PowerCepstrogram_into_Matrix_CPP_smoothed (me, thee, trendSubtracted, 0.0, pitchFloor, pitchCeiling, deltaF0,
+		peakInterpolationType, qminFit, qmaxFit, trendLineType, fitMethod);
+}
+
 autoMatrix PowerCepstrogram_to_Matrix_CPP (PowerCepstrogram me, bool trendSubtracted, double pitchFloor, double pitchCeiling,
 	double deltaF0, kVector_peakInterpolation peakInterpolationType, double qstartFit, double qendFit,
 	kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod)
@@ -269,6 +283,22 @@ void PowerCepstrogram_listCPP (PowerCepstrogram me, bool includeFrameNumber, boo
 	}
 }
 
+/*
+	The time averaging of Sound_getCPPS, done in place with running sums.
+	This equals the interpolating Sampled_getMean windows of PowerCepstrogram_smoothRectangular up to rounding.
+*/
+static void PowerCepstrogram_smoothAcrossTime_inplace (mutablePowerCepstrogram me, double timeAveragingWindow) {
+	const integer numberOfFrames = Melder_ifloor (timeAveragingWindow / my dx);
+	if (numberOfFrames > 1) {
+		autoVEC qin = raw_VEC (my nx);
+		for (integer iq = 1; iq <= my ny; iq ++) {
+			qin.all()  <<=  my z.row (iq);
+			VECsmoothByMovingAverage_interpolated_preallocated (my z.row (iq), qin.get(),
+				my xmin, my xmax, my x1, my dx, timeAveragingWindow);
+		}
+	}
+}
+
 static autoPowerCepstrogram PowerCepstrogram_smoothRectangular (PowerCepstrogram me, double timeAveragingWindow, double quefrencyAveragingWindow) {
 	try {
 		autoPowerCepstrogram thee = Data_copy (me);
@@ -417,28 +447,42 @@ void Sound_into_PowerCepstrogram (Sound input, PowerCepstrogram output, double e
 	SampledIntoSampled_analyseThreaded (sis.get());
 }
 
+static autoPowerCepstrogram Sound_to_PowerCepstrogram_threaded (Sound me, double pitchFloor, double dt, double maximumFrequency,
+	double preEmphasisFrequency, bool subtractTrend, double qminFit, double qmaxFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod)
+{
+	const kSound_windowShape windowShape = kSound_windowShape::GAUSSIAN_2;
+	const double effectiveAnalysisWidth = 3.0 / pitchFloor; // minimum analysis window has 3 periods of lowest pitch
+	const double physicalAnalysisWidth = getPhysicalAnalysisWidth (effectiveAnalysisWidth, windowShape);
+	const double physicalSoundDuration = my dx * my nx;
+	volatile const double windowDuration = Melder_clippedRight (physicalAnalysisWidth, physicalSoundDuration);
+	Melder_require (physicalSoundDuration >= physicalAnalysisWidth,
+		U"Your sound is too short:\n"
+		U"it should be longer than ", physicalAnalysisWidth, U" s.");
+	const double samplingFrequency = 2.0 * maximumFrequency;
+	autoSound input = Sound_resampleAndOrPreemphasize (me, maximumFrequency, 50_integer, preEmphasisFrequency);
+	double t1;
+	integer nFrames;
+	Sampled_shortTermAnalysis (me, windowDuration, dt, & nFrames, & t1);
+	const integer soundFrameSize = getSoundFrameSize (physicalAnalysisWidth, input -> dx);
+	const integer nfft = Melder_clippedLeft (2_integer, Melder_iroundUpToPowerOfTwo (soundFrameSize));
+	const integer nq = nfft / 2 + 1;
+	const double qmax = 0.5 * nfft / samplingFrequency, dq = 1.0 / samplingFrequency;
+	autoPowerCepstrogram output = PowerCepstrogram_create (my xmin, my xmax, nFrames, dt, t1, 0, qmax, nq, dq, 0);
+	SampledIntoSampled_assertEqualDomains (input.get(), output.get());
+	autoSoundFrameIntoPowerCepstrogramFrame ws = SoundFrameIntoPowerCepstrogramFrame_create (input.get(), output.get(), 
+		effectiveAnalysisWidth, windowShape);
+	if (subtractTrend)
+		SoundFrameIntoPowerCepstrogramFrame_initTrendSubtraction (ws.get(), qminFit, qmaxFit, lineType, fitMethod);
+	autoSoundIntoPowerCepstrogramStatus status = SoundIntoPowerCepstrogramStatus_create (output -> nx);
+	autoSampledIntoSampled sis = SampledIntoSampled_create (input.get(), output.get(), ws.move(), status.move());
+	SampledIntoSampled_analyseThreaded (sis.get());
+	return output;
+}
+
 autoPowerCepstrogram Sound_to_PowerCepstrogram_new (Sound me, double pitchFloor, double dt, double maximumFrequency, double preEmphasisFrequency) {
 	try {
-		const kSound_windowShape windowShape = kSound_windowShape::GAUSSIAN_2;
-		const double effectiveAnalysisWidth = 3.0 / pitchFloor; // minimum analysis window has 3 periods of lowest pitch
-		const double physicalAnalysisWidth = getPhysicalAnalysisWidth (effectiveAnalysisWidth, windowShape);
-		const double physicalSoundDuration = my dx * my nx;
-		volatile const double windowDuration = Melder_clippedRight (physicalAnalysisWidth, physicalSoundDuration);
-		Melder_require (physicalSoundDuration >= physicalAnalysisWidth,
-			U"Your sound is too short:\n"
-			U"it should be longer than ", physicalAnalysisWidth, U" s.");
-		const double samplingFrequency = 2.0 * maximumFrequency;
-		autoSound input = Sound_resampleAndOrPreemphasize (me, maximumFrequency, 50_integer, preEmphasisFrequency);
-		double t1;
-		integer nFrames;
-		Sampled_shortTermAnalysis (me, windowDuration, dt, & nFrames, & t1);
-		const integer soundFrameSize = getSoundFrameSize (physicalAnalysisWidth, input -> dx);
-		const integer nfft = Melder_clippedLeft (2_integer, Melder_iroundUpToPowerOfTwo (soundFrameSize));
-		const integer nq = nfft / 2 + 1;
-		const double qmax = 0.5 * nfft / samplingFrequency, dq = 1.0 / samplingFrequency;
-		autoPowerCepstrogram output = PowerCepstrogram_create (my xmin, my xmax, nFrames, dt, t1, 0, qmax, nq, dq, 0);
-		Sound_into_PowerCepstrogram (input.get(), output.get(), effectiveAnalysisWidth, windowShape);
-		return output;
+		return Sound_to_PowerCepstrogram_threaded (me, pitchFloor, dt, maximumFrequency, preEmphasisFrequency,
+			false, 0.0, 0.0, kCepstrum_trendType::DEFAULT, kCepstrum_trendFit::DEFAULT);
 	} catch (MelderError) {
 		Melder_throw (me, U": no PowerCepstrogram created.");
 	}
@@ -626,6 +670,95 @@ double PowerCepstrogram_getCPPS (PowerCepstrogram me, bool subtractTrendBeforeSm
 	}
 }
 
+double Sound_getCPPS (Sound me, double pitchFloor, double dt, double maximumFrequency, double preEmphasisFrequency,
+	bool subtractTrendBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType,
+	double qstartFit, double qendFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod)
+{
+	try {
+		/*
+			The same result as
+				PowerCepstrogram_getCPPS (Sound_to_PowerCepstrogram (me, ...), ...)
+			up to rounding, but with only one PowerCepstrogram: the trend is subtracted from each frame directly after
+			its analysis, the time averaging is done in place and the quefrency averaging is done on
+			each frame just before its peak search; both averagings use running sums instead of Sampled_getMean.
+		*/
+		autoPowerCepstrogram cepstrogram = Sound_to_PowerCepstrogram_threaded (me, pitchFloor, dt, maximumFrequency,
+			preEmphasisFrequency, subtractTrendBeforeSmoothing, qstartFit, qendFit, lineType, fitMethod);
+		PowerCepstrogram_smoothAcrossTime_inplace (cepstrogram.get(), timeAveragingWindow);
+		/*
+			Matrix rows: time, slope, intercept, peakdB, peakQuefrency, cpp
+		*/
+		autoMatrix cpp = Matrix_create (cepstrogram -> xmin, cepstrogram -> xmax, cepstrogram -> nx, cepstrogram -> dx,
+			cepstrogram -> x1, 0.5, 6.5, 6, 1.0, 1.0);
+		PowerCepstrogram_into_Matrix_CPP_smoothed (cepstrogram.get(), cpp.get(), subtractTrendBeforeSmoothing,
+			quefrencyAveragingWindow, peakSearchPitchFloor, peakSearchPitchCeiling, deltaF0, peakInterpolationType,
+			qstartFit, qendFit, lineType, fitMethod);
+		return NUMmean (cpp -> z.row (6));
+	} catch (MelderError) {
+		Melder_throw (me, U": no CPPS value calculated.");
+	}
+}
+
+autoTable Sounds_to_Table_CPPS (OrderedOf<structSound>* me, double pitchFloor, double dt, double maximumFrequency,
+	double preEmphasisFrequency, bool subtractTrendBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType,
+	double qstartFit, double qendFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod)
+{
+	try {
+		const conststring32 columnNames [] = { U"sound", U"duration(s)", U"CPPS(dB)" };
+		autoTable thee = Table_createWithColumnNames (my size, ARRAY_TO_STRVEC (columnNames));
+		for (integer isound = 1; isound <= my size; isound ++) {
+			Sound sound = my at [isound];
+			const double cpps = Sound_getCPPS (sound, pitchFloor, dt, maximumFrequency, preEmphasisFrequency,
+				subtractTrendBeforeSmoothing, timeAveragingWindow, quefrencyAveragingWindow, peakSearchPitchFloor,
+				peakSearchPitchCeiling, deltaF0, peakInterpolationType, qstartFit, qendFit, lineType, fitMethod);
+			Table_setStringValue (thee.get(), isound, 1, sound -> name ? sound -> name.get() : U"");
+			Table_setNumericValue (thee.get(), isound, 2, sound -> xmax - sound -> xmin);
+			Table_setNumericValue (thee.get(), isound, 3, cpps);
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (U"Sounds: no Table with CPPS values created.");
+	}
+}
+
+autoTable Sound_TextGrid_to_Table_CPPS (Sound me, TextGrid thee, integer tierNumber, double pitchFloor, double dt,
+	double maximumFrequency, double preEmphasisFrequency, bool subtractTrendBeforeSmoothing, double timeAveragingWindow,
+	double quefrencyAveragingWindow, double peakSearchPitchFloor, double peakSearchPitchCeiling,
+	double deltaF0, kVector_peakInterpolation peakInterpolationType, double qstartFit, double qendFit, kCepstrum_trendType lineType,
+	kCepstrum_trendFit fitMethod)
+{
+	try {
+		const IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (thee, tierNumber);
+		const double minimumDuration = getPhysicalAnalysisWidth (3.0 / pitchFloor, kSound_windowShape::GAUSSIAN_2);
+		const conststring32 columnNames [] = { U"tmin(s)", U"tmax(s)", U"label", U"CPPS(dB)" };
+		autoTable him = Table_createWithColumnNames (0, ARRAY_TO_STRVEC (columnNames));
+		for (integer interval = 1; interval <= tier -> intervals.size; interval ++) {
+			const TextInterval textInterval = tier -> intervals.at [interval];
+			if (! textInterval -> text || textInterval -> text [0] == U'\0')
+				continue;
+			const double tmin = std::max (textInterval -> xmin, my xmin), tmax = std::min (textInterval -> xmax, my xmax);
+			double cpps = undefined;
+			if (tmax - tmin >= minimumDuration) {   // otherwise the interval cannot hold a single analysis window
+				autoSound part = Sound_extractPart (me, tmin, tmax, kSound_windowShape::RECTANGULAR, 1.0, true);
+				cpps = Sound_getCPPS (part.get(), pitchFloor, dt, maximumFrequency, preEmphasisFrequency,
+					subtractTrendBeforeSmoothing, timeAveragingWindow, quefrencyAveragingWindow, peakSearchPitchFloor,
+					peakSearchPitchCeiling, deltaF0, peakInterpolationType, qstartFit, qendFit, lineType, fitMethod);
+			}
+			Table_appendRow (him.get());
+			const integer irow = his rows.size;
+			Table_setNumericValue (him.get(), irow, 1, tmin);
+			Table_setNumericValue (him.get(), irow, 2, tmax);
+			Table_setStringValue (him.get(), irow, 3, textInterval -> text.get());
+			Table_setNumericValue (him.get(), irow, 4, cpps);
+		}
+		return him;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": no Table with CPPS values created.");
+	}
+}
+
 double PowerCepstrogram_getCPPS_hillenbrand (PowerCepstrogram me, bool subtractTrendBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling) {
 	try {
 		autoPowerCepstrogram him;
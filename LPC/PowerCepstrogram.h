@@ -28,6 +28,7 @@
 #include "Matrix.h"
 #include "Sound.h"
 #include "Table.h"
+#include "TextGrid.h"
 
 Thing_define (PowerCepstrogram, Matrix) {
 	double v_getValueAtSample (integer sampleNumber, integer level, int unit) const
@@ -88,6 +89,29 @@ double PowerCepstrogram_getCPPS_hillenbrand (PowerCepstrogram me, bool subtractT
 double PowerCepstrogram_getCPPS (PowerCepstrogram me, bool subtractTrendBeforeSmoothing,
 	double timeAveragingWindow, double quefrencyAveragingWindow, double pitchFloor, double pitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType, double qstartFit, double qendFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod);
 
+double Sound_getCPPS (Sound me, double pitchFloor, double dt, double maximumFrequency, double preEmphasisFrequency,
+	bool subtractTrendBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType,
+	double qstartFit, double qendFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod);
+/*
+	Equals PowerCepstrogram_getCPPS (Sound_to_PowerCepstrogram (me, pitchFloor, dt, maximumFrequency, preEmphasisFrequency), ...)
+	up to rounding, but without the intermediate PowerCepstrograms.
+*/
+
+autoTable Sounds_to_Table_CPPS (OrderedOf<structSound>* me, double pitchFloor, double dt, double maximumFrequency,
+	double preEmphasisFrequency, bool subtractTrendBeforeSmoothing, double timeAveragingWindow, double quefrencyAveragingWindow,
+	double peakSearchPitchFloor, double peakSearchPitchCeiling, double deltaF0, kVector_peakInterpolation peakInterpolationType,
+	double qstartFit, double qendFit, kCepstrum_trendType lineType, kCepstrum_trendFit fitMethod);
+
+autoTable Sound_TextGrid_to_Table_CPPS (Sound me, TextGrid thee, integer tierNumber, double pitchFloor, double dt,
+	double maximumFrequency, double preEmphasisFrequency, bool subtractTrendBeforeSmoothing, double timeAveragingWindow,
+	double quefrencyAveragingWindow, double peakSearchPitchFloor, double peakSearchPitchCeiling,
+	double deltaF0, kVector_peakInterpolation peakInterpolationType, double qstartFit, double qendFit, kCepstrum_trendType lineType,
+	kCepstrum_trendFit fitMethod);
+/*
+	One row per non-empty interval of the tier; CPPS is undefined for intervals that are too short for the analysis.
+*/
+
 autoMatrix PowerCepstrogram_to_Matrix (PowerCepstrogram me);
 
 autoPowerCepstrogram Matrix_to_PowerCepstrogram (Matrix me);
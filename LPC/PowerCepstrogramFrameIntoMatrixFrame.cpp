@@ -17,6 +17,7 @@
  */
 
 #include "PowerCepstrogramFrameIntoMatrixFrame.h"
+#include "NUM2.h"
 
 #include "oo_DESTROY.h"
 #include "PowerCepstrogramFrameIntoMatrixFrame_def.h"
@@ -40,7 +41,11 @@
 Thing_implement (PowerCepstrogramFrameIntoMatrixFrame, SampledFrameIntoMatrixFrame, 0);
 
 void structPowerCepstrogramFrameIntoMatrixFrame :: getInputFrame () {
-	powerCepstrum -> z.row (1)  <<=  powercepstrogram -> z.column (currentFrame);
+	if (quefrencyAveragingWindow > 0.0)
+		VECsmoothByMovingAverage_interpolated_preallocated (powerCepstrum -> z.row (1), powercepstrogram -> z.column (currentFrame),
+			powerCepstrum -> xmin, powerCepstrum -> xmax, powerCepstrum -> x1, powerCepstrum -> dx, quefrencyAveragingWindow);
+	else
+		powerCepstrum -> z.row (1)  <<=  powercepstrogram -> z.column (currentFrame);
 	powerCepstrumWs -> newData (powerCepstrum.get()); // powercepstrum is in dB's now
 }
 
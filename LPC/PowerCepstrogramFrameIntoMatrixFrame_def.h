@@ -27,6 +27,7 @@ oo_DEFINE_CLASS (PowerCepstrogramFrameIntoMatrixFrame, SampledFrameIntoMatrixFra
 	oo_BOOLEAN (getSlopeAndIntercept)
 	oo_BOOLEAN (subtractTrend)
 	oo_BOOLEAN (trendSubtracted) // TODO ?? needed
+	oo_DOUBLE (quefrencyAveragingWindow) // smooth each frame before analysis if > 0.0
 	
 	#if oo_DECLARING
 		void getInputFrame ()
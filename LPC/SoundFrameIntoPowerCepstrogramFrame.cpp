@@ -71,6 +71,14 @@ bool structSoundFrameIntoPowerCepstrogramFrame :: inputFrameToOutputFrame () {
 		const double val = fftData [i] * df;
 		powercepstrum -> z [1] [i] = val * val;
 	}
+	/*
+		Step 4 (optional): subtract the trend line
+	*/
+	if (subtractTrend) {
+		powerCepstrumWs -> newData (powercepstrum.get());
+		powerCepstrumWs -> getSlopeAndIntercept ();
+		powerCepstrumWs -> subtractTrend ();
+	}
 	return true;
 }
 
@@ -97,4 +105,11 @@ autoSoundFrameIntoPowerCepstrogramFrame SoundFrameIntoPowerCepstrogramFrame_crea
 	}
 }
 
+void SoundFrameIntoPowerCepstrogramFrame_initTrendSubtraction (mutableSoundFrameIntoPowerCepstrogramFrame me,
+	double qminFit, double qmaxFit, kCepstrum_trendType trendLineType, kCepstrum_trendFit fitMethod)
+{
+	my powerCepstrumWs = PowerCepstrumWorkspace_create (my powercepstrum.get(), qminFit, qmaxFit, trendLineType, fitMethod);
+	my subtractTrend = true;
+}
+
 /* End of file SoundFrameIntoPowerCepstrogramFrame.cpp */
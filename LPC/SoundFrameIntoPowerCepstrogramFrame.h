@@ -21,6 +21,7 @@
 #include "LPC.h"
 #include "Sound.h"
 #include "PowerCepstrogram.h"
+#include "PowerCepstrumWorkspace.h"
 #include "NUMFourier.h"
 #include "SoundFrameIntoMatrixFrame.h"
 
@@ -29,4 +30,10 @@
 autoSoundFrameIntoPowerCepstrogramFrame SoundFrameIntoPowerCepstrogramFrame_create (constSound input, mutablePowerCepstrogram output, 
 	double effectiveAnalysisWidth, kSound_windowShape windowShape);
 
+void SoundFrameIntoPowerCepstrogramFrame_initTrendSubtraction (mutableSoundFrameIntoPowerCepstrogramFrame me,
+	double qminFit, double qmaxFit, kCepstrum_trendType trendLineType, kCepstrum_trendFit fitMethod);
+/*
+	Subtract the trend line from each frame before it is saved, as PowerCepstrogram_subtractTrend_inplace would do afterwards.
+*/
+
 #endif /*_SoundFrameIntoPowerCepstrogramFrame_h_ */
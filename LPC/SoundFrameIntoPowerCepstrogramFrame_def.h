@@ -24,6 +24,8 @@ oo_DEFINE_CLASS (SoundFrameIntoPowerCepstrogramFrame, SoundFrameIntoMatrixFrame)
 	oo_VEC (fftData, numberOfFourierSamples)
 	oo_OBJECT (NUMFourierTable, 0, fourierTable) // data for forward & back have equal dimensions!!
 	oo_OBJECT (PowerCepstrum, 0, powercepstrum)
+	oo_BOOLEAN (subtractTrend)
+	oo_OBJECT (PowerCepstrumWorkspace, 0, powerCepstrumWs) // only if subtractTrend
 	#if oo_DECLARING
 		bool inputFrameToOutputFrame ()
 			override;
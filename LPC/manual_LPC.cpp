@@ -81,6 +81,22 @@ NORMAL (U"After calculation of all the frame distances %d__%ij_, we find the opt
 	"Viterbi-algorithm.")
 MAN_END
 
+MAN_BEGIN (U"CCs: To Distance (DTW)...", U"djmw", 20261019)
+INTRO (U"You can choose this command after selecting two or more objects with cepstral coefficients (@MFCC's or @LFCC's). "
+	"It calculates the weighted distance along the optimal dynamic time warping path between every pair of objects "
+	"and stores them in a @Distance object, for example for @@Multidimensional scaling@ or clustering.")
+NORMAL (U"The frame distances are as in @@CC: To DTW...@, except that the regression coefficients are zero at the edges. "
+	"The path is restricted as in @@DTW: Find path (band & slope)...@; only the frame distances inside the band are calculated "
+	"and the path itself is not determined. No @DTW object is created: only four frames of the band are in memory at any time, "
+	"so that long objects do not need memory proportional to the product of their numbers of frames. "
+	"The pairs are distributed over the available processors.")
+ENTRY (U"Settings")
+TERM (U"##Maximum distance")
+DEFINITION (U"if positive, the calculation for a pair is abandoned as soon as it is clear that its distance will be larger, "
+	"first by means of a lower bound on the distance (LB_Keogh), then during the dynamic programming. "
+	"Such pairs get the maximum distance as their value.")
+MAN_END
+
 MAN_BEGIN (U"CC: To Matrix", U"djmw", 20011123)
 INTRO (U"Copies the cepstral coefficients of the selected @CC "
 	"object to a newly created @Matrix object.")
@@ -967,6 +983,21 @@ NORMAL (U"where %N represents the number of filters that were used to get the MF
 	"%%fromCoefficient% and %k larger than %%toCoefficient% take zero values in the evaluation.")
 MAN_END
 
+MAN_BEGIN (U"Sound: Get CPPS...", U"djmw", 20261019)
+INTRO (U"A command to get the smoothed cepstral peak prominence (CPPS) of the selected @@Sound@.")
+NORMAL (U"The result is the same as that of @@Sound: To PowerCepstrogram...@ followed by @@PowerCepstrogram: Get CPPS...@, "
+	"up to rounding, "
+	"but no intermediate PowerCepstrogram objects are created: the trend line is subtracted from each frame "
+	"directly after its analysis, and the averaging over quefrencies is performed on each frame just before its peak search. "
+	"The averagings are computed with running sums, which is faster for long sounds but may differ from the other route "
+	"in the last few digits.")
+NORMAL (U"With more than one Sound selected, ##To Table (CPPS)...# gives a @Table with the CPPS of each Sound. "
+	"With a Sound and a @TextGrid selected, ##To Table (CPPS)...# gives a Table with the CPPS of each non-empty interval "
+	"of the chosen interval tier. Intervals that are too short for a single analysis window get an undefined CPPS.")
+ENTRY (U"Settings")
+NORMAL (U"The analysis settings are those of @@Sound: To PowerCepstrogram...@, the other settings are those of @@PowerCepstrogram: Get CPPS...@.")
+MAN_END
+
 MAN_BEGIN (U"Sound: To PowerCepstrogram...", U"djmw", 20200403)
 INTRO (U"A command that creates a @@PowerCepstrogram@ from every selected @@Sound@.")
 ENTRY (U"Settings")
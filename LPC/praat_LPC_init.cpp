@@ -1232,6 +1232,100 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get())
 }
 
+FORM (QUERY_ONE_FOR_REAL__Sound_getCPPS, U"Sound: Get CPPS", U"Sound: Get CPPS...") {
+	COMMENT (U"Analysis:")
+	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
+	POSITIVE (timeStep, U"Time step (s)", U"0.002")
+	POSITIVE (maximumFrequency, U"Maximum frequency (Hz)", U"5000.0")
+	POSITIVE (preEmphasisFrequency, U"Pre-emphasis from (Hz)", U"50.0")
+	COMMENT (U"Smoothing of the Cepstrogram")
+	BOOLEAN (subtractTrendBeforeSmoothing, U"Subtract trend before smoothing", true)
+	REAL (smoothingWindowDuration, U"Time averaging window (s)", U"0.02")
+	REAL (quefrencySmoothingWindowDuration, U"Quefrency averaging window (s)", U"0.0005")
+	COMMENT (U"Peak search:")
+	REAL (fromPitch, U"left Peak search pitch range (Hz)", U"60.0")
+	REAL (toPitch, U"right Peak search pitch range (Hz)", U"330.0")
+	POSITIVE (tolerance, U"Tolerance (0-1)", U"0.05")
+	CHOICE_ENUM (kVector_peakInterpolation, peakInterpolationType,
+			U"Interpolation", kVector_peakInterpolation :: PARABOLIC)
+	COMMENT (U"Trend line:")
+	REAL (fromQuefrency_trendLine, U"left Trend line quefrency range (s)", U"0.001")
+	REAL (toQuefrency_trendLine, U"right Trend line quefrency range (s)", U"0.05")
+	OPTIONMENU_ENUM (kCepstrum_trendType, lineType, U"Trend type", kCepstrum_trendType::DEFAULT)
+	OPTIONMENU_ENUM (kCepstrum_trendFit, fitMethod, U"Fit method", kCepstrum_trendFit::DEFAULT)
+	OK
+DO
+	QUERY_ONE_FOR_REAL (Sound)
+		const double result = Sound_getCPPS (me, pitchFloor, timeStep, maximumFrequency, preEmphasisFrequency,
+			subtractTrendBeforeSmoothing, smoothingWindowDuration, quefrencySmoothingWindowDuration, fromPitch, toPitch,
+			tolerance, peakInterpolationType, fromQuefrency_trendLine, toQuefrency_trendLine, lineType, fitMethod
+		);
+	QUERY_ONE_FOR_REAL_END (U" dB");
+}
+
+FORM (COMBINE_ALL_TO_ONE__Sounds_to_Table_CPPS, U"Sounds: To Table (CPPS)", U"Sound: Get CPPS...") {
+	COMMENT (U"Analysis:")
+	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
+	POSITIVE (timeStep, U"Time step (s)", U"0.002")
+	POSITIVE (maximumFrequency, U"Maximum frequency (Hz)", U"5000.0")
+	POSITIVE (preEmphasisFrequency, U"Pre-emphasis from (Hz)", U"50.0")
+	COMMENT (U"Smoothing of the Cepstrogram")
+	BOOLEAN (subtractTrendBeforeSmoothing, U"Subtract trend before smoothing", true)
+	REAL (smoothingWindowDuration, U"Time averaging window (s)", U"0.02")
+	REAL (quefrencySmoothingWindowDuration, U"Quefrency averaging window (s)", U"0.0005")
+	COMMENT (U"Peak search:")
+	REAL (fromPitch, U"left Peak search pitch range (Hz)", U"60.0")
+	REAL (toPitch, U"right Peak search pitch range (Hz)", U"330.0")
+	POSITIVE (tolerance, U"Tolerance (0-1)", U"0.05")
+	CHOICE_ENUM (kVector_peakInterpolation, peakInterpolationType,
+			U"Interpolation", kVector_peakInterpolation :: PARABOLIC)
+	COMMENT (U"Trend line:")
+	REAL (fromQuefrency_trendLine, U"left Trend line quefrency range (s)", U"0.001")
+	REAL (toQuefrency_trendLine, U"right Trend line quefrency range (s)", U"0.05")
+	OPTIONMENU_ENUM (kCepstrum_trendType, lineType, U"Trend type", kCepstrum_trendType::DEFAULT)
+	OPTIONMENU_ENUM (kCepstrum_trendFit, fitMethod, U"Fit method", kCepstrum_trendFit::DEFAULT)
+	OK
+DO
+	COMBINE_ALL_TO_ONE (Sound)
+		autoTable result = Sounds_to_Table_CPPS (& list, pitchFloor, timeStep, maximumFrequency, preEmphasisFrequency,
+			subtractTrendBeforeSmoothing, smoothingWindowDuration, quefrencySmoothingWindowDuration, fromPitch, toPitch,
+			tolerance, peakInterpolationType, fromQuefrency_trendLine, toQuefrency_trendLine, lineType, fitMethod
+		);
+	COMBINE_ALL_TO_ONE_END (U"cpps")
+}
+
+FORM (CONVERT_ONE_AND_ONE_TO_ONE__Sound_TextGrid_to_Table_CPPS, U"Sound & TextGrid: To Table (CPPS)", U"Sound: Get CPPS...") {
+	NATURAL (tierNumber, U"Tier number", U"1")
+	COMMENT (U"Analysis:")
+	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
+	POSITIVE (timeStep, U"Time step (s)", U"0.002")
+	POSITIVE (maximumFrequency, U"Maximum frequency (Hz)", U"5000.0")
+	POSITIVE (preEmphasisFrequency, U"Pre-emphasis from (Hz)", U"50.0")
+	COMMENT (U"Smoothing of the Cepstrogram")
+	BOOLEAN (subtractTrendBeforeSmoothing, U"Subtract trend before smoothing", true)
+	REAL (smoothingWindowDuration, U"Time averaging window (s)", U"0.02")
+	REAL (quefrencySmoothingWindowDuration, U"Quefrency averaging window (s)", U"0.0005")
+	COMMENT (U"Peak search:")
+	REAL (fromPitch, U"left Peak search pitch range (Hz)", U"60.0")
+	REAL (toPitch, U"right Peak search pitch range (Hz)", U"330.0")
+	POSITIVE (tolerance, U"Tolerance (0-1)", U"0.05")
+	CHOICE_ENUM (kVector_peakInterpolation, peakInterpolationType,
+			U"Interpolation", kVector_peakInterpolation :: PARABOLIC)
+	COMMENT (U"Trend line:")
+	REAL (fromQuefrency_trendLine, U"left Trend line quefrency range (s)", U"0.001")
+	REAL (toQuefrency_trendLine, U"right Trend line quefrency range (s)", U"0.05")
+	OPTIONMENU_ENUM (kCepstrum_trendType, lineType, U"Trend type", kCepstrum_trendType::DEFAULT)
+	OPTIONMENU_ENUM (kCepstrum_trendFit, fitMethod, U"Fit method", kCepstrum_trendFit::DEFAULT)
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_ONE (Sound, TextGrid)
+		autoTable result = Sound_TextGrid_to_Table_CPPS (me, you, tierNumber, pitchFloor, timeStep, maximumFrequency, preEmphasisFrequency,
+			subtractTrendBeforeSmoothing, smoothingWindowDuration, quefrencySmoothingWindowDuration, fromPitch, toPitch,
+			tolerance, peakInterpolationType, fromQuefrency_trendLine, toQuefrency_trendLine, lineType, fitMethod
+		);
+	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get(), U"_cpps")
+}
+
 FORM (CONVERT_EACH_TO_ONE__Sound_to_PowerCepstrogram_hillenbrand, U"Sound: To PowerCepstrogram (hillenbrand)", U"Sound: To PowerCepstrogram...") {
 	POSITIVE (pitchFloor, U"Pitch floor (Hz)", U"60.0")
 	POSITIVE (timeStep, U"Time step (s)", U"0.002")
@@ -1430,6 +1524,26 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get())
 }
 
+FORM (SAVE_ONE__Sound_saveAsHtkMfccFile, U"Sound: Save as HTK MFCC file", U"Sound: To MFCC...") {
+	OUTFILE (featureFile, U"HTK feature file", U"")
+	NATURAL (numberOfCoefficients, U"Number of coefficients", U"12")
+	POSITIVE (windowLength, U"Window length (s)", U"0.015")
+	POSITIVE (timeStep, U"Time step (s)", U"0.005")
+	COMMENT (U"Filter bank parameters")
+	POSITIVE (firstFilterFrequency, U"First filter frequency (mel)", U"100.0")
+	POSITIVE (distanceBetweenFilters, U"Distance between filters (mel)", U"100.0")
+	REAL (maximumFrequency, U"Maximum frequency (mel)", U"0.0")
+	OK
+DO
+	Melder_require (numberOfCoefficients < 25, U"The number of coefficients should be less than 25.");
+	SAVE_ONE (Sound)
+		structMelderFile file { };
+		Melder_relativePathToFile (featureFile, & file);
+		Sound_saveAsHtkMfccFile (me, & file, numberOfCoefficients, windowLength, timeStep,
+				firstFilterFrequency, maximumFrequency, distanceBetweenFilters);
+	SAVE_ONE_END
+}
+
 FORM (GRAPHICS_EACH__VocalTract_drawSegments, U"VocalTract: Draw segments", nullptr) {
 	POSITIVE (maximumLength, U"Maximum length (cm)", U"20.0")
 	POSITIVE (maximumArea, U"Maximum area (cm^2)", U"90.0")
@@ -1872,6 +1986,10 @@ void praat_uvafon_LPC_init () {
 			CONVERT_EACH_TO_ONE__Sound_to_PowerCepstrogram);
 	praat_addAction1 (classSound, 0, U"To PowerCepstrogram (hillenbrand)...", U"To Harmonicity (gne)...", GuiMenu_DEPTH_1 | GuiMenu_HIDDEN,
 			CONVERT_EACH_TO_ONE__Sound_to_PowerCepstrogram_hillenbrand);
+	praat_addAction1 (classSound, 1, U"Get CPPS...", U"To PowerCepstrogram (hillenbrand)...", 1,
+			QUERY_ONE_FOR_REAL__Sound_getCPPS);
+	praat_addAction1 (classSound, 0, U"To Table (CPPS)...", U"Get CPPS...", 1,
+			COMBINE_ALL_TO_ONE__Sounds_to_Table_CPPS);
 	praat_addAction1 (classSound, 0, U"To Formant (robust)...", U"To Formant (sl)...", 2,
 			CONVERT_EACH_TO_ONE__Sound_to_Formant_robust);
 	praat_addAction1 (classSound, 0, U"To FormantPath...", U"To Formant (robust)...", 2, 
@@ -1893,10 +2011,14 @@ void praat_uvafon_LPC_init () {
 			CONVERT_EACH_TO_ONE__Sound_to_LPC_robust);
 	praat_addAction1 (classSound, 0, U"To MFCC...", U"To LPC (robust)...", 1,
 			CONVERT_EACH_TO_ONE__Sound_to_MFCC);
+	praat_addAction1 (classSound, 1, U"Save as HTK MFCC file...", U"Save as raw 16-bit little-endian file...", 0,
+			SAVE_ONE__Sound_saveAsHtkMfccFile);
 	praat_addAction2 (classSound, 1, classFormantPath, 1, U"View & Edit", nullptr,0,
 			EDITOR_ONE_WITH_ONE_Sound_FormantPath_createFormantPathEditor);
 	praat_addAction2 (classTextGrid, 1, classFormantPath, 1, U"View & Edit", nullptr,0,
 			EDITOR_ONE_WITH_ONE_TextGrid_FormantPath_createFormantPathEditor);
+	praat_addAction2 (classSound, 1, classTextGrid, 1, U"To Table (CPPS)...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_ONE__Sound_TextGrid_to_Table_CPPS);
 	praat_addAction3 (classSound, 1, classTextGrid, 1, classFormantPath, 1, U"View & Edit", nullptr, 0,
 			EDITOR_ONE_WITH_ONE_AND_ONE__Sound_TextGrid_FormantPath_createFormantPathEditor);
 	
@@ -202,14 +202,84 @@ static double getMaximumChange (constMATVU const& m, MATVU const& m0, const doub
 }
 
 /*
-	Calculating elementwise matrix multiplication, division and addition m = m0 .* (numerm ./(denom + eps))
-	Set elements < zero_threshold to zero
+	Calculating the elementwise multiplication, division and addition m = m0 * (numer / (denom + eps)) for a single cell.
+	Returns zero if the result is < zeroThreshold.
 */
+static inline double updatedValue (double m0, double numer, double denom, double divByZeroAvoidance, double zeroThreshold) {
+	if (m0 == 0.0 || numer == 0.0)
+		return 0.0;
+	const double update = m0 * (numer / (denom + divByZeroAvoidance));
+	return ( update < zeroThreshold ? 0.0 : update );
+}
+
+/*
+	Algorithm for Non-negative Matrix Factorization by multiplicative updates.
+	The algoritm is inspired by the nmf_mu.c algorithm in libNMF by 
+	A. Janecek, S. Schulze Grotthoff & W.N. Gangsterer (2011): 
+		"LIBNMF - A library for nonnegative matrix factorization."
+		Computing and informatics% #30: 205--224.
 
-static const void update (MATVU const& m, constMATVU const& m0, constMATVU const& numer, constMATVU const& denom, double zeroThreshold, double maximum) {
-	Melder_assert (m.nrow == m0.nrow && m.ncol == m0.ncol);
-	Melder_assert (m.nrow == numer.nrow && m.ncol == numer.ncol);
-	Melder_assert (m.nrow == denom.nrow && m.ncol == denom.ncol);
+	The data are visited in blocks of columns. Per block D(b) with weights W(b) we need F'D(b) (one matrix product);
+	the product F'F W(b) is calculated column by column in the update of W(b) itself, and the statistics
+	D(b)W(b)' and W(b)W(b)' for the update of F are accumulated over the blocks.
+	The F update calculates F (WW') row by row in the same way. Hence the work space does not depend on the number of columns
+	of the data, apart from one block of F'D.
+	In the online variant F is updated after each block (J. Mairal, F. Bach, J. Ponce & G. Sapiro (2010):
+	"Online learning for matrix factorization and sparse coding", Journal of Machine Learning Research 11: 19--60).
+*/
+static void NMF_improveFactorization_mu_columns (NMF me, NMF_DataColumns const& getColumns, integer blockSize, bool online,
+	integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info)
+{
+	Melder_require (blockSize > 0,
+		U"The block size should be positive.");
+	blockSize = std::min (blockSize, my numberOfColumns);
+	const integer numberOfFeatures = my numberOfFeatures;
+	const integer numberOfBlocks = (my numberOfColumns - 1) / blockSize + 1;
+	auto getBlock = [&] (integer iblock) -> constMATVU {
+		const integer firstColumn = 1 + (iblock - 1) * blockSize;
+		const integer lastColumn = std::min (firstColumn + blockSize - 1, my numberOfColumns);
+		constMATVU data = getColumns (firstColumn, lastColumn);
+		Melder_require (data.nrow == my numberOfRows && data.ncol == lastColumn - firstColumn + 1,
+			U"The data block for columns ", firstColumn, U" to ", lastColumn, U" should have ", my numberOfRows,
+			U" rows and ", lastColumn - firstColumn + 1, U" columns.");
+		return data;
+	};
+	/*
+		A preliminary pass for the norm of the data (for the distance calculation) and the maximum.
+	*/
+	double traceDtD = 0.0, maximum = 0.0;
+	for (integer iblock = 1; iblock <= numberOfBlocks; iblock ++) {
+		constMATVU data = getBlock (iblock);
+		traceDtD += NUMtrace2 (data.transpose(), data);
+		maximum = ( iblock == 1 ? NUMmax_e (data) : std::max (maximum, NUMmax_e (data)) );
+	}
+	/*
+		All work space is allocated only once.
+	*/
+	autoMAT productFtD = raw_MAT (numberOfFeatures, blockSize); // calculations of F'D(b)
+	autoMAT productFtF = raw_MAT (numberOfFeatures, numberOfFeatures); // calculations of F'F
+	autoMAT productWWt = zero_MAT (numberOfFeatures, numberOfFeatures); // accumulation of W(b)W(b)'
+	autoMAT productWWt_block = raw_MAT (numberOfFeatures, numberOfFeatures);
+	/*
+		In the online variant the statistics always belong to the current W: from the second pass on,
+		the contribution of the previous weights of a block is replaced by that of its new weights.
+	*/
+	autoMAT blockWeights0 = ( online ? raw_MAT (numberOfFeatures, blockSize) : autoMAT () );
+	autoMAT productWWt_block0 = ( online ? raw_MAT (numberOfFeatures, numberOfFeatures) : autoMAT () );
+	autoMAT productDWt = zero_MAT (my numberOfRows, numberOfFeatures); // accumulation of D(b)W(b)'
+	autoMAT features0 = raw_MAT (my numberOfRows, numberOfFeatures);
+	/*
+		Per column of W or row of F the update needs numberOfFeatures^2 multiplications.
+	*/
+	const integer thresholdNumberOfVectorsPerThread = std::max (1_integer, 20000 / (numberOfFeatures * (numberOfFeatures + 2)));
+	const integer maximumNumberOfThreads = MelderThread_computeNumberOfThreads (std::max (blockSize, my numberOfRows), thresholdNumberOfVectorsPerThread);
+	autoMAT threadProducts = raw_MAT (maximumNumberOfThreads, numberOfFeatures); // a column of F'F W(b) or a row of F WW'
+	autoMAT threadSums = raw_MAT (maximumNumberOfThreads, 3); // trace (W'F'D), max |W0|, max |W0 - W|
+
+	if (! NUMfpp)
+		NUMmachar ();
+	const double eps = NUMfpp -> eps;
+	const double sqrteps = sqrt (eps);
 	/*
 		The value 1e-9 is OK for matrices with values that are larger than 1.
 		For matrices with very small values we have to scale the divByZeroAvoidance value
@@ -217,104 +287,173 @@ static const void update (MATVU const& m, constMATVU const& m0, constMATVU const
 		A scaling with the maximum value seems reasonable.
 	*/
 	const double divByZeroAvoidance = 1e-09 * ( maximum < 1.0 ? maximum : 1.0 );
-	for (integer irow = 1; irow <= m.nrow; irow ++) 
-		for (integer icol = 1; icol <= m.ncol; icol++) {
-			if (m0 [irow] [icol] == 0.0 || numer [irow] [icol]  == 0.0) {
-				m [irow] [icol] = 0.0;
+
+	auto updateFeatures = [&] () {
+		/*
+			F = F .* (D*W') ./ (F*W*W' + 10^^−9^), row by row
+		*/
+		std::atomic <bool> errorFlag = false;
+		MelderThread_run (& errorFlag, my numberOfRows, thresholdNumberOfVectorsPerThread,
+			[&] (integer threadNumber, integer firstRow, integer lastRow) {
+				VEC productFWWt = threadProducts.row (threadNumber + 1);
+				for (integer irow = firstRow; irow <= lastRow; irow ++) {
+					for (integer ifeature = 1; ifeature <= numberOfFeatures; ifeature ++) {
+						double sum = 0.0;
+						for (integer jfeature = 1; jfeature <= numberOfFeatures; jfeature ++)
+							sum += my features [irow] [jfeature] * productWWt [jfeature] [ifeature];
+						productFWWt [ifeature] = sum;
+					}
+					for (integer ifeature = 1; ifeature <= numberOfFeatures; ifeature ++)
+						my features [irow] [ifeature] = updatedValue (my features [irow] [ifeature], productDWt [irow] [ifeature],
+								productFWWt [ifeature], divByZeroAvoidance, eps);
+				}
+			}
+		);
+	};
+
+	double dnorm0 = 0.0;
+	integer iter = 1;
+	bool convergence = false;
+	while (iter <= maximumNumberOfIterations && not convergence) {
+		/*
+			while iter < maxinter and not convergence
+				for each block b
+					(1) W(b) = W(b) .* (F'*D(b)) ./ (F'*F*W(b) + 10^^−9^)
+					(2) accumulate D(b)*W(b)' and W(b)*W(b)'
+						(online, from the second pass on: replace the contribution of the previous W(b))
+					(online) update F as in (3)
+				(3) F = F .* (D*W') ./ (F*W*W' + 10^^−9^)
+				(4) test for convergence
+			endwhile
+		*/
+		features0.all()  <<=  my features.all();
+		if (! online) {
+			productDWt.all()  <<=  0.0;
+			productWWt.all()  <<=  0.0;
+		}
+		threadSums.all()  <<=  0.0;
+		double traceWtFtFW = 0.0;
+		mtm_MAT_out (productFtF.get(), my features.get());
+		for (integer iblock = 1; iblock <= numberOfBlocks; iblock ++) {
+			constMATVU data = getBlock (iblock);
+			const integer firstColumn = 1 + (iblock - 1) * blockSize;
+			MATVU weights = my weights.verticalBand (firstColumn, firstColumn + data.ncol - 1);
+			MATVU blockFtD = productFtD.verticalBand (1, data.ncol);
+			
+			const bool mustReplaceContribution = ( online && iter > 1 );
+			MATVU weights0 = ( mustReplaceContribution ? blockWeights0.verticalBand (1, data.ncol) : MATVU () );
+			if (mustReplaceContribution)
+				weights0  <<=  weights;
+
+			// 1. Update W(b)
+			mul_fast_MAT_out (blockFtD, my features.transpose(), data);
+			std::atomic <bool> errorFlag = false;
+			MelderThread_run (& errorFlag, data.ncol, thresholdNumberOfVectorsPerThread,
+				[&] (integer threadNumber, integer firstCol, integer lastCol) {
+					VEC productFtFW = threadProducts.row (threadNumber + 1);
+					double traceWtFtD = 0.0, maximumWeight = 0.0, maximumChange = 0.0;
+					for (integer icol = firstCol; icol <= lastCol; icol ++) {
+						for (integer ifeature = 1; ifeature <= numberOfFeatures; ifeature ++) {
+							double sum = 0.0;
+							for (integer jfeature = 1; jfeature <= numberOfFeatures; jfeature ++)
+								sum += productFtF [ifeature] [jfeature] * weights [jfeature] [icol];
+							productFtFW [ifeature] = sum;
+						}
+						for (integer ifeature = 1; ifeature <= numberOfFeatures; ifeature ++) {
+							const double weight0 = weights [ifeature] [icol];
+							const double weight = updatedValue (weight0, blockFtD [ifeature] [icol], productFtFW [ifeature], divByZeroAvoidance, eps);
+							weights [ifeature] [icol] = weight;
+							traceWtFtD += weight * blockFtD [ifeature] [icol];
+							maximumWeight = std::max (maximumWeight, fabs (weight0));
+							maximumChange = std::max (maximumChange, fabs (weight0 - weight));
+						}
+					}
+					double *sums = & threadSums [threadNumber + 1] [1];
+					sums [0] += traceWtFtD;
+					sums [1] = std::max (sums [1], maximumWeight);
+					sums [2] = std::max (sums [2], maximumChange);
+				}
+			);
+			
+			// 2. Accumulate the statistics for the F update
+			mul_fast_MAT_out (productWWt_block.get(), weights, weights.transpose());
+			traceWtFtFW += NUMtrace2 (productFtF.get(), productWWt_block.get());
+			productWWt.get()  +=  productWWt_block.get();
+			if (mustReplaceContribution) {
+				mul_fast_MAT_out (productWWt_block0.get(), weights0, weights0.transpose());
+				productWWt.get()  -=  productWWt_block0.get();
+				/*
+					D(b)W(b)' - D(b)W0(b)' = D(b)(W(b) - W0(b))', which costs a single product.
+				*/
+				for (integer ifeature = 1; ifeature <= numberOfFeatures; ifeature ++)
+					for (integer icol = 1; icol <= data.ncol; icol ++)
+						weights0 [ifeature] [icol] = weights [ifeature] [icol] - weights0 [ifeature] [icol];
+				mulAdd_MAT_inout (productDWt.get(), data, weights0.transpose());
 			} else {
-				double update = m0 [irow] [icol] * (numer [irow] [icol] / (denom [irow] [icol] + divByZeroAvoidance));
-				m [irow] [icol] = ( update < zeroThreshold ? 0.0 : update );
+				mulAdd_MAT_inout (productDWt.get(), data, weights.transpose());
+			}
+			if (online && numberOfBlocks > 1) {
+				updateFeatures ();
+				mtm_MAT_out (productFtF.get(), my features.get());
 			}
 		}
+		
+		// 3. Update F
+		if (! online || numberOfBlocks == 1)
+			updateFeatures ();
+		
+		/* 4. Convergence test:
+			The Frobenius norm ||D-FW|| of a matrix can be written as
+			||D-FW||=trace(D'D) − 2trace(W'F'D) + trace(W'F'FW)
+					=trace(D'D) - 2trace(W'(F'D))+trace((F'F)(WW'))
+			This saves us from explicitly calculating the reconstruction FW because we already have performed most of
+			the needed matrix multiplications in the update step.
+			The traces are sums over the blocks (in the online variant each block has its own F).
+		*/
+		double traceWtFtD = 0.0, maximumWeight = 0.0, maximumWeightChange = 0.0;
+		for (integer ithread = 1; ithread <= threadSums.nrow; ithread ++) {
+			traceWtFtD += threadSums [ithread] [1];
+			maximumWeight = std::max (maximumWeight, threadSums [ithread] [2]);
+			maximumWeightChange = std::max (maximumWeightChange, threadSums [ithread] [3]);
+		}
+		const double distance = sqrt (std::max (traceDtD - 2.0 * traceWtFtD + traceWtFtFW, 0.0)); // just in case
+		const double dnorm = distance / (my numberOfRows * my numberOfColumns);
+		const double df = getMaximumChange (my features.get(), features0.get(), sqrteps);
+		const double dw = maximumWeightChange / (sqrteps + maximumWeight);
+		const double delta = std::max (df, dw);
+		convergence = ( iter > 1 && (delta < changeTolerance || dnorm < dnorm0 * approximationTolerance) );
+		if (info)
+			MelderInfo_writeLine (U"Iteration: ", iter, U", dnorm: ", dnorm, U", delta: ", delta);
+		
+		dnorm0 = dnorm;
+		++ iter;
+	}
+	if (info)
+		MelderInfo_drain();
 }
 
-/*
-	Algorithm for Non-negative Matrix Factorization by multiplicative updates.
-	The algoritm is inspired by the nmf_mu.c algorithm in libNMF by 
-	A. Janecek, S. Schulze Grotthoff & W.N. Gangsterer (2011): 
-		"LIBNMF - A library for nonnegative matrix factorization."
-		Computing and informatics% #30: 205--224.
-
-*/
 void NMF_improveFactorization_mu (NMF me, constMATVU const& data, integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info) {
 	try {
 		Melder_require (my numberOfColumns == data.ncol,
 			U"The number of columns should be equal.");
 		Melder_require (my numberOfRows == data.nrow,
 			U"The number of rows should be equal.");
-		
-		autoMAT productFtD = zero_MAT (my numberOfFeatures, my numberOfColumns); // calculations of F'D
-		autoMAT productFtFW = zero_MAT (my numberOfFeatures, my numberOfColumns); // calculations of F'F W
-		autoMAT weights0 = zero_MAT (my numberOfFeatures, my numberOfColumns);
-		
-		autoMAT productDWt = zero_MAT (my numberOfRows, my numberOfFeatures); // calculations of DW'
-		autoMAT productFWWt = zero_MAT (my numberOfRows, my numberOfFeatures); // calculations of FWW'
-		autoMAT features0 = zero_MAT (my numberOfRows, my numberOfFeatures);
-		
-		autoMAT productWWt = zero_MAT (my numberOfFeatures, my numberOfFeatures); // calculations of WW'
-		autoMAT productFtF = zero_MAT (my numberOfFeatures, my numberOfFeatures); // calculations of F'F
-		
-		const double traceDtD = NUMtrace2 (data.transpose(), data); // for distance calculation
-		features0.all()  <<=  my features.all();
-		weights0.all()  <<=  my weights.all();
-		
-		if (! NUMfpp)
-			NUMmachar ();
-		
-		const double eps = NUMfpp -> eps;
-		const double sqrteps = sqrt (eps);
-		const double maximum = NUMmax_e (data);
-		double dnorm0 = 0.0;
-		integer iter = 1;
-		bool convergence = false;	
-		
-		while (iter <= maximumNumberOfIterations && not convergence) {
-			/*
-				while iter < maxinter and not convergence
-					(1) W = W .* (F'*D) ./ (F'*F*W + 10^^−9^)
-					(2) F = F .* (D*W') ./ (F*W*W' + 10^^−9^)
-					(3) test for convergence
-				endwhile
-			*/
-			
-			// 1. Update W matrix
-			features0.all()  <<=  my features.all();
-			weights0.all()  <<=  my weights.all();
-			mul_MAT_out (productFtD.get(), features0.transpose(), data);
-			mul_MAT_out (productFtF.get(), features0.transpose(), features0.get());
-			mul_MAT_out (productFtFW.get(), productFtF.get(), weights0.get());
-			update (my weights.get(), weights0.get(), productFtD.get(), productFtFW.get(), eps, maximum);
-
-			// 2. Update F matrix
-			mul_MAT_out (productDWt.get(), data, my weights.transpose()); // productDWt = data*weights'
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose()); // work1 = weights*weights'
-			mul_MAT_out (productFWWt.get(), features0.get(), productWWt.get()); // productFWWt = features0 * work1
-			update (my features.get(), features0.get(), productDWt.get(), productFWWt.get(), eps, maximum);
-			
-			/* 3. Convergence test:
-				The Frobenius norm ||D-FW|| of a matrix can be written as
-				||D-FW||=trace(D'D) − 2trace(W'F'D) + trace(W'F'FW)
-						=trace(D'D) - 2trace(W'(F'D))+trace((F'F)(WW'))
-				This saves us from explicitly calculating the reconstruction FW because we already have performed most of
-				the needed matrix multiplications in the update step.
-			*/
-			
-			const double traceWtFtD  = NUMtrace2 (my weights.transpose(), productFtD.get());
-			const double traceWtFtFW = NUMtrace2 (productFtF.get(), productWWt.get());
-			const double distance = sqrt (std::max (traceDtD - 2.0 * traceWtFtD + traceWtFtFW, 0.0)); // just in case
-			const double dnorm = distance / (my numberOfRows * my numberOfColumns);
-			const double df = getMaximumChange (my features.get(), features0.get(), sqrteps);
-			const double dw = getMaximumChange (my weights.get(), weights0.get(), sqrteps);
-			const double delta = std::max (df, dw);
-			convergence = ( iter > 1 && (delta < changeTolerance || dnorm < dnorm0 * approximationTolerance) );
-			if (info)
-				MelderInfo_writeLine (U"Iteration: ", iter, U", dnorm: ", dnorm, U", delta: ", delta);
-			
-			dnorm0 = dnorm;
-			++ iter;
-		}
-		if (info)
-			MelderInfo_drain();
+		NMF_improveFactorization_mu_columns (me,
+			[&] (integer firstColumn, integer lastColumn) -> constMATVU {
+				return data.verticalBand (firstColumn, lastColumn);
+			},
+			my numberOfColumns, false, maximumNumberOfIterations, changeTolerance, approximationTolerance, info
+		);
+	} catch (MelderError) {
+		Melder_throw (me, U" factorization cannot be improved.");
+	}
+}
+
+void NMF_improveFactorization_mu_blocks (NMF me, NMF_DataColumns const& getColumns, integer blockSize, bool online,
+	integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info)
+{
+	try {
+		NMF_improveFactorization_mu_columns (me, getColumns, blockSize, online, maximumNumberOfIterations, changeTolerance, approximationTolerance, info);
 	} catch (MelderError) {
 		Melder_throw (me, U" factorization cannot be improved.");
 	}
@@ -362,8 +501,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				1. Solve equations for new W:  F´*F*W = F'*D
 			*/
 			weights0.all()  <<=  my weights.all();   // save previous weights for convergence test
-			mul_MAT_out (productFtD.get(), my features.transpose(), data);
-			mul_MAT_out (productFtF.get(), my features.transpose(), my features.get());
+			mul_fast_MAT_out (productFtD.get(), my features.transpose(), data);
+			mtm_MAT_out (productFtF.get(), my features.get());
 
 			svd_FtF -> u.all()  <<=  productFtF.all();
 			SVD_compute (svd_FtF.get());
@@ -374,8 +513,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				2. Solve equations for new F:  W*W'*F' = W*D'
 			*/
 			features0.all()  <<=  my features.all();   // save previous features for convergence test
-			mul_MAT_out  (productWDt.get(), my weights.get(), data.transpose());
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
+			mul_fast_MAT_out (productWDt.get(), my weights.get(), data.transpose());
+			mul_fast_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
 
 			svd_WWt -> u.all()  <<=  productWWt.all();
 			SVD_compute (svd_WWt.get());
@@ -419,9 +558,16 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 			U"The data matrix should not have cells that are zero.");
 		autoMAT vk = raw_MAT (data.nrow, data.ncol);
 		autoMAT fw = raw_MAT (data.nrow, data.ncol);
-		autoMAT fcol_x_wrow = raw_MAT (data.nrow, data.ncol);
+		autoVEC fcolumn0 = raw_VEC (data.nrow); // feature column before the update
+		autoVEC wrow0 = raw_VEC (data.ncol); // weight row before the update
 		autoVEC fcolumn_inv = raw_VEC (data.nrow); // feature column
 		autoVEC wrow_inv = raw_VEC (data.ncol); // weight row
+		/*
+			Every step below is a pass over all the cells of the data, which we distribute over the threads
+			by rows (or, for (3), by columns).
+		*/
+		const integer thresholdNumberOfRowsPerThread = std::max (1_integer, 10000 / data.ncol);
+		const integer thresholdNumberOfColumnsPerThread = std::max (1_integer, 10000 / data.nrow);
 		mul_MAT_out (fw.get(), my features.get(), my weights.get());
 		double divergence = MATgetDivergence_ItakuraSaito (data, fw.get());
 		const double divergence0 = divergence;
@@ -448,27 +594,63 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 				We can calculate the elements of G(k) while we are doing (2).
 			*/
 			for (integer kf = 1; kf <= my numberOfFeatures; kf ++) {
+				fcolumn0.all()  <<=  my features.column (kf);
+				wrow0.all()  <<=  my weights.row (kf);
 				// (1) and (2)
-				outer_MAT_out (fcol_x_wrow.get(), my features.column (kf), my weights.row (kf));
-				for (integer irow = 1; irow <= data.nrow; irow ++)
-					for (integer icol = 1; icol <= data.ncol; icol ++) {
-						double gk = fcol_x_wrow [irow] [icol] / fw [irow] [icol];
-						vk [irow] [icol] = gk * gk * data [irow] [icol] + (1.0 - gk) * fcol_x_wrow [irow] [icol];
+				std::atomic <bool> errorFlag = false;
+				MelderThread_run (& errorFlag, data.nrow, thresholdNumberOfRowsPerThread,
+					[&] (integer /* threadNumber */, integer firstRow, integer lastRow) {
+						for (integer irow = firstRow; irow <= lastRow; irow ++) {
+							const double fk = fcolumn0 [irow];
+							double *vkrow = & vk [irow] [1];
+							const double *fwrow = & fw [irow] [1];
+							for (integer icol = 1; icol <= data.ncol; icol ++) {
+								const double fcol_x_wrow = fk * wrow0 [icol];
+								const double gk = fcol_x_wrow / fwrow [icol - 1];
+								vkrow [icol - 1] = gk * gk * data [irow] [icol] + (1.0 - gk) * fcol_x_wrow;
+							}
+						}
+					}
+				);
+				// (3), accumulated row by row
+				VECinvertAndScale (fcolumn_inv.get(), my features.column (kf), 1.0 / my numberOfRows);
+				MelderThread_run (& errorFlag, data.ncol, thresholdNumberOfColumnsPerThread,
+					[&] (integer /* threadNumber */, integer firstColumn, integer lastColumn) {
+						VECVU wk = my weights.row (kf).part (firstColumn, lastColumn);
+						wk  <<=  0.0;
+						for (integer irow = 1; irow <= data.nrow; irow ++) {
+							const double finv = fcolumn_inv [irow];
+							const double *vkrow = & vk [irow] [firstColumn];
+							for (integer icol = 1; icol <= wk.size; icol ++)
+								wk [icol] += finv * vkrow [icol - 1];
+						}
 					}
-				// (3)
-				VECinvertAndScale (fcolumn_inv.get(), my features.column (kf), 1.0 / my numberOfRows);	
-				mul_VEC_out (my weights.row (kf), fcolumn_inv.get(), vk.get());
+				);
 				// (4)
 				VECinvertAndScale (wrow_inv.get(), my weights.row (kf), 1.0 / my numberOfColumns);
-				mul_VEC_out (my features.column (kf), vk.get(), wrow_inv.get());
+				MelderThread_run (& errorFlag, data.nrow, thresholdNumberOfRowsPerThread,
+					[&] (integer /* threadNumber */, integer firstRow, integer lastRow) {
+						mul_VEC_out (my features.column (kf).part (firstRow, lastRow), vk.horizontalBand (firstRow, lastRow), wrow_inv.get());
+					}
+				);
 				// (5)
 				double fcolumn_norm = NUMnorm (my features.column (kf), 2.0);
 				my features.column (kf)  /=  fcolumn_norm;
 				my weights.row (kf)  *=  fcolumn_norm;
 				// (6)
-				fw.get()  -=  fcol_x_wrow.get();
-				outer_MAT_out (fcol_x_wrow.get(), my features.column (kf), my weights.row (kf));
-				fw.get()  +=  fcol_x_wrow.get();
+				MelderThread_run (& errorFlag, data.nrow, thresholdNumberOfRowsPerThread,
+					[&] (integer /* threadNumber */, integer firstRow, integer lastRow) {
+						for (integer irow = firstRow; irow <= lastRow; irow ++) {
+							const double fk0 = fcolumn0 [irow], fk = my features [irow] [kf];
+							const double *wk = & my weights [kf] [1];
+							double *fwrow = & fw [irow] [1];
+							for (integer icol = 1; icol <= data.ncol; icol ++) {
+								fwrow [icol - 1] -= fk0 * wrow0 [icol];
+								fwrow [icol - 1] += fk * wk [icol - 1];
+							}
+						}
+					}
+				);
 			}
 			const double divergence_update = MATgetDivergence_ItakuraSaito (data, fw.get());
 			const double delta = divergence - divergence_update;
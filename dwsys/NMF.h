@@ -1,6 +1,6 @@
 /* NMF.h
  *
- * Copyright (C) 2019 David Weenink
+ * Copyright (C) 2019,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -51,6 +51,22 @@ void NMF_initializeFactorization (NMF me, constMATVU const& data, kNMF_Initializ
 */
 void NMF_improveFactorization_mu (NMF me, constMATVU const& data, integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info);
 
+/*
+	The data matrix supplied as blocks of columns:
+	the function returns the columns firstColumn..lastColumn (all rows) as a view that should remain valid until the next call.
+	The columns can come from memory or be read from a file (see NMF_improveFactorization_mu_matrixBinaryFile in Matrix_and_NMF.h).
+*/
+using NMF_DataColumns = std::function <constMATVU (integer firstColumn, integer lastColumn)>;
+
+/*
+	The multiplicative updates with the data visited in blocks of blockSize columns.
+	If online, F is updated after each block from the statistics D*W' and W*W'. In the first pass these are
+	accumulated over the blocks visited so far; in later passes the contribution of each block is replaced
+	when its weights have been updated. Otherwise F is updated once per pass as above.
+*/
+void NMF_improveFactorization_mu_blocks (NMF me, NMF_DataColumns const& getColumns, integer blockSize, bool online,
+	integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info);
+
 /*
 	Factorize D as F*W, where D, F and W >= 0
 	
@@ -130,6 +130,70 @@ void VECsmoothByMovingAverage_preallocated (VECVU const& out, constVECVU const&
 	}
 }
 
+void VECsmoothByMovingAverage_interpolated_preallocated (VECVU const& out, constVECVU const& in,
+	double xmin, double xmax, double x1, double dx, double averagingWindow)
+{
+	Melder_assert (out.size == in.size);
+	Melder_require (averagingWindow > 0.0,
+		U"The averaging window should be larger than 0.");
+	const integer n = in.size;
+	const double halfWindow = 0.5 * averagingWindow;
+	const double leftEdge = x1 - 0.5 * dx, rightEdge = leftEdge + n * dx;
+	/*
+		The sample window [imin, imax] only moves to the right as i increases,
+		so the sum over the window can be updated instead of recomputed.
+	*/
+	longdouble windowSum = 0.0;
+	integer ifirst = 1, ilast = 0; // the current window of the running sum
+	for (integer i = 1; i <= n; i ++) {
+		const double xmid = x1 + (i - 1) * dx;
+		const double xfrom = std::max (xmin, xmid - halfWindow), xto = std::min (xmax, xmid + halfWindow);
+		integer imin = 1 + Melder_iroundUp ((xfrom - x1) / dx), imax = 1 + Melder_iroundDown ((xto - x1) / dx);
+		Melder_clipLeft (1_integer, & imin);
+		Melder_clipRight (& imax, n);
+		Melder_assert (imin <= i && i <= imax);
+		while (ilast < imax)
+			windowSum += in [++ ilast];
+		while (ifirst < imin)
+			windowSum -= in [ifirst ++];
+		longdouble sum = windowSum, definitionRange = imax - imin + 1;
+		/*
+			Corrections within the first and last sampling intervals (linear interpolation).
+		*/
+		if (xfrom > leftEdge) {
+			double phase = (x1 + (imin - 1) * dx - xfrom) / dx;
+			const double rightValue = in [imin];
+			definitionRange -= 0.5;
+			sum -= 0.5 * rightValue;
+			if (imin > 1) {
+				const double leftValue = in [imin - 1];
+				definitionRange += phase;
+				sum += phase * (rightValue + 0.5 * phase * (leftValue - rightValue));
+			} else {
+				Melder_clipRight (& phase, 0.5);
+				definitionRange += phase;
+				sum += phase * rightValue;
+			}
+		}
+		if (xto < rightEdge) {
+			double phase = (xto - (x1 + (imax - 1) * dx)) / dx;
+			const double leftValue = in [imax];
+			definitionRange -= 0.5;
+			sum -= 0.5 * leftValue;
+			if (imax < n) {
+				const double rightValue = in [imax + 1];
+				definitionRange += phase;
+				sum += phase * (leftValue + 0.5 * phase * (rightValue - leftValue));
+			} else {
+				Melder_clipRight (& phase, 0.5);
+				definitionRange += phase;
+				sum += phase * leftValue;
+			}
+		}
+		out [i] = ( definitionRange <= 0.0 ? undefined : double (sum / definitionRange) );
+	}
+}
+
 void VECsmooth_gaussian (VECVU const& out, constVECVU const& in, double sigma, NUMFourierTable fftTable) {
 	Melder_require (out.size == in.size,
 		U"The sizes of the input and output vectors should be equal.");
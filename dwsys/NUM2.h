@@ -257,6 +257,16 @@ inline void MATnormalizeColumns_inplace (MATVU const& a, double power, double no
 
 void VECsmoothByMovingAverage_preallocated (VECVU const& out, constVECVU const& in, integer window);
 
+void VECsmoothByMovingAverage_interpolated_preallocated (VECVU const& out, constVECVU const& in,
+	double xmin, double xmax, double x1, double dx, double averagingWindow);
+/*
+	The values in[i] are samples at x1 + (i - 1) * dx of a function on the domain [xmin, xmax].
+	out [i] is the mean of the linearly interpolated function in the window of width averagingWindow centred
+	at sample i, i.e. what Sampled_getMean (..., interpolate = true) would return for that window up to rounding,
+	but computed with a running sum in O(n) instead of O(n * window).
+	out and in should not overlap.
+*/
+
 autoMAT MATcovarianceFromColumnCentredMatrix (constMATVU const& x, integer ndf);
 /*
 	Calculate covariance matrix(ncols x ncols) from data matrix (nrows x ncols);
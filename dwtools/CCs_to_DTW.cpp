@@ -148,4 +148,160 @@ trace(6);
 	}
 }
 
+/*
+	One row per frame, with the weights already applied, such that the squared Euclidean distance between two rows,
+	divided by the sum of the weights, equals the squared distance of CCs_to_DTW.
+	Regression coefficients are zero in the frames at the edges.
+*/
+static autoMAT CC_getWeightedFeatures (CC me, double coefficientWeight, double logEnergyWeight,
+	double coefficientRegressionWeight, double logEnergyRegressionWeight, integer numberOfRegressionFrames)
+{
+	const integer numberOfCoefficients = my maximumNumberOfCoefficients;
+	autoMAT features = zero_MAT (my nx, 2 * numberOfCoefficients + 2);
+	autoVEC r = raw_VEC (numberOfCoefficients + 1);
+	for (integer iframe = 1; iframe <= my nx; iframe ++) {
+		const CC_Frame frame = & my frame [iframe];
+		const VEC feature = features.row (iframe);
+		for (integer k = 1; k <= frame -> numberOfCoefficients; k ++)
+			feature [k] = sqrt (coefficientWeight) * frame -> c [k];
+		feature [numberOfCoefficients + 1] = sqrt (logEnergyWeight) * frame -> c0;
+		if (coefficientRegressionWeight != 0.0 || logEnergyRegressionWeight != 0.0) {
+			r.all()  <<=  0.0;
+			regression (r.get(), me, iframe, numberOfRegressionFrames);
+			for (integer k = 2; k <= frame -> numberOfCoefficients + 1; k ++)
+				feature [numberOfCoefficients + k] = sqrt (coefficientRegressionWeight) * r [k];
+			feature [2 * numberOfCoefficients + 2] = sqrt (logEnergyRegressionWeight) * r [1];
+		}
+	}
+	return features;
+}
+
+/*
+	LB_Keogh: every path has at least one cell in each column after its start, and the distance of such a cell
+	is at least the distance between the x-frame and the envelope of the y-frames in the band of its column.
+	The band rows only move upwards, so the envelopes can be tracked with monotone queues.
+*/
+static double DTW_getLowerBound (constMAT const& yFeatures, constMAT const& xFeatures, double weightSum,
+	constINTVEC const& rowFrom, constINTVEC const& rowTo, integer firstColumnOnAllPaths)
+{
+	const integer nx = xFeatures.nrow, ny = yFeatures.nrow;
+	for (integer ix = 2; ix <= nx; ix ++)
+		if (rowFrom [ix] < rowFrom [ix - 1] || rowTo [ix] < rowTo [ix - 1] || rowFrom [ix] > rowTo [ix])
+			return 0.0;   // no monotone band, no bound
+	autoVEC excess2 = zero_VEC (nx);
+	autoINTVEC maximumQueue = raw_INTVEC (ny), minimumQueue = raw_INTVEC (ny);
+	for (integer k = 1; k <= yFeatures.ncol; k ++) {
+		integer maxHead = 1, maxTail = 0, minHead = 1, minTail = 0, nextRow = 1;
+		for (integer ix = 1; ix <= nx; ix ++) {
+			for (; nextRow <= rowTo [ix]; nextRow ++) {
+				const double value = yFeatures [nextRow] [k];
+				while (maxTail >= maxHead && yFeatures [maximumQueue [maxTail]] [k] <= value)
+					maxTail --;
+				maximumQueue [++ maxTail] = nextRow;
+				while (minTail >= minHead && yFeatures [minimumQueue [minTail]] [k] >= value)
+					minTail --;
+				minimumQueue [++ minTail] = nextRow;
+			}
+			while (maximumQueue [maxHead] < rowFrom [ix])
+				maxHead ++;
+			while (minimumQueue [minHead] < rowFrom [ix])
+				minHead ++;
+			const double x = xFeatures [ix] [k];
+			const double upper = yFeatures [maximumQueue [maxHead]] [k], lower = yFeatures [minimumQueue [minHead]] [k];
+			const double d = ( x > upper ? x - upper : x < lower ? lower - x : 0.0 );
+			excess2 [ix] += d * d;
+		}
+	}
+	double lowerBound = 0.0;
+	for (integer ix = firstColumnOnAllPaths; ix <= nx; ix ++)
+		lowerBound += sqrt (excess2 [ix] / weightSum);
+	return lowerBound;
+}
+
+/*
+	Only the distances of the band are calculated, column by column, and no DTW is created:
+	the memory needed is proportional to the number of frames, not to the product of the numbers of frames.
+*/
+static double CCs_getWeightedDistance_dtw (CC me, CC thee, constMAT const& myFeatures, constMAT const& thyFeatures,
+	double weightSum, double sakoeChibaBand, int slope, double maximumDistance)
+{
+	autoSampledXY geometry = Thing_new (SampledXY);   // the time domains and samplings of the DTW of me and thee
+	SampledXY_init (geometry.get(), thy xmin, thy xmax, thy nx, thy dx, thy x1, my xmin, my xmax, my nx, my dx, my x1);
+	DTW_checkSlopeConstraints (geometry.get(), sakoeChibaBand, slope);
+	autoINTVEC rowFrom = raw_INTVEC (thy nx), rowTo = raw_INTVEC (thy nx);
+	DTW_getBandRows (geometry.get(), sakoeChibaBand, slope, rowFrom.get(), rowTo.get());
+	if (maximumDistance > 0.0) {
+		const integer firstColumnOnAllPaths = std::max (std::min (thy nx, my nx) / 10, 4_integer) + 1;
+		const double lowerBound = DTW_getLowerBound (myFeatures, thyFeatures, weightSum, rowFrom.get(), rowTo.get(), firstColumnOnAllPaths);
+		if (lowerBound / (thy nx + my nx) > maximumDistance)
+			return undefined;
+	}
+	return DTW_getWeightedDistance_bandRows (geometry.get(), rowFrom.get(), rowTo.get(), slope, maximumDistance,
+		[&] (integer jframe, integer fromFrame, integer toFrame, VEC const& distances) {
+			for (integer iframe = fromFrame; iframe <= toFrame; iframe ++) {
+				longdouble d2 = 0.0;
+				for (integer k = 1; k <= myFeatures.ncol; k ++) {
+					const double d = myFeatures [iframe] [k] - thyFeatures [jframe] [k];
+					d2 += d * d;
+				}
+				distances [iframe - fromFrame + 1] = sqrt (double (d2) / weightSum);
+			}
+		}
+	);
+}
+
+autoDistance CCs_to_Distance_dtw (OrderedOf<structCC>* me,
+	const double coefficientWeight, const double logEnergyWeight,
+	const double coefficientRegressionWeight, const double logEnergyRegressionWeight,
+	const double regressionWindowLength, const double sakoeChibaBand, const int slope, const double maximumDistance)
+{
+	try {
+		const integer numberOfObjects = my size;
+		Melder_require (numberOfObjects > 1,
+			U"There should be at least two objects.");
+		const double weightSum = coefficientWeight + logEnergyWeight + coefficientRegressionWeight + logEnergyRegressionWeight;
+		Melder_require (coefficientWeight >= 0.0 && logEnergyWeight >= 0.0 && coefficientRegressionWeight >= 0.0 &&
+			logEnergyRegressionWeight >= 0.0 && weightSum > 0.0,
+			U"The weights should not be negative and at least one of them should be positive.");
+		autoDistance thee = Distance_create (numberOfObjects);
+		autovector <autoMAT> featureMatrices = newvectorzero <autoMAT> (numberOfObjects);
+		for (integer iobject = 1; iobject <= numberOfObjects; iobject ++) {
+			const CC cc = my at [iobject];
+			Melder_require (cc -> maximumNumberOfCoefficients == my at [1] -> maximumNumberOfCoefficients,
+				U"The maximum number of coefficients should be equal.");
+			integer numberOfRegressionFrames = Melder_ifloor (regressionWindowLength / cc -> dx);
+			Melder_require (! (coefficientRegressionWeight != 0.0 && numberOfRegressionFrames < 2),
+				U"Time window for regression is too small.");
+			if (numberOfRegressionFrames % 2 == 0)
+				numberOfRegressionFrames ++;
+			featureMatrices [iobject] = CC_getWeightedFeatures (cc, coefficientWeight, logEnergyWeight,
+				coefficientRegressionWeight, logEnergyRegressionWeight, numberOfRegressionFrames);
+			TableOfReal_setRowLabel (thee.get(), iobject, cc -> name.get());
+			TableOfReal_setColumnLabel (thee.get(), iobject, cc -> name.get());
+		}
+		const integer numberOfPairs = numberOfObjects * (numberOfObjects - 1) / 2;
+		autoINTVEC first = raw_INTVEC (numberOfPairs), second = raw_INTVEC (numberOfPairs);
+		for (integer i = 1, ipair = 0; i < numberOfObjects; i ++) {
+			for (integer j = i + 1; j <= numberOfObjects; j ++) {
+				first [++ ipair] = i;
+				second [ipair] = j;
+			}
+		}
+
+		MelderThread_PARALLELIZE (numberOfPairs, 1)
+		MelderThread_FOR (ipair) {
+			const integer i = first [ipair], j = second [ipair];
+			double distance = CCs_getWeightedDistance_dtw (my at [i], my at [j], featureMatrices [i].get(), featureMatrices [j].get(),
+				weightSum, sakoeChibaBand, slope, maximumDistance);
+			if (isundef (distance))
+				distance = maximumDistance;
+			thy data [i] [j] = thy data [j] [i] = distance;
+		} MelderThread_ENDFOR
+
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (U"Distance not created from CCs.");
+	}
+}
+
 /* End of file CCs_to_DTW.cpp */
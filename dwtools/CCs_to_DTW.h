@@ -27,6 +27,7 @@
 
 #include "CC.h"
 #include "DTW.h"
+#include "Distance.h"
 
 
 autoDTW CCs_to_DTW (CC me, CC thee, double coefficientWeight, double logEnergyWeight, double coefficientRegressionWeight, double logEnergyRegressionWeight, double regressionWindowLength);
@@ -49,4 +50,15 @@ autoDTW CCs_to_DTW (CC me, CC thee, double coefficientWeight, double logEnergyWe
 	at least one of the four weights != 0
 */
 
+autoDistance CCs_to_Distance_dtw (OrderedOf<structCC>* me, double coefficientWeight, double logEnergyWeight,
+	double coefficientRegressionWeight, double logEnergyRegressionWeight, double regressionWindowLength,
+	double sakoeChibaBand, int slope, double maximumDistance);
+/*
+	The weighted DTW distances (see DTW_findPath_bandAndSlope) between all pairs of CCs, with the
+	frame distances of CCs_to_DTW, calculated in parallel and without determining the paths.
+	The earlier CC of a pair is on the y-axis.
+	If maximumDistance > 0, pairs whose distance is larger are abandoned as early as possible
+	(first by a lower bound, then during the dynamic programming) and get the value maximumDistance.
+*/
+
 #endif /* _CCs_to_DTW_h_ */
@@ -37,6 +37,7 @@
  djmw 20110304 Thing_new
 */
 
+#include <thread>
 #include "DTW.h"
 #include "Sound_extensions.h"
 #include "NUM2.h"
@@ -991,7 +992,7 @@ autoMatrix DTW_to_Matrix_cumulativeDistances (DTW me, double sakoeChibaBand, int
     }
 }
 
-static void DTW_relaxConstraints (DTW me, double band, int /* slope */, double *relaxedBand, int *relaxedSlope) {
+static void DTW_relaxConstraints (SampledXY me, double band, int /* slope */, double *relaxedBand, int *relaxedSlope) {
 
 	//double dtw_slope = (my ymax - my ymin - band) / (my xmax - my xmin - band);
 	//dtw_slope = dtw_slope+1.0; // fake instruction to avoid compiler warning
@@ -999,7 +1000,7 @@ static void DTW_relaxConstraints (DTW me, double band, int /* slope */, double *
 	*relaxedSlope = 1;
 }
 
-static void DTW_checkSlopeConstraints (DTW me, double band, int slope) {
+void DTW_checkSlopeConstraints (SampledXY me, double band, int slope) {
     try {
         const double slopes [5] = { DTW_BIG, DTW_BIG, 3.0, 2.0, 1.5 } ;
         double dtw_slope = (my ymax - my ymin - band) / (my xmax - my xmin - band);
@@ -1021,7 +1022,99 @@ static void DTW_checkSlopeConstraints (DTW me, double band, int slope) {
     }
 }
 
-static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const& psi) {
+/*
+	The path finder only needs the cells inside the Polygon. Column ix of the band holds the rows
+	rowFrom [ix] .. rowTo [ix]; the cumulative distances and the path directions of the cells
+	outside the band are never stored and these cells are unreachable.
+*/
+struct DTW_Band {
+	integer nx = 0, ny = 0;
+	autoINTVEC rowFrom, rowTo, offset;
+	autoVEC cumulative;
+	autoINTVEC psi;
+	/*
+		The local distances are either those of a full distance matrix,
+		or they are calculated for the band only and stored in the same layout as the cumulative distances.
+	*/
+	constMATVU distances;
+	autoVEC bandDistances;
+
+	void init (integer numberOfColumns, integer numberOfRows) {
+		nx = numberOfColumns;
+		ny = numberOfRows;
+		rowFrom = raw_INTVEC (nx);
+		rowTo = raw_INTVEC (nx);
+		offset = raw_INTVEC (nx);
+		for (integer ix = 1; ix <= nx; ix ++) {
+			rowFrom [ix] = 1;
+			rowTo [ix] = ny;
+		}
+	}
+	void allocate (constMATVU const& fullDistances) {
+		integer size = 0;
+		for (integer ix = 1; ix <= nx; ix ++) {
+			offset [ix] = size - rowFrom [ix] + 1;
+			if (rowTo [ix] >= rowFrom [ix])
+				size += rowTo [ix] - rowFrom [ix] + 1;
+		}
+		cumulative = raw_VEC (size);
+		psi = zero_INTVEC (size);
+		if (fullDistances.nrow > 0) {
+			Melder_assert (fullDistances.nrow == ny && fullDistances.ncol == nx);
+			distances = fullDistances;
+		} else {
+			bandDistances = raw_VEC (size);
+		}
+	}
+	/*
+		Keep only the last 'numberOfColumnsKept' columns, each in a slot as high as the highest column.
+		The local distances are calculated column by column as well.
+	*/
+	void allocateColumns (integer numberOfColumnsKept) {
+		integer maximumHeight = 0;
+		for (integer ix = 1; ix <= nx; ix ++)
+			maximumHeight = std::max (maximumHeight, rowTo [ix] - rowFrom [ix] + 1);
+		for (integer ix = 1; ix <= nx; ix ++)
+			offset [ix] = ((ix - 1) % numberOfColumnsKept) * maximumHeight - rowFrom [ix] + 1;
+		const integer size = numberOfColumnsKept * maximumHeight;
+		cumulative = raw_VEC (size);
+		psi = zero_INTVEC (size);
+		bandDistances = raw_VEC (size);
+	}
+	bool contains (integer iy, integer ix) const {
+		return iy >= rowFrom [ix] && iy <= rowTo [ix];
+	}
+	integer getPsi (integer iy, integer ix) const {
+		return ( contains (iy, ix) ? psi [offset [ix] + iy] : DTW_UNREACHABLE );
+	}
+	bool isReachable (integer iy, integer ix) const {
+		const integer direction = getPsi (iy, ix);
+		return direction != DTW_UNREACHABLE && direction != DTW_FORBIDDEN;
+	}
+	double& delta (integer iy, integer ix) {
+		return cumulative [offset [ix] + iy];
+	}
+	double distance (integer iy, integer ix) const {
+		if (distances.nrow > 0)
+			return distances [iy] [ix];
+		return ( contains (iy, ix) ? bandDistances [offset [ix] + iy] : undefined );
+	}
+	/*
+		The anti-diagonals can only be traversed as contiguous stretches if the band never
+		moves down as we go to the right.
+	*/
+	bool isMonotone () const {
+		for (integer ix = 2; ix <= nx; ix ++)
+			if (rowFrom [ix] > rowTo [ix] || (ix > 2 && (rowFrom [ix] < rowFrom [ix - 1] || rowTo [ix] < rowTo [ix - 1])))
+				return false;
+		return true;
+	}
+};
+
+/*
+	Everything "above" and "below" the Polygon becomes unreachable.
+*/
+static void DTW_Polygon_setBand (SampledXY me, Polygon thee, DTW_Band *band) {
     try {
         const double eps = my dx / 100.0;   // safe enough
         const double dtw_slope = (my ymax - my ymin) / (my xmax - my xmin);
@@ -1032,6 +1125,7 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
 		Melder_require (! (xmax <= my xmin || xmin >= my xmax || ymax <= my ymin || ymin >= my ymax),
 			U"DTW and Polygon don't overlap.");
 
+		band -> init (my nx, my ny);
         // find border "above" polygon
         for (integer ix = 1; ix <= my nx; ix ++) {
             const double x = my x1 + (ix - 1) * my dx;
@@ -1039,8 +1133,7 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
             for (integer iy = iystart + 1; iy <= my ny; iy ++) {
 				const double y = my y1 + (iy - 1) * my dy;
                 if (Polygon_getLocationOfPoint (thee, x, y, eps) == Polygon_OUTSIDE) {
-                    for (integer k = iy; k <= my ny; k ++)
-                        psi [k] [ix] = DTW_UNREACHABLE;
+                    band -> rowTo [ix] = iy - 1;
                     break;
                 }
             }
@@ -1054,8 +1147,7 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
             for (integer iy = iystart - 1; iy >= 1; iy --) {
                 const double y = my y1 + (iy - 1) * my dy;
                 if (Polygon_getLocationOfPoint (thee, x, y, eps) == Polygon_OUTSIDE) {
-                    for (integer k = iy; k >= 1; k --)
-                        psi [k] [ix] = DTW_UNREACHABLE;
+                    band -> rowFrom [ix] = iy + 1;
                     break;
                 }
             }
@@ -1065,7 +1157,6 @@ static void DTW_Polygon_setUnreachableParts (DTW me, Polygon thee, INTMAT const&
     }
 }
 
-#define DTW_ISREACHABLE(y,x) ((psi [y] [x] != DTW_UNREACHABLE) && (psi [y] [x] != DTW_FORBIDDEN))
 static void DTW_findPath_special (DTW me, bool /* matchStart */, bool /* matchEnd */, int slope, autoMatrix *cumulativeDists) {
 	try {
 		autoPolygon thee = DTW_to_Polygon (me, 0.0, slope);
@@ -1084,7 +1175,10 @@ static void getIntersectionPoint (double x1, double y1, double x2, double y2, do
 	*y3 = a * *x3 + y1 - a * x1;
 }
 
-autoPolygon DTW_to_Polygon (DTW me, double band, int slope) {
+/*
+	The Polygon only depends on the time domains and samplings of the DTW, not on its distances.
+*/
+static autoPolygon SampledXY_to_Polygon_dtwBand (SampledXY me, double band, int slope) {
     try {
 		try {
 			DTW_checkSlopeConstraints (me, band, slope);
@@ -1198,6 +1292,10 @@ autoPolygon DTW_to_Polygon (DTW me, double band, int slope) {
     }
 }
 
+autoPolygon DTW_to_Polygon (DTW me, double band, int slope) {
+	return SampledXY_to_Polygon_dtwBand (me, band, slope);
+}
+
 autoMatrix DTW_Polygon_to_Matrix_cumulativeDistances (DTW me, Polygon thee, int localSlope) {
     try {
         autoMatrix cumulativeDistances;
@@ -1217,223 +1315,694 @@ void DTW_findPath_bandAndSlope (DTW me, double sakoeChibaBand, int localSlope, a
     }
 }
 
-void DTW_Polygon_findPathInside (DTW me, Polygon thee, int localSlope, autoMatrix *cumulativeDists) {
-	try {
-		const double slopes [5] = { DTW_BIG, DTW_BIG, 3.0, 2.0, 1.5 };
-		// if localSlope == 1 start of path is within 10% of minimum duration. Starts farther away
-		integer delta_xy = std::min (my nx, my ny) / 10; // if localSlope == 1 start within 10% of
+static void DTW_Band_findBestPredecessor (DTW_Band *band, integer i, integer j, int localSlope) {
+	double g, gmin = DTW_BIG;
+	integer direction = 0;
+	if (band -> isReachable (i - 1, j - 1)) {
+		gmin = band -> delta (i - 1, j - 1) + 2.0 * band -> distance (i, j);
+		direction = DTW_XANDY;
+	} else if (band -> isReachable (i, j - 1)) {
+		gmin = band -> delta (i, j - 1) + band -> distance (i, j);
+		direction = DTW_X;
+	} else if (band -> isReachable (i - 1, j)) {
+		gmin = band -> delta (i - 1, j) + band -> distance (i, j);
+		direction = DTW_Y;
+	} else {
+		return;   // an isolated point
+	}
+
+	switch (localSlope) {
+	case 1:  {   // no restriction
+		if (band -> isReachable (i, j - 1) && ((g = band -> delta (i, j - 1) + band -> distance (i, j)) < gmin)) {
+			gmin = g;
+			direction = DTW_X;
+		}
+		if (band -> isReachable (i - 1, j) && ((g = band -> delta (i - 1, j) + band -> distance (i, j)) < gmin)) {
+			gmin = g;
+			direction = DTW_Y;
+		}
+	}
+	break;
+
+	/*
+		Sakoe & Chiba (1978) define the slope constraint measure as P = n / m, 
+			where n is the number of steps in the diagonal and 
+			m the number of steps in one of the other directions.
+			
+		P = 1/2
+	*/
+	case 2: {   // P = 1/2
+		if (j >= 4 && band -> isReachable (i - 1, j - 3) && band -> getPsi (i, j - 1) == DTW_X && band -> getPsi (i, j - 2) == DTW_XANDY &&
+			(g = band -> delta (i - 1, j - 3) + 2.0 * band -> distance (i, j - 2) + band -> distance (i, j - 1) + band -> distance (i, j)) < gmin) {
+			gmin = g;
+			direction = DTW_X;
+		}
+		if (j >= 3 && band -> isReachable (i - 1, j - 2) && band -> getPsi (i, j - 1) == DTW_XANDY &&
+			(g = band -> delta (i - 1, j - 2) + 2.0 * band -> distance (i, j - 1) + band -> distance (i, j)) < gmin) {
+			gmin = g;
+			direction = DTW_X;
+		}
+		if (i >= 3 && band -> isReachable (i - 2, j - 1) && band -> getPsi (i - 1, j) == DTW_XANDY &&
+			(g = band -> delta (i - 2, j - 1) + 2.0 * band -> distance (i - 1, j) + band -> distance (i, j)) < gmin) {
+			gmin = g;
+			direction = DTW_Y;
+		}
+		if (i >= 4 && band -> isReachable (i - 3, j - 1) && band -> getPsi (i - 1, j) == DTW_Y && band -> getPsi (i - 2, j) == DTW_XANDY &&
+			(g = band -> delta (i - 3, j - 1) + 2.0 * band -> distance (i - 2, j) + band -> distance (i - 1, j) + band -> distance (i, j)) < gmin) {
+			gmin = g;
+			direction = DTW_Y;
+		}
+	}
+	break;
+
+	// P = 1
+
+	case 3: {
+		if (j >= 3 && band -> isReachable (i - 1, j - 2) && band -> getPsi (i, j - 1) == DTW_XANDY &&
+				(g = band -> delta (i - 1, j - 2) + 2.0 * band -> distance (i, j - 1) + band -> distance (i, j)) < gmin)
+		{
+			gmin = g;
+			direction = DTW_X;
+		}
+		if (i >= 3 && band -> isReachable (i - 2, j - 1) && band -> getPsi (i - 1, j) == DTW_XANDY &&
+				(g = band -> delta (i - 2, j - 1) + 2.0 * band -> distance (i - 1, j) + band -> distance (i, j)) < gmin)
+		{
+			gmin = g;
+			direction = DTW_Y;
+		}
+	}
+	break;
+
+	// P = 2
+
+	case 4: {
+		if (i >= 3 && j >= 4 && band -> isReachable (i - 2, j - 3) && band -> getPsi (i, j - 1) == DTW_XANDY && band -> getPsi (i - 1, j - 2) == DTW_XANDY &&
+				(g = band -> delta (i - 2, j - 3) + 2.0 * band -> distance (i - 1, j - 2) + 2.0 * band -> distance (i, j - 1) + band -> distance (i, j)) < gmin)
+		{
+			gmin = g;
+			direction = DTW_X;
+		}
+		if (i >= 4 && j >= 3 && band -> isReachable (i - 3, j - 2) && band -> getPsi (i - 1, j) == DTW_XANDY && band -> getPsi (i - 2, j - 1) == DTW_XANDY &&
+				(g = band -> delta (i - 3, j - 2) + 2.0 * band -> distance (i - 2, j - 1) + 2.0 * band -> distance (i - 1, j) + band -> distance (i, j)) < gmin)
+		{
+			gmin = g;
+			direction = DTW_Y;
+		}
+	}
+	break;
+	default:
+	break;
+	}
+	Melder_assert (direction != 0);
+	band -> psi [band -> offset [j] + i] = direction;
+	band -> delta (i, j) = gmin;
+}
 
-		Melder_require (localSlope > 0 && localSlope < 5,
-			U"Local slope parameter ", localSlope, U" not supported.");
+/*
+	The threads of the anti-diagonal traversal wait for each other after each anti-diagonal.
+*/
+struct DTW_Barrier {
+	integer numberOfThreads;
+	std::atomic <integer> numberOfArrivals = 0;
+	std::atomic <integer> generation = 0;
+
+	DTW_Barrier (integer initialNumberOfThreads) : numberOfThreads (initialNumberOfThreads) { }
+	bool wait (std::atomic <bool> const& errorFlag) {
+		const integer myGeneration = generation;
+		if (++ numberOfArrivals == numberOfThreads) {
+			numberOfArrivals = 0;
+			generation ++;
+			return true;
+		}
+		while (generation == myGeneration) {
+			if (errorFlag)
+				return false;   // another thread has given up, so we will never be released
+			std::this_thread::yield ();
+		}
+		return true;
+	}
+};
 
-		autoMAT delta = copy_MAT (my z.get());
-		autoINTMAT psi = zero_INTMAT (my ny, my nx);
+/*
+	A cell only depends on cells with a smaller i + j. All cells on one anti-diagonal can therefore be
+	calculated at the same time, after the previous anti-diagonals have been finished.
+	The threads are started once; each takes its own share of every anti-diagonal.
+*/
+static void DTW_Band_forwardPass (DTW_Band *band, int localSlope) {
+	const integer nx = band -> nx, ny = band -> ny;
+	autoMelderProgress progress (U"Find path");
+	integer maximumBandWidth = 0;
+	for (integer j = 1; j <= nx; j ++)
+		maximumBandWidth = std::max (maximumBandWidth, band -> rowTo [j] - band -> rowFrom [j] + 1);
+	constexpr integer thresholdNumberOfCellsPerThread = 2000;
+	const integer numberOfThreads = MelderThread_computeNumberOfThreads (maximumBandWidth, thresholdNumberOfCellsPerThread);
+	/*
+		With a single thread the column order is faster, because it is kinder to the cache.
+	*/
+	if (band -> isMonotone () && numberOfThreads > 1) {
+		std::atomic <bool> errorFlag = false;
+		DTW_Barrier barrier (numberOfThreads);
 		/*
-			Start by making the outside unreachable.
+			MelderThread_run divides the "elements" 1 .. maximumBandWidth over exactly 'numberOfThreads' threads;
+			a thread with the elements 'firstShare' .. 'lastShare' computes the corresponding proportion of each anti-diagonal.
 		*/
-		for (integer j = 1; j <= my nx; j ++)
-			psi [1] [j] = DTW_UNREACHABLE;
-		for (integer i = 1; i <= my ny; i ++)
-			psi [i] [1] = DTW_UNREACHABLE;
+		MelderThread_run (& errorFlag, maximumBandWidth, thresholdNumberOfCellsPerThread,
+			[&] (integer threadNumber, integer firstShare, integer lastShare) {
+				try {
+					integer jfrom = 2, jto = 1;
+					for (integer diagonal = 4; diagonal <= nx + ny; diagonal ++) {
+						while (jfrom <= nx && jfrom + band -> rowTo [jfrom] < diagonal)
+							jfrom ++;
+						while (jto < nx && jto + 1 + std::max (band -> rowFrom [jto + 1], 2_integer) <= diagonal)
+							jto ++;
+						const integer numberOfCells = jto - jfrom + 1;
+						if (numberOfCells > 0) {
+							const integer myFirstColumn = jfrom + (firstShare - 1) * numberOfCells / maximumBandWidth;
+							const integer myLastColumn = jfrom - 1 + lastShare * numberOfCells / maximumBandWidth;
+							for (integer j = myFirstColumn; j <= myLastColumn; j ++)
+								if (band -> isReachable (diagonal - j, j))
+									DTW_Band_findBestPredecessor (band, diagonal - j, j, localSlope);
+							if (threadNumber == 0 && diagonal % 100 == 0)
+								Melder_progress (0.999 * diagonal / (nx + ny), U"Calculate time warp: anti-diagonal ", diagonal, U" from ", nx + ny, U".");
+						}
+						if (! barrier.wait (errorFlag))
+							return;
+					}
+				} catch (MelderError) {
+					errorFlag = true;
+				}
+			}
+		);
+	} else {
+		for (integer j = 2; j <= nx; j ++) {
+			for (integer i = std::max (band -> rowFrom [j], 2_integer); i <= band -> rowTo [j]; i ++)
+				if (band -> isReachable (i, j))
+					DTW_Band_findBestPredecessor (band, i, j, localSlope);
+			if (j % 10 == 2)
+				Melder_progress (0.999 * j / nx, U"Calculate time warp: frame ", j, U" from ", nx, U".");
+		}
+	}
+}
+
+/*
+	The cumulative distances of column j, which only depend on those of the three columns before it.
+	Returns the smallest cumulative distance in the column.
+*/
+static double DTW_Band_forwardColumn (DTW_Band *band, integer j, int localSlope) {
+	double columnMinimum = DTW_BIG;
+	for (integer i = std::max (band -> rowFrom [j], 2_integer); i <= band -> rowTo [j]; i ++) {
+		if (band -> isReachable (i, j)) {
+			DTW_Band_findBestPredecessor (band, i, j, localSlope);
+			columnMinimum = std::min (columnMinimum, band -> delta (i, j));
+		}
+	}
+	return columnMinimum;
+}
 
+/*
+	The first row and column are unreachable, except for their begin parts.
+	The columns are initialized from left to right; the cumulative distance along the first row
+	is carried from one column to the next in 'firstRowCumulative'.
+*/
+static void DTW_Band_initializeColumn (DTW_Band *band, integer ix, int localSlope, double *firstRowCumulative) {
+	const integer nx = band -> nx, ny = band -> ny;
+	const double slopes [5] = { DTW_BIG, DTW_BIG, 3.0, 2.0, 1.5 };
+	// if localSlope == 1 start of path is within 10% of minimum duration. Starts farther away
+	integer delta_xy = std::min (nx, ny) / 10; // if localSlope == 1 start within 10% of
+
+	for (integer iy = band -> rowFrom [ix]; iy <= band -> rowTo [ix]; iy ++) {
+		band -> delta (iy, ix) = band -> distance (iy, ix);
+		band -> psi [band -> offset [ix] + iy] = ( ix == 1 || iy == 1 ? DTW_UNREACHABLE : 0 );
+	}
+	if (ix == 1) {
 		/*
 			Make begin part of first column reachable.
 		*/
 		const integer rowto = ( localSlope != 1 ? Melder_ifloor (slopes [localSlope]) + 1 : delta_xy );
-		for (integer iy = 2; iy <= rowto; iy ++) {
+		double cumulative = band -> distance (1, 1);
+		for (integer iy = 2; iy <= std::min (rowto, band -> rowTo [1]); iy ++) {
 			if (localSlope != 1) {
-				delta [iy] [1] = delta [iy - 1] [1] + my z [iy] [1];
-				psi [iy] [1] = DTW_Y;
+				band -> delta (iy, 1) = cumulative += band -> distance (iy, 1);
+				band -> psi [band -> offset [1] + iy] = DTW_Y;
 			} else {
-				psi [iy] [1] = DTW_START;   // will be adapted by DTW_Polygon_setUnreachableParts
+				band -> psi [band -> offset [1] + iy] = DTW_START;
 			}
 		}
-		/*
-			Make begin part of first row reachable.
-		*/
-		const integer colto = ( localSlope != 1 ? Melder_ifloor (slopes [localSlope]) + 1 : delta_xy );
-		for (integer ix = 2; ix <= colto; ix ++) {
-			if (localSlope != 1) {
-				delta [1] [ix] = delta [1] [ix -1] + my z [1] [ix];
-				psi [1] [ix] = DTW_X;
-			} else {
-				psi [1] [ix] = DTW_START;   // will be adapted by DTW_Polygon_setUnreachableParts
-			}
+		*firstRowCumulative = band -> distance (1, 1);
+		return;
+	}
+	/*
+		Make begin part of first row reachable.
+	*/
+	const integer colto = ( localSlope != 1 ? Melder_ifloor (slopes [localSlope]) + 1 : delta_xy );
+	if (ix > colto)
+		return;
+	if (localSlope != 1)
+		*firstRowCumulative += band -> distance (1, ix);
+	if (! band -> contains (1, ix))
+		return;
+	if (localSlope != 1) {
+		band -> delta (1, ix) = *firstRowCumulative;
+		band -> psi [band -> offset [ix] + 1] = DTW_X;
+	} else {
+		band -> psi [band -> offset [ix] + 1] = DTW_START;
+	}
+}
+
+static void DTW_Band_initialize (DTW_Band *band, int localSlope) {
+	Melder_require (localSlope > 0 && localSlope < 5,
+		U"Local slope parameter ", localSlope, U" not supported.");
+	double firstRowCumulative;
+	for (integer ix = 1; ix <= band -> nx; ix ++)
+		DTW_Band_initializeColumn (band, ix, localSlope, & firstRowCumulative);
+}
+
+static double DTW_Band_getMinimumAtEnd (DTW_Band *band, integer *out_iy) {
+	const integer nx = band -> nx, ny = band -> ny;
+	integer iy = ny;
+	double minimum = ( band -> contains (iy, nx) ? band -> delta (iy, nx) : band -> distance (iy, nx) );
+	for (integer i = ny - 1; i > 0; i --) {
+		if (! band -> isReachable (i, nx)) {
+			break;   // we're in unreachable places
+		} else if (band -> delta (i, nx) < minimum) {
+			minimum = band -> delta (iy = i, nx);
 		}
+	}
+	if (out_iy)
+		*out_iy = iy;
+	return minimum;
+}
 
-		/*
-			Now we can set the unreachable parts from the Polygon.
-		*/
-		DTW_Polygon_setUnreachableParts (me, thee, psi.get());
+/*
+	Follow the directions back from (iy, nx). The path ends up in path [1 .. pathLength].
+*/
+static integer DTW_Band_traceBack (DTW_Band *band, integer iy, autovector <structDTW_Path>& path) {
+	const integer maximumPathLength = band -> nx + band -> ny - 1;
+	path.resize (maximumPathLength);
+	integer pathIndex = maximumPathLength;
+	path [pathIndex]. y = iy;
+	integer ix = path [pathIndex]. x = band -> nx;
 
-		/*
-			Forward pass.
-		*/
-		integer numberOfIsolatedPoints = 0;
-		autoMelderProgress progress (U"Find path");
-		for (integer j = 2; j <= my nx; j ++) {
-			for (integer i = 2; i <= my ny; i ++) {
-				if (! DTW_ISREACHABLE (i, j))
-					continue;
-				double g, gmin = DTW_BIG;
-				integer direction = 0;
-				if (DTW_ISREACHABLE (i - 1, j - 1)) {
-					gmin = delta [i - 1] [j - 1] + 2.0 * my z [i] [j];
-					direction = DTW_XANDY;
-				} else if (DTW_ISREACHABLE (i, j - 1)) {
-					gmin = delta [i] [j - 1] + my z [i] [j];
-					direction = DTW_X;
-				} else if (DTW_ISREACHABLE (i - 1, j)) {
-					gmin = delta [i - 1] [j] + my z [i] [j];
-					direction = DTW_Y;
-				} else {
-					numberOfIsolatedPoints ++;
-					continue;
-				}
+	/*
+		Fill path backwards.
+	*/
+	while (ix > 1) {
+		const integer direction = band -> getPsi (iy, ix);
+		if (direction == DTW_XANDY) {
+			ix --;
+			iy --;
+		} else if (direction == DTW_X) {
+			ix --;
+		} else if (direction == DTW_Y) {
+			iy --;
+		} else if (direction == DTW_START) {
+			break;
+		}
+		if (pathIndex < 2 || iy < 1)
+			break;
+		path [-- pathIndex]. x = ix;
+		path [pathIndex]. y = iy;
+	}
 
-				switch (localSlope) {
-				case 1:  {   // no restriction
-					if (DTW_ISREACHABLE (i, j - 1) && ((g = delta [i] [j - 1] + my z [i] [j]) < gmin)) {
-						gmin = g;
-						direction = DTW_X;
-					}
-					if (DTW_ISREACHABLE (i - 1, j) && ((g = delta [i - 1] [j] + my z [i] [j]) < gmin)) {
-						gmin = g;
-						direction = DTW_Y;
-					}
-				}
-				break;
+	const integer pathLength = maximumPathLength - pathIndex + 1;
+	if (pathIndex > 1)
+		for (integer j = 1; j <= pathLength; j ++)
+			path [j] = path [pathIndex ++];
+	path.resize (pathLength);
+	return pathLength;
+}
 
-				/*
-					Sakoe & Chiba (1978) define the slope constraint measure as P = n / m, 
-						where n is the number of steps in the diagonal and 
-						m the number of steps in one of the other directions.
-						
-					P = 1/2
-				*/
-				case 2: {   // P = 1/2
-					if (j >= 4 && DTW_ISREACHABLE (i - 1, j - 3) && psi [i] [j - 1] == DTW_X && psi [i] [j - 2] == DTW_XANDY &&
-						(g = delta [i-1] [j-3] + 2.0 * my z [i] [j-2] + my z [i] [j-1] + my z [i] [j]) < gmin) {
-						gmin = g;
-						direction = DTW_X;
-					}
-					if (j >= 3 && DTW_ISREACHABLE (i - 1, j - 2) && psi [i] [j - 1] == DTW_XANDY &&
-						(g = delta [i - 1] [j - 2] + 2.0 * my z [i] [j - 1] + my z [i] [j]) < gmin) {
-						gmin = g;
-						direction = DTW_X;
-					}
-					if (i >= 3 && DTW_ISREACHABLE (i - 2, j - 1) && psi [i - 1] [j] == DTW_XANDY &&
-						(g = delta [i - 2] [j - 1] + 2.0 * my z [i - 1] [j] + my z [i] [j]) < gmin) {
-						gmin = g;
-						direction = DTW_Y;
-					}
-					if (i >= 4 && DTW_ISREACHABLE (i - 3, j - 1) && psi [i - 1] [j] == DTW_Y && psi [i - 2] [j] == DTW_XANDY &&
-						(g = delta [i-3] [j-1] + 2.0 * my z [i-2] [j] + my z [i-1] [j] + my z [i] [j]) < gmin) {
-						gmin = g;
-						direction = DTW_Y;
-					}
-				}
-				break;
+static void DTW_Band_findPath (DTW_Band *band, DTW me, int localSlope, autoMatrix *cumulativeDists) {
+	DTW_Band_initialize (band, localSlope);
+	DTW_Band_forwardPass (band, localSlope);
 
-				// P = 1
+	/*
+		Find minimum at end of path and trace back.
+	*/
+	integer iy;
+	const double minimum = DTW_Band_getMinimumAtEnd (band, & iy);
+	my weightedDistance = minimum / (my nx + my ny);
+	my pathLength = DTW_Band_traceBack (band, iy, my path);
+	DTW_Path_recode (me);
+	if (cumulativeDists) {
+		autoMatrix him = Matrix_create (my xmin, my xmax, my nx, my dx, my x1,
+				my ymin, my ymax, my ny, my dy, my y1);
+		his z.all()  <<=  my z.all();
+		for (integer jx = 1; jx <= my nx; jx ++)
+			for (integer jy = band -> rowFrom [jx]; jy <= band -> rowTo [jx]; jy ++)
+				his z [jy] [jx] = band -> delta (jy, jx);
+		*cumulativeDists = him.move();
+	}
+}
 
-				case 3: {
-					if (j >= 3 && DTW_ISREACHABLE (i - 1, j - 2) && psi [i] [j - 1] == DTW_XANDY &&
-							(g = delta [i - 1] [j - 2] + 2.0 * my z [i] [j - 1] + my z [i] [j]) < gmin)
-					{
-						gmin = g;
-						direction = DTW_X;
-					}
-					if (i >= 3 && DTW_ISREACHABLE (i - 2, j - 1) && psi [i - 1] [j] == DTW_XANDY &&
-							(g = delta [i - 2] [j - 1] + 2.0 * my z [i - 1] [j] + my z [i] [j]) < gmin)
-					{
-						gmin = g;
-						direction = DTW_Y;
-					}
-				}
-				break;
+void DTW_Polygon_findPathInside (DTW me, Polygon thee, int localSlope, autoMatrix *cumulativeDists) {
+	try {
+		DTW_Band band;
+		DTW_Polygon_setBand (me, thee, & band);
+		band.allocate (my z.get());
+		DTW_Band_findPath (& band, me, localSlope, cumulativeDists);
+	} catch (MelderError) {
+		Melder_throw (me, U": cannot find path.");
+	}
+}
+
+void DTW_getBandRows (SampledXY me, double sakoeChibaBand, int localSlope, INTVEC const& rowFrom, INTVEC const& rowTo) {
+	try {
+		Melder_assert (rowFrom.size == my nx && rowTo.size == my nx);
+		autoPolygon polygon = SampledXY_to_Polygon_dtwBand (me, sakoeChibaBand, localSlope);
+		DTW_Band band;
+		DTW_Polygon_setBand (me, polygon.get(), & band);
+		rowFrom  <<=  band.rowFrom.all();
+		rowTo  <<=  band.rowTo.all();
+	} catch (MelderError) {
+		Melder_throw (U"Cannot determine the band.");
+	}
+}
 
-                // P = 2
+double DTW_getWeightedDistance_bandRows (SampledXY me, constINTVEC const& rowFrom, constINTVEC const& rowTo,
+	int localSlope, double maximumWeightedDistance,
+	std::function <void (integer ix, integer fromRow, integer toRow, VEC const& distances)> const& getColumnDistances)
+{
+	Melder_assert (rowFrom.size == my nx && rowTo.size == my nx);
+	Melder_require (localSlope > 0 && localSlope < 5,
+		U"Local slope parameter ", localSlope, U" not supported.");
+	DTW_Band band;
+	band.init (my nx, my ny);
+	band.rowFrom.all()  <<=  rowFrom;
+	band.rowTo.all()  <<=  rowTo;
+	band.allocateColumns (4);   // DTW_Band_findBestPredecessor looks back at most three columns
+	/*
+		Paths may start anywhere in the first 'delta_xy' (slope 1) or four (other slopes) columns.
+		From column 'firstColumnOnAllPaths' on, every path has a cell in each column and the cumulative distances only grow,
+		so we may stop as soon as all cells in a column exceed 'maximumCumulativeDistance'.
+	*/
+	const integer firstColumnOnAllPaths = std::max (std::min (my nx, my ny) / 10, 4_integer) + 1;
+	const double maximumCumulativeDistance = ( maximumWeightedDistance > 0.0 ? maximumWeightedDistance * (my nx + my ny) : DTW_BIG );
+	double firstRowCumulative;
+	for (integer ix = 1; ix <= my nx; ix ++) {
+		const integer fromRow = band.rowFrom [ix], toRow = band.rowTo [ix];
+		if (toRow >= fromRow)
+			getColumnDistances (ix, fromRow, toRow, band.bandDistances.part (band.offset [ix] + fromRow, band.offset [ix] + toRow));
+		DTW_Band_initializeColumn (& band, ix, localSlope, & firstRowCumulative);
+		if (ix == 1)
+			continue;
+		const double columnMinimum = DTW_Band_forwardColumn (& band, ix, localSlope);
+		if (ix >= firstColumnOnAllPaths && columnMinimum > maximumCumulativeDistance)
+			return undefined;
+	}
+	const double weightedDistance = DTW_Band_getMinimumAtEnd (& band, nullptr) / (my nx + my ny);
+	return ( maximumWeightedDistance > 0.0 && weightedDistance > maximumWeightedDistance ? undefined : weightedDistance );
+}
 
-				case 4: {
-					if (i >= 3 && j >= 4 && DTW_ISREACHABLE (i - 2, j - 3) && psi [i] [j - 1] == DTW_XANDY && psi [i - 1] [j - 2] == DTW_XANDY &&
-							(g = delta [i-2] [j-3] + 2.0 * my z [i-1] [j-2] + 2.0 * my z [i] [j-1] + my z [i] [j]) < gmin)
-					{
-						gmin = g;
-						direction = DTW_X;
-					}
-					if (i >= 4 && j >= 3 && DTW_ISREACHABLE (i - 3, j - 2) && psi [i - 1] [j] == DTW_XANDY && psi [i - 2] [j - 1] == DTW_XANDY &&
-							(g = delta [i-3] [j-2] + 2.0 * my z [i-2] [j-1] + 2.0 * my z [i-1] [j] + my z [i] [j]) < gmin)
-					{
-						gmin = g;
-						direction = DTW_Y;
-					}
-				}
-				break;
-				default:
-				break;
-				}
-				Melder_assert (direction != 0);
-				psi [i] [j] = direction;
-				delta [i] [j] = gmin;
+double DTW_getWeightedDistance_bandAndSlope (DTW me, double sakoeChibaBand, int localSlope, double maximumWeightedDistance) {
+	try {
+		autoINTVEC rowFrom = raw_INTVEC (my nx), rowTo = raw_INTVEC (my nx);
+		DTW_getBandRows (me, sakoeChibaBand, localSlope, rowFrom.get(), rowTo.get());
+		return DTW_getWeightedDistance_bandRows (me, rowFrom.get(), rowTo.get(), localSlope, maximumWeightedDistance,
+			[&] (integer ix, integer fromRow, integer toRow, VEC const& distances) {
+				for (integer iy = fromRow; iy <= toRow; iy ++)
+					distances [iy - fromRow + 1] = my z [iy] [ix];
 			}
-			if (j % 10 == 2)
-				Melder_progress (0.999 * j / my nx, U"Calculate time warp: frame ", j, U" from ", my nx, U".");
-		}
+		);
+	} catch (MelderError) {
+		Melder_throw (me, U": cannot determine the distance.");
+	}
+}
 
-		/*
-			Find minimum at end of path and trace back.
-		*/
-		integer iy = my ny;
-		double minimum = delta [iy] [my nx];
-		for (integer i = my ny - 1; i > 0; i --) {
-			if (! DTW_ISREACHABLE (i, my nx)) {
-				break;   // we're in unreachable places
-			} else if (delta [i] [my nx] < minimum) {
-				minimum = delta [iy = i] [my nx];
+/*
+	The distances inside the band, with the same metric as Matrices_to_DTW, stored in the band itself.
+	For the Euclidean metric the distances follow from the inner products |a|^2 + |b|^2 - 2 a.b,
+	which are calculated for blocks of columns at a time as a matrix product.
+*/
+static void Matrices_into_DTW_Band_distances (Matrix me, Matrix thee, DTW_Band *band, double metric) {
+	Melder_assert (band -> bandDistances.size == band -> cumulative.size);
+	if (metric == 2.0) {
+		constexpr integer blockSize = 64;
+		const integer numberOfBlocks = (thy nx - 1) / blockSize + 1;
+		autoMAT a = transpose_MAT (my z.get());
+		autoMAT b = transpose_MAT (thy z.get());
+		autoVEC asq = raw_VEC (my nx), bsq = raw_VEC (thy nx);
+		for (integer i = 1; i <= my nx; i ++)
+			asq [i] = NUMsum2 (a.row (i));
+		for (integer j = 1; j <= thy nx; j ++)
+			bsq [j] = NUMsum2 (b.row (j));
+		integer maximumNumberOfRows = 0;
+		for (integer iblock = 1; iblock <= numberOfBlocks; iblock ++) {
+			const integer jfrom = (iblock - 1) * blockSize + 1, jto = std::min (iblock * blockSize, thy nx);
+			integer rowFrom = my nx, rowTo = 1;
+			for (integer j = jfrom; j <= jto; j ++) {
+				rowFrom = std::min (rowFrom, band -> rowFrom [j]);
+				rowTo = std::max (rowTo, band -> rowTo [j]);
 			}
+			maximumNumberOfRows = std::max (maximumNumberOfRows, rowTo - rowFrom + 1);
 		}
 
-		integer pathIndex = my nx + my ny - 1;   // maximum path length
-		my weightedDistance = minimum / (my nx + my ny);
-		my path [pathIndex]. y = iy;
-		integer ix = my path [pathIndex]. x = my nx;
+		MelderThread_PARALLELIZE (numberOfBlocks, 1)
 
-		/*
-			Fill path backwards.
-		*/
-		while (ix > 1) {
-			if (psi [iy] [ix] == DTW_XANDY) {
-				ix --;
-				iy --;
-			} else if (psi [iy] [ix] == DTW_X) {
-				ix --;
-			} else if (psi [iy] [ix] == DTW_Y) {
-				iy --;
-			} else if (psi [iy] [ix] == DTW_START) {
-				break;
+		autoMAT innerProducts = raw_MAT (std::max (maximumNumberOfRows, 1_integer), blockSize);
+
+		MelderThread_FOR (iblock) {
+			const integer jfrom = (iblock - 1) * blockSize + 1, jto = std::min (iblock * blockSize, thy nx);
+			integer rowFrom = my nx, rowTo = 1;
+			for (integer j = jfrom; j <= jto; j ++) {
+				rowFrom = std::min (rowFrom, band -> rowFrom [j]);
+				rowTo = std::max (rowTo, band -> rowTo [j]);
+			}
+			if (rowFrom > rowTo)
+				continue;
+			MATVU ab = innerProducts.part (1, rowTo - rowFrom + 1, 1, jto - jfrom + 1);
+			mul_MAT_out (ab, a.horizontalBand (rowFrom, rowTo), b.horizontalBand (jfrom, jto).transpose());
+			for (integer j = jfrom; j <= jto; j ++) {
+				for (integer i = band -> rowFrom [j]; i <= band -> rowTo [j]; i ++) {
+					const double d2 = asq [i] + bsq [j] - 2.0 * ab [i - rowFrom + 1] [j - jfrom + 1];
+					band -> bandDistances [band -> offset [j] + i] = sqrt (std::max (d2, 0.0)) / my ny;
+				}
+			}
+		} MelderThread_ENDFOR
+	} else {
+		MelderThread_PARALLELIZE (thy nx, 10)
+		MelderThread_FOR (j) {
+			for (integer i = band -> rowFrom [j]; i <= band -> rowTo [j]; i ++) {
+				double dmax = 0.0, d = 0.0;
+				for (integer k = 1; k <= my ny; k ++) {
+					const double dtmp = fabs (my z [k] [i] - thy z [k] [j]);
+					if (dtmp > dmax)
+						dmax = dtmp;
+				}
+				if (dmax > 0) {
+					for (integer k = 1; k <= my ny; k ++) {
+						const double dtmp = fabs (my z [k] [i] - thy z [k] [j]) / dmax;
+						d +=  pow (dtmp, metric);
+					}
+				}
+				d = dmax * pow (d, 1.0 / metric);
+				band -> bandDistances [band -> offset [j] + i] = d / my ny;
 			}
-			if (pathIndex < 2 || iy < 1)
-				break;
-			//Melder_assert (pathIndex > 1 && iy > 0);
-			my path [-- pathIndex]. x = ix;
-			my path [pathIndex]. y = iy;
+		} MelderThread_ENDFOR
+	}
+}
+
+/*
+	The path through a band whose distances were calculated from two matrices. Everything is stored in the band,
+	so the memory is proportional to the size of the band, not to the product of the numbers of frames.
+*/
+struct DTW_BandPath {
+	autovector <structDTW_Path> path;
+	integer pathLength = 0;
+	double weightedDistance = undefined;
+};
+
+static void Matrices_findPathInBand (Matrix me, Matrix thee, DTW_Band *band, int localSlope, double metric, DTW_BandPath *result) {
+	band -> allocate (constMATVU ());
+	Matrices_into_DTW_Band_distances (me, thee, band, metric);
+	DTW_Band_initialize (band, localSlope);
+	DTW_Band_forwardPass (band, localSlope);
+	integer iy;
+	const double minimum = DTW_Band_getMinimumAtEnd (band, & iy);
+	result -> weightedDistance = minimum / (band -> nx + band -> ny);
+	result -> pathLength = DTW_Band_traceBack (band, iy, result -> path);
+}
+
+/*
+	The time domains and samplings of the DTW of two matrices, without its distances.
+*/
+static autoSampledXY Matrices_to_SampledXY_dtw (Matrix me, Matrix thee) {
+	autoSampledXY him = Thing_new (SampledXY);
+	SampledXY_init (him.get(), thy xmin, thy xmax, thy nx, thy dx, thy x1, my xmin, my xmax, my nx, my dx, my x1);
+	return him;
+}
+
+static void Matrices_setDTWBand_sakoeChiba (Matrix me, Matrix thee, double sakoeChibaBand, int slope, DTW_Band *band) {
+	autoSampledXY geometry = Matrices_to_SampledXY_dtw (me, thee);
+	autoPolygon polygon = SampledXY_to_Polygon_dtwBand (geometry.get(), sakoeChibaBand, slope);
+	DTW_Polygon_setBand (geometry.get(), polygon.get(), band);
+}
+
+static autoMatrix Matrix_averageColumnPairs (Matrix me) {
+	autoMatrix thee = Matrix_create (my xmin, my xmax, (my nx + 1) / 2, 2.0 * my dx, my x1 + 0.5 * my dx,
+			my ymin, my ymax, my ny, my dy, my y1);
+	for (integer j = 1; j <= thy nx; j ++) {
+		const integer jfrom = 2 * j - 1, jto = std::min (2 * j, my nx);
+		for (integer i = 1; i <= my ny; i ++)
+			thy z [i] [j] = ( jto > jfrom ? 0.5 * (my z [i] [jfrom] + my z [i] [jto]) : my z [i] [jfrom] );
+	}
+	return thee;
+}
+
+/*
+	Project the coarse path on a band with twice as many rows and columns and widen it by
+	'radius' cells in all directions.
+*/
+static void DTW_projectPathOnBand (DTW_BandPath const& coarse, integer radius, DTW_Band *band) {
+	const integer nx = band -> nx, ny = band -> ny;
+	autoINTVEC rowFrom = raw_INTVEC (nx), rowTo = raw_INTVEC (nx);
+	for (integer ix = 1; ix <= nx; ix ++) {
+		rowFrom [ix] = ny + 1;
+		rowTo [ix] = 0;
+	}
+	for (integer ipath = 1; ipath <= coarse.pathLength; ipath ++) {
+		const integer x = coarse.path [ipath]. x, y = coarse.path [ipath]. y;
+		for (integer ix = 2 * x - 1; ix <= std::min (2 * x, nx); ix ++) {
+			rowFrom [ix] = std::min (rowFrom [ix], 2 * y - 1);
+			rowTo [ix] = std::max (rowTo [ix], std::min (2 * y, ny));
 		}
+	}
+	/*
+		The coarse path does not necessarily start in the first column nor end in the last row.
+	*/
+	integer first = 1, last = nx;
+	while (first < nx && rowFrom [first] > rowTo [first])
+		first ++;
+	while (last > 1 && rowFrom [last] > rowTo [last])
+		last --;
+	for (integer ix = 1; ix < first; ix ++) {
+		rowFrom [ix] = 1;
+		rowTo [ix] = rowTo [first];
+	}
+	for (integer ix = last + 1; ix <= nx; ix ++) {
+		rowFrom [ix] = rowFrom [last];
+		rowTo [ix] = ny;
+	}
+	rowFrom [1] = 1;
+	rowTo [nx] = ny;
+	for (integer ix = 2; ix <= nx; ix ++) {   // the path is monotone, keep the band monotone as well
+		rowFrom [ix] = std::max (rowFrom [ix], rowFrom [ix - 1]);
+		rowTo [ix] = std::max (rowTo [ix], rowTo [ix - 1]);
+	}
+	for (integer ix = 1; ix <= nx; ix ++) {
+		band -> rowFrom [ix] = std::max (rowFrom [std::max (ix - radius, 1_integer)] - radius, 1_integer);
+		band -> rowTo [ix] = std::min (rowTo [std::min (ix + radius, nx)] + radius, ny);
+	}
+}
 
-		my pathLength = my nx + my ny - 1 - pathIndex + 1;
-		if (pathIndex > 1)
-			for (integer j = 1; j <= my pathLength; j ++)
-				my path [j] = my path [pathIndex ++];
-		my path.resize (my pathLength);   // maintain invariant
-		DTW_Path_recode (me);
-		if (cumulativeDists) {
-			autoMatrix him = Matrix_create (my xmin, my xmax, my nx, my dx, my x1,
-					my ymin, my ymax, my ny, my dy, my y1);
-			his z.all()  <<=  delta.all();
-			*cumulativeDists = him.move();
+/*
+	The band at each level follows from the path at the next coarser level.
+	Only one coarser band exists at a time, and no DTW object is created at any level.
+*/
+static void Matrices_setDTWBand_multiscale (Matrix me, Matrix thee, integer radius, double metric, DTW_Band *band) {
+	band -> init (thy nx, my nx);
+	const integer minimumNumberOfFrames = 2 * (radius + 2);
+	if (my nx > minimumNumberOfFrames && thy nx > minimumNumberOfFrames) {
+		autoMatrix meCoarse = Matrix_averageColumnPairs (me);
+		autoMatrix theeCoarse = Matrix_averageColumnPairs (thee);
+		DTW_BandPath coarsePath;
+		{// scope of the coarse band
+			DTW_Band coarseBand;
+			Matrices_setDTWBand_multiscale (meCoarse.get(), theeCoarse.get(), radius, metric, & coarseBand);
+			Matrices_findPathInBand (meCoarse.get(), theeCoarse.get(), & coarseBand, 1, metric, & coarsePath);
 		}
+		DTW_projectPathOnBand (coarsePath, radius, band);
+	}
+}
+
+/*
+	The DTW object itself has the full distance matrix; the cells outside the band are undefined.
+*/
+static autoDTW Matrices_DTW_Band_to_DTW (Matrix me, Matrix thee, DTW_Band *band, DTW_BandPath *bandPath) {
+	autoDTW him = DTW_create (my xmin, my xmax, my nx, my dx, my x1, thy xmin, thy xmax, thy nx, thy dx, thy x1);
+	his z.all()  <<=  undefined;
+	for (integer jx = 1; jx <= his nx; jx ++)
+		for (integer jy = band -> rowFrom [jx]; jy <= band -> rowTo [jx]; jy ++)
+			his z [jy] [jx] = band -> distance (jy, jx);
+	his weightedDistance = bandPath -> weightedDistance;
+	his pathLength = bandPath -> pathLength;
+	his path = std::move (bandPath -> path);
+	DTW_Path_recode (him.get());
+	return him;
+}
+
+static autoTable Matrices_DTW_Band_to_Table_path (Matrix me, Matrix thee, DTW_Band *band, DTW_BandPath *bandPath) {
+	const conststring32 columnNames [] = { U"frame1", U"frame2", U"time1", U"time2", U"distance", U"cumulativeDistance" };
+	autoTable him = Table_createWithColumnNames (bandPath -> pathLength, ARRAY_TO_STRVEC (columnNames));
+	for (integer ipath = 1; ipath <= bandPath -> pathLength; ipath ++) {
+		const integer iy = bandPath -> path [ipath]. y, ix = bandPath -> path [ipath]. x;
+		Table_setNumericValue (him.get(), ipath, 1, iy);
+		Table_setNumericValue (him.get(), ipath, 2, ix);
+		Table_setNumericValue (him.get(), ipath, 3, Sampled_indexToX (me, iy));
+		Table_setNumericValue (him.get(), ipath, 4, Sampled_indexToX (thee, ix));
+		Table_setNumericValue (him.get(), ipath, 5, band -> distance (iy, ix));
+		Table_setNumericValue (him.get(), ipath, 6, band -> delta (iy, ix));
+	}
+	return him;
+}
+
+autoDTW Matrices_to_DTW_band (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric) {
+	try {
+		Melder_require (thy ny == my ny,
+			U"Column sizes should be equal.");
+		DTW_Band band;
+		Matrices_setDTWBand_sakoeChiba (me, thee, sakoeChibaBand, slope, & band);
+		DTW_BandPath bandPath;
+		Matrices_findPathInBand (me, thee, & band, slope, metric, & bandPath);
+		return Matrices_DTW_Band_to_DTW (me, thee, & band, & bandPath);
 	} catch (MelderError) {
-		Melder_throw (me, U": cannot find path.");
+		Melder_throw (U"DTW not created from matrices.");
+	}
+}
+
+autoTable Matrices_to_Table_dtwPath_band (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric) {
+	try {
+		Melder_require (thy ny == my ny,
+			U"Column sizes should be equal.");
+		DTW_Band band;
+		Matrices_setDTWBand_sakoeChiba (me, thee, sakoeChibaBand, slope, & band);
+		DTW_BandPath bandPath;
+		Matrices_findPathInBand (me, thee, & band, slope, metric, & bandPath);
+		return Matrices_DTW_Band_to_Table_path (me, thee, & band, & bandPath);
+	} catch (MelderError) {
+		Melder_throw (U"DTW path not created from matrices.");
+	}
+}
+
+autoDTW Matrices_to_DTW_multiscale (Matrix me, Matrix thee, integer radius, double metric) {
+	try {
+		Melder_require (thy ny == my ny,
+			U"Column sizes should be equal.");
+		Melder_require (radius > 0,
+			U"The radius should be positive.");
+		DTW_Band band;
+		Matrices_setDTWBand_multiscale (me, thee, radius, metric, & band);
+		DTW_BandPath bandPath;
+		Matrices_findPathInBand (me, thee, & band, 1, metric, & bandPath);
+		return Matrices_DTW_Band_to_DTW (me, thee, & band, & bandPath);
+	} catch (MelderError) {
+		Melder_throw (U"DTW not created from matrices.");
+	}
+}
+
+autoTable Matrices_to_Table_dtwPath_multiscale (Matrix me, Matrix thee, integer radius, double metric) {
+	try {
+		Melder_require (thy ny == my ny,
+			U"Column sizes should be equal.");
+		Melder_require (radius > 0,
+			U"The radius should be positive.");
+		DTW_Band band;
+		Matrices_setDTWBand_multiscale (me, thee, radius, metric, & band);
+		DTW_BandPath bandPath;
+		Matrices_findPathInBand (me, thee, & band, 1, metric, & bandPath);
+		return Matrices_DTW_Band_to_Table_path (me, thee, & band, & bandPath);
+	} catch (MelderError) {
+		Melder_throw (U"DTW path not created from matrices.");
 	}
 }
 
@@ -28,6 +28,7 @@
 #include "Pitch.h"
 #include "DurationTier.h"
 #include "Sound.h"
+#include "Table.h"
 
 #include "DTW_def.h"
 
@@ -53,6 +54,30 @@ autoDTW DTW_swapAxes (DTW me);
 
 void DTW_findPath_bandAndSlope (DTW me, double sakoeChibaBand, int localSlope, autoMatrix *cumulativeDists);
 
+void DTW_checkSlopeConstraints (SampledXY me, double band, int slope);
+
+void DTW_getBandRows (SampledXY me, double sakoeChibaBand, int localSlope, INTVEC const& rowFrom, INTVEC const& rowTo);
+/*
+	DTW_findPath_bandAndSlope only uses the rows rowFrom [ix] .. rowTo [ix] of column ix.
+	Only the time domains and samplings of the DTW are used, so 'me' need not be a DTW.
+*/
+
+double DTW_getWeightedDistance_bandAndSlope (DTW me, double sakoeChibaBand, int localSlope, double maximumWeightedDistance);
+/*
+	The weighted distance of the path that DTW_findPath_bandAndSlope would find, without determining the path
+	(my path is not changed). If maximumWeightedDistance > 0, the calculation is abandoned as soon as the
+	weighted distance is known to exceed it, and the result is undefined.
+*/
+
+double DTW_getWeightedDistance_bandRows (SampledXY me, constINTVEC const& rowFrom, constINTVEC const& rowTo,
+	int localSlope, double maximumWeightedDistance,
+	std::function <void (integer ix, integer fromRow, integer toRow, VEC const& distances)> const& getColumnDistances);
+/*
+	As DTW_getWeightedDistance_bandAndSlope, for the band rows from DTW_getBandRows, but without a distance matrix:
+	the distances of the rows fromRow .. toRow of column ix are requested from getColumnDistances, column by column,
+	and only the last four columns of the band are kept. Can be called from a worker thread.
+*/
+
 void DTW_findPath (DTW me, bool matchStart, bool matchEnd, int slope); // deprecated
 /* Obsolete
 	Function:
@@ -115,6 +140,32 @@ autoMatrix DTW_Polygon_to_Matrix_cumulativeDistances (DTW me, Polygon thee, int
 
 autoDTW Matrices_to_DTW (Matrix me, Matrix thee, bool matchStart, bool matchEnd, int slope, double metric);
 
+autoDTW Matrices_to_DTW_band (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric);
+/*
+	As Matrices_to_DTW followed by DTW_findPath_bandAndSlope, but only the distances inside the
+	band are calculated (the other cells of the distance matrix are undefined) and the path finder
+	only stores the band.
+*/
+
+autoTable Matrices_to_Table_dtwPath_band (Matrix me, Matrix thee, double sakoeChibaBand, int slope, double metric);
+/*
+	The path of Matrices_to_DTW_band as a table with the columns
+	frame1, frame2, time1, time2, distance and cumulativeDistance,
+	without creating the nx by ny DTW: the memory is proportional to the size of the band.
+*/
+
+autoDTW Matrices_to_DTW_multiscale (Matrix me, Matrix thee, integer radius, double metric);
+/*
+	Coarse-to-fine path search (FastDTW, Salvador & Chan 2007): the path found for matrices with
+	half the number of columns, widened by 'radius' cells, defines the band at the next finer level.
+	Only the distances inside the final band are calculated.
+*/
+
+autoTable Matrices_to_Table_dtwPath_multiscale (Matrix me, Matrix thee, integer radius, double metric);
+/*
+	The path of Matrices_to_DTW_multiscale as a table, as in Matrices_to_Table_dtwPath_band.
+*/
+
 autoDTW Spectrograms_to_DTW (Spectrogram me, Spectrogram thee, bool matchStart, bool matchEnd, int slope, double metric);
 
 autoDTW Pitches_to_DTW (Pitch me, Pitch thee, double vuv_costs, double time_weight, bool matchStart, bool matchEnd, int slope);
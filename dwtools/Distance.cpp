@@ -43,22 +43,32 @@ autoDistance Configuration_to_Distance (Configuration me) {
 	try {
 		autoDistance thee = Distance_create (my numberOfRows);
 		TableOfReal_copyLabels (me, thee.get(), 1, -1);
+		const integer numberOfPoints = thy numberOfRows;
+		/*
+			Row i has numberOfPoints - i pairs; we handle rows k and numberOfPoints - k together,
+			so that every element of the parallel loop has the same amount of work.
+		*/
+		MelderThread_PARALLELIZE (numberOfPoints / 2, 50)
 		autoVEC dist = raw_VEC (my numberOfColumns);
-		for (integer i = 1; i <= thy numberOfRows - 1; i ++) {
-			for (integer j = i + 1; j <= thy numberOfColumns; j ++) {
-				dist.all()  <<=  my data.row (i)  -  my data.row (j);
-				abs_VEC_inout (dist.get());
-				const double dmax = NUMmax_e (dist.get());
-				double d = 0.0;
-				if (dmax > 0.0) {
-					dist.all()  /=  dmax;   // prevent overflow
-					power_VEC_inout (dist.get(), my metric);
-					d = NUMinner (my w.all(), dist.get());
-					d = dmax * pow (d, 1.0 / my metric);   // scale back
+		MelderThread_FOR (k) {
+			for (integer i = k; i <= numberOfPoints - k; i += numberOfPoints - 2 * k) {
+				for (integer j = i + 1; j <= numberOfPoints; j ++) {
+					dist.all()  <<=  my data.row (i)  -  my data.row (j);
+					abs_VEC_inout (dist.get());
+					const double dmax = NUMmax_e (dist.get());
+					double d = 0.0;
+					if (dmax > 0.0) {
+						dist.all()  /=  dmax;   // prevent overflow
+						power_VEC_inout (dist.get(), my metric);
+						d = NUMinner (my w.all(), dist.get());
+						d = dmax * pow (d, 1.0 / my metric);   // scale back
+					}
+					thy data [i] [j] = thy data [j] [i] = d;
 				}
-				thy data [i] [j] = thy data [j] [i] = d;
+				if (i == numberOfPoints - k)
+					break;
 			}
-		}
+		} MelderThread_ENDFOR
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no Distance created.");
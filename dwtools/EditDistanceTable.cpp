@@ -21,6 +21,7 @@
 */
 
 #include "EditDistanceTable.h"
+#include "Index.h"
 
 #include "oo_DESTROY.h"
 #include "EditDistanceTable_def.h"
@@ -324,6 +325,300 @@ autoTableOfReal EditCostsTable_to_TableOfReal (EditCostsTable me) {
 	}
 }
 
+/*
+	Symbols interned as integer codes (see StringsIndex_createFromSTRVEC): equal strings have equal codes.
+	For every code we look up its row and column in the EditCostsTable once, so that the costs of the
+	dynamic programming become array look-ups instead of string comparisons.
+*/
+struct EditCostsTable_Coded {
+	EditCostsTable costs;
+	autoINTVEC targetRow, sourceColumn;   // 0 if the symbol is not in the table
+	autoVEC insertion, deletion;
+
+	void init (EditCostsTable me, StringsIndex symbols) {
+		costs = me;
+		const integer numberOfCodes = ( symbols ? symbols -> classes -> size : 0 );
+		targetRow = raw_INTVEC (numberOfCodes);
+		sourceColumn = raw_INTVEC (numberOfCodes);
+		insertion = raw_VEC (numberOfCodes);
+		deletion = raw_VEC (numberOfCodes);
+		for (integer icode = 1; icode <= numberOfCodes; icode ++) {
+			const conststring32 symbol = StringsIndex_getClassLabelFromClassIndex (symbols, icode);
+			targetRow [icode] = EditCostsTable_getTargetIndex (me, symbol);
+			sourceColumn [icode] = EditCostsTable_getSourceIndex (me, symbol);
+			insertion [icode] = my data [( targetRow [icode] == 0 ? my numberOfRows - 1 : targetRow [icode] )] [my numberOfColumns];
+			deletion [icode] = my data [my numberOfRows] [( sourceColumn [icode] == 0 ? my numberOfColumns - 1 : sourceColumn [icode] )];
+		}
+	}
+	/*
+		Same as EditCostsTable_getSubstitutionCost.
+	*/
+	double substitution (integer targetCode, integer sourceCode) const {
+		const integer irow = targetRow [targetCode], icol = sourceColumn [sourceCode];
+		if (irow == 0 && icol == 0)
+			return ( targetCode == sourceCode ? costs -> data [costs -> numberOfRows - 1] [costs -> numberOfColumns - 1] :
+				costs -> data [costs -> numberOfRows] [costs -> numberOfColumns] );
+		return costs -> data [( irow == 0 ? costs -> numberOfRows - 1 : irow )] [( icol == 0 ? costs -> numberOfColumns - 1 : icol )];
+	}
+	/*
+		If all insertions and deletions cost the same positive amount c and no substitution is negative,
+		every path that leaves the diagonal band |j - i| <= k costs at least c * (2k + 2 - |m - n|).
+	*/
+	double uniformIndelCost () const {
+		if (insertion.size == 0)
+			return 0.0;
+		const double c = insertion [1];
+		if (! (c > 0.0))
+			return 0.0;
+		for (integer icode = 1; icode <= insertion.size; icode ++)
+			if (insertion [icode] != c || deletion [icode] != c)
+				return 0.0;
+		for (integer irow = 1; irow <= costs -> numberOfRows; irow ++)
+			for (integer icol = 1; icol <= costs -> numberOfColumns; icol ++)
+				if (costs -> data [irow] [icol] < 0.0)
+					return 0.0;
+		return c;
+	}
+};
+
+static autoStringsIndex STRVEC_internSymbols (constSTRVEC const& symbols) {
+	if (symbols.size == 0)
+		return autoStringsIndex ();   // a StringsIndex cannot be empty
+	return StringsIndex_createFromSTRVEC (symbols, kStrings_sorting::ALPHABETICAL);
+}
+
+/*
+	The edit distance between the coded target [1..n] and source [1..m], with only the cells
+	max (0, i - k) <= j <= min (m, i + k) of the dynamic programming table computed, two rows at a time.
+	The arithmetic is the same as in EditDistanceTable_findPath.
+	Returns +infinity if the band does not contain the end point.
+*/
+static double EditCostsTable_Coded_getBandedDistance (const EditCostsTable_Coded *me, constINTVEC const& target, constINTVEC const& source,
+	integer k, VEC previous, VEC current)
+{
+	const integer n = target.size, m = source.size;
+	if (integer_abs (m - n) > k)
+		return INFINITY;
+	previous [1] = 0.0;
+	for (integer j = 1; j <= std::min (m, k); j ++)
+		previous [j + 1] = previous [j] + my deletion [source [j]];
+	if (k + 1 <= m)
+		previous [k + 2] = INFINITY;
+	for (integer i = 1; i <= n; i ++) {
+		const integer jfrom = std::max (0_integer, i - k), jto = std::min (m, i + k);
+		const double insertion = my insertion [target [i]];
+		if (jfrom > 0)
+			current [jfrom] = INFINITY;   // the cell left of the band
+		for (integer j = jfrom; j <= jto; j ++) {
+			if (j == 0) {
+				current [1] = previous [1] + insertion;
+				continue;
+			}
+			const double left = current [j] + insertion;
+			const double bottom = previous [j + 1] + my deletion [source [j]];
+			double mindist = previous [j] + my substitution (target [i], source [j]);
+			if (bottom < mindist)
+				mindist = bottom;
+			if (left < mindist)
+				mindist = left;
+			current [j + 1] = mindist;
+		}
+		if (jto < m)
+			current [jto + 2] = INFINITY;   // the cell right of the band
+		std::swap (previous, current);
+	}
+	return previous [m + 1];
+}
+
+static double EditCostsTable_Coded_getDistance (const EditCostsTable_Coded *me, double uniformIndelCost,
+	constINTVEC const& target, constINTVEC const& source, VEC previous, VEC current)
+{
+	const integer n = target.size, m = source.size, kmax = std::max (n, m);
+	if (uniformIndelCost == 0.0)
+		return EditCostsTable_Coded_getBandedDistance (me, target, source, kmax, previous, current);
+	/*
+		Ukkonen: double the band until the distance found inside it is smaller than the cost
+		of the cheapest path that leaves it.
+	*/
+	const integer lengthDifference = integer_abs (n - m);
+	integer k = std::max (lengthDifference, 1_integer);
+	for (;;) {
+		if (k >= kmax)
+			return EditCostsTable_Coded_getBandedDistance (me, target, source, kmax, previous, current);
+		const double distance = EditCostsTable_Coded_getBandedDistance (me, target, source, k, previous, current);
+		if (distance <= uniformIndelCost * double (2 * k + 2 - lengthDifference))
+			return distance;
+		k *= 2;
+	}
+}
+
+/*
+	The full tables delta [1..n+1] [1..m+1] and psi [1..n+1] [1..m+1] of EditDistanceTable_findPath.
+*/
+static void EditCostsTable_Coded_fillTables (const EditCostsTable_Coded *me, constINTVEC const& target, constINTVEC const& source,
+	MAT const& delta, INTMAT const& psi)
+{
+	const integer n = target.size, m = source.size;
+	delta [1] [1] = 0.0;
+	psi [1] [1] = 0;
+	for (integer j = 1; j <= m; j ++) {
+		delta [1] [j + 1] = delta [1] [j] + my deletion [source [j]];
+		psi [1] [j + 1] = WARPING_fromLeft;
+	}
+	for (integer i = 1; i <= n; i ++) {
+		delta [i + 1] [1] = delta [i] [1] + my insertion [target [i]];
+		psi [i + 1] [1] = WARPING_fromBelow;
+	}
+	for (integer j = 1; j <= m; j ++) {
+		for (integer i = 1; i <= n; i ++) {
+			const double left = delta [i + 1] [j] + my insertion [target [i]];
+			const double bottom = delta [i] [j + 1] + my deletion [source [j]];
+			double mindist = delta [i] [j] + my substitution (target [i], source [j]);   // diag
+			psi [i + 1] [j + 1] = WARPING_fromDiag;
+			if (bottom < mindist) {
+				mindist = bottom;
+				psi [i + 1] [j + 1] = WARPING_fromBelow;
+			}
+			if (left < mindist) {
+				mindist = left;
+				psi [i + 1] [j + 1] = WARPING_fromLeft;
+			}
+			delta [i + 1] [j + 1] = mindist;
+		}
+	}
+}
+
+/*
+	The operations along the optimal path are written as one character per step:
+	'i' insertion, 'd' deletion, 's' substitution, '=' match.
+*/
+static double EditCostsTable_Coded_getAlignment (const EditCostsTable_Coded *me, constINTVEC const& target, constINTVEC const& source,
+	autostring32 *out_operations)
+{
+	const integer n = target.size, m = source.size;
+	autoINTMAT psi = raw_INTMAT (n + 1, m + 1);
+	autoMAT delta = raw_MAT (n + 1, m + 1);
+	EditCostsTable_Coded_fillTables (me, target, source, delta.get(), psi.get());
+	if (out_operations) {
+		autostring32 operations (n + m);
+		integer length = 0, i = n + 1, j = m + 1;
+		while (i > 1 || j > 1) {
+			char32 operation;
+			if (psi [i] [j] == WARPING_fromDiag) {
+				operation = ( target [i - 1] == source [j - 1] ? U'=' : U's' );
+				i --;
+				j --;
+			} else if (psi [i] [j] == WARPING_fromBelow) {
+				operation = U'i';   // a target symbol without a source symbol, as in EditDistanceTable_drawEditOperations
+				i --;
+			} else {
+				operation = U'd';
+				j --;
+			}
+			operations [length ++] = operation;
+		}
+		std::reverse (operations.get(), operations.get() + length);
+		operations [length] = U'\0';
+		*out_operations = operations.move();
+	}
+	return delta [n + 1] [m + 1];
+}
+
+autoTable STRVECs_to_Table_editDistances (constSTRVEC const& targets, constSTRVEC const& sources, EditCostsTable costs, bool alignments) {
+	try {
+		Melder_require (targets.size == sources.size,
+			U"The number of targets (", targets.size, U") should equal the number of sources (", sources.size, U").");
+		const integer numberOfPairs = targets.size;
+		/*
+			Split all transcriptions into symbols and intern them all at once.
+		*/
+		autoSTRVEC symbols;
+		autoINTVEC firstSymbol = raw_INTVEC (2 * numberOfPairs + 1);
+		for (integer itranscription = 1; itranscription <= 2 * numberOfPairs; itranscription ++) {
+			const conststring32 transcription = ( itranscription <= numberOfPairs ? targets [itranscription] : sources [itranscription - numberOfPairs] );
+			autoSTRVEC parts = splitByWhitespace_STRVEC (transcription ? transcription : U"");
+			firstSymbol [itranscription] = symbols.size + 1;
+			const integer offset = symbols.size;
+			symbols.resize (offset + parts.size);
+			for (integer ipart = 1; ipart <= parts.size; ipart ++)
+				symbols [offset + ipart] = parts [ipart].move();
+		}
+		firstSymbol [2 * numberOfPairs + 1] = symbols.size + 1;
+		autoStringsIndex interned = STRVEC_internSymbols (symbols.get());
+		symbols.reset();
+
+		autoEditCostsTable defaultCosts;
+		if (! costs) {
+			defaultCosts = EditCostsTable_createDefault ();
+			costs = defaultCosts.get();
+		}
+		EditCostsTable_Coded coded;
+		coded.init (costs, interned.get());
+		const double uniformIndelCost = coded.uniformIndelCost ();
+
+		autoVEC distances = raw_VEC (numberOfPairs);
+		autoSTRVEC operations;
+		if (alignments)
+			operations = autoSTRVEC (numberOfPairs);
+		integer maximumLength = 0;
+		for (integer itranscription = 1; itranscription <= 2 * numberOfPairs; itranscription ++)
+			maximumLength = std::max (maximumLength, firstSymbol [itranscription + 1] - firstSymbol [itranscription]);
+		const constINTVEC codes = ( interned ? interned -> classIndex.get() : constINTVEC () );
+
+		MelderThread_PARALLELIZE (numberOfPairs, 100)
+			autoVEC previous = raw_VEC (maximumLength + 2), current = raw_VEC (maximumLength + 2);
+		MelderThread_FOR (ipair) {
+			const integer itarget = ipair, isource = ipair + numberOfPairs;
+			const constINTVEC target = codes.part (firstSymbol [itarget], firstSymbol [itarget + 1] - 1);
+			const constINTVEC source = codes.part (firstSymbol [isource], firstSymbol [isource + 1] - 1);
+			if (alignments)
+				distances [ipair] = EditCostsTable_Coded_getAlignment (& coded, target, source, & operations [ipair]);
+			else
+				distances [ipair] = EditCostsTable_Coded_getDistance (& coded, uniformIndelCost, target, source, previous.get(), current.get());
+		} MelderThread_ENDFOR
+
+		autoTable thee = Table_createWithColumnNames (numberOfPairs,
+				( alignments ? autoSTRVEC ({ U"target", U"source", U"distance", U"operations" }) : autoSTRVEC ({ U"target", U"source", U"distance" }) ).get());
+		for (integer ipair = 1; ipair <= numberOfPairs; ipair ++) {
+			Table_setStringValue (thee.get(), ipair, 1, targets [ipair] ? targets [ipair] : U"");
+			Table_setStringValue (thee.get(), ipair, 2, sources [ipair] ? sources [ipair] : U"");
+			Table_setNumericValue (thee.get(), ipair, 3, distances [ipair]);
+			if (alignments)
+				Table_setStringValue (thee.get(), ipair, 4, operations [ipair].get());
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (U"Edit distances not computed.");
+	}
+}
+
+autoTable Strings_to_Table_editDistances (Strings me, Strings thee, EditCostsTable costs, bool alignments) {
+	try {
+		autoTable him = STRVECs_to_Table_editDistances (my strings.get(), thy strings.get(), costs, alignments);
+		return him;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": no edit distances computed.");
+	}
+}
+
+autoTable Table_to_Table_editDistances (Table me, conststring32 targetColumnLabel, conststring32 sourceColumnLabel, EditCostsTable costs, bool alignments) {
+	try {
+		const integer targetColumn = Table_columnNameToNumber_e (me, targetColumnLabel);
+		const integer sourceColumn = Table_columnNameToNumber_e (me, sourceColumnLabel);
+		autovector <conststring32> targets = newvectorraw <conststring32> (my rows.size);
+		autovector <conststring32> sources = newvectorraw <conststring32> (my rows.size);
+		for (integer irow = 1; irow <= my rows.size; irow ++) {
+			targets [irow] = Table_getStringValue_a (me, irow, targetColumn);
+			sources [irow] = Table_getStringValue_a (me, irow, sourceColumn);
+		}
+		autoTable him = STRVECs_to_Table_editDistances (constSTRVEC (& targets [1], my rows.size),
+				constSTRVEC (& sources [1], my rows.size), costs, alignments);
+		return him;
+	} catch (MelderError) {
+		Melder_throw (me, U": no edit distances computed.");
+	}
+}
+
 Thing_implement (EditDistanceTable, TableOfReal, 0);
 
 void structEditDistanceTable :: v1_info () {
@@ -538,36 +833,24 @@ void EditDistanceTable_findPath (EditDistanceTable me, autoTableOfReal *out_dire
 		const integer numberOfSources = my numberOfColumns - 1, numberOfTargets = my numberOfRows - 1;
 		autoINTMAT psi = zero_INTMAT (my numberOfRows, my numberOfColumns);
 		autoMAT delta = zero_MAT (my numberOfRows, my numberOfColumns);
+		/*
+			Intern the row and column symbols, so that the costs are looked up only once per distinct symbol.
+		*/
+		autovector <conststring32> symbols = newvectorraw <conststring32> (numberOfTargets + numberOfSources);
+		for (integer i = 1; i <= numberOfTargets; i ++)
+			symbols [i] = my rowLabels [i + 1].get();
+		for (integer j = 1; j <= numberOfSources; j ++)
+			symbols [numberOfTargets + j] = my columnLabels [j + 1].get();
+		for (integer isymbol = 1; isymbol <= symbols.size; isymbol ++)
+			if (! symbols [isymbol])
+				symbols [isymbol] = U"";
+		autoStringsIndex interned = STRVEC_internSymbols (constSTRVEC (symbols.cells, symbols.size));
+		EditCostsTable_Coded coded;
+		coded.init (my editCostsTable.get(), interned.get());
+		const constINTVEC codes = ( interned ? interned -> classIndex.get() : constINTVEC () );
+		EditCostsTable_Coded_fillTables (& coded, codes.part (1, numberOfTargets), codes.part (numberOfTargets + 1, codes.size),
+				delta.get(), psi.get());
 
-		for (integer icol = 2; icol <= my numberOfColumns; icol ++) {
-			delta [1] [icol] = delta [1] [icol - 1] + EditCostsTable_getDeletionCost (my editCostsTable.get(), my columnLabels [icol].get());
-			psi [1] [icol] = WARPING_fromLeft;
-		}
-		for (integer irow = 2; irow <= my numberOfRows; irow ++) {
-			delta [irow] [1] = delta [irow - 1] [1] + EditCostsTable_getInsertionCost (my editCostsTable.get(), my rowLabels [irow].get());
-			psi [irow] [1] = WARPING_fromBelow;
-		}
-		for (integer icol = 2; icol <= my numberOfColumns; icol ++) {
-			for (integer irow = 2; irow <= my numberOfRows; irow ++) {
-				// the substitution, deletion and insertion costs.
-				const double left = delta [irow] [icol - 1] +
-						EditCostsTable_getInsertionCost (my editCostsTable.get(), my rowLabels [irow].get());
-				const double bottom = delta [irow - 1] [icol] +
-						EditCostsTable_getDeletionCost (my editCostsTable.get(), my columnLabels [icol].get());
-				double mindist = delta [irow - 1] [icol - 1] +
-						EditCostsTable_getSubstitutionCost (my editCostsTable.get(), my rowLabels [irow].get(), my columnLabels [icol].get()); // diag
-				psi [irow] [icol] = WARPING_fromDiag;
-				if (bottom < mindist) {
-					mindist = bottom;
-					psi [irow] [icol] = WARPING_fromBelow;
-				}
-				if (left < mindist) {
-					mindist = left;
-					psi [irow] [icol] = WARPING_fromLeft;
-				}
-				delta [irow] [icol] = mindist;
-			}
-		}
 		// find minimum distance in last column
 		const integer iy = numberOfTargets, ix = numberOfSources;
 		WarpingPath_reset (my warpingPath.get());
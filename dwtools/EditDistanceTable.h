@@ -19,6 +19,7 @@
  */
 
 #include "Strings_extensions.h"
+#include "Table.h"
 #include "TableOfReal.h"
 
 #define WARPING_fromLeft 1
@@ -90,4 +91,19 @@ autoTableOfReal EditDistanceTable_to_TableOfReal_directions (EditDistanceTable m
 
 autoTableOfReal EditDistanceTable_to_TableOfReal (EditDistanceTable me);
 
+autoTable STRVECs_to_Table_editDistances (constSTRVEC const& targets, constSTRVEC const& sources, EditCostsTable costs, bool alignments);
+/*
+	targets [i] and sources [i] are whitespace-separated symbol sequences; the distance is the one that an
+	EditDistanceTable would give for the pair. The symbols are interned once for all pairs, the pairs are
+	processed in parallel. Without alignments and with equal insertion and deletion costs only a diagonal
+	band of the table is computed (Ukkonen).
+	costs == nullptr means the default costs.
+	The output table has columns "target", "source", "distance" and, with alignments, "operations"
+	(one character per edit step: i(nsertion), d(eletion), s(ubstitution) or = (match)).
+*/
+
+autoTable Strings_to_Table_editDistances (Strings me, Strings thee, EditCostsTable costs, bool alignments);
+
+autoTable Table_to_Table_editDistances (Table me, conststring32 targetColumnLabel, conststring32 sourceColumnLabel, EditCostsTable costs, bool alignments);
+
 #endif /* _EditDistanceTable_h_ */
@@ -66,6 +66,8 @@ static integer GaussianMixture_getNumberOfParametersInComponent (GaussianMixture
 	return ( thy numberOfRows == 1 ? 2 * thy numberOfColumns : thy numberOfColumns * (thy numberOfColumns + 3) / 2 );
 }
 
+static double GaussianMixture_getLikelihoodValue_fromLogLikelihood (GaussianMixture me, longdouble lnp, integer numberOfData, kGaussianMixtureCriterion criterion);
+
 static double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT const& probabilities, kGaussianMixtureCriterion criterion) {
 	Melder_require (probabilities.ncol == my numberOfComponents,
 		U"The number of columns in the probabilities should equal the number of components.");
@@ -101,7 +103,13 @@ static double GaussianMixture_getLikelihoodValue (GaussianMixture me, constMAT c
 		if (psum > 0.0)
 			lnp += (longdouble) log (psum);
 	}
+	return GaussianMixture_getLikelihoodValue_fromLogLikelihood (me, lnp, numberOfData, criterion);
+}
 
+/*
+	The criterion value from the log(likelihood) of numberOfData data (not for COMPLETE_DATA_ML).
+*/
+static double GaussianMixture_getLikelihoodValue_fromLogLikelihood (GaussianMixture me, longdouble lnp, integer numberOfData, kGaussianMixtureCriterion criterion) {
 	if (criterion == kGaussianMixtureCriterion::LIKELIHOOD)
 		return lnp;
 
@@ -792,6 +800,79 @@ void GaussianMixture_splitComponent (GaussianMixture me, integer component) {
 	}
 }
 
+/*
+	What the E-step needs from the components, calculated once per iteration.
+	The Mahalanobis distance uses the transpose of the inverse L^-1 of the Cholesky factor of S = L.L',
+	so that L^-1.(x-m) is a sum of contiguous rows scaled by the elements of x-m.
+	For diagonal covariances the factor is one row with the inverse standard deviations.
+*/
+struct GaussianMixture_ComponentCache {
+	integer numberOfComponents, dimension;
+	bool diagonal;
+	autoMAT centroids;   // numberOfComponents x dimension
+	autoVEC lnDensityConstants;   // -0.5 * (dimension * ln (2 pi) + ln |S|)
+	autoVEC lnMixingProbabilities;
+	autoTEN3 factors;   // numberOfComponents x dimension x dimension (or x 1 x dimension if diagonal)
+
+	void init (GaussianMixture gm, integer fromComponent, integer toComponent) {
+		if (NUMisEmpty (our centroids.get())) {
+			our numberOfComponents = gm -> numberOfComponents;
+			our dimension = gm -> dimension;
+			our diagonal = ( gm -> covariances -> at [1] -> numberOfRows == 1 );
+			our centroids = raw_MAT (our numberOfComponents, our dimension);
+			our lnDensityConstants = raw_VEC (our numberOfComponents);
+			our lnMixingProbabilities = raw_VEC (our numberOfComponents);
+			our factors = zero_TEN3 (our numberOfComponents, our diagonal ? 1 : our dimension, our dimension);
+		}
+		const double ln2pid = our dimension * log (NUM2pi);
+		for (integer component = fromComponent; component <= toComponent; component ++) {
+			const Covariance covi = gm -> covariances -> at [component];
+			SSCP_expandWithLowerCholeskyInverse (covi);
+			our centroids.row (component)  <<=  covi -> centroid.all();
+			our lnDensityConstants [component] = -0.5 * (ln2pid + covi -> lnd);
+			our lnMixingProbabilities [component] = ( gm -> mixingProbabilities [component] > 0.0 ?
+					log (gm -> mixingProbabilities [component]) : - INFINITY );
+			MATVU factor = our factors [component];
+			if (our diagonal)
+				factor.row (1)  <<=  covi -> lowerCholeskyInverse.diagonal();
+			else
+				for (integer irow = 1; irow <= our dimension; irow ++)
+					for (integer icol = 1; icol <= irow; icol ++)
+						factor [icol] [irow] = covi -> lowerCholeskyInverse [irow] [icol];
+		}
+	}
+	void getDifference (integer component, constVECVU const& x, VEC const& dif) const {
+		const double *centroid = & our centroids [component] [1];
+		for (integer i = 1; i <= our dimension; i ++)
+			dif [i] = x [i] - centroid [i - 1];
+	}
+	/*
+		Fills dif with x - centroid and returns (x-m)'.S^-1.(x-m); work has `dimension` elements.
+	*/
+	double getMahalanobisDistanceSquared (integer component, constVECVU const& x, VEC const& dif, VEC const& work) const {
+		our getDifference (component, x, dif);
+		double dsq = 0.0;
+		if (our diagonal) {
+			const double *inverseStddev = & our factors [component] [1] [1];
+			for (integer i = 1; i <= our dimension; i ++) {
+				const double t = inverseStddev [i - 1] * dif [i];
+				dsq += t * t;
+			}
+			return dsq;
+		}
+		work  <<=  0.0;
+		for (integer j = 1; j <= our dimension; j ++) {
+			const double difj = dif [j];
+			const double *factorRow = & our factors [component] [j] [1];
+			for (integer i = j; i <= our dimension; i ++)
+				work [i] += difj * factorRow [i - 1];
+		}
+		for (integer i = 1; i <= our dimension; i ++)
+			dsq += work [i] * work [i];
+		return dsq;
+	}
+};
+
 void GaussianMixture_TableOfReal_getComponentProbabilities (GaussianMixture me, TableOfReal thee, integer componentToUpdate, MAT const& probabilities) {
 	try {
 		Melder_require (probabilities.nrow == thy numberOfRows,
@@ -802,20 +883,27 @@ void GaussianMixture_TableOfReal_getComponentProbabilities (GaussianMixture me,
 			U"The number of columns in the TableOfReal and the dimension of the GaussianMixture should be equal.");
 		Melder_require (componentToUpdate >= 0 && componentToUpdate <= my numberOfComponents,
 			U"The component number should be in the interval from 0 to ", my numberOfComponents);
-		const double ln2pid = my dimension * log (NUM2pi);
 
 		const integer fromComponent = componentToUpdate == 0 ? 1 : componentToUpdate;
 		const integer toComponent = componentToUpdate == 0 ? my numberOfComponents : componentToUpdate;
 		
-		for (integer component = fromComponent; component <= toComponent; component ++) {
-			const Covariance covi = my covariances->at [component];
-			SSCP_expandWithLowerCholeskyInverse (covi);
-
-			for (integer irow = 1; irow <= thy numberOfRows; irow++) {
-				const double dsq = NUMmahalanobisDistanceSquared (covi -> lowerCholeskyInverse.get(), thy data.row (irow), covi -> centroid.get());
-				probabilities [irow] [component] = std::max (1e-300, exp (- 0.5 * (ln2pid + covi -> lnd + dsq))); // prevent probabilities from being zero
+		GaussianMixture_ComponentCache cache;
+		cache.init (me, fromComponent, toComponent);
+		const integer numberOfComputedComponents = toComponent - fromComponent + 1;
+		const integer thresholdNumberOfRowsPerThread = std::max (1_integer, 100000 / (numberOfComputedComponents * my dimension * my dimension));
+		const integer maximumNumberOfThreads = MelderThread_computeNumberOfThreads (thy numberOfRows, thresholdNumberOfRowsPerThread);
+		autoMAT threadWork = raw_MAT (2 * maximumNumberOfThreads, my dimension);
+		std::atomic <bool> errorFlag = false;
+		MelderThread_run (& errorFlag, thy numberOfRows, thresholdNumberOfRowsPerThread,
+			[&] (integer threadNumber, integer firstRow, integer lastRow) {
+				VEC dif = threadWork.row (2 * threadNumber + 1), work = threadWork.row (2 * threadNumber + 2);
+				for (integer irow = firstRow; irow <= lastRow; irow ++)
+					for (integer component = fromComponent; component <= toComponent; component ++) {
+						const double dsq = cache.getMahalanobisDistanceSquared (component, thy data.row (irow), dif, work);
+						probabilities [irow] [component] = std::max (1e-300, exp (cache.lnDensityConstants [component] - 0.5 * dsq)); // prevent probabilities from being zero
+					}
 			}
-		}
+		);
 	} catch (MelderError) {
 		Melder_throw (me, U" & ", thee, U": no component probabilies could be calculated.");
 	}
@@ -872,58 +960,307 @@ void GaussianMixture_unExpandPCA (GaussianMixture me) {
 	}
 }
 
-void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfReal thee, double delta_lnp, integer maxNumberOfIterations, double lambda, kGaussianMixtureCriterion criterion) {
+/*
+	The sufficient statistics of the M-step, per component k: the sum of the responsibilities N [k],
+	and the first and second moments of the data around the centroid m [k] of the E-step:
+		S1 [k] = sum (r [n] [k] (x [n] - m [k])),  S2 [k] = sum (r [n] [k] (x [n] - m [k]) (x [n] - m [k])')
+	(only the upper triangle of S2, or only its diagonal for diagonal covariances).
+	Moments around the old centroid do not suffer from cancellation in S2 / N - (S1 / N) (S1 / N)'.
+*/
+struct GaussianMixture_Statistics {
+	integer numberOfSlots, numberOfComponents;   // one slot per thread
+	autoMAT sumsOfResponsibilities;   // numberOfSlots x numberOfComponents
+	autoTEN3 firstMoments;   // numberOfSlots x numberOfComponents x dimension
+	autoTEN3 secondMoments;   // (numberOfSlots * numberOfComponents) x dimension x dimension (or x 1 x dimension if diagonal)
+
+	void init (integer numberOfSlots_, integer numberOfComponents_, integer dimension, bool diagonal) {
+		our numberOfSlots = numberOfSlots_;
+		our numberOfComponents = numberOfComponents_;
+		our sumsOfResponsibilities = zero_MAT (numberOfSlots, numberOfComponents);
+		our firstMoments = zero_TEN3 (numberOfSlots, numberOfComponents, dimension);
+		our secondMoments = zero_TEN3 (numberOfSlots * numberOfComponents, diagonal ? 1 : dimension, dimension);
+	}
+	VEC sumOfResponsibilities (integer slot) const {
+		return our sumsOfResponsibilities.row (slot);
+	}
+	MATVU firstMoment (integer slot) const {
+		return our firstMoments [slot];
+	}
+	MATVU secondMoment (integer slot, integer component) const {
+		return our secondMoments [(slot - 1) * our numberOfComponents + component];
+	}
+	void reset () {
+		our sumsOfResponsibilities.all()  <<=  0.0;
+		for (integer slot = 1; slot <= our numberOfSlots; slot ++) {
+			our firstMoments [slot]  <<=  0.0;
+			for (integer component = 1; component <= our numberOfComponents; component ++)
+				our secondMoment (slot, component)  <<=  0.0;
+		}
+	}
+	/*
+		target (slot 1) := decay * target + scale * (the sum over our slots)
+	*/
+	void addSlotsTo (GaussianMixture_Statistics *target, double decay, double scale) const {
+		for (integer component = 1; component <= our numberOfComponents; component ++) {
+			MATVU targetSecondMoment = target -> secondMoment (1, component);
+			if (decay == 0.0) {
+				target -> sumOfResponsibilities (1) [component] = 0.0;
+				target -> firstMoment (1).row (component)  <<=  0.0;
+				targetSecondMoment  <<=  0.0;
+			} else {
+				target -> sumOfResponsibilities (1) [component] *= decay;
+				target -> firstMoment (1).row (component)  *=  decay;
+				targetSecondMoment  *=  decay;
+			}
+			for (integer slot = 1; slot <= our numberOfSlots; slot ++) {
+				target -> sumOfResponsibilities (1) [component] += scale * our sumOfResponsibilities (slot) [component];
+				target -> firstMoment (1).row (component)  +=  scale  *  our firstMoment (slot).row (component);
+				targetSecondMoment  +=  scale  *  our secondMoment (slot, component);
+			}
+		}
+	}
+};
+
+/*
+	The E-step for the rows of `data`, in parallel.
+	The responsibilities are used immediately, so they are never stored; each thread adds them to its own slot
+	of the statistics, and to its own sums of ln (sum (k, pi [k] p [n] [k])) and sum (k, r [n] [k] ln (pi [k] p [n] [k])).
+	The log-sum-exp keeps the responsibilities accurate for data far from all centroids.
+*/
+static void GaussianMixture_accumulateStatistics (GaussianMixture_ComponentCache const& cache, constMATVU const& data,
+	integer thresholdNumberOfRowsPerThread, MAT const& threadWork, MAT const& threadSums, GaussianMixture_Statistics const& threadStatistics)
+{
+	const integer numberOfComponents = cache.numberOfComponents, dimension = cache.dimension;
+	std::atomic <bool> errorFlag = false;
+	MelderThread_run (& errorFlag, data.nrow, thresholdNumberOfRowsPerThread,
+		[&] (integer threadNumber, integer firstRow, integer lastRow) {
+			const integer slot = threadNumber + 1;
+			VEC sumOfResponsibilities = threadStatistics.sumOfResponsibilities (slot);
+			MATVU firstMoment = threadStatistics.firstMoment (slot);
+			VEC lnp = threadWork.row (3 * threadNumber + 1).part (1, numberOfComponents);
+			VEC dif = threadWork.row (3 * threadNumber + 2).part (1, dimension);
+			VEC work = threadWork.row (3 * threadNumber + 3).part (1, dimension);
+			double lnLikelihood = 0.0, lnCompleteData = 0.0;
+			for (integer irow = firstRow; irow <= lastRow; irow ++) {
+				constVECVU x = data.row (irow);
+				/*
+					ln (pi [k] p [n] [k]), Bishop eq. 9.23, and the log-sum-exp over the components
+				*/
+				double lnpmax = - INFINITY;
+				for (integer component = 1; component <= numberOfComponents; component ++) {
+					const double dsq = cache.getMahalanobisDistanceSquared (component, x, dif, work);
+					lnp [component] = cache.lnMixingProbabilities [component] + cache.lnDensityConstants [component] - 0.5 * dsq;
+					lnpmax = std::max (lnpmax, lnp [component]);
+				}
+				double sum = 0.0;
+				for (integer component = 1; component <= numberOfComponents; component ++)
+					sum += exp (lnp [component] - lnpmax);
+				const double lnsum = lnpmax + log (sum);
+				lnLikelihood += lnsum;
+				/*
+					The statistics for the M-step, Bishop eqs. 9.24 and 9.25
+				*/
+				for (integer component = 1; component <= numberOfComponents; component ++) {
+					const double responsibility = exp (lnp [component] - lnsum);
+					if (responsibility == 0.0)
+						continue;
+					lnCompleteData += responsibility * lnp [component];
+					cache.getDifference (component, x, dif);
+					sumOfResponsibilities [component] += responsibility;
+					double *moment1 = & firstMoment [component] [1];
+					for (integer i = 1; i <= dimension; i ++)
+						moment1 [i - 1] += responsibility * dif [i];
+					MATVU secondMoment = threadStatistics.secondMoment (slot, component);
+					if (cache.diagonal) {
+						double *moment2 = & secondMoment [1] [1];
+						for (integer i = 1; i <= dimension; i ++)
+							moment2 [i - 1] += responsibility * dif [i] * dif [i];
+					} else {
+						for (integer i = 1; i <= dimension; i ++) {
+							const double rdifi = responsibility * dif [i];
+							double *moment2 = & secondMoment [i] [1];
+							for (integer j = i; j <= dimension; j ++)
+								moment2 [j - 1] += rdifi * dif [j];
+						}
+					}
+				}
+			}
+			threadSums [slot] [1] += lnLikelihood;
+			threadSums [slot] [2] += lnCompleteData;
+		}
+	);
+}
+
+/*
+	M-step from the statistics in slot 1, which are sums over numberOfData data.
+*/
+static void GaussianMixture_updateFromStatistics (GaussianMixture me, GaussianMixture_Statistics const& statistics,
+	double numberOfData, Covariance covg, double lambda)
+{
+	constVEC sumOfResponsibilities = statistics.sumOfResponsibilities (1);
+	for (integer component = 1; component <= my numberOfComponents; component ++) {
+		const double nk = sumOfResponsibilities [component];
+		if (nk <= 0.0)
+			continue;   // an empty component keeps its mean and covariance
+		const Covariance thee = my covariances->at [component];
+		constVECVU firstMoment = statistics.firstMoment (1).row (component);
+		constMATVU secondMoment = statistics.secondMoment (1, component);
+		for (integer i = 1; i <= my dimension; i ++) {
+			const double shifti = firstMoment [i] / nk;
+			if (thy numberOfRows == 1)
+				thy data [1] [i] = secondMoment [1] [i] / nk - shifti * shifti;
+			else
+				for (integer j = i; j <= my dimension; j ++)
+					thy data [i] [j] = thy data [j] [i] = secondMoment [i] [j] / nk - shifti * (firstMoment [j] / nk);
+		}
+		for (integer i = 1; i <= my dimension; i ++)
+			thy centroid [i] += firstMoment [i] / nk;
+		thy numberOfObservations = nk * numberOfData / NUMsum (sumOfResponsibilities);
+		GaussianMixture_addCovarianceFraction (me, component, covg, lambda);
+	}
+	my mixingProbabilities.all()  <<=  sumOfResponsibilities;
+	VECnormalize_inplace (my mixingProbabilities.get(), 1.0, 1.0);
+}
+
+/*
+	Express the statistics in slot 1 around the new centroids: the M-step has moved centroid k by d = S1 [k] / N [k],
+	so that S2 [k] becomes S2 [k] - N [k] d d' and S1 [k] becomes zero.
+*/
+static void GaussianMixture_Statistics_recentre (GaussianMixture_Statistics const *me) {
+	for (integer component = 1; component <= my numberOfComponents; component ++) {
+		const double nk = my sumOfResponsibilities (1) [component];
+		VECVU firstMoment = my firstMoment (1).row (component);
+		MATVU secondMoment = my secondMoment (1, component);
+		if (nk > 0.0)
+			for (integer i = 1; i <= firstMoment.size; i ++) {
+				if (secondMoment.nrow == 1)
+					secondMoment [1] [i] -= firstMoment [i] * firstMoment [i] / nk;
+				else
+					for (integer j = i; j <= firstMoment.size; j ++)
+						secondMoment [i] [j] -= firstMoment [i] * firstMoment [j] / nk;
+			}
+		firstMoment  <<=  0.0;
+	}
+}
+
+/*
+	The total covariance of the data, for the stability term lambda, in two passes over the data.
+*/
+static autoCovariance GaussianMixture_DataRows_to_Covariance (GaussianMixture_DataRows const& getRows, integer numberOfRows, integer blockSize, integer dimension) {
+	autoCovariance thee = Covariance_create (dimension);
+	autoMAT dif = raw_MAT (blockSize, dimension);
+	autoMAT sscp = raw_MAT (dimension, dimension);
+	for (integer firstRow = 1; firstRow <= numberOfRows; firstRow += blockSize) {
+		constMATVU data = getRows (firstRow, std::min (firstRow + blockSize - 1, numberOfRows));
+		for (integer irow = 1; irow <= data.nrow; irow ++)
+			thy centroid.all()  +=  data.row (irow);
+	}
+	thy centroid.all()  /=  numberOfRows;
+	for (integer firstRow = 1; firstRow <= numberOfRows; firstRow += blockSize) {
+		constMATVU data = getRows (firstRow, std::min (firstRow + blockSize - 1, numberOfRows));
+		MATVU difb = dif.horizontalBand (1, data.nrow);
+		for (integer irow = 1; irow <= data.nrow; irow ++)
+			difb.row (irow)  <<=  data.row (irow)  -  thy centroid.all();
+		mtm_MAT_out (sscp.get(), difb);
+		thy data.all()  +=  sscp.all();
+	}
+	thy data.all()  /=  numberOfRows - 1.0;
+	thy numberOfObservations = numberOfRows;
+	return thee;
+}
+
+void GaussianMixture_improveLikelihood_rows (GaussianMixture me, GaussianMixture_DataRows const& getRows, integer numberOfRows,
+	integer blockSize, bool miniBatch, double delta_lnp, integer maxNumberOfIterations, double lambda, kGaussianMixtureCriterion criterion)
+{
 	try {
-		Melder_require (thy numberOfColumns == my dimension,
-			U"The number of columns and the dimension of the model should agree.");
-		Melder_require (my numberOfComponents < thy numberOfRows / 2,
+		Melder_require (my numberOfComponents < numberOfRows / 2,
 			U"Not enough data points.");
-
+		Melder_require (blockSize > 0,
+			U"The block size should be positive.");
+		blockSize = std::min (blockSize, numberOfRows);
+		const integer numberOfBlocks = (numberOfRows - 1) / blockSize + 1;
+		auto getBlock = [&] (integer iblock) -> constMATVU {
+			const integer firstRow = 1 + (iblock - 1) * blockSize;
+			const integer lastRow = std::min (firstRow + blockSize - 1, numberOfRows);
+			constMATVU data = getRows (firstRow, lastRow);
+			Melder_require (data.nrow == lastRow - firstRow + 1 && data.ncol == my dimension,
+				U"The data block for rows ", firstRow, U" to ", lastRow, U" should have ", lastRow - firstRow + 1,
+				U" rows and ", my dimension, U" columns.");
+			return data;
+		};
 		const conststring32 criterionText = GaussianMixture_criterionText (criterion);
+		/*
+			The global covariance matrix is added with scaling coefficient lambda during updating the
+			mixture covariances to prevent numerical instabilities.
+		*/
+		autoCovariance covg = GaussianMixture_DataRows_to_Covariance (getRows, numberOfRows, blockSize, my dimension);
 
-		// The global covariance matrix is added with scaling coefficient lambda during updating the
-		// mixture covariances to prevent numerical instabilities.
-
-		autoCovariance covg = TableOfReal_to_Covariance (thee);
-		autoMAT probabilities = raw_MAT (thy numberOfRows, my numberOfComponents);
-		autoMAT responsibilities = raw_MAT (thy numberOfRows, my numberOfComponents);
-		
-		GaussianMixture_TableOfReal_getComponentProbabilities (me, thee, 0, probabilities.get());
+		GaussianMixture_ComponentCache cache;
+		cache.init (me, 1, my numberOfComponents);
+		/*
+			Per row the E-step and the statistics each need about numberOfComponents * dimension^2 operations.
+		*/
+		const integer thresholdNumberOfRowsPerThread = std::max (1_integer, 100000 / (my numberOfComponents * my dimension * my dimension));
+		const integer maximumNumberOfThreads = MelderThread_computeNumberOfThreads (blockSize, thresholdNumberOfRowsPerThread);
+		autoMAT threadWork = raw_MAT (3 * maximumNumberOfThreads, std::max (my numberOfComponents, my dimension));
+		autoMAT threadSums = raw_MAT (maximumNumberOfThreads, 2);   // ln (likelihood), complete-data ln (likelihood)
+		GaussianMixture_Statistics threadStatistics, statistics;
+		threadStatistics.init (maximumNumberOfThreads, my numberOfComponents, my dimension, cache.diagonal);
+		statistics.init (1, my numberOfComponents, my dimension, cache.diagonal);
+		integer numberOfBatchUpdates = 0;
+		/*
+			One pass over the data: the E-step with the current parameters, which gives the value of the criterion
+			and the statistics for the M-step.
+			With mini-batches, the parameters are updated after each block by stepwise EM
+			(P. Liang & D. Klein (2009): "Online EM for unsupervised models", Proceedings of NAACL-HLT 2009: 611--619):
+			the statistics per data point are s := (1 - eta) s + eta s(b), with eta = (t + 2)^^-0.6^ after t updates.
+			The criterion then is a sum over the blocks, each with its own parameters.
+		*/
+		auto pass = [&] () -> double {
+			threadSums.all()  <<=  0.0;
+			for (integer iblock = 1; iblock <= numberOfBlocks; iblock ++) {
+				constMATVU data = getBlock (iblock);
+				GaussianMixture_accumulateStatistics (cache, data, thresholdNumberOfRowsPerThread, threadWork.get(), threadSums.get(), threadStatistics);
+				if (miniBatch) {
+					const double eta = ( numberOfBatchUpdates == 0 ? 1.0 : pow (numberOfBatchUpdates + 2.0, -0.6) );
+					threadStatistics.addSlotsTo (& statistics, 1.0 - eta, eta / data.nrow);
+					threadStatistics.reset ();
+					numberOfBatchUpdates ++;
+					GaussianMixture_updateFromStatistics (me, statistics, numberOfRows, covg.get(), lambda);
+					GaussianMixture_Statistics_recentre (& statistics);
+					cache.init (me, 1, my numberOfComponents);
+				}
+			}
+			longdouble lnLikelihood = 0.0, lnCompleteData = 0.0;
+			for (integer ithread = 1; ithread <= maximumNumberOfThreads; ithread ++) {
+				lnLikelihood += threadSums [ithread] [1];
+				lnCompleteData += threadSums [ithread] [2];
+			}
+			if (criterion == kGaussianMixtureCriterion::COMPLETE_DATA_ML)
+				return (double) lnCompleteData;
+			return GaussianMixture_getLikelihoodValue_fromLogLikelihood (me, lnLikelihood, numberOfRows, criterion);
+		};
 
-		double lnp = GaussianMixture_getLikelihoodValue (me, probabilities.get(), criterion);
+		double lnp = pass ();
 		integer iter = 0;
 		autoMelderProgress progress (U"Improve likelihood...");
 		try {
-			double lnp_prev, lnp_start = lnp / thy numberOfRows;
+			double lnp_prev, lnp_start = lnp / numberOfRows;
 			do {
 				iter ++;
-				/*
-					E-step: get responsibilities (gamma) with current parameters
-					See C. Bishop (2006), Pattern reconition and machine learning, Springer, page 439...
-				*/
-				GaussianMixture_getResponsibilities (me, probabilities.get(), 0, responsibilities.get());
-
 				lnp_prev = lnp;
-				
-				/*
-					M-step: 1. new means & covariances
-				*/
-				for (integer component = 1; component <= my numberOfComponents; component ++) {
-					GaussianMixture_updateComponent (me, component, thy data.get(), responsibilities.get());
-					GaussianMixture_addCovarianceFraction (me, component, covg.get(), lambda);
+				if (! miniBatch) {
+					/*
+						M-step: new means, covariances and mixingProbabilities
+						See C. Bishop (2006), Pattern reconition and machine learning, Springer, page 439...
+					*/
+					threadStatistics.addSlotsTo (& statistics, 0.0, 1.0);
+					threadStatistics.reset ();
+					GaussianMixture_updateFromStatistics (me, statistics, numberOfRows, covg.get(), lambda);
+					cache.init (me, 1, my numberOfComponents);
 				}
-
-				/*
-					M-step: 2. new mixingProbabilities
-				*/
-				autoVEC totalResponsibilities = columnSums_VEC (responsibilities.get());
-				my mixingProbabilities.all()  <<=  totalResponsibilities.get();
-				my mixingProbabilities.all()  *=  1.0 / responsibilities.nrow;
-				
-				GaussianMixture_TableOfReal_getComponentProbabilities (me, thee, 0, probabilities.get());
-				
-				lnp = GaussianMixture_getLikelihoodValue (me, probabilities.get(), criterion);
-				Melder_progress ((double) iter / (double) maxNumberOfIterations, criterionText, U": ", lnp / thy numberOfRows, U", L0: ", lnp_start);
+				lnp = pass ();
+				Melder_progress ((double) iter / (double) maxNumberOfIterations, criterionText, U": ", lnp / numberOfRows, U", L0: ", lnp_start);
 			} while (fabs (lnp - lnp_prev) > std::max (fabs (delta_lnp * lnp_prev), NUMeps) && iter < maxNumberOfIterations);
 		} catch (MelderError) {
 			Melder_clearError ();
@@ -936,6 +1273,21 @@ void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfR
 			if (cov -> numberOfObservations > 1.5)
 				cov -> data.row (1)  *=  cov -> numberOfObservations / (cov -> numberOfObservations - 1.0);
 		}
+	} catch (MelderError) {
+		Melder_throw (me, U": likelihood cannot be improved.");
+	}
+}
+
+void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfReal thee, double delta_lnp, integer maxNumberOfIterations, double lambda, kGaussianMixtureCriterion criterion) {
+	try {
+		Melder_require (thy numberOfColumns == my dimension,
+			U"The number of columns and the dimension of the model should agree.");
+		GaussianMixture_improveLikelihood_rows (me,
+			[&] (integer firstRow, integer lastRow) -> constMATVU {
+				return thy data.horizontalBand (firstRow, lastRow);
+			},
+			thy numberOfRows, thy numberOfRows, false, delta_lnp, maxNumberOfIterations, lambda, criterion
+		);
 	} catch (MelderError) {
 		Melder_throw (me, U" & ", thee, U": likelihood cannot be improved.");
 	}
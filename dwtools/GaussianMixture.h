@@ -96,6 +96,20 @@ autoGaussianMixture TableOfReal_to_GaussianMixture (TableOfReal me, integer numb
 
 void GaussianMixture_TableOfReal_improveLikelihood (GaussianMixture me, TableOfReal thee, double delta_lnp, integer maxNumberOfIterations, double lambda, kGaussianMixtureCriterion criterion);
 
+/*
+	The data supplied as blocks of rows, so that they do not have to be in memory as a whole:
+	the function returns the rows firstRow..lastRow (all columns), either as a view of a matrix in memory
+	or of a buffer that it has filled. The view should remain valid until the next call.
+*/
+using GaussianMixture_DataRows = std::function <constMATVU (integer firstRow, integer lastRow)>;
+
+/*
+	EM with the data visited in blocks of blockSize rows; the E-step runs in parallel over the rows of a block.
+	If miniBatch, the parameters are updated after each block (stepwise EM), otherwise after each pass over the data.
+*/
+void GaussianMixture_improveLikelihood_rows (GaussianMixture me, GaussianMixture_DataRows const& getRows, integer numberOfRows,
+	integer blockSize, bool miniBatch, double delta_lnp, integer maxNumberOfIterations, double lambda, kGaussianMixtureCriterion criterion);
+
 /*
 	Learn a GaussiamMixture from multivariate data (unsupervised).
 	1) it is capable of selecting the number of components and 
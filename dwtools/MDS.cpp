@@ -1159,39 +1159,51 @@ autoDissimilarityList DistanceList_to_DissimilarityList (DistanceList me) {
 
 /*****************  Kruskal *****************************************/
 
-static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance disp, Weight weight, constMAT vplus) {
-	const integer nPoints = cx -> numberOfRows, nDimensions = cx -> numberOfColumns;
+/*
+	If all off-diagonal weights are equal to c, V = c (n I - 1 1'), and its Moore-Penrose inverse
+	is (I - 1 1' / n) / (n c). Returns c, or 0.0 if the weights are not uniform.
+*/
+static double Weight_getUniformWeight (Weight me) {
+	const integer nPoints = my numberOfRows;
+	const double c = ( nPoints > 1 ? my data [1] [2] : 0.0 );
+	if (c <= 0.0)
+		return 0.0;
+	for (integer i = 1; i <= nPoints; i ++)
+		for (integer j = 1; j <= nPoints; j ++)
+			if (i != j && my data [i] [j] != c)
+				return 0.0;
+	return c;
+}
 
-	autoMAT b = raw_MAT (nPoints, nPoints);
-	autoDistance distZ = Configuration_to_Distance (cz);
-	/*
-		compute B(Z) (eq. 8.25)
-	*/
-	for (integer i = 1; i <= nPoints; i ++) {
-		longdouble sum = 0.0;
+/*
+	Guttman transform: X = (V+)B(Z)Z (eq. 8.29).
+	Row i of B(Z)Z equals sum_(j != i) b [i] [j] (z [j] - z [i]), with b [i] [j] = - w [i] [j] fit [i] [j] / d [i] [j] (eq. 8.25),
+	so we never need B itself. The columns of B(Z)Z sum to zero, hence for uniform weights (V+)B(Z)Z = B(Z)Z / (n c).
+*/
+static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance distZ, Distance disp, Weight weight, double uniformWeight, constMAT vplus) {
+	const integer nPoints = cx -> numberOfRows, nDimensions = cx -> numberOfColumns;
+	autoMAT bz = raw_MAT (nPoints, nDimensions);
+	MelderThread_PARALLELIZE (nPoints, 50)
+	autoVEC sum = raw_VEC (nDimensions);
+	MelderThread_FOR (i) {
+		constVEC zi = cz -> data.row (i), dzi = distZ -> data.row (i), fiti = disp -> data.row (i), wi = weight -> data.row (i);
+		sum.all()  <<=  0.0;
 		for (integer j = 1; j <= nPoints; j ++) {
-			const double dzij = distZ -> data [i] [j];
-			if (i == j || dzij == 0.0)
+			const double dzij = dzi [j];
+			if (j == i || dzij == 0.0)
 				continue;
-			b [i] [j] = - weight -> data [i] [j] * disp -> data [i] [j] / dzij;
-			sum += b [i] [j];
-		}
-		b [i] [i] = - (double) sum;
-	}
-	/*
-		Guttman transform: Xu = (V+)B(Z)Z (eq. 8.29)
-	*/
-	for (integer i = 1; i <= nPoints; i ++) {
-		for (integer j = 1; j <= nDimensions; j ++) {
-			longdouble xij = 0.0;
-			for (integer k = 1;  k <= nPoints; k ++) {
-				for (integer l = 1; l <= nPoints; l ++) {
-					xij += vplus [i] [k] * b [k] [l] * cz -> data [l] [j];
-				}
-			}
-			cx -> data [i] [j] = (double) xij;
+			const double bij = - wi [j] * fiti [j] / dzij;
+			constVEC zj = cz -> data.row (j);
+			for (integer k = 1; k <= nDimensions; k ++)
+				sum [k] += bij * (zj [k] - zi [k]);
 		}
-	}
+		bz.row (i)  <<=  sum.all();
+	} MelderThread_ENDFOR
+	if (uniformWeight > 0.0) {
+		cx -> data.all()  <<=  bz.all();
+		cx -> data.all()  /=  nPoints * uniformWeight;
+	} else
+		mul_fast_MAT_out (cx -> data.get(), vplus, bz.get());
 }
 
 double Distance_Weight_stress (Distance fit, Distance conf, Weight weight, kMDS_stressMeasure stressMeasure) {
@@ -1252,16 +1264,30 @@ double Distance_Weight_stress (Distance fit, Distance conf, Weight weight, kMDS_
 void Distance_Weight_rawStressComponents (Distance fit, Distance conf, Weight weight, double *out_etafit, double *out_etaconf, double *out_rho)
 {
 	const integer nPoints = conf -> numberOfRows;
-	longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
-	for (integer i = 1; i <= nPoints - 1; i ++) {
+	/*
+		Per-row partial sums, added in row order afterwards, so that the result does not depend on the number of threads.
+	*/
+	autoMAT partial = zero_MAT (nPoints, 3);
+	MelderThread_PARALLELIZE (nPoints - 1, 200)
+	MelderThread_FOR (i) {
 		constVEC wi = weight -> data.row (i);
 		constVEC fiti = fit -> data.row (i);
 		constVEC confi = conf -> data.row (i);
+		longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
 		for (integer j = i + 1; j <= nPoints; j ++) {
 			etafit += wi [j] * fiti [j] * fiti [j];
 			etaconf += wi [j] * confi [j] * confi [j];
 			rho += wi [j] * fiti [j] * confi [j];
 		}
+		partial [i] [1] = (double) etafit;
+		partial [i] [2] = (double) etaconf;
+		partial [i] [3] = (double) rho;
+	} MelderThread_ENDFOR
+	longdouble etafit = 0.0, etaconf = 0.0, rho = 0.0;
+	for (integer i = 1; i <= nPoints - 1; i ++) {
+		etafit += partial [i] [1];
+		etaconf += partial [i] [2];
+		rho += partial [i] [3];
 	}
 	if (out_etafit)
 		*out_etafit = (double) etafit;
@@ -1363,35 +1389,37 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 			aw = Weight_create (nPoints);
 			weight = aw.get();
 		}
-		autoMAT v = raw_MAT (nPoints, nPoints);
 		autoConfiguration z = Data_copy (conf);
 		autoMDSVec vec = Dissimilarity_to_MDSVec (me);
 
 		if (showProgress)
 			Melder_progress (0.0, U"MDS analysis");
 
-		// Get V (eq. 8.19).
-
-		for (integer irow = 1; irow <= nPoints; irow ++) {
-			longdouble wsum = 0.0;
-			for (integer icol = 1; icol <= nPoints; icol ++) {
-				if (irow != icol) {
-					v [irow] [icol] = -  weight -> data [irow] [icol];
-					wsum +=  weight -> data [irow] [icol];
+		const double uniformWeight = Weight_getUniformWeight (weight);
+		autoMAT vplus;
+		if (uniformWeight == 0.0) {
+			// Get V (eq. 8.19).
+			autoMAT v = raw_MAT (nPoints, nPoints);
+			for (integer irow = 1; irow <= nPoints; irow ++) {
+				longdouble wsum = 0.0;
+				for (integer icol = 1; icol <= nPoints; icol ++) {
+					if (irow != icol) {
+						v [irow] [icol] = -  weight -> data [irow] [icol];
+						wsum +=  weight -> data [irow] [icol];
+					}
 				}
+				v [irow] [irow] = (double) wsum;
 			}
-			v [irow] [irow] = (double) wsum;
+			/*
+				V is row and column centered and therefore: rank(V) <= nPoints-1.
+				V^-1 does not exist -> get Moore-Penrose inverse.
+			*/
+			constexpr double tol = 1e-6;
+			vplus = newMATpseudoInverse (v.get(), tol);
 		}
-
-		/*
-			V is row and column centered and therefore: rank(V) <= nPoints-1.
-			V^-1 does not exist -> get Moore-Penrose inverse.
-		*/
-		constexpr double tol = 1e-6;
-		autoMAT vplus = newMATpseudoInverse (v.get(), tol);
 		double stressp = 1e308, stress = 0.0;
+		autoDistance dist = Configuration_to_Distance (conf);   // of conf == z
 		for (integer iter = 1; iter <= numberOfIterations; iter ++) {
-			autoDistance dist = Configuration_to_Distance (conf);
 			/*
 				transform & normalization
 			*/
@@ -1399,7 +1427,7 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 			/*
 				Make conf the Guttman transform of z
 			*/
-			smacof_guttmanTransform (conf, z.get(), fit.get(), weight, vplus.get());
+			smacof_guttmanTransform (conf, z.get(), dist.get(), fit.get(), weight, uniformWeight, vplus.get());
 			/*
 				Compute stress
 			*/
@@ -1414,6 +1442,7 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 				Make Z = X
 			*/
 			z -> data.all()  <<=  conf -> data.all();
+			dist = cdist.move();
 
 			stressp = stress;
 			if (showProgress)
@@ -1572,6 +1601,131 @@ autoConfiguration Dissimilarity_Weight_ispline_mds (Dissimilarity me, Weight w,
 	}
 }
 
+/***** landmark **/
+
+/*
+	Maxmin selection: the first landmark is a random point, every next landmark is the point
+	with the largest dissimilarity to its nearest landmark chosen so far.
+*/
+static autoINTVEC Dissimilarity_getMaxminLandmarks (Dissimilarity me, integer numberOfLandmarks) {
+	const integer nPoints = my numberOfRows;
+	autoINTVEC landmarks = raw_INTVEC (numberOfLandmarks);
+	autoVEC minimumDissimilarity = raw_VEC (nPoints);
+	minimumDissimilarity.all()  <<=  INFINITY;
+	integer landmark = NUMrandomInteger (1, nPoints);
+	for (integer ilandmark = 1; ilandmark <= numberOfLandmarks; ilandmark ++) {
+		landmarks [ilandmark] = landmark;
+		integer farthest = 0;
+		double maximum = -1.0;
+		for (integer i = 1; i <= nPoints; i ++) {
+			const double delta = 0.5 * (my data [i] [landmark] + my data [landmark] [i]);
+			if (delta < minimumDissimilarity [i])
+				minimumDissimilarity [i] = delta;
+			if (minimumDissimilarity [i] > maximum) {
+				maximum = minimumDissimilarity [i];
+				farthest = i;
+			}
+		}
+		landmark = farthest;
+	}
+	return landmarks;
+}
+
+autoConfiguration Dissimilarity_to_Configuration_landmark_mds (Dissimilarity me, integer numberOfDimensions, integer numberOfLandmarks,
+	integer numberOfRefinementIterations, double tolerance, integer numberOfIterations, integer numberOfRepetitions, bool showProgress)
+{
+	try {
+		const integer nPoints = my numberOfRows;
+		numberOfLandmarks = std::min (numberOfLandmarks, nPoints);
+		Melder_require (numberOfLandmarks > numberOfDimensions,
+			U"The number of landmarks should be larger than the number of dimensions.");
+		/*
+			1. Scale the landmarks with smacof (ratio transformation).
+		*/
+		autoINTVEC landmarks = Dissimilarity_getMaxminLandmarks (me, numberOfLandmarks);
+		autoINTVEC landmarkNumber = zero_INTVEC (nPoints);   // 0 for non-landmarks
+		autoDissimilarity landmarkDissimilarity = Dissimilarity_create (numberOfLandmarks);
+		for (integer k = 1; k <= numberOfLandmarks; k ++) {
+			landmarkNumber [landmarks [k]] = k;
+			TableOfReal_setRowLabel (landmarkDissimilarity.get(), k, my rowLabels [landmarks [k]].get());
+			TableOfReal_setColumnLabel (landmarkDissimilarity.get(), k, my rowLabels [landmarks [k]].get());
+			for (integer l = 1; l <= numberOfLandmarks; l ++)
+				landmarkDissimilarity -> data [k] [l] = ( k == l ? 0.0 :
+						0.5 * (my data [landmarks [k]] [landmarks [l]] + my data [landmarks [l]] [landmarks [k]]) );
+		}
+		autoConfiguration landmarkConfiguration = Dissimilarity_Weight_ratio_mds (landmarkDissimilarity.get(), nullptr,
+			numberOfDimensions, tolerance, numberOfIterations, numberOfRepetitions, showProgress);
+		constMAT xl = landmarkConfiguration -> data.get();
+		/*
+			The smacof configuration approximates the dissimilarities up to a scale factor.
+		*/
+		autoDistance landmarkDistance = Configuration_to_Distance (landmarkConfiguration.get());
+		longdouble deltaDistance = 0.0, deltaSquared = 0.0;
+		for (integer k = 1; k < numberOfLandmarks; k ++) {
+			for (integer l = k + 1; l <= numberOfLandmarks; l ++) {
+				const double delta = landmarkDissimilarity -> data [k] [l];
+				deltaDistance += delta * landmarkDistance -> data [k] [l];
+				deltaSquared += delta * delta;
+			}
+		}
+		Melder_require (deltaSquared > 0.0,
+			U"The dissimilarities between the landmarks should not all be zero.");
+		const double scale = double (deltaDistance / deltaSquared);
+		/*
+			2. Place every other point by distance-based triangulation (Gower's add-a-point):
+			with centred landmark coordinates Xc, x = centroid + 1/2 pinv (Xc) (|xc_k|^2 - delta_k^2).
+		*/
+		autoVEC centroid = columnMeans_VEC (xl);
+		autoMAT xc = copy_MAT (xl);
+		for (integer k = 1; k <= numberOfLandmarks; k ++)
+			xc.row (k)  -=  centroid.all();
+		autoVEC squaredNorm = raw_VEC (numberOfLandmarks);
+		for (integer k = 1; k <= numberOfLandmarks; k ++)
+			squaredNorm [k] = NUMsum2 (xc.row (k));
+		autoMAT pinv = newMATpseudoInverse (xc.get(), 1e-12);   // numberOfDimensions x numberOfLandmarks
+
+		autoConfiguration thee = Configuration_create (nPoints, numberOfDimensions);
+		TableOfReal_copyLabels (me, thee.get(), 1, 0);
+		MelderThread_PARALLELIZE (nPoints, 100)
+		autoVEC rhs = raw_VEC (numberOfLandmarks), delta = raw_VEC (numberOfLandmarks), x = raw_VEC (numberOfDimensions);
+		MelderThread_FOR (i) {
+			VEC xi = thy data.row (i);
+			if (landmarkNumber [i] > 0) {
+				xi  <<=  xl.row (landmarkNumber [i]);
+				continue;
+			}
+			for (integer k = 1; k <= numberOfLandmarks; k ++) {
+				delta [k] = scale * 0.5 * (my data [i] [landmarks [k]] + my data [landmarks [k]] [i]);
+				rhs [k] = 0.5 * (squaredNorm [k] - delta [k] * delta [k]);
+			}
+			mul_VEC_out (xi, pinv.get(), rhs.get());
+			xi  +=  centroid.all();
+			/*
+				3. Refine by majorization of the stress with respect to the (fixed) landmarks:
+				x <- (1/L) sum_k (x_k + delta_k (x - x_k) / |x - x_k|).
+			*/
+			for (integer iter = 1; iter <= numberOfRefinementIterations; iter ++) {
+				x.all()  <<=  0.0;
+				for (integer k = 1; k <= numberOfLandmarks; k ++) {
+					constVEC xk = xl.row (k);
+					double d = 0.0;
+					for (integer j = 1; j <= numberOfDimensions; j ++)
+						d += (xi [j] - xk [j]) * (xi [j] - xk [j]);
+					d = sqrt (d);
+					const double factor = ( d > 0.0 ? delta [k] / d : 0.0 );
+					for (integer j = 1; j <= numberOfDimensions; j ++)
+						x [j] += xk [j] + factor * (xi [j] - xk [j]);
+				}
+				for (integer j = 1; j <= numberOfDimensions; j ++)
+					xi [j] = x [j] / numberOfLandmarks;
+			}
+		} MelderThread_ENDFOR
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": no Configuration created (landmark mds method).");
+	}
+}
+
 /***** classical **/
 
 static void MDSVec_Distances_getStressValues (MDSVec me, Distance ddist, Distance dfit, kMDS_KruskalStress stress_formula, double *out_stress, double *out_s, double *out_t, double *out_dbar) {
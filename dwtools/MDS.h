@@ -249,6 +249,15 @@ autoConfiguration Dissimilarity_Weight_ispline_mds (Dissimilarity me, Weight wei
 	double tolerance, integer numberOfIterations, integer numberOfRepetitions, bool showProgress
 );
 
+autoConfiguration Dissimilarity_to_Configuration_landmark_mds (Dissimilarity me, integer numberOfDimensions, integer numberOfLandmarks,
+	integer numberOfRefinementIterations, double tolerance, integer numberOfIterations, integer numberOfRepetitions, bool showProgress
+);
+/*
+	Ratio mds on a maxmin subset of landmarks only; the other points are placed by triangulation
+	with respect to the landmarks and then refined by a few majorization steps.
+	Needs O(numberOfPoints * numberOfLandmarks) time instead of O(numberOfPoints^2) per iteration.
+*/
+
 void Dissimilarity_Configuration_Weight_drawAbsoluteRegression (Dissimilarity d, Configuration c, Weight w, Graphics g,
 	double xmin, double xmax, double ymin, double ymax,
 	double size_mm, conststring32 mark, bool garnish
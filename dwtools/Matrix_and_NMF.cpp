@@ -1,6 +1,6 @@
 /* Matrix_and_NMF.cpp
  *
- * Copyright (C) 2019 David Weenink
+ * Copyright (C) 2019,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -81,4 +81,56 @@ void NMF_Matrix_improveFactorization_is (NMF me, Matrix thee, integer maximumNum
 	NMF_improveFactorization_is (me, thy z.get(), maximumNumberOfIterations, changeTolerance, approximationTolerance, info);
 }
 
+void NMF_improveFactorization_mu_matrixBinaryFile (NMF me, MelderFile file, integer blockSize, bool online,
+	integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info)
+{
+	try {
+		autofile f = Melder_fopen (file, "rb");
+		char firstBytes [12];
+		Melder_require (fread (firstBytes, 1, 12, f) == 12 && strnequ (firstBytes, "ooBinaryFile", 12),
+			U"The file should be a Praat binary file.");
+		autostring32 className = bingetw8 (f);
+		Melder_require (str32equ (className.get(), Melder_cat (classMatrix -> className, U" ", classMatrix -> version)),
+			U"The file should contain a Matrix saved by a recent version of Praat, not a ", className.get(), U".");
+		/*
+			The attributes of the Matrix, in the order of Function_def.h, Sampled_def.h and SampledXY_def.h;
+			the cells follow, row after row.
+		*/
+		bingetr64 (f);   // xmin
+		bingetr64 (f);   // xmax
+		const integer numberOfColumns = bingetinteger32BE (f);
+		bingetr64 (f);   // dx
+		bingetr64 (f);   // x1
+		bingetr64 (f);   // ymin
+		bingetr64 (f);   // ymax
+		const integer numberOfRows = bingetinteger32BE (f);
+		bingetr64 (f);   // dy
+		bingetr64 (f);   // y1
+		const off_t startOfData = ftello (f);
+		Melder_require (numberOfRows == my numberOfRows && numberOfColumns == my numberOfColumns,
+			U"The dimensions of the NMF and the Matrix should match.");
+		Melder_require (blockSize > 0,
+			U"The block size should be positive.");
+		autoMAT block = raw_MAT (numberOfRows, std::min (blockSize, numberOfColumns));
+		NMF_improveFactorization_mu_blocks (me,
+			[&] (integer firstColumn, integer lastColumn) -> constMATVU {
+				MATVU columns = block.verticalBand (1, lastColumn - firstColumn + 1);
+				for (integer irow = 1; irow <= numberOfRows; irow ++) {
+					const off_t startOfRowPart = startOfData + off_t (sizeof (double)) * ((irow - 1) * numberOfColumns + firstColumn - 1);
+					Melder_require (fseeko (f, startOfRowPart, SEEK_SET) == 0,
+						U"Cannot find row ", irow, U" in file ", file, U".");
+					for (integer icol = 1; icol <= columns.ncol; icol ++)
+						columns [irow] [icol] = bingetr64 (f);
+				}
+				Melder_require (NUMisNonNegative (columns),
+					U"No matrix elements should be negative.");
+				return columns;
+			},
+			blockSize, online, maximumNumberOfIterations, changeTolerance, approximationTolerance, info
+		);
+	} catch (MelderError) {
+		Melder_throw (me, U": factorization not improved from ", file, U".");
+	}
+}
+
 /* End of file Matrix_and_NMF.cpp */
@@ -2,7 +2,7 @@
 #define _Matrix_and_NMF_h_
 /* Matrix_and_NMF.h
  * 
- * Copyright (C) 2019 David Weenink
+ * Copyright (C) 2019,2026 David Weenink
  * 
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -29,6 +29,13 @@ void NMF_Matrix_improveFactorization_mu (NMF me, Matrix thee, integer maximumNum
 void NMF_Matrix_improveFactorization_als (NMF me, Matrix thee, integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info);
 void NMF_Matrix_improveFactorization_is (NMF me, Matrix thee, integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info);
 
+/*
+	The Matrix is read from a Praat binary file, one block of columns at a time,
+	so that it never has to be in memory as a whole.
+*/
+void NMF_improveFactorization_mu_matrixBinaryFile (NMF me, MelderFile file, integer blockSize, bool online,
+	integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info);
+
 autoMatrix NMF_to_Matrix (NMF me);
 
 #endif /* _Matrix_and_NMF_h_ */
@@ -37,6 +37,7 @@
 #include "Eigen_and_TableOfReal.h"
 #include "Matrix_extensions.h"
 #include "NUM2.h"
+#include "NUMmachar.h"
 #include "PCA.h"
 #include "TableOfReal_extensions.h"
 
@@ -192,6 +193,175 @@ autoPCA TableOfReal_to_PCA_byRows (TableOfReal me) {
 	}
 }
 
+/*
+	Truncated PCA.
+
+	The data are read in blocks of rows, which are centred on the fly,
+	so that no centred copy of the whole table is needed and the time is linear in the number of rows.
+	If the number of columns is small compared to the number of components,
+	we accumulate the sums of squares and cross products block by block and
+	compute the eigenvectors of this (numberOfColumns x numberOfColumns) matrix.
+	Otherwise we never form that matrix, but find the dominant subspace by randomized subspace iteration
+	(Halko, Martinsson & Tropp 2011, algorithm 4.4), where each multiplication by the SSCP matrix
+	is a pass over the blocks; finally, the components are found in that subspace by Rayleigh-Ritz.
+	All the products are done by the (multithreaded) matrix multiplication kernels.
+*/
+struct PCA_CentredRowBlocks {
+	constMATVU data;
+	autoVEC centroid;
+	integer numberOfRowsPerBlock;
+	autoMAT block;
+
+	void init (constMATVU const& m) {
+		our data = m;
+		our numberOfRowsPerBlock = std::min (m.nrow, std::max (64_integer, (1_integer << 21) / m.ncol));
+		our block = raw_MAT (numberOfRowsPerBlock, m.ncol);
+		/*
+			The centroid, block by block.
+		*/
+		autovector <longdouble> sum = newvectorzero <longdouble> (m.ncol);
+		autoVEC blockSum = raw_VEC (m.ncol);
+		for (integer iblock = 1; iblock <= numberOfBlocks (); iblock ++) {
+			blockSum.all()  <<=  0.0;
+			const integer firstRow = (iblock - 1) * numberOfRowsPerBlock + 1;
+			const integer lastRow = std::min (firstRow + numberOfRowsPerBlock - 1, m.nrow);
+			for (integer irow = firstRow; irow <= lastRow; irow ++)
+				blockSum.all()  +=  m.row (irow);
+			for (integer icol = 1; icol <= m.ncol; icol ++)
+				sum [icol] += blockSum [icol];
+		}
+		our centroid = raw_VEC (m.ncol);
+		for (integer icol = 1; icol <= m.ncol; icol ++)
+			our centroid [icol] = double (sum [icol] / m.nrow);
+	}
+	integer numberOfBlocks () const {
+		return (our data.nrow - 1) / our numberOfRowsPerBlock + 1;
+	}
+	MATVU centredBlock (integer iblock) {
+		const integer firstRow = (iblock - 1) * numberOfRowsPerBlock + 1;
+		const integer lastRow = std::min (firstRow + numberOfRowsPerBlock - 1, our data.nrow);
+		MATVU result = our block.horizontalBand (1, lastRow - firstRow + 1);
+		result  <<=  our data.part (firstRow, lastRow, 1, our data.ncol);
+		for (integer irow = 1; irow <= result.nrow; irow ++)
+			result.row (irow)  -=  our centroid.all();
+		return result;
+	}
+};
+
+/*
+	Modified Gram-Schmidt, twice, on the rows.
+	A row that is (numerically) dependent on the previous rows is replaced by a random direction.
+*/
+static void orthonormalizeRows_MAT_inout (MAT const& m) {
+	for (integer irow = 1; irow <= m.nrow; irow ++) {
+		VEC row = m.row (irow);
+		for (integer itry = 1; itry <= 3; itry ++) {
+			const double originalNorm = NUMnorm (row, 2.0);
+			for (integer ipass = 1; ipass <= 2; ipass ++)
+				for (integer jrow = 1; jrow < irow; jrow ++)
+					row  -=  NUMinner (row, m.row (jrow)) * m.row (jrow);
+			const double norm = NUMnorm (row, 2.0);
+			if (norm > 1e-10 * originalNorm) {
+				row  /=  norm;
+				break;
+			}
+			randomGauss_VEC_out (row, 0.0, 1.0);
+		}
+	}
+}
+
+autoPCA TableOfReal_to_PCA_byRows_truncated (TableOfReal me, integer numberOfComponents, integer numberOfPowerIterations) {
+	try {
+		constMAT m = my data.get();
+		Melder_require (m.nrow > 1,
+			U"The number of rows should be larger than 1.");
+		Melder_require (numberOfComponents > 0 && numberOfComponents <= m.ncol,
+			U"The number of components should be in the range from 1 to ", m.ncol, U".");
+		Melder_require (numberOfPowerIterations >= 0,
+			U"The number of power iterations should not be negative.");
+		Melder_require (NUMdefined (m),
+			U"All matrix elements should be defined.");
+		PCA_CentredRowBlocks blocks;
+		blocks.init (m);
+
+		const integer numberOfOversamples = 10;
+		const integer subspaceDimension = std::min (numberOfComponents + numberOfOversamples, m.ncol);
+		autoMAT eigenvectors;   // row-wise
+		autoVEC eigenvalues;
+		if (m.ncol <= 4 * (numberOfPowerIterations + 1) * subspaceDimension) {
+			/*
+				Forming the SSCP matrix is cheaper than the passes of the subspace iteration.
+			*/
+			autoMAT sscp = zero_MAT (m.ncol, m.ncol), blockSSCP = raw_MAT (m.ncol, m.ncol);
+			for (integer iblock = 1; iblock <= blocks.numberOfBlocks (); iblock ++) {
+				mtm_MAT_out (blockSSCP.get(), blocks.centredBlock (iblock));
+				sscp.all()  +=  blockSSCP.all();
+			}
+			MAT_getEigenSystemFromSymmetricMatrix (sscp.get(), & eigenvectors, & eigenvalues, false);
+		} else {
+			autoMAT basis = randomGauss_MAT (subspaceDimension, m.ncol, 0.0, 1.0);   // row-wise
+			orthonormalizeRows_MAT_inout (basis.get());
+			autoMAT projection = raw_MAT (blocks.numberOfRowsPerBlock, subspaceDimension);
+			autoMAT product = raw_MAT (subspaceDimension, m.ncol);
+			for (integer iteration = 0; iteration <= numberOfPowerIterations; iteration ++) {
+				/*
+					product = basis . SSCP, i.e. the sum over the blocks of (block . basis')' . block
+				*/
+				product.all()  <<=  0.0;
+				for (integer iblock = 1; iblock <= blocks.numberOfBlocks (); iblock ++) {
+					MATVU block = blocks.centredBlock (iblock);
+					MATVU y = projection.horizontalBand (1, block.nrow);
+					mul_fast_MAT_out (y, block, basis.transpose());
+					mulAdd_MAT_inout (product.all(), y.transpose(), block);
+				}
+				basis.all()  <<=  product.all();
+				orthonormalizeRows_MAT_inout (basis.get());
+			}
+			/*
+				Rayleigh-Ritz: the eigenvectors of basis . SSCP . basis' within the subspace.
+			*/
+			autoMAT reduced = zero_MAT (subspaceDimension, subspaceDimension), blockReduced = raw_MAT (subspaceDimension, subspaceDimension);
+			for (integer iblock = 1; iblock <= blocks.numberOfBlocks (); iblock ++) {
+				MATVU block = blocks.centredBlock (iblock);
+				MATVU y = projection.horizontalBand (1, block.nrow);
+				mul_fast_MAT_out (y, block, basis.transpose());
+				mtm_MAT_out (blockReduced.get(), y);
+				reduced.all()  +=  blockReduced.all();
+			}
+			autoMAT reducedEigenvectors;
+			MAT_getEigenSystemFromSymmetricMatrix (reduced.get(), & reducedEigenvectors, & eigenvalues, false);
+			eigenvectors = mul_MAT (reducedEigenvectors.get(), basis.get());
+		}
+		/*
+			As in Eigen_initFromSquareRoot, we drop the components whose eigenvalues are zero within rounding.
+		*/
+		if (! NUMfpp)
+			NUMmachar ();
+		const double tolerance = NUMfpp -> eps * m.ncol * std::max (eigenvalues [1], 0.0);
+		integer numberOfEigenvalues = 0;
+		while (numberOfEigenvalues < numberOfComponents && eigenvalues [numberOfEigenvalues + 1] > tolerance)
+			numberOfEigenvalues ++;
+		Melder_require (numberOfEigenvalues > 0,
+			U"Not all values in your table should be zero.");
+
+		autoPCA thee = Thing_new (PCA);
+		Eigen_init (thee.get(), numberOfEigenvalues, m.ncol);
+		thy eigenvectors.all()  <<=  eigenvectors.horizontalBand (1, numberOfEigenvalues);
+		/*
+			The covariance matrix C = A'A / (N-1).
+		*/
+		for (integer i = 1; i <= numberOfEigenvalues; i ++)
+			thy eigenvalues [i] = eigenvalues [i] / (m.nrow - 1);
+		thy centroid = copy_VEC (blocks.centroid.get());
+		thy labels = autoSTRVEC (m.ncol);
+		thy labels.all()  <<=  my columnLabels.all();
+		PCA_setNumberOfObservations (thee.get(), m.nrow);
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": truncated PCA not created.");
+	}
+}
+
 autoPCA Matrix_to_PCA_byColumns (Matrix me) {
 	try {
 		autoPCA thee = MAT_to_PCA (my z.get(), true);
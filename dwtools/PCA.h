@@ -41,6 +41,13 @@ integer PCA_getNumberOfObservations (PCA me);
 
 autoPCA TableOfReal_to_PCA_byRows (TableOfReal me);
 
+autoPCA TableOfReal_to_PCA_byRows_truncated (TableOfReal me, integer numberOfComponents, integer numberOfPowerIterations);
+/*
+	Only the first `numberOfComponents` components, in time linear in the number of rows.
+	The power iterations are only used if the number of columns is large compared to the number of components;
+	see PCA.cpp.
+*/
+
 autoEigen PCA_to_Eigen (PCA me);
 
 /* Calculate PCA of M'M */
@@ -48,10 +48,6 @@ autoPitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceilin
 
 		autoPitch thee = Pitch_create (my xmin, my xmax, my nx, my dx, my x1, ceiling, maxnCandidates);
 		autoVEC power = raw_VEC (my nx);
-		autoVEC pitch = raw_VEC (numberOfFrequencyPoints);
-		autoVEC sumspec = raw_VEC (numberOfFrequencyPoints);
-		autoVEC y = raw_VEC (my ny);
-		autoVEC yv2 = raw_VEC (my ny);
 		autoVEC fl2 = raw_VEC (my ny);
 		/*
 			From ERB's to log (f)
@@ -60,10 +56,19 @@ autoPitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceilin
 			const double f = NUMerbToHertz (my y1 + (i - 1) * my dy);
 			fl2 [i] = NUMlog2 (f);
 		}
+		/*
+			The harmonic shifts and weights of formula (8), the same for all frames.
+		*/
+		autoINTVEC harmonicOffsets = raw_INTVEC (maxHarmonic);
+		autoVEC harmonicWeights = raw_VEC (maxHarmonic);
+		for (integer m = 1; m <= maxHarmonic; m ++) {
+			harmonicWeights [m] = 1 - harmonicFallOffSlope * NUMlog2 (m);
+			harmonicOffsets [m] = Melder_ifloor (nPointsPerOctave * NUMlog2 (m));
+		}
 		/*
 			Determine global maximum power in frame
 		*/
-		double maxStrength = 0.0, maxPower = 0.0;
+		double maxPower = 0.0;
 		for (integer j = 1; j <= my nx; j ++) {
 			const double p = NUMsum (my s.column (j));
 			if (p > maxPower)
@@ -72,8 +77,20 @@ autoPitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceilin
 		}
 		Melder_require (maxPower != 0.0,
 			U"The sound should not have all amplitudes equal to zero.");
+		/*
+			The frames are independent, except for the normalization by the strongest candidate of all frames,
+			which therefore is done afterwards.
+		*/
+		autoVEC maximumStrengths = zero_VEC (my nx);
 
-		for (integer j = 1; j <= my nx; j ++) {
+		MelderThread_PARALLELIZE (my nx, 20)
+
+		autoVEC pitch = raw_VEC (numberOfFrequencyPoints);
+		autoVEC sumspec = raw_VEC (numberOfFrequencyPoints);
+		autoVEC y = raw_VEC (my ny);
+		autoVEC yv2 = raw_VEC (my ny);
+
+		MelderThread_FOR (j) {
 			const Pitch_Frame pitchFrame = & thy frames [j];
 
 			pitchFrame -> intensity = power [j] / maxPower;
@@ -89,8 +106,8 @@ autoPitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceilin
 				Formula (8): weighted harmonic summation.
 			*/
 			for (integer m = 1; m <= maxHarmonic; m ++) {
-				const double hm = 1 - harmonicFallOffSlope * NUMlog2 (m);
-				const integer kb = 1 + Melder_ifloor (nPointsPerOctave * NUMlog2 (m));   // TODO: what is kb?
+				const double hm = harmonicWeights [m];
+				const integer kb = 1 + harmonicOffsets [m];
 				for (integer k = kb; k <= numberOfFrequencyPoints; k ++)
 					if (pitch [k] > 0.0)
 						sumspec [k - kb + 1] += pitch [k] * hm;
@@ -109,15 +126,16 @@ autoPitch SPINET_to_Pitch (SPINET me, double harmonicFallOffSlope, double ceilin
 					const double x = dfl2 * (y1 - y3) / (2 * denum);
 					const double f = pow (2.0, fminl2 + (k - 1) * dfl2 + x);
 					const double strength = (2.0 * y1 * (4.0 * y2 + y3) - y1 * y1 - tmp * tmp) / (8.0 * denum);
-					if (strength > maxStrength)
-						maxStrength = strength;
+					if (strength > maximumStrengths [j])
+						maximumStrengths [j] = strength;
 					Pitch_Frame_addPitch (pitchFrame, f, strength, maxnCandidates);
 				}
 			}
-		}
+		} MelderThread_ENDFOR
 
 		// Scale the pitch strengths
 
+		const double maxStrength = NUMmax_u (maximumStrengths.get());
 		for (integer j = 1; j <= my nx; j ++) {
 			double f0, localStrength;
 			Pitch_Frame_getPitch (& thy frames [j], & f0, & localStrength);
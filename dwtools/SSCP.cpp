@@ -1,6 +1,6 @@
 /* SSCP.cpp
  *
- * Copyright (C) 1993-2020 David Weenink
+ * Copyright (C) 1993-2020,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -442,6 +442,48 @@ autoSSCP TableOfReal_to_SSCP (TableOfReal me, integer rowb, integer rowe, intege
 	}
 }
 
+void SSCP_addRows (SSCP me, constMATVU const& rows) {
+	try {
+		Melder_require (my numberOfRows == my numberOfColumns && my expansionNumberOfRows == 0,
+			U"The SSCP should have a complete matrix.");
+		Melder_require (rows.ncol == my numberOfColumns,
+			U"The number of columns should equal the dimension of the SSCP (", my numberOfColumns, U").");
+		Melder_require (NUMdefined (rows),
+			U"All the elements should be defined.");
+		if (rows.nrow == 0)
+			return;
+		/*
+			The sums of squares and cross products of the block around its own centroid,
+			combined with ours as in Chan, Golub & LeVeque (1979):
+				SSCP = SSCP1 + SSCP2 + n1 n2 / n (c2 - c1)(c2 - c1)'
+		*/
+		autoMAT centred = copy_MAT (rows);
+		autoVEC blockCentroid = columnMeans_VEC (rows);
+		centred.all()  -=  blockCentroid.all();
+		autoMAT blockSSCP = raw_MAT (my numberOfColumns, my numberOfColumns);
+		mtm_MAT_out (blockSSCP.get(), centred.get());
+		const double n1 = my numberOfObservations, n2 = rows.nrow, n = n1 + n2;
+		autoVEC delta = raw_VEC (my numberOfColumns);
+		for (integer icol = 1; icol <= my numberOfColumns; icol ++)
+			delta [icol] = blockCentroid [icol] - my centroid [icol];
+		const double weight = n1 * n2 / n;
+		for (integer irow = 1; irow <= my numberOfColumns; irow ++)
+			for (integer icol = 1; icol <= my numberOfColumns; icol ++)
+				my data [irow] [icol] += blockSSCP [irow] [icol] + weight * delta [irow] * delta [icol];
+		for (integer icol = 1; icol <= my numberOfColumns; icol ++)
+			my centroid [icol] += delta [icol] * n2 / n;
+		my numberOfObservations = n;
+	} catch (MelderError) {
+		Melder_throw (me, U": rows not added.");
+	}
+}
+
+void SSCP_TableOfReal_addRows (SSCP me, TableOfReal thee, integer fromRow, integer toRow, integer fromColumn, integer toColumn) {
+	fixAndCheckRowRange (& fromRow, & toRow, thy data.get(), 1);
+	fixAndCheckColumnRange (& fromColumn, & toColumn, thy data.get(), 1);
+	SSCP_addRows (me, thy data.part (fromRow, toRow, fromColumn, toColumn));
+}
+
 autoSSCP TableOfReal_to_SSCP_rowWeights (TableOfReal me, integer rowb, integer rowe, integer colb, integer cole, integer weightColumnNumber) {
 	try {
 		Melder_require (NUMdefined (my data.get()),
@@ -812,9 +854,14 @@ void SSCP_expandWithLowerCholeskyInverse (SSCP me) {
 	if (NUMisEmpty (my lowerCholeskyInverse.get()))
 		my lowerCholeskyInverse = raw_MAT (my numberOfColumns, my numberOfColumns);
 	if (my numberOfRows == 1) {   // diagonal
+		/*
+			Store the inverse as a full diagonal matrix, as for a singular matrix below,
+			because NUMmahalanobisDistanceSquared only recognizes a one-row matrix as diagonal.
+		*/
+		my lowerCholeskyInverse.all()  <<=  0.0;
 		my lnd = 0.0;
 		for (integer j = 1; j <= my numberOfColumns; j ++) {
-			my lowerCholeskyInverse [1] [j] = 1.0 / sqrt (my data [1] [j]);   // inverse is 1/stddev
+			my lowerCholeskyInverse [j] [j] = 1.0 / sqrt (my data [1] [j]);   // inverse is 1/stddev
 			my lnd += log (my data [1] [j]);   // diagonal elmnt is variance
 		}
 	} else {
@@ -2,7 +2,7 @@
 #define _SSCP_h_
 /* SSCP.h
  *
- * Copyright (C) 1993-2020 David Weenink
+ * Copyright (C) 1993-2020,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -66,6 +66,15 @@ double SSCP_getConcentrationEllipseArea(SSCP me, double scale, bool confidence,
 double SSCP_getFractionVariation (SSCP me, integer from, integer to);
 
 autoSSCP TableOfReal_to_SSCP (TableOfReal me, integer rowb, integer rowe, integer colb, integer cole);
+
+void SSCP_addRows (SSCP me, constMATVU const& rows);
+/*
+	Accumulate more observations, e.g. a table that does not fit in memory, block by block:
+	afterwards me is the SSCP of the old and the new observations together (and SSCP_to_PCA gives their PCA).
+	Starts from SSCP_create or SSCP_reset (no observations) or from an SSCP of earlier rows.
+*/
+
+void SSCP_TableOfReal_addRows (SSCP me, TableOfReal thee, integer fromRow, integer toRow, integer fromColumn, integer toColumn);
 autoSSCP TableOfReal_to_SSCP_rowWeights (TableOfReal me, integer rowb, integer rowe, integer colb, integer cole, integer weightColumnNumber);
 
 autoTableOfReal SSCP_TableOfReal_extractDistanceQuantileRange (SSCP me, TableOfReal thee, double qlow, double qhigh);
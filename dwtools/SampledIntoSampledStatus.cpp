@@ -94,6 +94,19 @@ autoSoundIntoPowerCepstrogramStatus SoundIntoPowerCepstrogramStatus_create (inte
 }
 
 
+Thing_implement (SoundIntoPitchStatus, SoundIntoSampledStatus, 0);
+
+autoSoundIntoPitchStatus SoundIntoPitchStatus_create (integer numberOfFrames) {
+	try {
+		autoSoundIntoPitchStatus me = Thing_new (SoundIntoPitchStatus);
+		SoundIntoSampledStatus_init (me.get(), numberOfFrames);
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"Cannot create SoundIntoPitchStatus.");
+	}
+}
+
+
 Thing_implement (PowerCepstrogramIntoMatrixStatus, SampledIntoSampledStatus, 0);
 
 void structPowerCepstrogramIntoMatrixStatus :: showStatus () {
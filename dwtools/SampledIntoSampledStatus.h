@@ -45,6 +45,12 @@ Thing_define (SoundIntoPowerCepstrogramStatus, SoundIntoSampledStatus) {
 autoSoundIntoPowerCepstrogramStatus SoundIntoPowerCepstrogramStatus_create (integer numberOfFrames);
 
 
+Thing_define (SoundIntoPitchStatus, SoundIntoSampledStatus) {
+};
+
+autoSoundIntoPitchStatus SoundIntoPitchStatus_create (integer numberOfFrames);
+
+
 Thing_define (PowerCepstrogramIntoMatrixStatus, SampledIntoSampledStatus) {
 		autoVEC slopes, intercepts;
 		autoINTVEC startFrames, numberOfTries;
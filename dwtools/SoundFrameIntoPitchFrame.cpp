@@ -0,0 +1,321 @@
+/* SoundFrameIntoPitchFrame.cpp
+ *
+ * Copyright (C) 2026 agent
+ *
+ * The subharmonic summation is adapted from Sound_to_Pitch_shs in Sound_to_Pitch2.cpp,
+ * Copyright (C) 1993-2019 David Weenink.
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoundFrameIntoPitchFrame.h"
+#include "Pitch_extensions.h"
+#include "Sound_extensions.h"
+#include "NUM2.h"
+
+#include "oo_DESTROY.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_COPY.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_EQUAL.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_CAN_WRITE_AS_ENCODING.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_WRITE_TEXT.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_WRITE_BINARY.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_READ_TEXT.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_READ_BINARY.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+#include "oo_DESCRIPTION.h"
+#include "SoundFrameIntoPitchFrame_def.h"
+
+Thing_implement (SoundFrameIntoPitchFrame, SoundFrameIntoSampledFrame, 0);
+
+void structSoundFrameIntoPitchFrame :: allocateOutputFrames () {
+	Melder_assert (our outputPitch);
+	for (integer iframe = 1; iframe <= outputPitch -> nx; iframe ++)
+		Pitch_Frame_init (& outputPitch -> frames [iframe], maxnCandidates);
+}
+
+void SoundFrameIntoPitchFrame_init (mutableSoundFrameIntoPitchFrame me, constSound input, mutablePitch output,
+	double effectiveAnalysisWidth, kSound_windowShape windowShape)
+{
+	SoundFrameIntoSampledFrame_init (me, input, output, effectiveAnalysisWidth, windowShape);
+	my outputPitch = output;
+	my maxnCandidates = output -> maxnCandidates;
+}
+
+/************************ subharmonic summation *****************************/
+
+Thing_implement (SoundFrameIntoPitchFrameSHS, SoundFrameIntoPitchFrame, 0);
+
+static double Sound_approximateLocalSampleMean (constSound me, double fromTime, double toTime) {
+	const integer n1 = Melder_clippedLeft (1_integer, Sampled_xToNearestIndex (me, fromTime));
+	const integer n2 = Melder_clippedRight (Sampled_xToNearestIndex (me, toTime), my nx);
+	return n1 <= n2 ? NUMmean (my z [1].part (n1, n2)) : undefined;
+}
+
+static void spec_enhance_SHS (VEC const& a, INTVEC const& posmax) {
+	Melder_assert (a.size >= 2);
+	Melder_assert (posmax.size >= (a.size + 1) / 2);
+	integer nmax = 0;
+	if (a [1] > a [2])
+		posmax [++ nmax] = 1;
+
+	for (integer i = 2; i <= a.size - 1; i ++)
+		if (a [i] > a [i - 1] && a [i] >= a [i + 1])
+			posmax [++ nmax] = i;
+
+	if (a [a.size] > a [a.size - 1])
+		posmax [++ nmax] = a.size;
+
+	if (nmax == 1) {
+		a.part (1, posmax [1] - 3)  <<=  0.0;
+		a.part (posmax [1] + 3, a.size)  <<=  0.0;
+	} else {
+		for (integer i = 2; i <= nmax; i ++)
+			a.part (posmax [i - 1] + 3, posmax [i] - 3)  <<=  0.0;
+	}
+}
+
+static void spec_smoooth_SHS (VEC const& a) {
+	/*
+		Convolve in-place with the small symmetric moving-average
+		kernel { 0.25, 0.5, 0.25 }, aligned around its second element.
+		The basic equation for an output element a_new [i] is:
+			a_new [i] := 0.25 * (a [i - 1] + 2.0 * a [i] + a [i + 1])
+
+		The procedure is performed in place, i.e., the vector a_new []
+		appears as the new version of the vector a [], so that care has
+		to be taken to timely save elements that will be overwritten.
+		At the edges we perform "same" convolution, meaning that
+		the output vector has the same number of elements as the
+		input vector (this is a natural situation in case of in-place
+		filtering). The elements just beyond the edges of the vector,
+		namely a [0] and a [a.size + 1], are assumed to be zero.
+	*/
+	double a_i_minus_1 = 0.0;   // save a [i - 1], for i == 1
+	for (integer i = 1; i <= a.size - 1; i ++) {
+		const double a_i = a [i];   // save a [i]
+		a [i] = 0.25 * (a_i_minus_1 + 2.0 * a_i + a [i + 1]);
+		a_i_minus_1 = a_i;
+	}
+	a [a.size] = 0.25 * (a_i_minus_1 + 2.0 * a [a.size]);
+}
+
+/*
+	The same bisection as in NUMcubicSplineInterpolation, but performed only once,
+	because the points on the octave scale are the same for every frame.
+*/
+static integer NUMcubicSplineInterpolation_getInterval (constVEC const& x, double xin) {
+	integer klo = 1, khi = x.size;
+	while (khi - klo > 1) {
+		const integer k = (khi + klo) >> 1;
+		if (x [k] > xin)
+			khi = k;
+		else
+			klo = k;
+	}
+	Melder_require (x [khi] - x [klo] != 0.0,
+		U"NUMcubicSplineInterpolation: bad input value.");
+	return klo;
+}
+
+bool structSoundFrameIntoPitchFrameSHS :: inputFrameToOutputFrame () {
+	const Pitch_Frame pitchFrame = & outputPitch -> frames [currentFrame];
+	const double tmid = Sampled_indexToX (outputPitch, currentFrame);
+	const double halfWindow = 0.5 * physicalAnalysisWidth;
+	/*
+		Get local 'intensity'
+	*/
+	const double localMean = Sound_approximateLocalSampleMean (sound, tmid - 3.0 * halfWindow, tmid + 3.0 * halfWindow);
+	const double localPeak = Sound_localPeak (sound, tmid - halfWindow, tmid + halfWindow, localMean);
+	pitchFrame -> intensity = ( localPeak > globalPeak ? 1.0 : localPeak / globalPeak );
+	/*
+		From the windowed frame to the amplitude spectrum; the scaling is as in Sound_to_Spectrum.
+	*/
+	fftData.part (1, soundFrameSize)  <<=  soundFrame;
+	fftData.part (soundFrameSize + 1, numberOfFourierSamples)  <<=  0.0;
+	NUMfft_forward (fourierTable.get(), fftData.get());
+	const double scaling = sound -> dx;
+	amplitudeSpectrum [1] = fabs (fftData [1] * scaling);
+	for (integer j = 2; j < numberOfFrequencies; j ++)
+		amplitudeSpectrum [j] = hypot (fftData [j + j - 2] * scaling, fftData [j + j - 1] * scaling);
+	amplitudeSpectrum [numberOfFrequencies] = fabs (fftData [numberOfFourierSamples] * scaling);
+	/*
+		Enhance the peaks in the spectrum and smooth the enhanced spectrum.
+	*/
+	spec_enhance_SHS (amplitudeSpectrum.get(), peakPositions.get());
+	spec_smoooth_SHS (amplitudeSpectrum.get());
+	/*
+		Go to a logarithmic scale and perform cubic spline interpolation to get
+		spectral values for the increased number of frequency points.
+		Multiply by frequency selectivity of the auditory system.
+	*/
+	NUMcubicSplineInterpolation_getSecondDerivatives (secondDerivatives.get(), log2Frequencies.get(), amplitudeSpectrum.get(), 1e30, 1e30);
+	for (integer j = 1; j <= numberOfLog2Frequencies; j ++) {
+		const double f = minimumLog2Frequency + (j - 1) * log2FrequencyStep;
+		const integer klo = splineIntervals [j], khi = klo + 1;
+		const double h = log2Frequencies [khi] - log2Frequencies [klo];
+		const double a = (log2Frequencies [khi] - f) / h;
+		const double b = (f - log2Frequencies [klo]) / h;
+		const double yint = a * amplitudeSpectrum [klo] + b * amplitudeSpectrum [khi] +
+				((a * a * a - a) * secondDerivatives [klo] + (b * b * b - b) * secondDerivatives [khi]) * (h * h) / 6.0;
+		log2Spectrum [j] = ( yint > 0.0 ? yint * auditoryWeights [j] : 0.0 );
+	}
+	/*
+		The subharmonic summation. Shift spectra in octaves and sum.
+		Each subharmonic is one diagonal of the weight matrix; the inner loop is a contiguous
+		multiply-add that the compiler can vectorize.
+	*/
+	subharmonicSum.get()  <<=  0.0;
+	double *sum = & subharmonicSum [1];
+	for (integer m = 1; m <= numberOfSubharmonics; m ++) {
+		const integer offset = subharmonicOffsets [m];
+		const integer n = numberOfLog2Frequencies - offset;
+		const double *spectrum = & log2Spectrum [1 + offset];
+		const double weight = subharmonicWeights [m];
+		for (integer k = 0; k < n; k ++)
+			sum [k] += spectrum [k] * weight;
+	}
+	/*
+		First register the voiceless candidate (always present).
+	*/
+	pitchFrame -> candidates. resize (pitchFrame -> nCandidates = 0);
+	Pitch_Frame_addPitch (pitchFrame, 0.0, 0.0, maxnCandidates);
+	/*
+		Get the best local estimates for the pitch as the maxima of the
+		subharmonic sum spectrum by parabolic interpolation on three points:
+		The formula for a parabola with a maximum is:
+			y(x) = a - b (x - c)^2 with a, b, c >= 0
+		The three points are (-x, y1), (0, y2) and (x, y3).
+		The solution for a (the maximum) and c (the position) is:
+		a = (2 y1 (4 y2 + y3) - y1^2 - (y3 - 4 y2)^2)/( 8 (y1 - 2 y2 + y3)
+		c = dx (y1 - y3) / (2 (y1 - 2 y2 + y3))
+		(b = (2 y2 - y1 - y3) / (2 dx^2) )
+	*/
+	for (integer k = 2; k <= numberOfLog2Frequencies - 1; k ++) {
+		const double y1 = subharmonicSum [k - 1], y2 = subharmonicSum [k], y3 = subharmonicSum [k + 1];
+		if (y2 > y1 && y2 >= y3) {
+			const double denum = y1 - 2.0 * y2 + y3, tmp = y3 - 4.0 * y2;
+			const double x = log2FrequencyStep * (y1 - y3) / (2.0 * denum);
+			const double f = pow (2.0, minimumLog2Frequency + (k - 1) * log2FrequencyStep + x);
+			const double strength = (2.0 * y1 * (4.0 * y2 + y3) - y1 * y1 - tmp * tmp) / (8.0 * denum);
+			Pitch_Frame_addPitch (pitchFrame, f, strength, maxnCandidates);
+		}
+	}
+	/*
+		Check whether f0 corresponds to an actual periodicity T = 1 / f0:
+		correlate two signal periods of duration T, one starting at the
+		middle of the interval and one starting T seconds before.
+		If there is periodicity the correlation coefficient should be high.
+
+		However, some sounds do not show any regularity, or very low
+		frequency and regularity, and nevertheless have a definite
+		pitch, e.g. Shepard sounds.
+
+		Base V/UV decision on correlation coefficients.
+		Resize the pitch strengths w.r.t. the cc.
+	*/
+	double pitch_strength, f0;
+	Pitch_Frame_getPitch (pitchFrame, & f0, & pitch_strength);
+	const double cc = ( f0 > 0.0 ? Sound_correlateParts (sound, tmid - 1.0 / f0, tmid, 1.0 / f0) : 0.0 );
+	constexpr double vuvCriterion = 0.52;
+	Pitch_Frame_resizeStrengths (pitchFrame, cc, vuvCriterion);
+	return true;
+}
+
+autoSoundFrameIntoPitchFrameSHS SoundFrameIntoPitchFrameSHS_create (constSound input, mutablePitch output, double pitchFloor,
+	double maximumFrequency, integer maxnSubharmonics, double compressionFactor, integer numberOfPointsPerOctave)
+{
+	try {
+		autoSoundFrameIntoPitchFrameSHS me = Thing_new (SoundFrameIntoPitchFrameSHS);
+		const double samplingFrequency = 2.0 * maximumFrequency;
+		const double windowDuration = 2.0 / pitchFloor;
+		SoundFrameIntoPitchFrame_init (me.get(), input, output, windowDuration, kSound_windowShape::HAMMING);
+		/*
+			The classic SHS Hamming window, which is zero at both ends (as in Sound_createHamming).
+		*/
+		const double p = NUM2pi / (my soundFrameSize - 1);
+		for (integer i = 1; i <= my soundFrameSize; i ++)
+			my windowFunction [i] = 0.54 - 0.46 * cos ((i - 1) * p);
+		/*
+			Compute the absolute value of the globally largest amplitude w.r.t. the global mean.
+		*/
+		const double globalMean = Sound_approximateLocalSampleMean (input, input -> xmin, input -> xmax);
+		my globalPeak = Sound_localPeak (input, input -> xmin, input -> xmax, globalMean);
+
+		my numberOfFourierSamples = Melder_clippedLeft (256_integer /* the minimum number of points for the FFT */,
+				Melder_iroundUpToPowerOfTwo (my soundFrameSize));
+		my numberOfFrequencies = my numberOfFourierSamples / 2 + 1;
+		my fourierTable = NUMFourierTable_create (my numberOfFourierSamples);
+		my fftData = raw_VEC (my numberOfFourierSamples);
+		my amplitudeSpectrum = raw_VEC (my numberOfFrequencies);
+		my peakPositions = raw_INTVEC (my numberOfFrequencies);
+		my secondDerivatives = raw_VEC (my numberOfFrequencies);
+		/*
+			For the cubic spline interpolation we need the frequencies on an octave
+			scale, i.e., a log2 scale. All frequencies should be DIFFERENT, otherwise
+			the cubic spline interpolation will give corrupt results.
+			Because log2(f==0) is not defined, we use the heuristic: f [2] - f [1] == f [3] - f [2].
+		*/
+		const double df = samplingFrequency / my numberOfFourierSamples;
+		my log2Frequencies = raw_VEC (my numberOfFrequencies);
+		for (integer i = 2; i <= my numberOfFrequencies; i ++)
+			my log2Frequencies [i] = NUMlog2 ((i - 1) * df);
+		my log2Frequencies [1] = 2.0 * my log2Frequencies [2] - my log2Frequencies [3];
+		/*
+			The number of points on the octave scale.
+		*/
+		const double fminl2 = NUMlog2 (pitchFloor), fmaxl2 = NUMlog2 (maximumFrequency);
+		my numberOfLog2Frequencies = Melder_ifloor ((fmaxl2 - fminl2) * numberOfPointsPerOctave);
+		my minimumLog2Frequency = fminl2;
+		my log2FrequencyStep = (fmaxl2 - fminl2) / (my numberOfLog2Frequencies - 1);
+		my log2Spectrum = raw_VEC (my numberOfLog2Frequencies);
+		my subharmonicSum = raw_VEC (my numberOfLog2Frequencies);
+		/*
+			Frequencies regularly spaced on a log2-scale and the frequency weighting function.
+		*/
+		const double atans = numberOfPointsPerOctave * NUMlog2 (65.0 / 50.0) - 1.0;
+		my splineIntervals = raw_INTVEC (my numberOfLog2Frequencies);
+		my auditoryWeights = raw_VEC (my numberOfLog2Frequencies);
+		for (integer j = 1; j <= my numberOfLog2Frequencies; j ++) {
+			const double f = fminl2 + (j - 1) * my log2FrequencyStep;
+			my splineIntervals [j] = NUMcubicSplineInterpolation_getInterval (my log2Frequencies.get(), f);
+			my auditoryWeights [j] = 0.5 + atan (3.0 * (j - atans) / numberOfPointsPerOctave) / NUMpi;
+		}
+		/*
+			The subharmonic weights: subharmonic m shifts the spectrum down by log2 (m) octaves
+			and is weighted by compressionFactor^(m-1).
+			Shifts beyond the octave scale contribute nothing and are clipped.
+		*/
+		my numberOfSubharmonics = maxnSubharmonics + 1;
+		my subharmonicOffsets = raw_INTVEC (my numberOfSubharmonics);
+		my subharmonicWeights = raw_VEC (my numberOfSubharmonics);
+		double hm = 1.0;
+		for (integer m = 1; m <= my numberOfSubharmonics; m ++) {
+			my subharmonicOffsets [m] = std::min (Melder_ifloor (numberOfPointsPerOctave * NUMlog2 (m)), my numberOfLog2Frequencies);
+			my subharmonicWeights [m] = hm;
+			hm *= compressionFactor;
+		}
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"Cannot create SoundFrameIntoPitchFrameSHS.");
+	}
+}
+
+/* End of file SoundFrameIntoPitchFrame.cpp */
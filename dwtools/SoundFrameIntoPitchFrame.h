@@ -0,0 +1,41 @@
+#ifndef _SoundFrameIntoPitchFrame_h_
+#define _SoundFrameIntoPitchFrame_h_
+/* SoundFrameIntoPitchFrame.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Pitch.h"
+#include "Sound.h"
+#include "NUMFourier.h"
+#include "SoundFrameIntoSampledFrame.h"
+#include "SampledIntoSampledStatus.h"
+
+#include "SoundFrameIntoPitchFrame_def.h"
+
+void SoundFrameIntoPitchFrame_init (mutableSoundFrameIntoPitchFrame me, constSound input, mutablePitch output,
+	double effectiveAnalysisWidth, kSound_windowShape windowShape
+);
+
+autoSoundFrameIntoPitchFrameSHS SoundFrameIntoPitchFrameSHS_create (constSound input, mutablePitch output, double pitchFloor,
+	double maximumFrequency, integer maxnSubharmonics, double compressionFactor, integer numberOfPointsPerOctave
+);
+/*
+	The input should have been resampled to 2 * maximumFrequency.
+	The analysis window is a Hamming window of duration 2 / pitchFloor.
+*/
+
+#endif /*_SoundFrameIntoPitchFrame_h_ */
@@ -0,0 +1,68 @@
+/* SoundFrameIntoPitchFrame_def.h
+ *
+ * Copyright (C) 2026 agent
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define ooSTRUCT SoundFrameIntoPitchFrame
+oo_DEFINE_CLASS (SoundFrameIntoPitchFrame, SoundFrameIntoSampledFrame)
+
+	oo_UNSAFE_BORROWED_TRANSIENT_MUTABLE_OBJECT_REFERENCE (Pitch, outputPitch)
+	oo_INTEGER (maxnCandidates)
+
+	#if oo_DECLARING
+		void allocateOutputFrames ()
+			override;
+	#endif
+
+oo_END_CLASS (SoundFrameIntoPitchFrame)
+#undef ooSTRUCT
+
+#define ooSTRUCT SoundFrameIntoPitchFrameSHS
+oo_DEFINE_CLASS (SoundFrameIntoPitchFrameSHS, SoundFrameIntoPitchFrame)
+
+	oo_DOUBLE (globalPeak)						// of the whole sound, w.r.t. its mean
+	oo_DOUBLE (minimumLog2Frequency)
+	oo_DOUBLE (log2FrequencyStep)
+	oo_INTEGER (numberOfFourierSamples)
+	oo_INTEGER (numberOfFrequencies)			// numberOfFourierSamples / 2 + 1
+	oo_INTEGER (numberOfLog2Frequencies)		// number of points on the octave scale
+	oo_INTEGER (numberOfSubharmonics)			// maximum number of subharmonics + 1
+	oo_VEC (fftData, numberOfFourierSamples)
+	oo_OBJECT (NUMFourierTable, 0, fourierTable)
+	oo_VEC (amplitudeSpectrum, numberOfFrequencies)
+	oo_INTVEC (peakPositions, numberOfFrequencies)
+	oo_VEC (log2Frequencies, numberOfFrequencies)
+	oo_VEC (secondDerivatives, numberOfFrequencies)
+	oo_INTVEC (splineIntervals, numberOfLog2Frequencies)	// the lower index in log2Frequencies of each octave scale point
+	oo_VEC (auditoryWeights, numberOfLog2Frequencies)		// the arc tangent frequency selectivity
+	oo_VEC (log2Spectrum, numberOfLog2Frequencies)
+	oo_VEC (subharmonicSum, numberOfLog2Frequencies)
+	/*
+		The subharmonic summation is a sparse matrix with one diagonal per subharmonic:
+			subharmonicSum [k] = sum (m = 1..numberOfSubharmonics, subharmonicWeights [m] * log2Spectrum [k + subharmonicOffsets [m]])
+	*/
+	oo_INTVEC (subharmonicOffsets, numberOfSubharmonics)
+	oo_VEC (subharmonicWeights, numberOfSubharmonics)
+
+	#if oo_DECLARING
+		bool inputFrameToOutputFrame ()
+			override;
+	#endif
+
+oo_END_CLASS (SoundFrameIntoPitchFrameSHS)
+#undef ooSTRUCT
+
+/* End of file SoundFrameIntoPitchFrame_def.h */
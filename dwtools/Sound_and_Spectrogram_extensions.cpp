@@ -43,7 +43,7 @@ autoSound BandFilterSpectrogram_as_Sound (BandFilterSpectrogram me, int to_dB);
 	where erf(x) = 1 - erfc(x) and n is the windowLength in samples.
 	To compare with the rectangular window we need to divide this by the window width (n -1) x 1^2.
 */
-static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+double NUMgaussianWindow_powerCorrection (integer numberOfSamples_window) {
 	double windowFactor = 1.0;
 	if (numberOfSamples_window > 1) {
 		const double e12 = exp (-12);
@@ -54,7 +54,11 @@ static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSampl
 		const double p1 = 4 * NUMsqrtpi * NUMsqrt3 * e12 * (1 - NUMerfcc (arg1)) * (numberOfSamples_window + 1);
 		windowFactor =  (p2 - p1 + 24 * (numberOfSamples_window - 1) * e12 * e12) / denum;
 	}
-	my z.get()  /=  windowFactor;
+	return windowFactor;
+}
+
+static void _Spectrogram_windowCorrection (Spectrogram me, integer numberOfSamples_window) {
+	my z.get()  /=  NUMgaussianWindow_powerCorrection (numberOfSamples_window);
 }
 
 static autoSpectrum Sound_to_Spectrum_power (Sound me) {
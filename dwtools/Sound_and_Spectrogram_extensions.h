@@ -26,6 +26,13 @@
 #include "Pitch.h"
 #include "Sound.h"
 
+double NUMgaussianWindow_powerCorrection (integer numberOfSamples_window);
+/*
+	The area under the square of the Gaussian analysis window,
+	divided by that of a rectangular window of the same length.
+	The filter bank spectrograms divide their power by this factor.
+*/
+
 autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_bark, double fmax_bark, double df_bark);
 /*
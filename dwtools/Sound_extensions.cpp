@@ -1320,7 +1320,7 @@ double Sound_power (Sound me) {
 	return sqrt (sumSq) * my dx / (my xmax - my xmin);
 }
 
-double Sound_correlateParts (Sound me, double tx, double ty, double duration) {
+double Sound_correlateParts (constSound me, double tx, double ty, double duration) {
 	if (ty < tx)
 		std::swap (tx, ty);
 	const integer nbx = Sampled_xToNearestIndex (me, tx);
@@ -1353,7 +1353,7 @@ double Sound_correlateParts (Sound me, double tx, double ty, double duration) {
 	return rxy;
 }
 
-double Sound_localPeak (Sound me, double fromTime, double toTime, double reference) {
+double Sound_localPeak (constSound me, double fromTime, double toTime, double reference) {
 	integer n1 = Sampled_xToNearestIndex (me, fromTime);
 	integer n2 = Sampled_xToNearestIndex (me, toTime);
 	const double *s = & my z [1] [0];
@@ -108,12 +108,12 @@ autoSound Sound_filterByGammaToneFilter (Sound me, double centre_frequency, doub
 void Sounds_multiply (Sound me, Sound thee);
 /* precondition: my nx == thy nx */
 
-double Sound_correlateParts (Sound me, double t1, double t2, double duration);
+double Sound_correlateParts (constSound me, double t1, double t2, double duration);
 /*
 	Correlate part (t1, t1+duration) with (t2, t2+duration)
 */
 
-double Sound_localPeak (Sound me, double fromTime, double toTime, double reference);
+double Sound_localPeak (constSound me, double fromTime, double toTime, double reference);
 
 autoSound Sound_localAverage (Sound me, double averaginginterval, int windowType);
 /* y [n] = sum(i=-n, i=n, x [n+i]) / (2*n+1) */
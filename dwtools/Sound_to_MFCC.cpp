@@ -1,6 +1,6 @@
 /* Sound_to_MFCC.cpp
  *
- * Copyright (C) 1993-2017 David Weenink
+ * Copyright (C) 1993-2017,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,15 +23,237 @@
 
 #include "Sound_to_MFCC.h"
 #include "Sound_and_Spectrogram_extensions.h"
+#include "Sound_extensions.h"
+#include "NUM2.h"
+
+/*
+	Everything that is computed only once and that all threads can read at the same time.
+	The power spectrum of a frame goes to the filter outputs as a matrix product with `filters`,
+	and the dB values of the filter outputs go to the cepstrum as a matrix product with `cosines`.
+	The scaling of the power spectrum (as in Sound_to_Spectrum_power) and the window correction
+	are included in `filters`, so that the results equal those of Sound_to_MelSpectrogram
+	followed by MelSpectrogram_to_MFCC.
+*/
+struct MelCepstrumAnalysis {
+	integer numberOfFrames;
+	double t1, dt;
+	double windowDuration;
+	integer numberOfSamples_window, numberOfFourierSamples, numberOfFrequencies;
+	double fmin_mel, fmax_mel, f1_mel, df_mel;
+	integer numberOfFilters, numberOfCoefficients;
+	autoVEC window;
+	autoMAT filters;   // numberOfFilters x numberOfFrequencies
+	autoMAT cosines;   // (numberOfCoefficients + 1) x numberOfFilters
+};
+
+static void MelCepstrumAnalysis_init (MelCepstrumAnalysis *me, Sound sound, integer numberOfCoefficients,
+	double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel)
+{
+	const double samplingFrequency = 1.0 / sound -> dx, nyquist = 0.5 * samplingFrequency;
+	const double windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	const double fbottom = NUMhertzToMel2 (100.0), fceiling = NUMhertzToMel2 (nyquist);
+	/*
+		The same defaults as in Sound_to_MelSpectrogram.
+	*/
+	if (fmax_mel <= 0.0 || fmax_mel > fceiling)
+		fmax_mel = fceiling;
+	if (fmax_mel <= f1_mel) {
+		f1_mel = fbottom;
+		fmax_mel = fceiling;
+	}
+	if (f1_mel <= 0.0)
+		f1_mel = fbottom;
+	if (df_mel <= 0.0)
+		df_mel = 100.0;
+	const integer numberOfFilters = Melder_iround ((fmax_mel - f1_mel) / df_mel);
+	Melder_require (numberOfFilters > 1,
+		U"The combination of filter parameters should give more than one filter.");
+	if (numberOfCoefficients <= 0 || numberOfCoefficients > numberOfFilters - 1)
+		numberOfCoefficients = numberOfFilters - 1;
+
+	Sampled_shortTermAnalysis (sound, windowDuration, dt, & my numberOfFrames, & my t1);
+	my dt = dt;
+	my windowDuration = windowDuration;
+	my fmin_mel = 0.0;
+	my fmax_mel = fmax_mel;
+	my f1_mel = f1_mel;
+	my df_mel = df_mel;
+	my numberOfFilters = numberOfFilters;
+	my numberOfCoefficients = numberOfCoefficients;
+
+	autoSound gaussian = Sound_createGaussian (windowDuration, samplingFrequency);
+	my numberOfSamples_window = gaussian -> nx;
+	my window = copy_VEC (gaussian -> z.row (1));
+	my numberOfFourierSamples = Melder_iroundUpToPowerOfTwo (my numberOfSamples_window);
+	my numberOfFrequencies = my numberOfFourierSamples / 2 + 1;
+
+	/*
+		The power in a frequency bin is |X|^2 * dt^2 * 2 * df / windowDuration,
+		where the bins at 0 Hz and at the Nyquist frequency count only once.
+	*/
+	const double df = 1.0 / (sound -> dx * my numberOfFourierSamples);
+	const double powerScale = sound -> dx * sound -> dx * 2.0 * df / windowDuration /
+			NUMgaussianWindow_powerCorrection (my numberOfSamples_window);
+	my filters = zero_MAT (numberOfFilters, my numberOfFrequencies);
+	for (integer ifilter = 1; ifilter <= numberOfFilters; ifilter ++) {
+		const double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+		const double fc_hz = NUMmelToHertz2 (fc_mel);
+		const double fl_hz = NUMmelToHertz2 (std::max (fc_mel - df_mel, 0.0));
+		const double fh_hz = NUMmelToHertz2 (std::min (fc_mel + df_mel, nyquist));
+		for (integer ifreq = 1; ifreq <= my numberOfFrequencies; ifreq ++) {
+			const double f = (ifreq - 1) * df;
+			const double binScale = ( ifreq == 1 || ifreq == my numberOfFrequencies ? 0.5 * powerScale : powerScale );
+			my filters [ifilter] [ifreq] = NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, f) * binScale;
+		}
+	}
+	autoMAT cosinesTable = MATcosinesTable (numberOfFilters);
+	my cosines = copy_MAT (cosinesTable.horizontalBand (1, numberOfCoefficients + 1));
+}
+
+/*
+	The buffers of one thread, for a block of at most `blockSize` frames.
+*/
+struct MelCepstrumWorkspace {
+	autoNUMFourierTable fourierTable;
+	autoMAT frames;   // blockSize x numberOfFourierSamples
+	autoMAT power;   // blockSize x numberOfFrequencies
+	autoMAT filterOutputs;   // blockSize x numberOfFilters
+
+	void init (MelCepstrumAnalysis const& analysis, integer blockSize) {
+		our fourierTable = NUMFourierTable_create (analysis.numberOfFourierSamples);
+		our frames = raw_MAT (blockSize, analysis.numberOfFourierSamples);
+		our power = raw_MAT (blockSize, analysis.numberOfFrequencies);
+		our filterOutputs = raw_MAT (blockSize, analysis.numberOfFilters);
+	}
+};
+
+constexpr integer MelCepstrum_BLOCK_SIZE = 32;
+
+/*
+	Computes the cepstra of frames firstFrame .. lastFrame into the first rows of `cepstra`,
+	with c0 in the first column.
+*/
+static void Sound_into_melCepstra (Sound me, MelCepstrumAnalysis const& analysis, integer firstFrame, integer lastFrame, MAT const& cepstra) {
+	const integer numberOfFrames = lastFrame - firstFrame + 1;
+	Melder_assert (cepstra.nrow >= numberOfFrames);
+	Melder_assert (cepstra.ncol == analysis.numberOfCoefficients + 1);
+	const integer numberOfBlocks = (numberOfFrames - 1) / MelCepstrum_BLOCK_SIZE + 1;
+	const integer nfft = analysis.numberOfFourierSamples, nfreq = analysis.numberOfFrequencies;
+
+	MelderThread_PARALLELIZE (numberOfBlocks, 2)
+
+	MelCepstrumWorkspace workspace;
+	workspace. init (analysis, MelCepstrum_BLOCK_SIZE);
+
+	MelderThread_FOR (iblock) {
+		const integer fromRow = (iblock - 1) * MelCepstrum_BLOCK_SIZE + 1;
+		const integer toRow = std::min (fromRow + MelCepstrum_BLOCK_SIZE - 1, numberOfFrames);
+		const integer blockSize = toRow - fromRow + 1;
+		for (integer irow = 1; irow <= blockSize; irow ++) {
+			const integer iframe = firstFrame + fromRow + irow - 2;
+			const double t = analysis.t1 + (iframe - 1) * analysis.dt;
+			const integer startSample = Sampled_xToNearestIndex (me, t - 0.5 * analysis.windowDuration);
+			VEC frame = workspace.frames.row (irow);
+			for (integer i = 1; i <= analysis.numberOfSamples_window; i ++) {
+				const integer isamp = startSample - 1 + i;
+				frame [i] = ( isamp < 1 || isamp > my nx ? 0.0 : my z [1] [isamp] * analysis.window [i] );
+			}
+			frame.part (analysis.numberOfSamples_window + 1, nfft)  <<=  0.0;
+			NUMfft_forward (workspace.fourierTable.get(), frame);
+			VEC power = workspace.power.row (irow);
+			power [1] = frame [1] * frame [1];
+			for (integer ifreq = 2; ifreq < nfreq; ifreq ++)
+				power [ifreq] = frame [ifreq + ifreq - 2] * frame [ifreq + ifreq - 2] + frame [ifreq + ifreq - 1] * frame [ifreq + ifreq - 1];
+			power [nfreq] = frame [nfft] * frame [nfft];
+		}
+		MATVU filterOutputs = workspace.filterOutputs.horizontalBand (1, blockSize);
+		mul_MAT_out (filterOutputs, workspace.power.horizontalBand (1, blockSize), analysis.filters.transpose());
+		for (integer irow = 1; irow <= blockSize; irow ++)
+			for (integer ifilter = 1; ifilter <= analysis.numberOfFilters; ifilter ++) {
+				const double power = filterOutputs [irow] [ifilter];
+				filterOutputs [irow] [ifilter] = ( power > 0.0 ?
+						BandFilterSpectrogram_DBFAC * log10 (power / BandFilterSpectrogram_DBREF) : -300.0 );
+			}
+		mul_MAT_out (cepstra.horizontalBand (fromRow, toRow), filterOutputs, analysis.cosines.transpose());
+	} MelderThread_ENDFOR
+}
+
+/*
+	We analyse in chunks, so that the memory needed for the intermediate cepstra does not grow with the duration.
+*/
+constexpr integer MelCepstrum_CHUNK_SIZE = 4096;
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
-		autoMelSpectrogram mf = Sound_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
-		autoMFCC mfcc = MelSpectrogram_to_MFCC (mf.get(), numberOfCoefficients);
-		return mfcc;
+		MelCepstrumAnalysis analysis;
+		MelCepstrumAnalysis_init (& analysis, me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		/*
+			As in MelSpectrogram_to_MFCC, the maximum number of coefficients is the number of filters minus one,
+			which is necessary for the inverse transform.
+		*/
+		autoMFCC thee = MFCC_create (my xmin, my xmax, analysis.numberOfFrames, dt, analysis.t1,
+				analysis.numberOfFilters - 1, analysis.fmin_mel, analysis.fmax_mel);
+		autoMAT cepstra = raw_MAT (std::min (analysis.numberOfFrames, MelCepstrum_CHUNK_SIZE), analysis.numberOfCoefficients + 1);
+		autoMelderProgress progress (U"MFCC analysis");
+		for (integer firstFrame = 1; firstFrame <= analysis.numberOfFrames; firstFrame += MelCepstrum_CHUNK_SIZE) {
+			const integer lastFrame = std::min (firstFrame + MelCepstrum_CHUNK_SIZE - 1, analysis.numberOfFrames);
+			Sound_into_melCepstra (me, analysis, firstFrame, lastFrame, cepstra.get());
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				const constVEC cepstrum = cepstra.row (iframe - firstFrame + 1);
+				const CC_Frame ccframe = & thy frame [iframe];
+				CC_Frame_init (ccframe, analysis.numberOfCoefficients);
+				ccframe -> c0 = cepstrum [1];
+				ccframe -> c.all()  <<=  cepstrum.part (2, analysis.numberOfCoefficients + 1);
+			}
+			Melder_progress ((double) lastFrame / analysis.numberOfFrames,
+				U"Frame ", lastFrame, U" out of ", analysis.numberOfFrames, U".");
+		}
+		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no MFCC created.");
 	}
 }
 
+void Sound_saveAsHtkMfccFile (Sound me, MelderFile file, integer numberOfCoefficients, double analysisWidth,
+	double dt, double f1_mel, double fmax_mel, double df_mel)
+{
+	try {
+		MelCepstrumAnalysis analysis;
+		MelCepstrumAnalysis_init (& analysis, me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		const integer numberOfValuesPerFrame = analysis.numberOfCoefficients + 1;
+		Melder_require (analysis.numberOfFrames <= INT32_MAX,
+			U"An HTK file cannot contain more than ", Melder_bigInteger (INT32_MAX), U" frames.");
+		const double sampPeriod = dt / 100e-9;   // in units of 100 ns
+		Melder_require (sampPeriod >= 1.0 && sampPeriod <= INT32_MAX,
+			U"The time step cannot be represented in an HTK file.");
+
+		autofile f = Melder_fopen (file, "wb");
+		/*
+			HTK header, big-endian: nSamples, sampPeriod, sampSize, parmKind.
+		*/
+		constexpr int16 HTK_MFCC = 6, HTK_QUALIFIER_0 = 020000;   // MFCC_0: c0 is stored after the other coefficients
+		binputi32 ((int32) analysis.numberOfFrames, f);
+		binputi32 ((int32) Melder_iround (sampPeriod), f);
+		binputi16 ((int16) (4 * numberOfValuesPerFrame), f);
+		binputi16 (HTK_MFCC | HTK_QUALIFIER_0, f);
+
+		autoMAT cepstra = raw_MAT (std::min (analysis.numberOfFrames, MelCepstrum_CHUNK_SIZE), numberOfValuesPerFrame);
+		autoMelderProgress progress (U"MFCC analysis");
+		for (integer firstFrame = 1; firstFrame <= analysis.numberOfFrames; firstFrame += MelCepstrum_CHUNK_SIZE) {
+			const integer lastFrame = std::min (firstFrame + MelCepstrum_CHUNK_SIZE - 1, analysis.numberOfFrames);
+			Sound_into_melCepstra (me, analysis, firstFrame, lastFrame, cepstra.get());
+			for (integer irow = 1; irow <= lastFrame - firstFrame + 1; irow ++) {
+				for (integer icoef = 2; icoef <= numberOfValuesPerFrame; icoef ++)
+					binputr32 (cepstra [irow] [icoef], f);
+				binputr32 (cepstra [irow] [1], f);
+			}
+			Melder_progress ((double) lastFrame / analysis.numberOfFrames,
+				U"Frame ", lastFrame, U" out of ", analysis.numberOfFrames, U".");
+		}
+		f.close (file);
+	} catch (MelderError) {
+		Melder_throw (me, U": MFCCs not saved to HTK file ", file, U".");
+	}
+}
+
 /* End of file Sound_to_MFCC.cpp */
@@ -2,7 +2,7 @@
 #define _Sound_to_MFCC_h_
 /* Sound_to_MFCC.h
  *
- * Copyright (C) 1993-2017 David Weenink
+ * Copyright (C) 1993-2017,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -29,5 +29,21 @@
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth,
 	double dt, double f1_mel, double fmax_mel, double df_mel);
+/*
+	Gives the same result as Sound_to_MelSpectrogram followed by MelSpectrogram_to_MFCC,
+	but without the intermediate MelSpectrogram: the frames are analysed in blocks on multiple threads,
+	and the filter bank and the cosine transform are applied as matrix products.
+	Only the first channel is analysed.
+*/
+
+void Sound_saveAsHtkMfccFile (Sound me, MelderFile file, integer numberOfCoefficients, double analysisWidth,
+	double dt, double f1_mel, double fmax_mel, double df_mel);
+/*
+	As Sound_to_MFCC, but writes the coefficients straight to a binary HTK feature file
+	(big-endian header and 32-bit floats, parameter kind MFCC_0, i.e. c1..cN followed by c0),
+	without creating an MFCC object.
+	Note that the coefficients follow the Davis & Mermelstein definition used in MFCC.h,
+	without the sqrt(2/N) scaling of the HTK book.
+*/
 
 #endif /* _Sound_to_MFCC_h_ */
@@ -1,6 +1,6 @@
 /* Sound_to_SPINET.cpp
  *
- * Copyright (C) 1993-2019 David Weenink
+ * Copyright (C) 1993-2019,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,6 +23,7 @@
 
 #include "Sound_to_SPINET.h"
 #include "NUM2.h"
+#include "NUMFourier.h"
 
 static double fgamma (double x, integer n) {
 	const double x2p1 = 1.0 + x * x;
@@ -51,11 +52,10 @@ autoSPINET Sound_to_SPINET (Sound me, double timeStep, double windowDuration, do
 		Sampled_shortTermAnalysis (me, windowDuration, timeStep, & numberOfFrames, & firstTime);
 		autoSPINET thee = SPINET_create (my xmin, my xmax, numberOfFrames, timeStep, firstTime, minimumFrequencyHz, maximumFrequencyHz, numberOfGammaFilters, excitationErbProportion, inhibitionErbProportion);
 		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
-		autoSound frame = Sound_createSimple (1, windowDuration, samplingFrequency);
 		autoVEC f = raw_VEC (numberOfGammaFilters);
 		autoVEC bw = raw_VEC (numberOfGammaFilters);
-		autoVEC aex = raw_VEC (numberOfGammaFilters);
-		autoVEC ain = raw_VEC (numberOfGammaFilters);
+		autoVEC aex = zero_VEC (numberOfGammaFilters);
+		autoVEC ain = zero_VEC (numberOfGammaFilters);
 		/*
 			Cochlear filterbank: gammatone.
 		*/
@@ -63,17 +63,55 @@ autoSPINET Sound_to_SPINET (Sound me, double timeStep, double windowDuration, do
 			f [i] = NUMerbToHertz (thy y1 + (i - 1) * thy dy);
 			bw [i] = NUM2pi * b * (f [i] * (6.23e-6 * f [i] + 93.39e-3) + 28.52);
 		}
+		/*
+			Each channel is the convolution of the sound with a gammatone of 0.1 s.
+			As in Sounds_convolve, we multiply spectra, but the spectrum of the sound,
+			which is the same for all channels, is computed only once.
+		*/
+		autoSound gammaTone1 = Sound_createGammaTone (0.0, 0.1, samplingFrequency, thy gamma, b, f [1], 0.0, 0.0, false);
+		const integer numberOfSamples_sound = my nx, numberOfSamples_gammaTone = gammaTone1 -> nx;
+		const integer numberOfSamples_filtered = numberOfSamples_sound + numberOfSamples_gammaTone - 1;
+		const integer nfft = Melder_iroundUpToPowerOfTwo (numberOfSamples_filtered);
+		autoNUMFourierTable fourierTable = NUMFourierTable_create (nfft);
+		autoVEC soundSpectrum = zero_VEC (nfft);
+		soundSpectrum.part (1, numberOfSamples_sound)  <<=  my z.row (1);
+		NUMfft_forward (fourierTable.get(), soundSpectrum.get());
 
 		autoMelderProgress progress (U"SPINET analysis");
 
-		for (integer i = 1; i <= numberOfGammaFilters; i ++) {
+		MelderThread_PARALLELIZE (numberOfGammaFilters, 1)
+
+		/*
+			The FFT routines use part of the table as scratch space, so each thread needs a table of its own.
+		*/
+		autoNUMFourierTable threadFourierTable = NUMFourierTable_create (nfft);
+		autoVEC spectrum = raw_VEC (nfft);
+		autoSound filtered = Sound_create (1, my xmin + gammaTone1 -> xmin, my xmax + gammaTone1 -> xmax, numberOfSamples_filtered,
+				my dx, my x1 + gammaTone1 -> x1);
+		autoSound frame = Sound_createSimple (1, windowDuration, samplingFrequency);
+
+		MelderThread_FOR (i) {
 			const double bb = (f [i] / 1000.0) * exp (- f [i] / 1000.0); // outer & middle ear and phase locking
 			const double tgammaMax = (thy gamma - 1) / bw [i]; // the time where the gamma function envelope has its maximum
 			const double gammaMaxAmplitude = pow ((thy gamma - 1) / (NUMe * bw [i]), thy gamma - 1);
 			const double timeCorrection = tgammaMax - windowDuration / 2.0;
 
 			autoSound gammaTone = Sound_createGammaTone (0.0, 0.1, samplingFrequency, thy gamma, b, f [i], 0.0, 0.0, false);
-			autoSound filtered = Sounds_convolve (me, gammaTone.get(), kSounds_convolve_scaling::SUM, kSounds_convolve_signalOutsideTimeDomain::ZERO);
+			Melder_assert (gammaTone -> nx == numberOfSamples_gammaTone);
+			spectrum.part (1, numberOfSamples_gammaTone)  <<=  gammaTone -> z.row (1);
+			spectrum.part (numberOfSamples_gammaTone + 1, nfft)  <<=  0.0;
+			NUMfft_forward (threadFourierTable.get(), spectrum.get());
+			spectrum [1] *= soundSpectrum [1];
+			for (integer k = 2; k < nfft; k += 2) {
+				const double re = soundSpectrum [k] * spectrum [k] - soundSpectrum [k + 1] * spectrum [k + 1];
+				spectrum [k + 1] = soundSpectrum [k] * spectrum [k + 1] + soundSpectrum [k + 1] * spectrum [k];
+				spectrum [k] = re;
+			}
+			if (nfft > 1)
+				spectrum [nfft] *= soundSpectrum [nfft];
+			NUMfft_backward (threadFourierTable.get(), spectrum.get());
+			filtered -> z.row (1)  <<=  spectrum.part (1, numberOfSamples_filtered);
+			filtered -> z.row (1)  *=  1.0 / nfft;
 			/*
 				To energy measure: weigh with broad-band transfer function.
 			*/
@@ -82,32 +120,39 @@ autoSPINET Sound_to_SPINET (Sound me, double timeStep, double windowDuration, do
 				Sounds_multiply (frame.get(), window.get());
 				thy y [i] [j] = Sound_power (frame.get()) * bb / gammaMaxAmplitude;
 			}
-			Melder_progress ((double) i / numberOfGammaFilters, U"SPINET: filter ", i, U" from ", numberOfGammaFilters, U".");
-		}
+			if (MelderThread_IS_MASTER) {
+				const double estimatedProgress = MelderThread_ESTIMATED_PROGRESS;
+				Melder_progress (estimatedProgress, U"SPINET: approximately ", Melder_iround (numberOfGammaFilters * estimatedProgress),
+						U" filters from ", numberOfGammaFilters, U".");
+			}
+		} MelderThread_ENDFOR
 		/*
 			Excitatory and inhibitory area functions.
 		*/
+		autoMAT hexsq = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
+		autoMAT hinsq = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
 		for (integer i = 1; i <= numberOfGammaFilters; i ++) {
 			for (integer k = 1; k <= numberOfGammaFilters; k ++) {
 				const double fr = (f [k] - f [i]) / bw [i];
-				aex [i] += fgamma (fr / thy excitationErbProportion, thy gamma);
-				ain [i] += fgamma (fr / thy inhibitionErbProportion, thy gamma);
+				hexsq [i] [k] = fgamma (fr / thy excitationErbProportion, thy gamma);
+				hinsq [i] [k] = fgamma (fr / thy inhibitionErbProportion, thy gamma);
+				aex [i] += hexsq [i] [k];
+				ain [i] += hinsq [i] [k];
 			}
 		}
 		/*
-			On-center off-surround interactions
+			On-center off-surround interactions: s = rectify (w . y),
+			where w [i] [k] = hexsq [i] [k] / aex [i] - hinsq [i] [k] / ain [i].
 		*/
-		for (integer j = 1; j <= numberOfFrames; j ++)
-			for (integer i = 1; i <= numberOfGammaFilters; i ++) {
-				longdouble a = 0.0;
-				for (integer k = 1; k <= numberOfGammaFilters; k ++) {
-					const double fr = (f [k] - f [i]) / bw [i];
-					const double hexsq = fgamma (fr / thy excitationErbProportion, thy gamma);
-					const double hinsq = fgamma (fr / thy inhibitionErbProportion, thy gamma);
-					a += thy y [k] [j] * (hexsq / aex [i] - hinsq / ain [i]);
-				}
-				thy s [i] [j] = a > 0.0 ? (double) a : 0.0;
-			}
+		autoMAT w = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
+		for (integer i = 1; i <= numberOfGammaFilters; i ++)
+			for (integer k = 1; k <= numberOfGammaFilters; k ++)
+				w [i] [k] = hexsq [i] [k] / aex [i] - hinsq [i] [k] / ain [i];
+		mul_MAT_out (thy s.get(), w.get(), thy y.get());
+		for (integer i = 1; i <= numberOfGammaFilters; i ++)
+			for (integer j = 1; j <= numberOfFrames; j ++)
+				if (thy s [i] [j] < 0.0)
+					thy s [i] [j] = 0.0;
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U":  no SPINET created.");
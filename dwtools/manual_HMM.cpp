@@ -188,6 +188,21 @@ ENTRY (U"Settings & EM Algorithm")
 NORMAL (U"As described in @@TableOfReal: To GaussianMixture...@.")
 MAN_END
 
+MAN_BEGIN (U"GaussianMixture & TableOfReal: Improve likelihood (blocks)...", U"djmw", 20261019)
+INTRO (U"Try to improve the likelihood of the parameters in the @@GaussianMixture@ by an @@expectation-maximization@ algorithm "
+	"that visits the rows of the @TableOfReal in consecutive blocks.")
+ENTRY (U"Settings")
+TERM (U"##Block size (rows)")
+DEFINITION (U"the number of data rows that are processed together. Only the sufficient statistics of the mixture, "
+	"i.e. for each component the sum of the responsibilities and the first and second moments, are kept between blocks.")
+TERM (U"##Mini-batch")
+DEFINITION (U"if off, the parameters are updated once after all blocks have been visited; the result is then the same as "
+	"with @@GaussianMixture & TableOfReal: Improve likelihood...@. If on, the parameters are updated after every block "
+	"with a stepwise EM algorithm: the statistics of the block are mixed into the running statistics with a step size "
+	"(%t+2)^^\\-m0.6^, where %t counts the updates. For large data sets this generally converges in far fewer passes.")
+NORMAL (U"The other settings are as described in @@TableOfReal: To GaussianMixture...@.")
+MAN_END
+
 MAN_BEGIN (U"GaussianMixture & TableOfReal: To Correlation (columns)", U"djmw", 20101111)
 INTRO (U"Create a @Correlation matrix from the selected @TableOfReal and the @GaussianMixture.")
 NORMAL (U"We start by calculating the ClassificationTable @@GaussianMixture & TableOfReal: To ClassificationTable|from "
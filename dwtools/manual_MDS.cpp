@@ -684,6 +684,7 @@ LIST_ITEM (U"\\bu @@Dissimilarity: To Configuration (interval mds)...")
 LIST_ITEM (U"\\bu @@Dissimilarity: To Configuration (ratio mds)...")
 LIST_ITEM (U"\\bu @@Dissimilarity: To Configuration (absolute mds)...")
 LIST_ITEM (U"\\bu @@Dissimilarity: To Configuration (kruskal)...")
+LIST_ITEM (U"\\bu @@Dissimilarity: To Configuration (landmark mds)...")
 LIST_ITEM (U"Transformations")
 LIST_ITEM (U"\\bu @@Dissimilarity: To Distance...")
 LIST_ITEM (U"\\bu @@Dissimilarity: To Weight")
@@ -859,6 +860,31 @@ NORMAL (U"The @disparities %d\\'p__%ij_ will be obtained from dissimilarities "
 EQUATION (U"%d\\'p__%ij_ = %b \\.c %\\de__%ij_")
 MAN_END
 
+MAN_BEGIN (U"Dissimilarity: To Configuration (landmark mds)...", U"djmw", 20261019)
+INTRO (U"A command that creates a @Configuration object from a large @Dissimilarity object, "
+	"by performing a ratio mds on a subset of the points only.")
+ENTRY (U"Settings")
+TERM (U"##Number of dimensions")
+DEFINITION (U"the dimension of the resulting configuration.")
+TERM (U"##Number of landmarks")
+DEFINITION (U"the number of points on which the @@Dissimilarity: To Configuration (ratio mds)...|ratio mds@ is performed. "
+	"If this number is not smaller than the number of points, all points are landmarks.")
+TERM (U"##Number of refinement iterations")
+DEFINITION (U"the number of majorization steps with which the position of each point that is not a landmark is improved.")
+TERM (U"##Tolerance#, ##Maximum number of iterations#, ##Number of repetitions")
+DEFINITION (U"determine the ratio mds of the landmarks.")
+ENTRY (U"Algorithm")
+NORMAL (U"The first landmark is chosen at random, every next landmark is the point whose "
+	"dissimilarity to its nearest landmark is largest (maxmin selection). "
+	"After the ratio mds of the landmarks, every other point %a is placed by triangulation:")
+EQUATION (U"%%x__a_% = %%x%\\bar + \\de (%X__c_\\'p%X__c_)^^\\-1^%X__c_\\'p (%n \\-- %\\de__%a_^2)")
+NORMAL (U"where %X__c_ contains the centred landmark coordinates, %n__%k_ is the squared norm of the %k-th row of %X__c_, "
+	"and %\\de__%ak_ are the dissimilarities of %a to the landmarks, scaled to the configuration. "
+	"The position is then refined by minimizing the stress with respect to the fixed landmarks.")
+NORMAL (U"For %N points and %L landmarks, the computing time is proportional to %N\\.c%L instead of to %N^2 "
+	"per iteration. The placement of the points is multi-threaded.")
+MAN_END
+
 MAN_BEGIN (U"Dissimilarity: To Distance...", U"djmw", 20040407)
 INTRO (U"A command that creates a @Distance object from a selected "
 	"@Dissimilarity object.")
@@ -2751,6 +2751,55 @@ MAN_BEGIN (U"Matrix: To NMF (IS)...", U"djmw", 20191025)
 INTRO (U"A command to get the @@non-negative matrix factorization@ of a matrix based on the Itakura-Saito distance as was described in @@Févotte, Bertin & Durrieu (2009)@.")
 MAN_END
 
+MAN_BEGIN (U"Matrix: To DTW (band)...", U"djmw", 20261019)
+INTRO (U"A command to create a @DTW from two selected @Matrix objects, where the path is restricted to a Sakoe-Chiba band.")
+NORMAL (U"The columns of the matrices are the frames, the rows are the features. The result is the same as the one of "
+	"##To DTW...# followed by @@DTW: Find path (band & slope)...@, but only the distances inside the band are calculated; "
+	"the distances outside the band are undefined. This saves a lot of time for long matrices. "
+	"While searching for the path, only the band is kept in memory; "
+	"if you do not need the DTW itself, @@Matrix: To Table (DTW path, band)...@ avoids creating it altogether.")
+ENTRY (U"Settings")
+TERM (U"##Distance metric")
+DEFINITION (U"the %n in the distance (\\Si__%k_ |%x__%k_ \\-- %y__%k_|^%n)^^1/%n^ between two frames.")
+TERM (U"##Sakoe-Chiba band (s)#, ##Slope constraint#")
+DEFINITION (U"as in @@DTW: Find path (band & slope)...@.")
+MAN_END
+
+MAN_BEGIN (U"Matrix: To DTW (multiscale)...", U"djmw", 20261019)
+INTRO (U"A command to create a @DTW from two selected @Matrix objects with a coarse-to-fine search for the path, "
+	"as described in @@Salvador & Chan (2007)@.")
+NORMAL (U"The path is first determined for matrices in which every two successive frames have been averaged into one frame, "
+	"recursively. The path at the coarser level, widened by %radius frames on all sides, "
+	"defines the band where the path at the finer level is searched for. "
+	"Only the distances inside this band are calculated; the distances outside the band are undefined.")
+ENTRY (U"Settings")
+TERM (U"##Distance metric")
+DEFINITION (U"the %n in the distance (\\Si__%k_ |%x__%k_ \\-- %y__%k_|^%n)^^1/%n^ between two frames.")
+TERM (U"##Radius (frames)")
+DEFINITION (U"the number of frames by which the projected path is widened. Larger values make it less likely to miss the optimal path.")
+MAN_END
+
+MAN_BEGIN (U"Matrix: To Table (DTW path, band)...", U"djmw", 20261019)
+INTRO (U"A command to create a @Table with the path of @@Matrix: To DTW (band)...@ from two selected @Matrix objects, "
+	"without creating the @DTW.")
+NORMAL (U"The memory needed is proportional to the number of cells in the Sakoe-Chiba band, "
+	"instead of to the product of the numbers of frames of the two matrices. "
+	"Each row of the table is a point of the path, with the columns ##frame1# and ##frame2# (the frame numbers in the first "
+	"and the second matrix), ##time1# and ##time2# (the corresponding times), ##distance# (the distance between the two frames) "
+	"and ##cumulativeDistance# (the weighted distance accumulated along the path).")
+ENTRY (U"Settings")
+NORMAL (U"as in @@Matrix: To DTW (band)...@.")
+MAN_END
+
+MAN_BEGIN (U"Matrix: To Table (DTW path, multiscale)...", U"djmw", 20261019)
+INTRO (U"A command to create a @Table with the path of @@Matrix: To DTW (multiscale)...@ from two selected @Matrix objects, "
+	"without creating the @DTW.")
+NORMAL (U"The columns of the table are as in @@Matrix: To Table (DTW path, band)...@. "
+	"At every level of the coarse-to-fine search only the band is kept in memory.")
+ENTRY (U"Settings")
+NORMAL (U"as in @@Matrix: To DTW (multiscale)...@.")
+MAN_END
+
 MAN_BEGIN (U"MelFilter", U"djmw", 20141022)
 INTRO (U"A #deprecated @@types of objects|type of object@ in Praat. It has been replaced by the @@MelSpectrogram@.")
 NORMAL (U"An object of type MelFilter represents an acoustic time-frequency "
@@ -2813,6 +2862,50 @@ MAN_BEGIN (U"NMF", U"djmw", 20190312)
 INTRO (U"An object of type ##NMF# represents the @@non-negative matrix factorization@ of a matrix.")
 MAN_END
 
+MAN_BEGIN (U"NMF: Improve factorization (m.u., Matrix binary file)...", U"djmw", 20261019)
+INTRO (U"Improves the @@non-negative matrix factorization@ of a Matrix that is stored in a Praat binary file, "
+	"without reading the whole Matrix into memory.")
+NORMAL (U"The data are read from the file one block of columns at a time, in every pass through the data. "
+	"A Matrix that is too large to be held in memory can therefore be factorized, as long as the selected NMF fits; "
+	"you can create an NMF with the right numbers of rows and columns with ##Create NMF (random uniform)...#.")
+ENTRY (U"Settings")
+TERM (U"##Matrix binary file#")
+DEFINITION (U"the file, as written by ##Save as binary file...# for a Matrix. "
+	"The numbers of rows and columns of the Matrix should equal those of the NMF.")
+NORMAL (U"The other settings are those of @@NMF & Matrix: Improve factorization (m.u., blocks)...@, "
+	"and with the same settings and the same NMF the result is also the same as for that command.")
+MAN_END
+
+MAN_BEGIN (U"Create NMF (random uniform)...", U"djmw", 20261019)
+INTRO (U"A command to create an @NMF whose features and weights are drawn from a uniform distribution between 0 and 1.")
+NORMAL (U"This is the starting point for @@NMF: Improve factorization (m.u., Matrix binary file)...@, "
+	"which does not need a Matrix object.")
+MAN_END
+
+MAN_BEGIN (U"NMF & Matrix: Improve factorization (m.u., blocks)...", U"djmw", 20261019)
+INTRO (U"Improves the @@non-negative matrix factorization@ of the selected Matrix with multiplicative updates, "
+	"visiting the columns of the data matrix in blocks.")
+ENTRY (U"Settings")
+TERM (U"##Block size (columns)#")
+DEFINITION (U"the number of columns of the data that are processed together. "
+	"Apart from the factorization itself, the memory used only depends on this number and not on the number of columns of the data.")
+TERM (U"##Online#")
+DEFINITION (U"if on, the feature matrix #%F is updated after each block instead of once per pass through the data. "
+	"The statistics ##D*W'# and ##W*W'# for this update are accumulated over the blocks visited so far "
+	"(Mairal, Bach, Ponce & Sapiro 2010); from the second pass on, the contribution of a block is replaced "
+	"as soon as its weights have been updated. This often needs fewer passes through the data.")
+TERM (U"##Maximum number of iterations#")
+DEFINITION (U"the maximum number of passes through the data.")
+TERM (U"##Change tolerance#, ##Approximation tolerance#")
+DEFINITION (U"determine when the iteration has converged, as in the other multiplicative update commands.")
+ENTRY (U"Algorithm")
+NORMAL (U"For each block %b of columns the weights are updated as ##W__%b_ = W__%b_ .* (F'*D__%b_) ./ (F'*F*W__%b_ + 10^^−9^)#. "
+	"The product ##F'*F*W__%b_# is computed column by column within this update, in parallel over the columns, "
+	"and the update of #%F is done in parallel over its rows. "
+	"Without the online option and with a block size that is at least the number of columns, "
+	"the result equals that of ##Improve factorization (m.u.)...#.")
+MAN_END
+
 MAN_BEGIN (U"non-negative matrix factorization", U"djmw", 20230801)
 INTRO (U"The ##non-negative matrix factorization## or ##NMF# is a factorization of a data matrix #%D, whose elements are all non-negative, into a feature matrix #%F and a weights matrix #%W such that #%D \\~~ #%F #%W, where the elements of #%F and #%W are also all non-negative.")
 ENTRY (U"Algorithms for computing NMF")
@@ -5000,6 +5093,24 @@ NORMAL (U"Normally %numberOfConstraints will equal 1. However, when the SSCP was
 	"within-groups SSCP from pooling the individual group SSCP's, %numberOfConstraints will equal the number of pooled SSCP's,  %g.")
 MAN_END
 
+MAN_BEGIN (U"SSCP & TableOfReal: Add rows...", U"djmw", 20261019)
+INTRO (U"Adds the selected rows of the @TableOfReal to the sums of squares and cross products "
+	"of the selected @SSCP, as if the SSCP had been calculated from all these rows together.")
+NORMAL (U"With this command a @PCA can be computed from a data set that is too large to be held "
+	"in memory at once: create an SSCP from the first block of rows with @@TableOfReal: To SSCP...@, "
+	"add each following block with this command, and finally use ##To PCA#.")
+ENTRY (U"Settings")
+TERM (U"##Begin row#, ##End row#")
+DEFINITION (U"the rows to add. If both are zero, all rows are added.")
+TERM (U"##Begin column#, ##End column#")
+DEFINITION (U"the columns to use. Their number must equal the dimension of the SSCP.")
+ENTRY (U"Algorithm")
+NORMAL (U"The sums of squares and cross products of the block are calculated around the centroid "
+	"of the block and then merged with those of the SSCP, with a correction for the difference between "
+	"the two centroids (@@Chan, Golub & LeVeque (1979)@). This is numerically as good as calculating "
+	"the SSCP from all rows at once.")
+MAN_END
+
 MAN_BEGIN (U"SSCP & TableOfReal: Extract quantile range...", U"djmw", 20040225)
 INTRO (U"Extract those rows from the selected @TableOfReal object whose @@Mahalanobis "
 	"distance@, with respect to the selected @SSCP object, are within the "
@@ -5072,6 +5183,25 @@ Example 10
 )~~~"
 MAN_PAGES_END
 
+MAN_BEGIN (U"Strings: To Table (edit distances)...", U"djmw", 20261019)
+INTRO (U"A command to compute the edit distances between many pairs of symbol sequences at once, "
+	"for example between recognised and reference phone transcriptions.")
+NORMAL (U"Select two @Strings objects with the same number of strings, the targets first and the sources second. "
+	"Each string is a transcription whose symbols are separated by white space. The result is a @Table with a row for every pair "
+	"and columns \"target\", \"source\" and \"distance\". The distance is the one that an @@EditDistanceTable@ of the two "
+	"transcriptions would give in its top-right cell. If you also select an @@EditCostsTable@, its costs are used, otherwise the default costs.")
+NORMAL (U"The same command exists for a @Table, where you name the target and the source column.")
+ENTRY (U"Setting")
+TERM (U"##Alignments")
+DEFINITION (U"adds a column \"operations\" with one character per step of the minimum path: "
+	"\"i\" for an insertion, \"d\" for a deletion, \"s\" for a substitution and \"=\" for a match.")
+ENTRY (U"Algorithm")
+NORMAL (U"The symbols of all transcriptions are converted to integer codes once, and the costs per code are looked up once in the "
+	"EditCostsTable. The pairs are processed in parallel. If no alignments are needed and all insertion and deletion costs are equal, "
+	"only a diagonal band of the table is computed; the band is doubled until the distance inside it is smaller than the cost "
+	"of any path that leaves the band (Ukkonen's method).")
+MAN_END
+
 MAN_BEGIN (U"T-test", U"djmw", 20020117)
 INTRO (U"A test on the mean of a normal variate when the variance is unknown.")
 NORMAL (U"In Praat, the %t-test is used to query a @Covariance object and:")
@@ -5739,6 +5869,29 @@ INTRO (U"A command that creates a @PCA object from every selected "
 NORMAL (U"In @@Principal component analysis|the tutorial on PCA@ you will find more info on principal component analysis.")
 MAN_END
 
+MAN_BEGIN (U"TableOfReal: To PCA (truncated)...", U"djmw", 20261019)
+INTRO (U"A command that creates a @PCA object with only the first components from every selected "
+	"@TableOfReal object, where, as in @@TableOfReal: To PCA@, the TableOfReal object is interpreted as row-oriented.")
+NORMAL (U"For tables with very many rows, this is much faster than @@TableOfReal: To PCA@, because "
+	"no full singular value decomposition of the data is computed: the rows are processed in blocks, "
+	"so that the computing time grows linearly with the number of rows.")
+ENTRY (U"Settings")
+TERM (U"##Number of components#")
+DEFINITION (U"the number of principal components that you want. Components whose eigenvalue is zero are not included.")
+TERM (U"##Number of power iterations#")
+DEFINITION (U"determines the precision if the number of columns is large compared to the number of components.")
+ENTRY (U"Algorithm")
+NORMAL (U"If the number of columns is small compared to the number of components, the sums of squares and cross products "
+	"of the centred data are accumulated block by block, after which the eigenvectors of this matrix are computed. "
+	"The result is then equal to the first components of @@TableOfReal: To PCA@ (apart from the signs of the eigenvectors).")
+NORMAL (U"Otherwise, the space spanned by the dominant eigenvectors is approximated by %%randomized subspace iteration%: "
+	"a random orthonormal basis of dimension %%numberOfComponents% + 10 is multiplied by the sums of squares and "
+	"cross products matrix (without this matrix ever being formed) and orthonormalized again, "
+	"%%numberOfPowerIterations% + 1 times. The components are then found within this subspace. "
+	"Each multiplication takes a pass over the blocks of data; more power iterations give more precise components "
+	"if the eigenvalues decrease slowly.")
+MAN_END
+
 MAN_BEGIN (U"TableOfReal: To SSCP...", U"djmw", 19990218)
 INTRO (U"Calculates Sums of Squares and Cross Products (@SSCP) from the selected @TableOfReal.")
 ENTRY (U"Algorithm")
@@ -6599,6 +6752,11 @@ NORMAL (U"H. Sakoe & S. Chiba (1978): \"Dynamic programming algorithm optimizati
 	"%%Transactions on ASSP% #26: 43\\--49.")
 MAN_END
 
+MAN_BEGIN (U"Salvador & Chan (2007)", U"djmw", 20261019)
+NORMAL (U"S. Salvador & P. Chan (2007): \"Toward accurate dynamic time warping in linear time and space.\" "
+	"%%Intelligent Data Analysis% #11: 561\\--580.")
+MAN_END
+
 MAN_BEGIN (U"Sandwell (1987)", U"djmw", 20170915)
 NORMAL (U"D.T. Sandwell (1987): \"Biharmonic spline interpolation of GEOS-3 and SEASAT altimeter data.\", "
 		"%%Geophysica Research Letters% #14: 139\\--142.")
@@ -1,6 +1,6 @@
 /* praat_David_init.cpp
  *
- * Copyright (C) 1993-2025 David Weenink, 2015,2023,2024 Paul Boersma
+ * Copyright (C) 1993-2026 David Weenink, 2015,2023,2024 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -484,6 +484,32 @@ DO
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get());
 }
 
+FORM (COMBINE_ALL_TO_ONE__CCs_to_Distance_dtw, U"CCs: To Distance (DTW)", U"CCs: To Distance (DTW)...") {
+	COMMENT (U"Distance  between cepstral coefficients")
+	REAL (cepstralWeight, U"Cepstral weight", U"1.0")
+	REAL (logEnergyWeight, U"Log energy weight", U"0.0")
+	REAL (regressionWeight, U"Regression weight", U"0.0")
+	REAL (regressionLogEnergyWeight, U"Regression log energy weight", U"0.0")
+	REAL (regressionWindowLength, U"Regression window length (s)", U"0.056")
+	COMMENT (U"Path constraints")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.05")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	REAL (maximumDistance, U"Maximum distance", U"0.0 (= no maximum)")
+	OK
+DO
+	COMBINE_ALL_TO_ONE (CC)
+		Melder_require (list.size > 1,
+			U"To compute a distance, you should select at least two CC objects.");
+		autoDistance result = CCs_to_Distance_dtw (& list, cepstralWeight, logEnergyWeight, regressionWeight,
+			regressionLogEnergyWeight, regressionWindowLength, sakoeChibaBand, slopeConstraint, maximumDistance
+		);
+	COMBINE_ALL_TO_ONE_END (U"dtw")
+}
+
 DIRECT (CONVERT_EACH_TO_ONE__CC_to_Matrix) {
 	CONVERT_EACH_TO_ONE (CC)
 		autoMatrix result = CC_to_Matrix (me);
@@ -3413,6 +3439,28 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get(), U"_", columnLabel)
 }
 
+FORM (CONVERT_EACH_TO_ONE__Table_to_Table_editDistances, U"Table: To Table (edit distances)", U"Strings: To Table (edit distances)...") {
+	SENTENCE (targetColumnLabel, U"Target column", U"target")
+	SENTENCE (sourceColumnLabel, U"Source column", U"source")
+	BOOLEAN (alignments, U"Alignments", false)
+	OK
+DO
+	CONVERT_EACH_TO_ONE (Table)
+		autoTable result = Table_to_Table_editDistances (me, targetColumnLabel, sourceColumnLabel, nullptr, alignments);
+	CONVERT_EACH_TO_ONE_END (my name.get(), U"_distances")
+}
+
+FORM (CONVERT_ONE_AND_ONE_TO_ONE__Table_EditCostsTable_to_Table_editDistances, U"Table & EditCostsTable: To Table (edit distances)", U"Strings: To Table (edit distances)...") {
+	SENTENCE (targetColumnLabel, U"Target column", U"target")
+	SENTENCE (sourceColumnLabel, U"Source column", U"source")
+	BOOLEAN (alignments, U"Alignments", false)
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_ONE (Table, EditCostsTable)
+		autoTable result = Table_to_Table_editDistances (me, targetColumnLabel, sourceColumnLabel, you, alignments);
+	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get(), U"_distances")
+}
+
 /******************* LegendreSeries *********************************/
 
 FORM (CREATE_ONE__LegendreSeries_create, U"Create LegendreSeries", U"Create LegendreSeries...") {
@@ -3759,6 +3807,44 @@ DO
 	MODIFY_FIRST_OF_ONE_AND_ONE_END
 }
 
+FORM (MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_mu_blocks, U"NMF & Matrix: Improve factorization (m.u., blocks)", U"NMF & Matrix: Improve factorization (m.u., blocks)...") {
+	NATURAL (blockSize, U"Block size (columns)", U"1000")
+	BOOLEAN (online, U"Online", true)
+	NATURAL (maximumNumberOfIterations, U"Maximum number of iterations", U"100")
+	REAL (tolx, U"Change tolerance", U"1e-9")
+	REAL (told, U"Approximation tolerance", U"1e-9")
+	BOOLEAN (info, U"Info", 0)
+	OK
+DO
+	MODIFY_FIRST_OF_ONE_AND_ONE (NMF, Matrix)
+		Melder_require (my numberOfColumns == your nx && my numberOfRows == your ny,
+			U"The dimensions of the NMF and the Matrix should match.");
+		NMF_improveFactorization_mu_blocks (me,
+			[&] (integer firstColumn, integer lastColumn) -> constMATVU {
+				return your z.verticalBand (firstColumn, lastColumn);
+			},
+			blockSize, online, maximumNumberOfIterations, tolx, told, info
+		);
+	MODIFY_FIRST_OF_ONE_AND_ONE_END
+}
+
+FORM (MODIFY_EACH__NMF_improveFactorization_mu_matrixBinaryFile, U"NMF: Improve factorization (m.u., Matrix binary file)", U"NMF: Improve factorization (m.u., Matrix binary file)...") {
+	INFILE (matrixFile, U"Matrix binary file", U"data.Matrix")
+	NATURAL (blockSize, U"Block size (columns)", U"1000")
+	BOOLEAN (online, U"Online", true)
+	NATURAL (maximumNumberOfIterations, U"Maximum number of iterations", U"100")
+	REAL (tolx, U"Change tolerance", U"1e-9")
+	REAL (told, U"Approximation tolerance", U"1e-9")
+	BOOLEAN (info, U"Info", 0)
+	OK
+DO
+	MODIFY_EACH (NMF)
+		structMelderFile file { };
+		Melder_relativePathToFile (matrixFile, & file);
+		NMF_improveFactorization_mu_matrixBinaryFile (me, & file, blockSize, online, maximumNumberOfIterations, tolx, told, info);
+	MODIFY_EACH_END
+}
+
 FORM (MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_als, U"NMF & Matrix: Improve factorization (ALS)", nullptr) {
 	NATURAL (maximumNumberOfIterations, U"Maximum number of iterations", U"10")
 	REAL (tolx, U"Change tolerance", U"1e-9")
@@ -3794,6 +3880,56 @@ DO
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (CONVERT_TWO_TO_ONE__Matrices_to_DTW_band, U"Matrices: To DTW (band)", U"Matrix: To DTW (band)...") {
+	REAL (distanceMetric, U"Distance metric", U"2.0")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.05")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Matrix)
+		autoDTW result = Matrices_to_DTW_band (me, you, sakoeChibaBand, slopeConstraint, distanceMetric);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
+FORM (CONVERT_TWO_TO_ONE__Matrices_to_DTW_multiscale, U"Matrices: To DTW (multiscale)", U"Matrix: To DTW (multiscale)...") {
+	REAL (distanceMetric, U"Distance metric", U"2.0")
+	NATURAL (radius, U"Radius (frames)", U"10")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Matrix)
+		autoDTW result = Matrices_to_DTW_multiscale (me, you, radius, distanceMetric);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
+FORM (CONVERT_TWO_TO_ONE__Matrices_to_Table_dtwPath_band, U"Matrices: To Table (DTW path, band)", U"Matrix: To Table (DTW path, band)...") {
+	REAL (distanceMetric, U"Distance metric", U"2.0")
+	REAL (sakoeChibaBand, U"Sakoe-Chiba band (s)", U"0.05")
+	CHOICE (slopeConstraint, U"Slope constraint", 1)
+		OPTION (U"no restriction")
+		OPTION (U"1/3 < slope < 3")
+		OPTION (U"1/2 < slope < 2")
+		OPTION (U"2/3 < slope < 3/2")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Matrix)
+		autoTable result = Matrices_to_Table_dtwPath_band (me, you, sakoeChibaBand, slopeConstraint, distanceMetric);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
+FORM (CONVERT_TWO_TO_ONE__Matrices_to_Table_dtwPath_multiscale, U"Matrices: To Table (DTW path, multiscale)", U"Matrix: To Table (DTW path, multiscale)...") {
+	REAL (distanceMetric, U"Distance metric", U"2.0")
+	NATURAL (radius, U"Radius (frames)", U"10")
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Matrix)
+		autoTable result = Matrices_to_Table_dtwPath_multiscale (me, you, radius, distanceMetric);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
 FORM (CONVERT_EACH_TO_ONE__Matrix_to_PatternList, U"Matrix: To PatternList", nullptr) {
 	NATURAL (join, U"Join", U"1")
 	OK
@@ -4266,6 +4402,21 @@ DO
 	CONVERT_ONE_AND_ONE_TO_ONE_END (U"ttgn_", tierNumber)
 }
 
+FORM (CREATE_ONE__NMF_create, U"Create NMF (random uniform)", U"Create NMF (random uniform)...") {
+	WORD (name, U"Name", U"nmf")
+	NATURAL (numberOfRows, U"Number of rows", U"100")
+	NATURAL (numberOfColumns, U"Number of columns", U"1000")
+	NATURAL (numberOfFeatures, U"Number of features", U"10")
+	OK
+DO
+	Melder_require (numberOfFeatures <= numberOfColumns,
+		U"The number of features should not exceed the number of columns.");
+	CREATE_ONE
+		autoNMF result = NMF_create (numberOfRows, numberOfColumns, numberOfFeatures);
+		NMF_initializeFactorization (result.get(), constMATVU (), kNMF_Initialization::RANDOM_UNIFORM);
+	CREATE_ONE_END (name)
+}
+
 DIRECT (HELP__NMF_help) {
 	HELP (U"NMF")
 }
@@ -6686,6 +6837,18 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get())
 }
 
+FORM (MODIFY_FIRST_OF_ONE_AND_ONE__SSCP_TableOfReal_addRows, U"SSCP & TableOfReal: Add rows", U"SSCP & TableOfReal: Add rows...") {
+	INTEGER (fromRow, U"Begin row", U"0")
+	INTEGER (toRow, U"End row", U"0")
+	INTEGER (fromColumn, U"Begin column", U"0")
+	INTEGER (toColumn, U"End column", U"0")
+	OK
+DO
+	MODIFY_FIRST_OF_ONE_AND_ONE (SSCP, TableOfReal)
+		SSCP_TableOfReal_addRows (me, you, fromRow, toRow, fromColumn, toColumn);
+	MODIFY_FIRST_OF_ONE_AND_ONE_END
+}
+
 DIRECT (CONVERT_EACH_TO_ONE__SSCP_to_PCA) {
 	CONVERT_EACH_TO_ONE (SSCP)
 		autoPCA result = SSCP_to_PCA (me);
@@ -6778,6 +6941,24 @@ DIRECT (CONVERT_TWO_TO_ONE__Strings_to_EditDistanceTable) {
 	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
 }
 
+FORM (CONVERT_TWO_TO_ONE__Strings_to_Table_editDistances, U"Strings: To Table (edit distances)", U"Strings: To Table (edit distances)...") {
+	BOOLEAN (alignments, U"Alignments", false)
+	OK
+DO
+	CONVERT_TWO_TO_ONE (Strings)
+		autoTable result = Strings_to_Table_editDistances (me, you, nullptr, alignments);
+	CONVERT_TWO_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
+FORM (CONVERT_TWO_AND_ONE_TO_ONE__Strings_EditCostsTable_to_Table_editDistances, U"Strings & EditCostsTable: To Table (edit distances)", U"Strings: To Table (edit distances)...") {
+	BOOLEAN (alignments, U"Alignments", false)
+	OK
+DO
+	CONVERT_TWO_AND_ONE_TO_ONE (Strings, EditCostsTable)
+		autoTable result = Strings_to_Table_editDistances (me, you, him, alignments);
+	CONVERT_TWO_AND_ONE_TO_ONE_END (my name.get(), U"_", your name.get())
+}
+
 FORM (CONVERT_EACH_TO_ONE__Strings_to_StringsIndex, U"Strings: To StringsIndex", nullptr) {
 	OPTIONMENU_ENUM (kStrings_sorting, sorting, U"Sorting method", kStrings_sorting::DEFAULT)
 	OK
@@ -7919,6 +8100,16 @@ DIRECT (CONVERT_EACH_TO_ONE__TableOfReal_to_PCA_byRows) {
 	CONVERT_EACH_TO_ONE_END (my name.get())
 }
 
+FORM (CONVERT_EACH_TO_ONE__TableOfReal_to_PCA_byRows_truncated, U"TableOfReal: To PCA (truncated)", U"TableOfReal: To PCA (truncated)...") {
+	NATURAL (numberOfComponents, U"Number of components", U"20")
+	INTEGER (numberOfPowerIterations, U"Number of power iterations", U"2")
+	OK
+DO
+	CONVERT_EACH_TO_ONE (TableOfReal)
+		autoPCA result = TableOfReal_to_PCA_byRows_truncated (me, numberOfComponents, numberOfPowerIterations);
+	CONVERT_EACH_TO_ONE_END (my name.get())
+}
+
 FORM (CONVERT_EACH_TO_ONE__TableOfReal_to_SSCP, U"TableOfReal: To SSCP", U"TableOfReal: To SSCP...") {
 	INTEGER (fromRow, U"Begin row", U"0")
 	INTEGER (toRow, U"End row", U"0")
@@ -8660,6 +8851,8 @@ void praat_CC_init (ClassInfo klas) {
 			CONVERT_EACH_TO_ONE__CC_to_Matrix);
 	praat_addAction1 (klas, 2, U"To DTW...", nullptr, 0, 
 			CONVERT_TWO_TO_ONE__CCs_to_DTW);
+	praat_addAction1 (klas, 0, U"To Distance (DTW)...", nullptr, 0, 
+			COMBINE_ALL_TO_ONE__CCs_to_Distance_dtw);
 }
 
 static void praat_Eigen_Matrix_project (ClassInfo klase, ClassInfo klasm); // deprecated 2014
@@ -9076,6 +9269,8 @@ void praat_David_init () {
 	praat_addMenuCommand (U"Objects", U"New", U"Create Strings as characters...", U"Create Strings from tokens...", GuiMenu_DEPTH_2 | GuiMenu_HIDDEN,
 			CREATE_ONE__Strings_createAsCharacters);
 
+	praat_addMenuCommand (U"Objects", U"New", U"Create NMF (random uniform)...", nullptr, GuiMenu_HIDDEN,
+			CREATE_ONE__NMF_create);
 	praat_addMenuCommand (U"Objects", U"New", U"Create simple Polygon...", nullptr, GuiMenu_HIDDEN,
 			CREATE_ONE__Polygon_createSimple);
 	praat_addMenuCommand (U"Objects", U"New", U"Create Polygon (random vertices)...", nullptr, GuiMenu_DEPRECATED_2016,
@@ -9818,6 +10013,14 @@ void praat_David_init () {
 			CONVERT_EACH_TO_MULTIPLE_Matrix_eigen_complex);
 	praat_addAction1 (classMatrix, 2, U"To DTW...", U"To ParamCurve", 1,
 			CONVERT_TWO_TO_ONE__Matrices_to_DTW);
+	praat_addAction1 (classMatrix, 2, U"To DTW (band)...", U"To DTW...", 1,
+			CONVERT_TWO_TO_ONE__Matrices_to_DTW_band);
+	praat_addAction1 (classMatrix, 2, U"To DTW (multiscale)...", U"To DTW (band)...", 1,
+			CONVERT_TWO_TO_ONE__Matrices_to_DTW_multiscale);
+	praat_addAction1 (classMatrix, 2, U"To Table (DTW path, band)...", U"To DTW (multiscale)...", 1,
+			CONVERT_TWO_TO_ONE__Matrices_to_Table_dtwPath_band);
+	praat_addAction1 (classMatrix, 2, U"To Table (DTW path, multiscale)...", U"To Table (DTW path, band)...", 1,
+			CONVERT_TWO_TO_ONE__Matrices_to_Table_dtwPath_multiscale);
 
 	praat_addAction2 (classMatrix, 1, classCategories, 1, U"To TableOfReal", nullptr, 0,
 			CONVERT_ONE_AND_ONE_TO_ONE__Matrix_Categories_to_TableOfReal);
@@ -9905,6 +10108,8 @@ void praat_David_init () {
 			GRAPHICS_EACH__NMF_paintWeights);
 	praat_addAction1 (classNMF, 0, U"To Matrix", nullptr, 0,
 			CONVERT_EACH_TO_ONE__NMF_to_Matrix);
+	praat_addAction1 (classNMF, 0, U"Improve factorization (m.u., Matrix binary file)...", nullptr, 0,
+			MODIFY_EACH__NMF_improveFactorization_mu_matrixBinaryFile);
 
 	praat_addAction2 (classNMF, 1, classMatrix, 1, U"Get Euclidean distance", nullptr, 0,
 			QUERY_ONE_AND_ONE_FOR_REAL__NMF_Matrix_getEuclideanDistance);
@@ -9914,6 +10119,8 @@ void praat_David_init () {
 			MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_als);
 	praat_addAction2 (classNMF, 1, classMatrix, 1, U"Improve factorization (m.u.)...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_mu);
+	praat_addAction2 (classNMF, 1, classMatrix, 1, U"Improve factorization (m.u., blocks)...", nullptr, 0,
+			MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_mu_blocks);
 	praat_addAction2 (classNMF, 1, classMatrix, 1, U"Improve factorization (IS)...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_AND_ONE__NMF_Matrix_improveFactorization_is);
 
@@ -10348,6 +10555,8 @@ void praat_David_init () {
 			CONVERT_EACH_TO_ONE__SSCP_to_Correlation);
 	praat_addAction1 (classSSCP, 0, U"To Covariance...", nullptr, 0,
 			CONVERT_EACH_TO_ONE__SSCP_to_Covariance);
+	praat_addAction2 (classSSCP, 1, classTableOfReal, 1, U"Add rows...", nullptr, 0,
+			MODIFY_FIRST_OF_ONE_AND_ONE__SSCP_TableOfReal_addRows);
 
 	praat_addAction1 (classStrings, 0, U"To Categories", nullptr, 0,
 			CONVERT_EACH_TO_ONE__Strings_to_Categories);
@@ -10361,6 +10570,8 @@ void praat_David_init () {
 			CONVERT_EACH_TO_ONE__Strings_to_Permutation);
 	praat_addAction1 (classStrings, 2, U"To EditDistanceTable", U"To Distributions", 0,
 			CONVERT_TWO_TO_ONE__Strings_to_EditDistanceTable);
+	praat_addAction1 (classStrings, 2, U"To Table (edit distances)...", U"To EditDistanceTable", 0,
+			CONVERT_TWO_TO_ONE__Strings_to_Table_editDistances);
 	praat_addAction1 (classStrings, 0, U"To StringsIndex...", U"To Permutation...", GuiMenu_HIDDEN,
 			CONVERT_EACH_TO_ONE__Strings_to_StringsIndex);
 	praat_addAction1 (classSVD, 0, U"SVD help", nullptr, 0,
@@ -10475,6 +10686,8 @@ void praat_David_init () {
 			QUERY_ONE_FOR_REAL__Table_getMedianAbsoluteDeviation);
 	praat_addAction1 (classTable, 0, U"To StringsIndex (column)...", nullptr, GuiMenu_HIDDEN,
 			CONVERT_EACH_TO_ONE__Table_to_StringsIndex_column);
+	praat_addAction1 (classTable, 0, U"To Table (edit distances)...", nullptr, GuiMenu_HIDDEN,
+			CONVERT_EACH_TO_ONE__Table_to_Table_editDistances);
 	praat_addAction1 (classTableOfReal, 0, U"Multivariate tests -", U"Get column stdev (label)...", 1, nullptr);
 		praat_addAction1 (classTableOfReal, 1, U"Report multivariate normality...", U"Multivariate tests -",
 			GuiMenu_DEPTH_2, INFO_ONE__TableOfReal_reportMultivariateNormality);
@@ -10493,6 +10706,8 @@ void praat_David_init () {
 			CONVERT_EACH_TO_ONE__TableOfReal_to_Discriminant);
 	praat_addAction1 (classTableOfReal, 0, U"To PCA", nullptr, 1,
 			CONVERT_EACH_TO_ONE__TableOfReal_to_PCA_byRows);
+	praat_addAction1 (classTableOfReal, 0, U"To PCA (truncated)...", nullptr, 1,
+			CONVERT_EACH_TO_ONE__TableOfReal_to_PCA_byRows_truncated);
 	praat_addAction1 (classTableOfReal, 0, U"To SSCP...", nullptr, 1, 
 			CONVERT_EACH_TO_ONE__TableOfReal_to_SSCP);
 	praat_addAction1 (classTableOfReal, 0, U"To SSCP (row weights)...", nullptr, 1, 
@@ -10586,6 +10801,10 @@ void praat_David_init () {
 
 	praat_addAction2 (classTextGrid, 2, classEditCostsTable, 1, U"To Table (text alignment)...", nullptr, 0,
 			CONVERT_TWO_AND_ONE_TO_ONE__TextGrids_EditCostsTable_to_Table_textAlignment);
+	praat_addAction2 (classStrings, 2, classEditCostsTable, 1, U"To Table (edit distances)...", nullptr, 0,
+			CONVERT_TWO_AND_ONE_TO_ONE__Strings_EditCostsTable_to_Table_editDistances);
+	praat_addAction2 (classTable, 1, classEditCostsTable, 1, U"To Table (edit distances)...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_ONE__Table_EditCostsTable_to_Table_editDistances);
 	praat_addAction2 (classTextGrid, 1, classNavigationContext, 1, U"To TextGridNavigator...", nullptr, 0,
 			CONVERT_ONE_AND_ONE_TO_ONE__TextGrid_and_NavigationContext_to_TextGridNavigator);
 	praat_addAction2 (classTextGrid, 1, classNavigationContext, 1, U"To TextGridTierNavigator...", nullptr, 0,
@@ -638,6 +638,29 @@ DO
 	MODIFY_FIRST_OF_ONE_AND_ONE_END
 }
 
+FORM (MODIFY_FIRST_OF_ONE_AND_ONE__GaussianMixture_TableOfReal_improveLikelihood_blocks, U"GaussianMixture & TableOfReal: Improve likelihood (blocks)", U"GaussianMixture & TableOfReal: Improve likelihood (blocks)...") {
+	NATURAL (blockSize, U"Block size (rows)", U"10000")
+	BOOLEAN (miniBatch, U"Mini-batch", true)
+	POSITIVE (tolerance, U"Tolerance of minimizer", U"0.001")
+	NATURAL (maximumNumberOfIterations, U"Maximum number of iterations", U"200")
+	REAL (lambda, U"Stability coefficient lambda", U"0.001")
+	OPTIONMENU_ENUM (kGaussianMixtureCriterion, criterion, U"Criterion based on", kGaussianMixtureCriterion::DEFAULT)
+	OK
+DO
+	Melder_require (lambda >= 0.0 && lambda < 1.0, 
+		U"Lambda should be in the interval [0, 1).");
+	MODIFY_FIRST_OF_ONE_AND_ONE (GaussianMixture, TableOfReal)
+		Melder_require (your numberOfColumns == my dimension,
+			U"The number of columns and the dimension of the model should agree.");
+		GaussianMixture_improveLikelihood_rows (me,
+			[&] (integer firstRow, integer lastRow) -> constMATVU {
+				return your data.horizontalBand (firstRow, lastRow);
+			},
+			your numberOfRows, blockSize, miniBatch, tolerance, maximumNumberOfIterations, lambda, criterion
+		);
+	MODIFY_FIRST_OF_ONE_AND_ONE_END
+}
+
 FORM (CONVERT_ONE_AND_ONE_TO_ONE__GaussianMixture_TableOfReal_to_GaussianMixture_CEMM, U"GaussianMixture & TableOfReal: To GaussianMixture (CEMM)", U"GaussianMixture & TableOfReal: To GaussianMixture (CEMM)...") {
 	INTEGER (minimumNumberOfComponents, U"Minimum number of components", U"1")
 	POSITIVE (tolerance, U"Tolerance of minimizer", U"0.001")
@@ -742,6 +765,8 @@ void praat_HMM_init () {
 			QUERY_ONE_AND_ONE_FOR_REAL__GaussianMixture_TableOfReal_getLikelihoodValue);
 	praat_addAction2 (classGaussianMixture, 1, classTableOfReal, 1, U"Improve likelihood...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_AND_ONE__GaussianMixture_TableOfReal_improveLikelihood);
+	praat_addAction2 (classGaussianMixture, 1, classTableOfReal, 1, U"Improve likelihood (blocks)...", nullptr, 0,
+			MODIFY_FIRST_OF_ONE_AND_ONE__GaussianMixture_TableOfReal_improveLikelihood_blocks);
 	praat_addAction2 (classGaussianMixture, 1, classTableOfReal, 1, U"To GaussianMixture (CEMM)...", nullptr, 0,
 			CONVERT_ONE_AND_ONE_TO_ONE__GaussianMixture_TableOfReal_to_GaussianMixture_CEMM);
 	praat_addAction2 (classGaussianMixture, 1, classTableOfReal, 1, U"To TableOfReal (probabilities)", nullptr, 0,
@@ -854,6 +854,26 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get(), U"_ratio")
 }
 
+FORM (CONVERT_EACH_TO_ONE__Dissimilarity_to_Configuration_landmark_mds, U"Dissimilarity: To Configuration (landmark mds)", U"Dissimilarity: To Configuration (landmark mds)...") {
+	COMMENT (U"Configuration")
+	NATURAL (numberOfDimensions, U"Number of dimensions", U"2")
+	COMMENT (U"Landmarks")
+	NATURAL (numberOfLandmarks, U"Number of landmarks", U"200")
+	INTEGER (numberOfRefinementIterations, U"Number of refinement iterations", U"5")
+	praat_Dissimilarity_to_Configuration_commonFields(tolerance,maximumNumberOfIterations,numberOfRepetitions)	
+	OK
+DO
+	Melder_require (numberOfRefinementIterations >= 0,
+		U"The number of refinement iterations should not be negative.");
+	CONVERT_EACH_TO_ONE (Dissimilarity)
+		constexpr bool showProgress = true;
+		autoConfiguration result = Dissimilarity_to_Configuration_landmark_mds (
+			me, numberOfDimensions, numberOfLandmarks, numberOfRefinementIterations,
+			tolerance, maximumNumberOfIterations, numberOfRepetitions, showProgress
+		);
+	CONVERT_EACH_TO_ONE_END (my name.get(), U"_landmark")
+}
+
 FORM (CONVERT_EACH_TO_ONE__Dissimilarity_to_Configuration_interval_mds, U"Dissimilarity: To Configuration (interval mds)", U"Dissimilarity: To Configuration (interval mds)...") {
 	COMMENT (U"Configuration")
 	NATURAL (numberOfDimensions, U"Number of dimensions", U"2")
@@ -1515,6 +1535,8 @@ void praat_MDS_actions_init () {
 			CONVERT_EACH_TO_ONE__Dissimilarity_to_Configuration_absolute_mds);
 	praat_addAction1 (classDissimilarity, 1, U"To Configuration (kruskal)...", nullptr, 1,
 			CONVERT_EACH_TO_ONE__Dissimilarity_to_Configuration_kruskal);
+	praat_addAction1 (classDissimilarity, 1, U"To Configuration (landmark mds)...", nullptr, 1,
+			CONVERT_EACH_TO_ONE__Dissimilarity_to_Configuration_landmark_mds);
 	praat_addAction1 (classDissimilarity, 0, U"To Distance...", nullptr, 0, 
 			CONVERT_EACH_TO_ONE__Dissimilarity_to_Distance);
 	praat_addAction1 (classDissimilarity, 0, U"To Weight", nullptr, 0, 
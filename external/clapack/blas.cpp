@@ -963,6 +963,20 @@ L60:
 	return 0;
     }
 
+/*     Large products go to the cache-blocked multithreaded kernel of Praat. */
+/*     The column-major arrays are viewed as matrices with row stride 1. */
+
+    if ((double) *m * (double) *n * (double) *k >= 1e5) {
+	MATVU cc (c__ + c_offset, *m, *n, 1, c_dim1);
+	constMATVU aa = ( nota ? constMATVU (a + a_offset, *m, *k, 1, a_dim1) :
+		constMATVU (a + a_offset, *m, *k, a_dim1, 1) );
+	constMATVU bb = ( notb ? constMATVU (b + b_offset, *k, *n, 1, b_dim1) :
+		constMATVU (b + b_offset, *k, *n, b_dim1, 1) );
+	if (_mul_blocked_MAT_out (cc, aa, bb, *alpha, *beta)) {
+	    return 0;
+	}
+    }
+
 /*     Start the operations. */
 
     if (notb) {
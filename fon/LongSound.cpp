@@ -1,6 +1,6 @@
 /* LongSound.cpp
  *
- * Copyright (C) 1992-2008,2010-2019,2021-2025 Paul Boersma, 2007 Erez Volk (for FLAC and MP3)
+ * Copyright (C) 1992-2008,2010-2019,2021-2026 Paul Boersma, 2007 Erez Volk (for FLAC and MP3)
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -58,9 +58,11 @@ constexpr integer defaultBufferDuration = 600;   // seconds
 constexpr integer maximumBufferDuration = 10000;   // seconds
 
 static integer prefs_bufferLength;
+static bool prefs_saveSummary;
 
 void LongSound_preferences () {
 	Preferences_addInteger (U"LongSound.bufferLength2", & prefs_bufferLength, defaultBufferDuration);
+	Preferences_addBool (U"LongSound.saveSummary", & prefs_saveSummary, false);
 }
 
 integer LongSound_getBufferSizePref_seconds () {
@@ -71,6 +73,14 @@ void LongSound_setBufferSizePref_seconds (const integer size) {
 	prefs_bufferLength = Melder_clipped (minimumBufferDuration, size, maximumBufferDuration);
 }
 
+bool LongSound_getSaveSummaryPref () {
+	return prefs_saveSummary;
+}
+
+void LongSound_setSaveSummaryPref (const bool save) {
+	prefs_saveSummary = save;
+}
+
 void structLongSound :: v9_destroy () noexcept {
 	/*
 		The play callback may contain a pointer to my buffer.
@@ -526,7 +536,14 @@ void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, const i
 	*minimum = 1.0;
 	*maximum = -1.0;
 	try {
-		LongSound_haveWindow (me, tmin, tmax);
+		if (! LongSound_haveWindow (me, tmin, tmax)) {
+			constexpr integer numberOfColumns = 64;
+			autoVEC minima = raw_VEC (numberOfColumns), maxima = raw_VEC (numberOfColumns), rootMeanSquares = raw_VEC (numberOfColumns);
+			LongSound_getWindowEnvelope (me, tmin, tmax, channel, minima.get(), maxima.get(), rootMeanSquares.get());
+			*minimum = NUMmin_u (minima.get());
+			*maximum = NUMmax_u (maxima.get());
+			return;
+		}
 	} catch (MelderError) {
 		Melder_clearError ();
 		return;
@@ -543,6 +560,211 @@ void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, const i
 	*maximum = maximum_int / 32768.0;
 }
 
+/*
+	The waveform summary can be saved next to the sound file, so that it does not have to be computed again
+	the next time the file is opened. The summary file is recognized by the properties of the sound file,
+	including its modification time, so that a summary of an older version of the file is computed anew.
+*/
+static const char summaryFileSignature [] = "PraatLongSoundSummary2";
+
+static void LongSound_getSummaryFile (LongSound me, MelderFile summaryFile) {
+	Melder_pathToFile (Melder_cat (MelderFile_peekPath (& my file), U".praat-summary"), summaryFile);
+}
+
+static void LongSound_saveSummary (LongSound me) {
+	structMelderFile summaryFile { };
+	LongSound_getSummaryFile (me, & summaryFile);
+	autofile f = Melder_fopen (& summaryFile, "wb");
+	fwrite (summaryFileSignature, 1, sizeof (summaryFileSignature), f);
+	binputr64 (my nx, f);
+	binputi32 (my numberOfChannels, f);
+	binputr64 (my sampleRate, f);
+	binputr64 (MelderFile_length (& my file), f);
+	binputr64 (MelderFile_modificationTime (& my file), f);
+	binputi32 (LongSound_SUMMARY_BLOCK_SIZE, f);
+	binputi32 (LongSound_SUMMARY_NUMBER_OF_LEVELS, f);
+	for (integer ilevel = 1; ilevel <= LongSound_SUMMARY_NUMBER_OF_LEVELS; ilevel ++) {
+		const LongSound_SummaryLevel& level = my summary [ilevel];
+		for (integer i = 1; i <= level.minima.size; i ++) {
+			binputr32 (level.minima [i], f);
+			binputr32 (level.maxima [i], f);
+			binputr32 (level.sumsOfSquares [i], f);
+		}
+	}
+	f.close (& summaryFile);
+}
+
+static bool LongSound_readSummary (LongSound me) {
+	structMelderFile summaryFile { };
+	LongSound_getSummaryFile (me, & summaryFile);
+	if (! MelderFile_exists (& summaryFile))
+		return false;
+	autofile f = Melder_fopen (& summaryFile, "rb");
+	char signature [sizeof (summaryFileSignature)];
+	if (fread (signature, 1, sizeof (summaryFileSignature), f) != sizeof (summaryFileSignature) ||
+		! strequ (signature, summaryFileSignature) ||
+		bingetr64 (f) != my nx ||
+		bingeti32 (f) != my numberOfChannels ||
+		bingetr64 (f) != my sampleRate ||
+		bingetr64 (f) != MelderFile_length (& my file) ||
+		bingetr64 (f) != MelderFile_modificationTime (& my file) ||
+		bingeti32 (f) != LongSound_SUMMARY_BLOCK_SIZE ||
+		bingeti32 (f) != LongSound_SUMMARY_NUMBER_OF_LEVELS
+	)
+		return false;   // a summary of a different sound file
+	for (integer ilevel = 1; ilevel <= LongSound_SUMMARY_NUMBER_OF_LEVELS; ilevel ++) {
+		LongSound_SummaryLevel& level = my summary [ilevel];
+		for (integer i = 1; i <= level.minima.size; i ++) {
+			level.minima [i] = bingetr32 (f);
+			level.maxima [i] = bingetr32 (f);
+			level.sumsOfSquares [i] = bingetr32 (f);
+		}
+	}
+	const bool complete = ! feof (f) && ! ferror (f);
+	f.close (& summaryFile);
+	return complete;
+}
+
+static void LongSound_initSummary (LongSound me) {
+	if (my summaryChunkIsComputed.size > 0)
+		return;
+	for (integer ilevel = 1; ilevel <= LongSound_SUMMARY_NUMBER_OF_LEVELS; ilevel ++) {
+		LongSound_SummaryLevel& level = my summary [ilevel];
+		level.blockSize = LongSound_SUMMARY_BLOCK_SIZE << (2 * (ilevel - 1));
+		level.numberOfBlocks = (my nx - 1) / level.blockSize + 1;
+		level.minima = newvectorzero <float> (level.numberOfBlocks * my numberOfChannels);
+		level.maxima = newvectorzero <float> (level.numberOfBlocks * my numberOfChannels);
+		level.sumsOfSquares = newvectorzero <float> (level.numberOfBlocks * my numberOfChannels);
+	}
+	const integer numberOfChunks = my summary [LongSound_SUMMARY_NUMBER_OF_LEVELS]. numberOfBlocks;
+	autoBOOLVEC chunkIsComputed = zero_BOOLVEC (numberOfChunks);
+	if (prefs_saveSummary) {
+		bool summaryHasBeenRead = false;
+		try {
+			summaryHasBeenRead = LongSound_readSummary (me);
+		} catch (MelderError) {
+			Melder_clearError ();   // an unreadable summary file will simply be overwritten
+		}
+		if (summaryHasBeenRead) {
+			for (integer ichunk = 1; ichunk <= numberOfChunks; ichunk ++)
+				chunkIsComputed [ichunk] = true;
+			my summaryNumberOfComputedChunks = numberOfChunks;
+		}
+	}
+	my summaryChunkIsComputed = chunkIsComputed.move();
+}
+
+static void LongSound_computeSummaryChunk (LongSound me, const integer ichunk) {
+	const integer chunkSize = my summary [LongSound_SUMMARY_NUMBER_OF_LEVELS]. blockSize;
+	const integer firstSample = (ichunk - 1) * chunkSize + 1;
+	const integer lastSample = std::min (ichunk * chunkSize, my nx);
+	autoMAT samples = raw_MAT (my numberOfChannels, lastSample - firstSample + 1);
+	LongSound_readAudioToFloat (me, samples.get(), firstSample);
+	/*
+		The lowest level from the samples, each higher level from the level below;
+		the chunk consists of whole blocks at every level.
+	*/
+	LongSound_SummaryLevel& lowest = my summary [1];
+	for (integer iblock = (firstSample - 1) / lowest.blockSize + 1; iblock <= (lastSample - 1) / lowest.blockSize + 1; iblock ++) {
+		const integer firstColumn = (iblock - 1) * lowest.blockSize - (firstSample - 1) + 1;
+		const integer lastColumn = std::min (firstColumn + lowest.blockSize - 1, samples.ncol);
+		for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++) {
+			const constVECVU values = samples.row (ichan).part (firstColumn, lastColumn);
+			double minimum = values [1], maximum = values [1], sumOfSquares = 0.0;
+			for (integer i = 1; i <= values.size; i ++) {
+				const double value = values [i];
+				if (value < minimum)
+					minimum = value;
+				if (value > maximum)
+					maximum = value;
+				sumOfSquares += value * value;
+			}
+			const integer index = (iblock - 1) * my numberOfChannels + ichan;
+			lowest.minima [index] = float (minimum);
+			lowest.maxima [index] = float (maximum);
+			lowest.sumsOfSquares [index] = float (sumOfSquares);
+		}
+	}
+	for (integer ilevel = 2; ilevel <= LongSound_SUMMARY_NUMBER_OF_LEVELS; ilevel ++) {
+		LongSound_SummaryLevel& level = my summary [ilevel];
+		const LongSound_SummaryLevel& below = my summary [ilevel - 1];
+		for (integer iblock = (firstSample - 1) / level.blockSize + 1; iblock <= (lastSample - 1) / level.blockSize + 1; iblock ++) {
+			const integer firstBlockBelow = (iblock - 1) * 4 + 1;
+			const integer lastBlockBelow = std::min (iblock * 4, below.numberOfBlocks);
+			for (integer ichan = 1; ichan <= my numberOfChannels; ichan ++) {
+				const integer index = (iblock - 1) * my numberOfChannels + ichan;
+				const integer firstIndexBelow = (firstBlockBelow - 1) * my numberOfChannels + ichan;
+				float minimum = below.minima [firstIndexBelow], maximum = below.maxima [firstIndexBelow];
+				double sumOfSquares = 0.0;
+				for (integer iblockBelow = firstBlockBelow; iblockBelow <= lastBlockBelow; iblockBelow ++) {
+					const integer indexBelow = (iblockBelow - 1) * my numberOfChannels + ichan;
+					minimum = std::min (minimum, below.minima [indexBelow]);
+					maximum = std::max (maximum, below.maxima [indexBelow]);
+					sumOfSquares += below.sumsOfSquares [indexBelow];
+				}
+				level.minima [index] = minimum;
+				level.maxima [index] = maximum;
+				level.sumsOfSquares [index] = float (sumOfSquares);
+			}
+		}
+	}
+	my summaryChunkIsComputed [ichunk] = true;
+	my summaryNumberOfComputedChunks += 1;
+	if (my summaryNumberOfComputedChunks == my summaryChunkIsComputed.size && prefs_saveSummary) {
+		try {
+			LongSound_saveSummary (me);
+		} catch (MelderError) {
+			Melder_clearError ();   // e.g. a read-only folder: the summary will be computed again next time
+		}
+	}
+}
+
+void LongSound_getWindowEnvelope (LongSound me, double tmin, double tmax, const integer channel,
+	const VEC out_minima, const VEC out_maxima, const VEC out_rootMeanSquares)
+{
+	Melder_assert (out_maxima.size == out_minima.size && out_rootMeanSquares.size == out_minima.size);
+	out_minima  <<=  0.0;
+	out_maxima  <<=  0.0;
+	out_rootMeanSquares  <<=  0.0;
+	const integer numberOfColumns = out_minima.size;
+	integer imin, imax;
+	const integer numberOfSamples = Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax);
+	if (numberOfSamples < 1 || numberOfColumns < 1)
+		return;
+	LongSound_initSummary (me);
+	const integer chunkSize = my summary [LongSound_SUMMARY_NUMBER_OF_LEVELS]. blockSize;
+	for (integer ichunk = (imin - 1) / chunkSize + 1; ichunk <= (imax - 1) / chunkSize + 1; ichunk ++)
+		if (! my summaryChunkIsComputed [ichunk])
+			LongSound_computeSummaryChunk (me, ichunk);
+	/*
+		The coarsest level whose blocks are no longer than a quarter of a column,
+		so that the outermost blocks of a column stick out of it by little.
+	*/
+	const double numberOfSamplesPerColumn = double (numberOfSamples) / numberOfColumns;
+	integer ilevel = 1;
+	while (ilevel < LongSound_SUMMARY_NUMBER_OF_LEVELS && 4 * my summary [ilevel + 1]. blockSize <= numberOfSamplesPerColumn)
+		ilevel ++;
+	const LongSound_SummaryLevel& level = my summary [ilevel];
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+		const integer firstSample = imin + Melder_ifloor ((icolumn - 1) * numberOfSamplesPerColumn);
+		const integer lastSample = std::max (firstSample, imin + Melder_ifloor (icolumn * numberOfSamplesPerColumn) - 1);
+		const integer firstBlock = (firstSample - 1) / level.blockSize + 1;
+		const integer lastBlock = (std::min (lastSample, imax) - 1) / level.blockSize + 1;
+		const integer firstIndex = (firstBlock - 1) * my numberOfChannels + channel;
+		double minimum = level.minima [firstIndex], maximum = level.maxima [firstIndex], sumOfSquares = 0.0;
+		for (integer iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+			const integer index = (iblock - 1) * my numberOfChannels + channel;
+			minimum = std::min (minimum, double (level.minima [index]));
+			maximum = std::max (maximum, double (level.maxima [index]));
+			sumOfSquares += level.sumsOfSquares [index];
+		}
+		const integer numberOfSamplesInBlocks = std::min (lastBlock * level.blockSize, my nx) - (firstBlock - 1) * level.blockSize;
+		out_minima [icolumn] = minimum;
+		out_maxima [icolumn] = maximum;
+		out_rootMeanSquares [icolumn] = sqrt (sumOfSquares / numberOfSamplesInBlocks);
+	}
+}
+
 static struct LongSoundPlay {
 	integer numberOfSamples, i1, i2, silenceBefore, silenceAfter;
 	double startTime, endTime, dt, t1;
@@ -28,6 +28,20 @@ struct FLAC__StreamDecoder;
 struct FLAC__StreamEncoder;
 struct _MP3_FILE;
 
+/*
+	A pyramid of waveform summaries, for drawing windows in which many samples fall on a single pixel column.
+	Level 1 summarizes blocks of LongSound_SUMMARY_BLOCK_SIZE samples,
+	and each next level blocks of four times as many samples.
+	The summary is computed from the file when first needed, one top-level block ("chunk") at a time.
+*/
+#define LongSound_SUMMARY_BLOCK_SIZE  256
+#define LongSound_SUMMARY_NUMBER_OF_LEVELS  7
+
+struct LongSound_SummaryLevel {
+	integer blockSize, numberOfBlocks;
+	autovector <float> minima, maxima, sumsOfSquares;   // for each block, the channels are consecutive
+};
+
 Thing_define (LongSound, SampledXY) {
 	structMelderFile file;
 	FILE *f;
@@ -49,6 +63,10 @@ Thing_define (LongSound, SampledXY) {
 	double *compressedFloats [2];
 	int16 *compressedShorts;
 
+	LongSound_SummaryLevel summary [1 + LongSound_SUMMARY_NUMBER_OF_LEVELS];
+	autoBOOLVEC summaryChunkIsComputed;
+	integer summaryNumberOfComputedChunks;
+
 	void v9_destroy () noexcept
 		override;
 	void v1_info ()
@@ -71,6 +89,17 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax);
  */
 
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, integer channel, double *minimum, double *maximum);
+/*
+	From the buffer if the window fits in it, otherwise from the waveform summary.
+*/
+
+void LongSound_getWindowEnvelope (LongSound me, double tmin, double tmax, integer channel,
+		VEC out_minima, VEC out_maxima, VEC out_rootMeanSquares);
+/*
+	From the waveform summary: the window is divided into as many equal columns as the size of the vectors,
+	and each column receives the extrema and the root-mean-square of the blocks that it overlaps with.
+	The work is proportional to the number of columns, except when parts of the summary still have to be computed.
+*/
 
 void LongSound_playPart (LongSound me, double startTime, double endTime, Sound_PlayCallback playCallback, Thing playBoss);
 
@@ -88,6 +117,8 @@ void LongSound_concatenate (SoundAndLongSoundList collection, MelderFile file, i
 void LongSound_preferences ();
 integer LongSound_getBufferSizePref_seconds ();
 void LongSound_setBufferSizePref_seconds (integer size);
+bool LongSound_getSaveSummaryPref ();
+void LongSound_setSaveSummaryPref (bool save);
 
 /* End of file LongSound.h */
 #endif
@@ -1,6 +1,6 @@
 /* Praat_tests.cpp
  *
- * Copyright (C) 2001-2007,2009,2011-2025 Paul Boersma, David Weenink 2025
+ * Copyright (C) 2001-2007,2009,2011-2026 Paul Boersma, David Weenink 2025
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -32,6 +32,7 @@
 #include "praat.h"
 #include "NUM2.h"
 #include "Sound.h"
+#include "LongSound.h"
 
 #include "enums_getText.h"
 #include "Praat_tests_enums.h"
@@ -66,6 +67,112 @@ static autoMAT constantHH (integer nrow, integer ncol, double value) {
 	return result;
 }
 
+/*
+	The envelope of a LongSound, as computed from its waveform summary, should agree with the samples,
+	also after the summary has been saved next to the file and the file has been replaced.
+*/
+static void checkLongSoundEnvelope (LongSound longSound, Sound sound) {
+	const integer numberOfSamples = sound -> nx;
+	/*
+		Columns that consist of whole summary blocks: exactly the extrema and the root-mean-square of the samples.
+	*/
+	for (integer columnSize = LongSound_SUMMARY_BLOCK_SIZE * 4; columnSize <= numberOfSamples / 2; columnSize *= 4) {
+		const integer numberOfColumns = numberOfSamples / columnSize;
+		autoVEC minima = raw_VEC (numberOfColumns), maxima = raw_VEC (numberOfColumns), rootMeanSquares = raw_VEC (numberOfColumns);
+		for (integer channel = 1; channel <= sound -> ny; channel ++) {
+			LongSound_getWindowEnvelope (longSound, sound -> xmin, sound -> xmin + numberOfColumns * columnSize * sound -> dx,
+					channel, minima.get(), maxima.get(), rootMeanSquares.get());
+			for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+				const constVECVU samples = sound -> z.row (channel).part ((icolumn - 1) * columnSize + 1, icolumn * columnSize);
+				Melder_require (minima [icolumn] == NUMmin_e (samples) && maxima [icolumn] == NUMmax_e (samples),
+					U"Extrema of column ", icolumn, U" of ", numberOfColumns, U" in channel ", channel, U": ",
+					minima [icolumn], U" ", maxima [icolumn], U" instead of ", NUMmin_e (samples), U" ", NUMmax_e (samples), U".");
+				const double rootMeanSquare = sqrt (NUMsum2 (samples) / samples.size);
+				Melder_require (fabs (rootMeanSquares [icolumn] - rootMeanSquare) <= 1e-5 * rootMeanSquare,
+					U"Root-mean-square of column ", icolumn, U" of ", numberOfColumns, U" in channel ", channel, U": ",
+					rootMeanSquares [icolumn], U" instead of ", rootMeanSquare, U".");
+			}
+		}
+	}
+	/*
+		Arbitrary windows: each column extends by less than a quarter of a column on either side.
+	*/
+	for (integer iwindow = 1; iwindow <= 20; iwindow ++) {
+		const double tmin = NUMrandomUniform (sound -> xmin, sound -> xmax);
+		const double tmax = NUMrandomUniform (tmin, sound -> xmax);
+		const integer numberOfColumns = NUMrandomInteger (1, 1000);
+		integer imin, imax;
+		const integer numberOfWindowSamples = Sampled_getWindowSamples (sound, tmin, tmax, & imin, & imax);
+		if (numberOfWindowSamples < numberOfColumns)
+			continue;
+		autoVEC minima = raw_VEC (numberOfColumns), maxima = raw_VEC (numberOfColumns), rootMeanSquares = raw_VEC (numberOfColumns);
+		LongSound_getWindowEnvelope (longSound, tmin, tmax, 1, minima.get(), maxima.get(), rootMeanSquares.get());
+		const double numberOfSamplesPerColumn = double (numberOfWindowSamples) / numberOfColumns;
+		for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+			const integer firstSample = imin + Melder_ifloor ((icolumn - 1) * numberOfSamplesPerColumn);
+			const integer lastSample = std::max (firstSample, imin + Melder_ifloor (icolumn * numberOfSamplesPerColumn) - 1);
+			const integer slack = Melder_ifloor (0.25 * numberOfSamplesPerColumn) + LongSound_SUMMARY_BLOCK_SIZE;
+			const constVECVU inner = sound -> z.row (1).part (firstSample, lastSample);
+			const constVECVU outer = sound -> z.row (1).part (std::max (firstSample - slack, 1_integer),
+					std::min (lastSample + slack, numberOfSamples));
+			Melder_require (minima [icolumn] <= NUMmin_e (inner) && minima [icolumn] >= NUMmin_e (outer) &&
+					maxima [icolumn] >= NUMmax_e (inner) && maxima [icolumn] <= NUMmax_e (outer),
+				U"Extrema of column ", icolumn, U" of ", numberOfColumns, U" between ", tmin, U" and ", tmax, U" seconds.");
+		}
+	}
+}
+
+static void checkLongSoundSummary () {
+	structMelderFolder temporaryFolder { };
+	Melder_getTempDir (& temporaryFolder);
+	structMelderFile soundFile { }, summaryFile { };
+	MelderFolder_getFile (& temporaryFolder, U"praat_test_LongSound_summary.wav", & soundFile);
+	Melder_pathToFile (Melder_cat (MelderFile_peekPath (& soundFile), U".praat-summary"), & summaryFile);
+	const bool savedPreference = LongSound_getSaveSummaryPref ();
+	LongSound_setSaveSummaryPref (true);
+	try {
+		for (integer version = 1; version <= 2; version ++) {
+			/*
+				Two versions of the file, with the same length and format but different samples;
+				the second has to be given a different modification time.
+			*/
+			const double previousModificationTime = MelderFile_modificationTime (& soundFile);
+			autoSound original = Sound_create (2, 0.0, 60.0, 2'646'000, 1.0 / 44100.0, 0.5 / 44100.0);
+			for (integer isamp = 1; isamp <= original -> nx; isamp ++) {
+				const double time = original -> x1 + (isamp - 1) * original -> dx;
+				original -> z [1] [isamp] = 0.8 * sin (2.0 * NUMpi * (100.0 * version) * time) * (time / 60.0) + NUMrandomGauss (0.0, 0.01);
+				original -> z [2] [isamp] = 0.3 * sin (2.0 * NUMpi * 0.1 * version * time) + NUMrandomGauss (0.0, 0.05);
+			}
+			for (integer iattempt = 1; ; iattempt ++) {
+				Sound_saveAsAudioFile (original.get(), & soundFile, Melder_WAV, 16);
+				if (MelderFile_modificationTime (& soundFile) != previousModificationTime || iattempt >= 300)
+					break;
+				Melder_sleep (0.01);
+			}
+			autoSound sound = Sound_readFromSoundFile (& soundFile);   // the samples as quantized in the file
+			for (integer iopening = 1; iopening <= 2; iopening ++) {
+				/*
+					The first opening computes the summary, and saves it because it is complete;
+					the second opening reads the summary file.
+				*/
+				autoLongSound longSound = LongSound_open (& soundFile);
+				checkLongSoundEnvelope (longSound.get(), sound.get());
+				Melder_require (MelderFile_exists (& summaryFile),
+					U"The summary file should have been written (version ", version, U", opening ", iopening, U").");
+			}
+		}
+	} catch (MelderError) {
+		LongSound_setSaveSummaryPref (savedPreference);
+		MelderFile_delete (& soundFile);
+		MelderFile_delete (& summaryFile);
+		throw;
+	}
+	LongSound_setSaveSummaryPref (savedPreference);
+	MelderFile_delete (& soundFile);
+	MelderFile_delete (& summaryFile);
+	MelderInfo_writeLine (U"LongSound summary OK");
+}
+
 int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, conststring32 arg3, conststring32 arg4) {
 	int64 n = Melder_atoi (arg1);
 	double t = 0.0;
@@ -703,6 +810,9 @@ int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, cons
 				Melder_stopwatch();
 			t = stopwatch ();
 		} break;
+		case kPraatTests::CHECK_LONG_SOUND_SUMMARY: {
+			checkLongSoundSummary ();
+		} break;
 	}
 	MelderInfo_writeLine (Melder_single (t * 1e9 / n), U" nanoseconds per iteration");
 	MelderInfo_close ();
@@ -1,6 +1,6 @@
 /* Praat_tests_enums.h
  *
- * Copyright (C) 2001-2005,2009,2013-2018,2020,2021,2024,2025 Paul Boersma
+ * Copyright (C) 2001-2005,2009,2013-2018,2020,2021,2024-2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -68,6 +68,7 @@ enums_begin (kPraatTests, 0)
 	enums_add (kPraatTests, 48, TIME_NS_DATE, U"TimeNsDate")
 	enums_add (kPraatTests, 49, TIME_MELDER_CLOCK, U"TimeMelderClock")
 	enums_add (kPraatTests, 50, TIME_STOPWATCH, U"TimeStopwatch")
-enums_end (kPraatTests, 50, CHECK_RANDOM_1009_2009)
+	enums_add (kPraatTests, 51, CHECK_LONG_SOUND_SUMMARY, U"CheckLongSoundSummary")
+enums_end (kPraatTests, 51, CHECK_RANDOM_1009_2009)
 
 /* End of file Praat_tests_enums.h */
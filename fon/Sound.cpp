@@ -770,6 +770,46 @@ autoSound Sound_autoCorrelate (constSound me, kSounds_convolve_scaling scaling,
 	}
 }
 
+/*
+	A curve with many more samples than there are columns in the drawing (at a printer resolution)
+	is reduced to the minimum and the maximum within each column, in their original order,
+	so that the picture (and any PostScript or PDF file made from it) need not contain every sample.
+*/
+static void Sound_drawCurve (constSound me, Graphics g, const integer channel, const integer ixmin, const integer ixmax) {
+	const double xmin = Matrix_columnToX (me, ixmin), xmax = Matrix_columnToX (me, ixmax);
+	const integer numberOfColumns = Melder_iround (fabs (Graphics_dxWCtoMM (g, xmax - xmin)) *
+			std::max (Graphics_getResolution (g), 600) / 25.4);
+	const integer numberOfSamples = ixmax - ixmin + 1;
+	if (numberOfSamples <= 2 * numberOfColumns) {
+		Graphics_function (g, & my z [channel] [0], ixmin, ixmax, xmin, xmax);
+		return;
+	}
+	const constVEC samples = my z.row (channel);
+	autoVEC x = raw_VEC (2 * numberOfColumns), y = raw_VEC (2 * numberOfColumns);
+	integer numberOfPoints = 0;
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+		const integer first = ixmin + (icolumn - 1) * numberOfSamples / numberOfColumns;
+		const integer last = ixmin + icolumn * numberOfSamples / numberOfColumns - 1;
+		integer iminimum = first, imaximum = first;
+		for (integer ix = first + 1; ix <= last; ix ++) {
+			if (samples [ix] < samples [iminimum])
+				iminimum = ix;
+			else if (samples [ix] > samples [imaximum])
+				imaximum = ix;
+		}
+		const integer ifirstExtremum = std::min (iminimum, imaximum), ilastExtremum = std::max (iminimum, imaximum);
+		numberOfPoints += 1;
+		x [numberOfPoints] = Matrix_columnToX (me, ifirstExtremum);
+		y [numberOfPoints] = samples [ifirstExtremum];
+		if (ilastExtremum != ifirstExtremum) {
+			numberOfPoints += 1;
+			x [numberOfPoints] = Matrix_columnToX (me, ilastExtremum);
+			y [numberOfPoints] = samples [ilastExtremum];
+		}
+	}
+	Graphics_polyline (g, numberOfPoints, & x [1], & y [1]);
+}
+
 void Sound_draw (constSound me, Graphics g,
 	double tmin, double tmax, double minimum, double maximum, bool garnish, conststring32 method)
 {
@@ -827,8 +867,7 @@ void Sound_draw (constSound me, Graphics g,
 			/*
 				The default: draw as a curve.
 			*/
-			Graphics_function (g, & my z [channel] [0], ixmin, ixmax,
-					Matrix_columnToX (me, ixmin), Matrix_columnToX (me, ixmax));
+			Sound_drawCurve (me, g, channel, ixmin, ixmax);
 		}
 	}
 	Graphics_setWindow (g, timesAreReversed ? tmax : tmin, timesAreReversed ? tmin : tmax, minimum, maximum);
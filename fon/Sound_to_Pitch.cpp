@@ -1,6 +1,6 @@
 /* Sound_to_Pitch.cpp
  *
- * Copyright (C) 1992-2005,2007-2012,2014-2020,2023-2025 Paul Boersma
+ * Copyright (C) 1992-2005,2007-2012,2014-2020,2023-2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -261,199 +261,268 @@ static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
 	}
 }
 
-autoPitch Sound_to_Pitch_any (Sound me,
+/*
+	The part of a periodicity analysis that is computed only once,
+	and that all threads can read at the same time.
+*/
+struct PitchAnalysisSetup {
+	int method;
+	double pitchFloor, pitchCeiling;
+	integer maxnCandidates;
+	double dt, t1;
+	integer numberOfFrames;
+	double dt_window;
+	integer nsamp_window, halfnsamp_window;
+	integer maximumLag, nsampFFT, nsamp_period, halfnsamp_period;
+	integer brent_ixmax, brent_depth;
+	double globalPeak;
+	autoVEC window, windowR;   // only for autocorrelation
+};
+
+static void Sound_setUpPitchAnalysis (Sound me, PitchAnalysisSetup *setup,
 	int method, double periodsPerWindow,
 	double dt, double pitchFloor, double pitchCeiling,
-	integer maxnCandidates,
-	double silenceThreshold, double voicingThreshold,
-	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost)
+	integer maxnCandidates)
 {
+	double interpolation_depth;
+	integer brent_depth;
+
+	Melder_assert (maxnCandidates >= 2);
+	Melder_assert (method >= AC_HANNING && method <= FCC_ACCURATE);
+
+	if (maxnCandidates < pitchCeiling / pitchFloor)
+		maxnCandidates = Melder_ifloor (pitchCeiling / pitchFloor);
+
+	if (dt <= 0.0)
+		dt = periodsPerWindow / pitchFloor / 4.0;   // e.g. 3 periods, 75 Hz: 10 milliseconds
+
+	switch (method) {
+		case AC_HANNING:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
+			interpolation_depth = 0.5;
+			break;
+		case AC_GAUSS:
+			periodsPerWindow *= 2;   // because Gaussian window is twice as long
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
+			interpolation_depth = 0.25;   // because Gaussian window is twice as long
+			break;
+		case FCC_NORMAL:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
+			interpolation_depth = 1.0;
+			break;
+		case FCC_ACCURATE:
+			brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
+			interpolation_depth = 1.0;
+			break;
+	}
+	volatile const double duration = my dx * my nx;   // volatile, because we need to truncate to 64 bits
+	if (pitchFloor < periodsPerWindow / duration)
+		Melder_throw (U"To analyse this Sound, “pitch floor” must not be less than ", periodsPerWindow / duration, U" Hz.");
+
+	/*
+		Determine the number of samples in the longest period.
+		We need this to compute the local mean of the sound (looking one period in both directions),
+		and to compute the local peak of the sound (looking half a period in both directions).
+	*/
+	const integer nsamp_period = Melder_ifloor (1.0 / my dx / pitchFloor);
+	const integer halfnsamp_period = nsamp_period / 2 + 1;
+
+	Melder_clipRight (& pitchCeiling, 0.5 / my dx);
+
+	/*
+		Determine window duration in seconds and in samples.
+	*/
+	const double dt_window = periodsPerWindow / pitchFloor;
+	integer nsamp_window = Melder_ifloor (dt_window / my dx);
+	const integer halfnsamp_window = nsamp_window / 2 - 1;
+	if (halfnsamp_window < 2)
+		Melder_throw (U"Analysis window too short.");
+	nsamp_window = halfnsamp_window * 2;
+
+	/*
+		Determine the maximum lag.
+	*/
+	const integer maximumLag = std::min (Melder_ifloor (nsamp_window / periodsPerWindow) + 2, nsamp_window);
+
+	/*
+		Determine the number of frames.
+		Fit as many frames as possible symmetrically in the total duration.
+		We do this even for the forward cross-correlation method,
+		because that allows us to compare the two methods.
+	*/
+	integer numberOfFrames;
+	double t1;
 	try {
-		double t1;
-		integer numberOfFrames;
-		integer nsampFFT;
-		double interpolation_depth;
-		integer brent_ixmax, brent_depth;
-		double globalPeak;
-
-		Melder_assert (maxnCandidates >= 2);
-		Melder_assert (method >= AC_HANNING && method <= FCC_ACCURATE);
-
-		if (maxnCandidates < pitchCeiling / pitchFloor)
-			maxnCandidates = Melder_ifloor (pitchCeiling / pitchFloor);
-
-		if (dt <= 0.0)
-			dt = periodsPerWindow / pitchFloor / 4.0;   // e.g. 3 periods, 75 Hz: 10 milliseconds
-
-		switch (method) {
-			case AC_HANNING:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
-				interpolation_depth = 0.5;
-				break;
-			case AC_GAUSS:
-				periodsPerWindow *= 2;   // because Gaussian window is twice as long
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
-				interpolation_depth = 0.25;   // because Gaussian window is twice as long
-				break;
-			case FCC_NORMAL:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC70;
-				interpolation_depth = 1.0;
-				break;
-			case FCC_ACCURATE:
-				brent_depth = NUM_PEAK_INTERPOLATE_SINC700;
-				interpolation_depth = 1.0;
-				break;
+		Sampled_shortTermAnalysis (me, method >= FCC_NORMAL ? 1.0 / pitchFloor + dt_window : dt_window, dt, & numberOfFrames, & t1);
+	} catch (MelderError) {
+		Melder_throw (U"The pitch analysis would give zero pitch frames.");
+	}
+
+	/*
+		Compute the global absolute peak for determination of silence threshold.
+	*/
+	double globalPeak = 0.0;
+	for (integer ichan = 1; ichan <= my ny; ichan ++) {
+		const double mean = NUMmean (my z.row (ichan));
+		for (integer i = 1; i <= my nx; i ++) {
+			double value = fabs (my z [ichan] [i] - mean);
+			if (value > globalPeak)
+				globalPeak = value;
 		}
-		volatile const double duration = my dx * my nx;   // volatile, because we need to truncate to 64 bits
-		if (pitchFloor < periodsPerWindow / duration)
-			Melder_throw (U"To analyse this Sound, “pitch floor” must not be less than ", periodsPerWindow / duration, U" Hz.");
+	}
+
+	integer nsampFFT = 0;
+	if (method < FCC_NORMAL) {   // for autocorrelation analysis
 
 		/*
-			Determine the number of samples in the longest period.
-			We need this to compute the local mean of the sound (looking one period in both directions),
-			and to compute the local peak of the sound (looking half a period in both directions).
+			Compute the number of samples needed for doing FFT.
+			To avoid edge effects, we have to append zeroes to the window.
+			The maximum lag considered for maxima is maximumLag.
+			The maximum lag used in interpolation is nsamp_window * interpolation_depth.
 		*/
-		const integer nsamp_period = Melder_ifloor (1.0 / my dx / pitchFloor);
-		const integer halfnsamp_period = nsamp_period / 2 + 1;
-
-		Melder_clipRight (& pitchCeiling, 0.5 / my dx);
+		nsampFFT = 1;
+		while (nsampFFT < nsamp_window * (1 + interpolation_depth))
+			nsampFFT *= 2;
 
 		/*
-			Determine window duration in seconds and in samples.
+			Create buffers for autocorrelation analysis.
 		*/
-		const double dt_window = periodsPerWindow / pitchFloor;
-		integer nsamp_window = Melder_ifloor (dt_window / my dx);
-		const integer halfnsamp_window = nsamp_window / 2 - 1;
-		if (halfnsamp_window < 2)
-			Melder_throw (U"Analysis window too short.");
-		nsamp_window = halfnsamp_window * 2;
+		setup -> windowR = zero_VEC (nsampFFT);
+		setup -> window = zero_VEC (nsamp_window);
+		VEC window = setup -> window.get(), windowR = setup -> windowR.get();
+		autoNUMFourierTable fftTable = NUMFourierTable_create (nsampFFT);
 
 		/*
-			Determine the minimum and maximum lags.
+			A Gaussian or Hanning window is applied against phase effects.
+			The Hanning window is 2 to 5 dB better for 3 periods/window.
+			The Gaussian window is 25 to 29 dB better for 6 periods/window.
 		*/
-		const integer minimumLag = std::max (2_integer, Melder_ifloor (1.0 / my dx / pitchCeiling));
-		const integer maximumLag = std::min (Melder_ifloor (nsamp_window / periodsPerWindow) + 2, nsamp_window);
+		if (method == AC_GAUSS) {   // Gaussian window
+			double imid = 0.5 * (nsamp_window + 1), edge = exp (-12.0);
+			for (integer i = 1; i <= nsamp_window; i ++)
+				window [i] = (exp (-48.0 * (i - imid) * (i - imid) /
+						(nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
+		} else {   // Hanning window
+			for (integer i = 1; i <= nsamp_window; i ++)
+				window [i] = 0.5 - 0.5 * cos (NUM2pi * i / (nsamp_window + 1));
+		}
 
 		/*
-			Determine the number of frames.
-			Fit as many frames as possible symmetrically in the total duration.
-			We do this even for the forward cross-correlation method,
-			because that allows us to compare the two methods.
+			Compute the normalized autocorrelation of the window.
 		*/
-		try {
-			Sampled_shortTermAnalysis (me, method >= FCC_NORMAL ? 1.0 / pitchFloor + dt_window : dt_window, dt, & numberOfFrames, & t1);
-		} catch (MelderError) {
-			Melder_throw (U"The pitch analysis would give zero pitch frames.");
+		for (integer i = 1; i <= nsamp_window; i ++)
+			windowR [i] = window [i];
+		NUMfft_forward (fftTable.get(), windowR);
+		windowR [1] *= windowR [1];   // DC component
+		for (integer i = 2; i < nsampFFT; i += 2) {
+			windowR [i] = windowR [i] * windowR [i] + windowR [i + 1] * windowR [i + 1];
+			windowR [i + 1] = 0.0;   // power spectrum: square and zero
 		}
+		windowR [nsampFFT] *= windowR [nsampFFT];   // Nyquist frequency
+		NUMfft_backward (fftTable.get(), windowR);   // autocorrelation
+		for (integer i = 2; i <= nsamp_window; i ++)
+			windowR [i] /= windowR [1];   // normalize
+		windowR [1] = 1.0;   // normalize
+	}
+
+	setup -> method = method;
+	setup -> pitchFloor = pitchFloor;
+	setup -> pitchCeiling = pitchCeiling;
+	setup -> maxnCandidates = maxnCandidates;
+	setup -> dt = dt;
+	setup -> t1 = t1;
+	setup -> numberOfFrames = numberOfFrames;
+	setup -> dt_window = dt_window;
+	setup -> nsamp_window = nsamp_window;
+	setup -> halfnsamp_window = halfnsamp_window;
+	setup -> maximumLag = maximumLag;
+	setup -> nsampFFT = nsampFFT;
+	setup -> nsamp_period = nsamp_period;
+	setup -> halfnsamp_period = halfnsamp_period;
+	setup -> brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
+	setup -> brent_depth = brent_depth;
+	setup -> globalPeak = globalPeak;
+}
+
+/*
+	The buffers that each thread needs for itself.
+	They are allocated once per thread, not once per frame.
+*/
+struct PitchAnalysisWorkspace {
+	autoMAT frame;
+	autoNUMFourierTable fftTable;
+	autoVEC ac;
+	autoVEC rbuffer;
+	double *r;
+	autoINTVEC imax;
+	autoVEC localMean;
+
+	void init (Sound me, PitchAnalysisSetup const& setup) {
+		if (setup.method >= FCC_NORMAL) {   // cross-correlation
+			our frame = zero_MAT (my ny, setup.nsamp_window);
+		} else {   // autocorrelation
+			our fftTable = NUMFourierTable_create (setup.nsampFFT);
+			our frame = zero_MAT (my ny, setup.nsampFFT);
+			our ac = zero_VEC (setup.nsampFFT);
+		}
+		our rbuffer = zero_VEC (2 * setup.nsamp_window + 1);
+		our r = & our rbuffer [1 + setup.nsamp_window];
+		our imax = zero_INTVEC (setup.maxnCandidates);
+		our localMean = zero_VEC (my ny);
+	}
+};
+
+static void Sound_into_PitchFrame (Sound me, Pitch_Frame pitchFrame, double t,
+	PitchAnalysisSetup const& setup, double voicingThreshold, double octaveCost,
+	PitchAnalysisWorkspace *workspace)
+{
+	Sound_into_PitchFrame (me, pitchFrame, t,
+		setup.pitchFloor, setup.maxnCandidates, setup.method, voicingThreshold, octaveCost,
+		workspace -> fftTable.get(), setup.dt_window, setup.nsamp_window, setup.halfnsamp_window,
+		setup.maximumLag, setup.nsampFFT, setup.nsamp_period, setup.halfnsamp_period,
+		setup.brent_ixmax, setup.brent_depth, setup.globalPeak,
+		workspace -> frame.get(), workspace -> ac.get(), setup.window.get(), setup.windowR.get(),
+		workspace -> r, workspace -> imax.get(), workspace -> localMean.get()
+	);
+}
+
+autoPitch Sound_to_Pitch_any (Sound me,
+	int method, double periodsPerWindow,
+	double dt, double pitchFloor, double pitchCeiling,
+	integer maxnCandidates,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost)
+{
+	try {
+		PitchAnalysisSetup setup;
+		Sound_setUpPitchAnalysis (me, & setup, method, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxnCandidates);
+		const integer numberOfFrames = setup.numberOfFrames;
 
 		/*
 			Create the resulting pitch contour.
 		*/
-		autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, dt, t1, pitchCeiling, maxnCandidates);
+		autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, setup.dt, setup.t1,
+				setup.pitchCeiling, setup.maxnCandidates);
 
 		/*
 			Create (too much) space for candidates.
 		*/
 		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
 			const Pitch_Frame pitchFrame = & thy frames [iframe];
-			Pitch_Frame_init (pitchFrame, maxnCandidates);
+			Pitch_Frame_init (pitchFrame, setup.maxnCandidates);
 		}
 
-		/*
-			Compute the global absolute peak for determination of silence threshold.
-		*/
-		globalPeak = 0.0;
-		for (integer ichan = 1; ichan <= my ny; ichan ++) {
-			const double mean = NUMmean (my z.row (ichan));
-			for (integer i = 1; i <= my nx; i ++) {
-				double value = fabs (my z [ichan] [i] - mean);
-				if (value > globalPeak)
-					globalPeak = value;
-			}
-		}
-		if (globalPeak == 0.0)
+		if (setup.globalPeak == 0.0)
 			return thee;
 
-		autoVEC window, windowR;
-		if (method >= FCC_NORMAL) {   // for cross-correlation analysis
-
-			nsampFFT = 0;
-			brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
-
-		} else {   // for autocorrelation analysis
-
-			/*
-				Compute the number of samples needed for doing FFT.
-				To avoid edge effects, we have to append zeroes to the window.
-				The maximum lag considered for maxima is maximumLag.
-				The maximum lag used in interpolation is nsamp_window * interpolation_depth.
-			*/
-			nsampFFT = 1;
-			while (nsampFFT < nsamp_window * (1 + interpolation_depth))
-				nsampFFT *= 2;
-
-			/*
-				Create buffers for autocorrelation analysis.
-			*/
-			windowR. resize (nsampFFT);
-			window. resize (nsamp_window);
-			autoNUMFourierTable fftTable = NUMFourierTable_create (nsampFFT);
-
-			/*
-				A Gaussian or Hanning window is applied against phase effects.
-				The Hanning window is 2 to 5 dB better for 3 periods/window.
-				The Gaussian window is 25 to 29 dB better for 6 periods/window.
-			*/
-			if (method == AC_GAUSS) {   // Gaussian window
-				double imid = 0.5 * (nsamp_window + 1), edge = exp (-12.0);
-				for (integer i = 1; i <= nsamp_window; i ++)
-					window [i] = (exp (-48.0 * (i - imid) * (i - imid) /
-							(nsamp_window + 1) / (nsamp_window + 1)) - edge) / (1.0 - edge);
-			} else {   // Hanning window
-				for (integer i = 1; i <= nsamp_window; i ++)
-					window [i] = 0.5 - 0.5 * cos (NUM2pi * i / (nsamp_window + 1));
-			}
-
-			/*
-				Compute the normalized autocorrelation of the window.
-			*/
-			for (integer i = 1; i <= nsamp_window; i ++)
-				windowR [i] = window [i];
-			NUMfft_forward (fftTable.get(), windowR.get());
-			windowR [1] *= windowR [1];   // DC component
-			for (integer i = 2; i < nsampFFT; i += 2) {
-				windowR [i] = windowR [i] * windowR [i] + windowR [i + 1] * windowR [i + 1];
-				windowR [i + 1] = 0.0;   // power spectrum: square and zero
-			}
-			windowR [nsampFFT] *= windowR [nsampFFT];   // Nyquist frequency
-			NUMfft_backward (fftTable.get(), windowR.get());   // autocorrelation
-			for (integer i = 2; i <= nsamp_window; i ++)
-				windowR [i] /= windowR [1];   // normalize
-			windowR [1] = 1.0;   // normalize
-
-			brent_ixmax = Melder_ifloor (nsamp_window * interpolation_depth);
-		}
-
 		autoMelderProgress progress (U"Sound to Pitch...");
 		if (MelderThread_TRACING)
 			Melder_casual (U"channel frame time pitch");
 
 		MelderThread_PARALLELIZE (numberOfFrames, 5)
 
-		autoMAT frame;
-		autoNUMFourierTable fftTable;
-		autoVEC ac;
-		if (method >= FCC_NORMAL) {   // cross-correlation
-			frame = zero_MAT (my ny, nsamp_window);
-		} else {   // autocorrelation
-			fftTable = NUMFourierTable_create (nsampFFT);
-			frame = zero_MAT (my ny, nsampFFT);
-			ac = zero_VEC (nsampFFT);
-		}
-		autoVEC rbuffer = zero_VEC (2 * nsamp_window + 1);
-		double *r = & rbuffer [1 + nsamp_window];
-		autoINTVEC imax = zero_INTVEC (maxnCandidates);
-		autoVEC localMean = zero_VEC (my ny);
+		PitchAnalysisWorkspace workspace;
+		workspace. init (me, setup);
 
 		MelderThread_FOR (iframe) {
 
@@ -466,14 +535,7 @@ autoPitch Sound_to_Pitch_any (Sound me,
 					U" out of ", numberOfFrames, U" frames"
 				);
 			}
-			Sound_into_PitchFrame (me, pitchFrame, time,
-				pitchFloor, maxnCandidates, method, voicingThreshold, octaveCost,
-				fftTable.get(), dt_window, nsamp_window, halfnsamp_window,
-				maximumLag, nsampFFT, nsamp_period, halfnsamp_period,
-				brent_ixmax, brent_depth, globalPeak,
-				frame.get(), ac.get(), window.get(), windowR.get(),
-				r, imax.get(), localMean.get()
-			);
+			Sound_into_PitchFrame (me, pitchFrame, time, setup, voicingThreshold, octaveCost, & workspace);
 			if (MelderThread_TRACING)
 				Melder_casual (MelderThread_CHANNEL, U" ", iframe, U" ", time, U" ", pitchFrame -> candidates [1]. frequency);
 
@@ -481,7 +543,7 @@ autoPitch Sound_to_Pitch_any (Sound me,
 
 		Melder_progress (0.95, U"Sound to Pitch: path finder");
 		Pitch_pathFinder (thee.get(), silenceThreshold, voicingThreshold,
-				octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling, Melder_debug == 31 ? true : false);
+				octaveCost, octaveJumpCost, voicedUnvoicedCost, setup.pitchCeiling, Melder_debug == 31 ? true : false);
 
 		return thee;
 	} catch (MelderError) {
@@ -489,6 +551,90 @@ autoPitch Sound_to_Pitch_any (Sound me,
 	}
 }
 
+static double Pitch_Frame_strengthToHarmonicity (Pitch_Frame me) {
+	if (my candidates [1]. frequency == 0.0)
+		return -200.0;
+	const double r = my candidates [1]. strength;
+	return ( r <= 1e-15 ? -150.0 : r > 1.0 - 1e-15 ? 150.0 : 10.0 * log10 (r / (1.0 - r)) );
+}
+
+autoHarmonicity Sound_to_Harmonicity_any (Sound me,
+	int method, double periodsPerWindow,
+	double dt, double pitchFloor, double silenceThreshold)
+{
+	try {
+		const double pitchCeiling = 0.5 / my dx;
+		const integer maxnCandidates = 15;
+		if (Melder_debug == 58) {
+			/*
+				The original route: store all candidates and let the path finder choose.
+			*/
+			autoPitch pitch = Sound_to_Pitch_any (me, method, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxnCandidates,
+					silenceThreshold, 0.0, 0.0, 0.0, 0.0);
+			autoHarmonicity thee = Harmonicity_create (my xmin, my xmax, pitch -> nx, pitch -> dx, pitch -> x1);
+			for (integer iframe = 1; iframe <= thy nx; iframe ++)
+				thy z [1] [iframe] = Pitch_Frame_strengthToHarmonicity (& pitch -> frames [iframe]);
+			return thee;
+		}
+
+		PitchAnalysisSetup setup;
+		Sound_setUpPitchAnalysis (me, & setup, method, periodsPerWindow, dt, pitchFloor, pitchCeiling, maxnCandidates);
+		const integer numberOfFrames = setup.numberOfFrames;
+		autoHarmonicity thee = Harmonicity_create (my xmin, my xmax, numberOfFrames, setup.dt, setup.t1);
+		if (setup.globalPeak == 0.0) {
+			thy z.row (1)  <<=  -200.0;
+			return thee;
+		}
+
+		autoMelderProgress progress (U"Sound to Harmonicity...");
+
+		MelderThread_PARALLELIZE (numberOfFrames, 5)
+
+		PitchAnalysisWorkspace workspace;
+		workspace. init (me, setup);
+		structPitch_Frame pitchFrame;
+		Pitch_Frame_init (& pitchFrame, setup.maxnCandidates);
+
+		MelderThread_FOR (iframe) {
+
+			if (MelderThread_IS_MASTER) {
+				const double estimatedProgress = MelderThread_ESTIMATED_PROGRESS;
+				Melder_progress (0.1 + 0.8 * estimatedProgress,
+					U"Sound to Harmonicity: analysed approximately ", Melder_iround (numberOfFrames * estimatedProgress),
+					U" out of ", numberOfFrames, U" frames"
+				);
+			}
+			const double time = Sampled_indexToX (thee.get(), iframe);
+			Sound_into_PitchFrame (me, & pitchFrame, time, setup, 0.0, 0.0, & workspace);
+			/*
+				With a zero voicing threshold and zero costs, the path finder would choose,
+				in every frame, the first of the locally strongest candidates;
+				we make that choice here directly.
+			*/
+			const double unvoicedStrength = ( silenceThreshold <= 0.0 ? 0.0 :
+					std::max (0.0, 2.0 - pitchFrame. intensity / silenceThreshold) );
+			integer winner = 0;
+			double maximum = -1e30;
+			for (integer icand = 1; icand <= pitchFrame. nCandidates; icand ++) {
+				const Pitch_Candidate candidate = & pitchFrame. candidates [icand];
+				const double strength = ( Pitch_util_frequencyIsVoiced (candidate -> frequency, setup.pitchCeiling) ?
+						candidate -> strength : unvoicedStrength );
+				if (strength > maximum) {
+					maximum = strength;
+					winner = icand;
+				}
+			}
+			std::swap (pitchFrame. candidates [1], pitchFrame. candidates [winner]);
+			thy z [1] [iframe] = Pitch_Frame_strengthToHarmonicity (& pitchFrame);
+
+		} MelderThread_ENDFOR
+
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": harmonicity analysis not performed.");
+	}
+}
+
 autoPitch Sound_to_Pitch (Sound me, double timeStep, double pitchFloor, double pitchCeiling) {
 	return Sound_to_Pitch_rawAc (me, timeStep, pitchFloor, pitchCeiling,
 			15, false, 0.03, 0.45, 0.01, 0.35, 0.14);
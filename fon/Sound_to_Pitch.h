@@ -18,6 +18,7 @@
 
 #include "Sound.h"
 #include "Pitch.h"
+#include "Harmonicity.h"
 
 autoPitch Sound_to_Pitch (Sound me, double timeStep,
 	double pitchFloor, double pitchCeiling);
@@ -86,6 +87,24 @@ autoPitch Sound_to_Pitch_any (Sound me,
 		pitches above a certain value "voiceless".
 */
 
+autoHarmonicity Sound_to_Harmonicity_any (Sound me,
+	int method,                 // as in Sound_to_Pitch_any
+	double periodsPerWindow,    // 4.5 for HNR (ac), 1 for HNR (cc)
+	double timeStep,            // in seconds; 0.0 = automatic = periodsPerWindow / pitchFloor / 4
+	double pitchFloor,          // in Hz
+	double silenceThreshold);   // relative to purely periodic; default 0.1
+/*
+	Function:
+		harmonics-to-noise ratio, frame by frame.
+	Description:
+		The frames are analysed on multiple threads exactly as in Sound_to_Pitch_any,
+		with the pitch ceiling at the Nyquist frequency, a voicing threshold of 0
+		and all costs 0. With these settings the path finder would simply choose the strongest
+		candidate in each frame, so this function makes that choice directly,
+		without storing the candidates of all frames and without running the path finder.
+		Set Melder_debug to 58 to go through Sound_to_Pitch_any and Pitch_pathFinder instead.
+*/
+
 autoPitch Sound_to_Pitch_filteredAc (Sound me,
 	double timeStep, double pitchFloor, double pitchTop,
 	integer maxnCandidates, bool veryAccurate,
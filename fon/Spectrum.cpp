@@ -1,6 +1,6 @@
 /* Spectrum.cpp
  *
- * Copyright (C) 1992-2008,2011,2012,2014-2023 Paul Boersma
+ * Copyright (C) 1992-2008,2011,2012,2014-2023,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -376,46 +376,51 @@ autoSpectrum Spectrum_cepstralSmoothing (Spectrum me, double bandWidth) {
 	}
 }
 
-void Spectrum_passHannBand (Spectrum me, double fmin, double fmax0, double smooth) {
-	const double fmax = ( fmax0 == 0.0 ? my xmax : fmax0 );
+double Spectrum_passHannBand_gain (double frequency, double spectrumMaximumFrequency, double fmin, double fmax0, double smooth) {
+	const double fmax = ( fmax0 == 0.0 ? spectrumMaximumFrequency : fmax0 );
 	const double f1 = fmin - smooth, f2 = fmin + smooth, f3 = fmax - smooth, f4 = fmax + smooth;
 	const double halfpibysmooth = ( smooth != 0.0 ? NUMpi / (2.0 * smooth) : 0.0 );
+	if (frequency < f1 || frequency > f4)
+		return 0.0;
+	if (frequency < f2 && fmin > 0.0)
+		return 0.5 - 0.5 * cos (halfpibysmooth * (frequency - f1));
+	if (frequency > f3 && fmax < spectrumMaximumFrequency)
+		return 0.5 + 0.5 * cos (halfpibysmooth * (frequency - f3));
+	return 1.0;
+}
+
+double Spectrum_stopHannBand_gain (double frequency, double spectrumMaximumFrequency, double fmin, double fmax0, double smooth) {
+	const double fmax = ( fmax0 == 0.0 ? spectrumMaximumFrequency : fmax0 );
+	const double f1 = fmin - smooth, f2 = fmin + smooth, f3 = fmax - smooth, f4 = fmax + smooth;
+	const double halfpibysmooth = ( smooth != 0.0 ? NUMpi / (2.0 * smooth) : 0.0 );
+	if (frequency < f1 || frequency > f4)
+		return 1.0;
+	if (frequency < f2 && fmin > 0.0)
+		return 0.5 + 0.5 * cos (halfpibysmooth * (frequency - f1));
+	if (frequency > f3 && fmax < spectrumMaximumFrequency)
+		return 0.5 - 0.5 * cos (halfpibysmooth * (frequency - f3));
+	return 0.0;
+}
+
+void Spectrum_passHannBand (Spectrum me, double fmin, double fmax, double smooth) {
 	const VEC re = my z.row (1), im = my z.row (2);
 	for (integer i = 1; i <= my nx; i ++) {
-		const double frequency = my x1 + (i - 1) * my dx;
-		if (frequency < f1 || frequency > f4)
-			re [i] = im [i] = 0.0;
-		if (frequency < f2 && fmin > 0.0) {
-			const double factor = 0.5 - 0.5 * cos (halfpibysmooth * (frequency - f1));
-			re [i] *= factor;
-			im [i] *= factor;
-		} else if (frequency > f3 && fmax < my xmax) {
-			const double factor = 0.5 + 0.5 * cos (halfpibysmooth * (frequency - f3));
-			re [i] *= factor;
-			im [i] *= factor;
+		const double gain = Spectrum_passHannBand_gain (my x1 + (i - 1) * my dx, my xmax, fmin, fmax, smooth);
+		if (gain != 1.0) {
+			re [i] *= gain;
+			im [i] *= gain;
 		}
 	}
 }
 
-void Spectrum_stopHannBand (Spectrum me, double fmin, double fmax0, double smooth) {
-	const double fmax = ( fmax0 == 0.0 ? my xmax : fmax0 );
-	const double f1 = fmin - smooth, f2 = fmin + smooth, f3 = fmax - smooth, f4 = fmax + smooth;
-	const double halfpibysmooth = ( smooth != 0.0 ? NUMpi / (2.0 * smooth) : 0.0 );
+void Spectrum_stopHannBand (Spectrum me, double fmin, double fmax, double smooth) {
 	const VEC re = my z.row (1), im = my z.row (2);
 	for (integer i = 1; i <= my nx; i ++) {
-		const double frequency = my x1 + (i - 1) * my dx;
-		if (frequency < f1 || frequency > f4)
-			continue;
-		if (frequency < f2 && fmin > 0.0) {
-			const double factor = 0.5 + 0.5 * cos (halfpibysmooth * (frequency - f1));
-			re [i] *= factor;
-			im [i] *= factor;
-		} else if (frequency > f3 && fmax < my xmax) {
-			const double factor = 0.5 - 0.5 * cos (halfpibysmooth * (frequency - f3));
-			re [i] *= factor;
-			im [i] *= factor;
-		} else
-			re [i] = im [i] = 0.0;
+		const double gain = Spectrum_stopHannBand_gain (my x1 + (i - 1) * my dx, my xmax, fmin, fmax, smooth);
+		if (gain != 1.0) {
+			re [i] *= gain;
+			im [i] *= gain;
+		}
 	}
 }
 
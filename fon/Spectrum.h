@@ -2,7 +2,7 @@
 #define _Spectrum_h_
 /* Spectrum.h
  *
- * Copyright (C) 1992-2005,2007,2011,2015-2017,2019-2021 Paul Boersma
+ * Copyright (C) 1992-2005,2007,2011,2015-2017,2019-2021,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -99,6 +99,12 @@ autoSpectrum Spectrum_cepstralSmoothing (Spectrum me, double bandWidth);
 
 void Spectrum_passHannBand (Spectrum me, double fmin, double fmax, double smooth);
 void Spectrum_stopHannBand (Spectrum me, double fmin, double fmax, double smooth);
+/*
+	The factors by which the two functions above multiply the value at `frequency`,
+	in a spectrum that runs up to `spectrumMaximumFrequency`; `fmax` = 0.0 stands for that maximum.
+*/
+double Spectrum_passHannBand_gain (double frequency, double spectrumMaximumFrequency, double fmin, double fmax, double smooth);
+double Spectrum_stopHannBand_gain (double frequency, double spectrumMaximumFrequency, double fmin, double fmax, double smooth);
 
 MelderPoint Spectrum_getNearestMaximum (Spectrum me, double frequency);
 
@@ -402,7 +402,7 @@ MAN_BEGIN (U"LongSound: View", U"ppgb", 19980730)
 INTRO (U"A command to view the selected @LongSound object in a @LongSoundEditor.")
 MAN_END
 
-MAN_BEGIN (U"LongSoundEditor", U"ppgb", 20041124)
+MAN_BEGIN (U"LongSoundEditor", U"ppgb", 20261019)
 INTRO (U"One of the @Editors in Praat, for viewing a @LongSound object.")
 NORMAL (U"This viewer allows you:")
 LIST_ITEM (U"• to view and hear parts of the sound as it is on disk;")
@@ -412,8 +412,14 @@ LIST_ITEM (U"• to copy a selected part as a @Sound object to the @Sound clipbo
 	"so that you can paste it into another Sound object that you are viewing in a @SoundEditor.")
 NORMAL (U"To label and segment the LongSound object, use the @TextGridEditor instead (see @LongSound).")
 NORMAL (U"The display and playback of the samples is restricted to 60 seconds at a time, for reasons of speed "
-	"(although you can change this number with ##LongSound prefs# from the main #Preferences menu; "
+	"(although you can change this number with ##LongSound settings...# from the #Settings submenu of the Praat menu); "
 	"the sound file itself can contain several hours of sound.")
+NORMAL (U"If you zoom out beyond that, you will still see the waveform, namely as its minimum, maximum "
+	"and root-mean-square values per screen pixel. These are computed from a summary of the sound file "
+	"that is made the first time you view each stretch of the file. "
+	"If you switch on ##Save waveform summaries# in ##LongSound settings...#, "
+	"the summary is saved next to the sound file (in a file whose name ends in .praat-summary), "
+	"so that it does not have to be made again the next time you open the file.")
 MAN_END
 
 MAN_BEGIN (U"Open long sound file...", U"ppgb", 19980730)
@@ -263,11 +263,16 @@ FORM (SETTINGS__LongSoundSettings, U"LongSound settings", U"LongSound") {
 	NATURAL (maximumViewablePart, U"Maximum viewable part (seconds)", U"60")
 	COMMENT (U"Note: this setting works for the next long sound file that you open,")
 	COMMENT (U"not for currently existing LongSound objects.")
+	COMMENT (U"Zoomed-out waveforms are drawn from a summary of the sound file,")
+	COMMENT (U"which can be saved next to the sound file for the next time:")
+	BOOLEAN (saveWaveformSummaries, U"Save waveform summaries", false)
 OK
 	SET_INTEGER (maximumViewablePart, LongSound_getBufferSizePref_seconds ())
+	SET_BOOLEAN (saveWaveformSummaries, LongSound_getSaveSummaryPref ())
 DO
 	PREFS
 		LongSound_setBufferSizePref_seconds (maximumViewablePart);
+		LongSound_setSaveSummaryPref (saveWaveformSummaries);
 	PREFS_END
 }
 
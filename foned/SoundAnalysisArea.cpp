@@ -1,6 +1,6 @@
 /* SoundAnalysisArea.cpp
  *
- * Copyright (C) 1992-2025 Paul Boersma
+ * Copyright (C) 1992-2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -73,6 +73,9 @@ DEFINE_dynamic_instancePref_pitch (bool, veryAccurate)
 DEFINE_dynamic_instancePref_pitch (integer, maximumNumberOfCandidates)
 DEFINE_dynamic_instancePref_pitch (double, silenceThreshold)
 DEFINE_dynamic_instancePref_pitch (double, voicingThreshold)
+DEFINE_dynamic_instancePref_pitch (double, octaveCost)
+DEFINE_dynamic_instancePref_pitch (double, octaveJumpCost)
+DEFINE_dynamic_instancePref_pitch (double, voicedUnvoicedCost)
 
 double structSoundAnalysisArea :: dynamic_instancePref_pitch_ceilingOrTop () {
 	switch (our instancePref_pitch_method()) {
@@ -114,17 +117,6 @@ static double periodsPerAnalysisWindow (SoundAnalysisArea me) {
 	}
 }
 
-/*
-	Some tryToCompute<Analysis>() functions.
-	The "try" means that any exceptions that are generated, will be ignored;
-	this is necessary because these functions have to be used in an editor window,
-	where they have to work in the background,
-	because they are not explicly called by a user action.
-
-	Postcondition:
-		- If a tryToCompute<Analysis>() function fails, the <Analysis> should be null;
-		  this is how tryToCompute<Analysis>() signals failure.
-*/
 static autoSound extractSoundOrNull (SoundAnalysisArea me, double tmin, double tmax) {
 	autoSound sound;
 	if (my longSound()) {
@@ -136,23 +128,431 @@ static autoSound extractSoundOrNull (SoundAnalysisArea me, double tmin, double t
 	}
 	return sound;
 }
+
+/*
+	The analyses proper, performed on a stretch of sound that includes the margins.
+*/
+static double spectrogramMargin (SoundAnalysisArea me) {
+	return ( my instancePref_spectrogram_windowShape() == kSound_to_Spectrogram_windowShape::GAUSSIAN ?
+			my instancePref_spectrogram_windowLength() : 0.5 * my instancePref_spectrogram_windowLength() );
+}
+static double pitchMargin (SoundAnalysisArea me) {
+	return ( my dynamic_instancePref_pitch_veryAccurate() ? 3.0 : 1.5 ) / my dynamic_instancePref_pitch_floor();
+}
+static double intensityMargin (SoundAnalysisArea me) {
+	return 3.2 / my dynamic_instancePref_pitch_floor();
+}
+static double formantMargin (SoundAnalysisArea me) {
+	return my instancePref_formant_windowLength();
+}
+static autoSpectrogram computeSpectrogram (SoundAnalysisArea me, Sound sound, double timeStep) {
+	return Sound_to_Spectrogram_e (sound,
+		my instancePref_spectrogram_windowLength(),
+		my instancePref_spectrogram_viewTo(),
+		timeStep,
+		my instancePref_spectrogram_viewTo() / my instancePref_spectrogram_frequencySteps(),
+		my instancePref_spectrogram_windowShape(), 8.0, 8.0
+	);
+}
+static autoPitch computePitch (SoundAnalysisArea me, Sound sound, double pitchTimeStep) {
+	if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_AUTOCORRELATION)
+		return Sound_to_Pitch_filteredAc (sound,
+			pitchTimeStep, my instancePref_pitch_filteredAC_floor(), my instancePref_pitch_filteredAC_top(),
+			my instancePref_pitch_filteredAC_maximumNumberOfCandidates(), my instancePref_pitch_filteredAC_veryAccurate(),
+			my instancePref_pitch_filteredAC_attenuationAtTop(),
+			my instancePref_pitch_filteredAC_silenceThreshold(), my instancePref_pitch_filteredAC_voicingThreshold(),
+			my instancePref_pitch_filteredAC_octaveCost(), my instancePref_pitch_filteredAC_octaveJumpCost(),
+			my instancePref_pitch_filteredAC_voicedUnvoicedCost()
+		);
+	else if	(my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::RAW_CROSS_CORRELATION)
+		return Sound_to_Pitch_rawCc (sound,
+			pitchTimeStep, my instancePref_pitch_rawCC_floor(), my instancePref_pitch_rawCC_ceiling(),
+			my instancePref_pitch_rawCC_maximumNumberOfCandidates(), my instancePref_pitch_rawCC_veryAccurate(),
+			my instancePref_pitch_rawCC_silenceThreshold(), my instancePref_pitch_rawCC_voicingThreshold(),
+			my instancePref_pitch_rawCC_octaveCost(), my instancePref_pitch_rawCC_octaveJumpCost(),
+			my instancePref_pitch_rawCC_voicedUnvoicedCost()
+		);
+	else if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::RAW_AUTOCORRELATION)
+		return Sound_to_Pitch_rawAc (sound,
+			pitchTimeStep, my instancePref_pitch_rawAC_floor(), my instancePref_pitch_rawAC_ceiling(),
+			my instancePref_pitch_rawAC_maximumNumberOfCandidates(), my instancePref_pitch_rawAC_veryAccurate(),
+			my instancePref_pitch_rawAC_silenceThreshold(), my instancePref_pitch_rawAC_voicingThreshold(),
+			my instancePref_pitch_rawAC_octaveCost(), my instancePref_pitch_rawAC_octaveJumpCost(),
+			my instancePref_pitch_rawAC_voicedUnvoicedCost()
+		);
+	else if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_CROSS_CORRELATION)
+		return Sound_to_Pitch_filteredCc (sound, pitchTimeStep,
+			my instancePref_pitch_filteredCC_floor(), my instancePref_pitch_filteredCC_top(),
+			my instancePref_pitch_filteredCC_maximumNumberOfCandidates(), my instancePref_pitch_filteredCC_veryAccurate(),
+			my instancePref_pitch_filteredCC_attenuationAtTop(),
+			my instancePref_pitch_filteredCC_silenceThreshold(), my instancePref_pitch_filteredCC_voicingThreshold(),
+			my instancePref_pitch_filteredCC_octaveCost(), my instancePref_pitch_filteredCC_octaveJumpCost(),
+			my instancePref_pitch_filteredCC_voicedUnvoicedCost()
+		);
+	else
+		Melder_fatal (U"Unknown pitch method ", (int) my instancePref_pitch_method(), U".");
+}
+static autoIntensity computeIntensity (SoundAnalysisArea me, Sound sound, double timeStep) {
+	return Sound_to_Intensity (sound, my dynamic_instancePref_pitch_floor(), timeStep,
+			my instancePref_intensity_subtractMeanPressure());
+}
+static autoFormant computeFormants (SoundAnalysisArea me, Sound sound, double formantTimeStep) {
+	return Sound_to_Formant_any (sound, formantTimeStep,
+		Melder_iround (my instancePref_formant_numberOfFormants() * 2.0), my instancePref_formant_ceiling(),
+		my instancePref_formant_windowLength(), (int) my instancePref_formant_method(), my instancePref_formant_preemphasisFrom(), 50.0
+	);
+}
+
+#pragma mark - SoundAnalysisArea analysis tiles
+
+/*
+	Except with a view-dependent time step, the spectrogram, pitch, intensity and formants
+	are computed in tiles of a fixed number of frames, on a time grid that is fixed with respect
+	to the samples of the sound, so that scrolling can reuse the tiles that have been computed before.
+
+	A long window is served from a coarser level, in which each tile spans twice as much time
+	as in the level below, so that the number of frames in the window stays limited.
+	At coarse levels where the time step is large with respect to the analysis window,
+	each frame is computed from its own short stretch of sound,
+	so that a zoomed-out window does not require reading (and analysing) all of the sound.
+
+	Tiles are computed on demand, visible tiles only, and each analysis is multi-threaded by itself.
+	Neighbouring tiles are not filled in ahead of time. That could be done from an idle or timer callback,
+	as in the SoundRecorder (g_idle_add, a CFRunLoopTimer, GuiAddWorkProc), but such a callback
+	runs on the main thread, so it would hold up scrolling unless it computed a small piece per call;
+	and a thread of its own cannot read the sound of a LongSound, whose buffer is shared with the drawing.
+	When the tiles take up more memory than the budget, the tiles that were used longest ago are removed.
+
+	The pitch path finder works per tile. To keep the paths of consecutive tiles from disagreeing
+	at the tile boundaries, each pitch tile is analysed together with 25 frames on either side,
+	which are then thrown away. The path may still differ from that of an analysis of the whole sound
+	where an octave decision depends on more than 25 frames of context,
+	and at the coarse levels where every frame is analysed from its own short stretch of sound,
+	there is no path across frames at all.
+*/
+
+Thing_implement (SoundAnalysisTile, Thing, 0);
+
+enum { TILE_SPECTROGRAM = 1, TILE_PITCH, TILE_INTENSITY, TILE_FORMANTS };
+
+constexpr integer numberOfFramesPerTile = 100;
+constexpr integer maximumNumberOfTileBytes = 100'000'000;
+constexpr integer maximumTileLevel = 30;
+constexpr integer numberOfPitchPathContextFrames = 25;
+
+static double tileMargin (SoundAnalysisArea me, int kind) {
+	switch (kind) {
+		case TILE_SPECTROGRAM: return spectrogramMargin (me);
+		case TILE_PITCH: return pitchMargin (me);
+		case TILE_INTENSITY: return intensityMargin (me);
+		case TILE_FORMANTS: return formantMargin (me);
+		default: Melder_fatal (U"Unknown tile kind ", kind, U".");
+	}
+}
+
+/*
+	The time step at level 0, before it is adapted to the sampling period of the sound.
+	These are the default time steps of the analyses, except for the spectrogram,
+	whose time step would otherwise depend on the window;
+	a twelfth of the window length stays above the minimum time step of Sound_to_Spectrogram_e ().
+*/
+static double tileTimeStep (SoundAnalysisArea me, int kind) {
+	const bool fixed = ( my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ );
+	switch (kind) {
+		case TILE_SPECTROGRAM: return my instancePref_spectrogram_windowLength() / 12.0;
+		case TILE_PITCH: return ( fixed ? my instancePref_fixedTimeStep() : 0.25 * periodsPerAnalysisWindow (me) / my dynamic_instancePref_pitch_floor() );
+		case TILE_INTENSITY: return 0.8 / my dynamic_instancePref_pitch_floor();
+		case TILE_FORMANTS: return ( fixed ? my instancePref_fixedTimeStep() : 0.25 * my instancePref_formant_windowLength() );
+		default: Melder_fatal (U"Unknown tile kind ", kind, U".");
+	}
+}
+
+static integer maximumNumberOfFramesPerWindow (SoundAnalysisArea me, int kind) {
+	if (kind == TILE_SPECTROGRAM)
+		return my instancePref_spectrogram_timeSteps();
+	return std::max (1_integer, Melder_iceiling (my instancePref_longestAnalysis() / tileTimeStep (me, kind)));
+}
+
+/*
+	All the settings that a tile depends on. Tiles computed with other settings are forgotten.
+*/
+static conststring32 tileSignature (SoundAnalysisArea me, int kind) {
+	switch (kind) {
+		case TILE_SPECTROGRAM:
+			return Melder_cat (my instancePref_spectrogram_windowLength(), U" ", my instancePref_spectrogram_viewTo(),
+				U" ", my instancePref_spectrogram_frequencySteps(), U" ", (int) my instancePref_spectrogram_windowShape());
+		case TILE_PITCH: {
+			const bool filtered = (
+				my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_AUTOCORRELATION ||
+				my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_CROSS_CORRELATION
+			);
+			return Melder_cat ((int) my instancePref_pitch_method(), U" ", tileTimeStep (me, kind),
+				U" ", my dynamic_instancePref_pitch_floor(), U" ", my dynamic_instancePref_pitch_ceilingOrTop(),
+				U" ", my dynamic_instancePref_pitch_maximumNumberOfCandidates(), U" ", my dynamic_instancePref_pitch_veryAccurate(),
+				U" ", filtered ? dynamic_instancePref_pitch_attenuationAtTop (me) : 0.0,
+				U" ", my dynamic_instancePref_pitch_silenceThreshold(), U" ", my dynamic_instancePref_pitch_voicingThreshold(),
+				U" ", my dynamic_instancePref_pitch_octaveCost(), U" ", my dynamic_instancePref_pitch_octaveJumpCost(),
+				U" ", my dynamic_instancePref_pitch_voicedUnvoicedCost());
+		}
+		case TILE_INTENSITY:
+			return Melder_cat (my dynamic_instancePref_pitch_floor(), U" ", my instancePref_intensity_subtractMeanPressure());
+		case TILE_FORMANTS:
+			return Melder_cat (tileTimeStep (me, kind), U" ", my instancePref_formant_numberOfFormants(),
+				U" ", my instancePref_formant_ceiling(), U" ", my instancePref_formant_windowLength(),
+				U" ", (int) my instancePref_formant_method(), U" ", my instancePref_formant_preemphasisFrom());
+		default: Melder_fatal (U"Unknown tile kind ", kind, U".");
+	}
+}
+
+static autoSampled computeAnalysis (SoundAnalysisArea me, int kind, Sound sound, double timeStep) {
+	switch (kind) {
+		case TILE_SPECTROGRAM: return computeSpectrogram (me, sound, timeStep);
+		case TILE_PITCH: return computePitch (me, sound, timeStep);
+		case TILE_INTENSITY: return computeIntensity (me, sound, timeStep);
+		case TILE_FORMANTS: return computeFormants (me, sound, timeStep);
+		default: Melder_fatal (U"Unknown tile kind ", kind, U".");
+	}
+}
+
+static autoSampled newAnalysisLike (Sampled model, double xmin, double xmax, integer numberOfFrames, double timeStep, double t1) {
+	if (Thing_isa (model, classPitch)) {
+		Pitch pitch = static_cast <Pitch> (model);
+		return Pitch_create (xmin, xmax, numberOfFrames, timeStep, t1, pitch -> ceiling, pitch -> maxnCandidates);
+	}
+	if (Thing_isa (model, classFormant))
+		return Formant_create (xmin, xmax, numberOfFrames, timeStep, t1, static_cast <Formant> (model) -> maxnFormants);
+	if (Thing_isa (model, classSpectrogram)) {
+		Spectrogram spectrogram = static_cast <Spectrogram> (model);
+		return Spectrogram_create (xmin, xmax, numberOfFrames, timeStep, t1,
+				spectrogram -> ymin, spectrogram -> ymax, spectrogram -> ny, spectrogram -> dy, spectrogram -> y1);
+	}
+	Melder_assert (Thing_isa (model, classIntensity));
+	return Intensity_create (xmin, xmax, numberOfFrames, timeStep, t1);
+}
+
+static void copyAnalysisFrame (Sampled from, integer fromFrame, Sampled to, integer toFrame) {
+	if (Thing_isa (from, classPitch))
+		static_cast <Pitch> (from) -> frames [fromFrame]. copy (& static_cast <Pitch> (to) -> frames [toFrame]);
+	else if (Thing_isa (from, classFormant))
+		static_cast <Formant> (from) -> frames [fromFrame]. copy (& static_cast <Formant> (to) -> frames [toFrame]);
+	else
+		static_cast <Matrix> (to) -> z.column (toFrame) <<= static_cast <Matrix> (from) -> z.column (fromFrame);
+}
+
+static integer numberOfBytesInAnalysis (Sampled analysis) {
+	integer numberOfBytes = 0;
+	if (Thing_isa (analysis, classPitch)) {
+		Pitch pitch = static_cast <Pitch> (analysis);
+		for (integer iframe = 1; iframe <= pitch -> nx; iframe ++)
+			numberOfBytes += sizeof (structPitch_Frame) + pitch -> frames [iframe]. nCandidates * sizeof (structPitch_Candidate);
+	} else if (Thing_isa (analysis, classFormant)) {
+		Formant formant = static_cast <Formant> (analysis);
+		for (integer iframe = 1; iframe <= formant -> nx; iframe ++)
+			numberOfBytes += sizeof (structFormant_Frame) + formant -> frames [iframe]. numberOfFormants * sizeof (structFormant_Formant);
+	} else {
+		numberOfBytes = static_cast <Matrix> (analysis) -> nx * static_cast <Matrix> (analysis) -> ny * integer (sizeof (double));
+	}
+	return numberOfBytes;
+}
+
+/*
+	A stretch of the sound from any first sample on, with zeroes outside the sound,
+	so that stretches of the same length yield analyses whose frames lie at the same positions
+	with respect to the samples, also at the edges of the sound.
+*/
+static autoSound extractPaddedSound (SoundAnalysisArea me, integer firstSample, integer numberOfSamples) {
+	SampledXY soundOrLongSound = my soundOrLongSound();
+	const double dx = soundOrLongSound -> dx;
+	const integer numberOfChannels = ( my longSound() ? my longSound() -> numberOfChannels : my sound() -> ny );
+	const double x1 = Sampled_indexToX (soundOrLongSound, firstSample);
+	autoSound sound = Sound_create (numberOfChannels, x1 - 0.5 * dx, x1 + (numberOfSamples - 0.5) * dx, numberOfSamples, dx, x1);
+	const integer firstAvailableSample = std::max (firstSample, 1_integer);
+	const integer lastAvailableSample = std::min (firstSample + numberOfSamples - 1, soundOrLongSound -> nx);
+	if (lastAvailableSample < firstAvailableSample)
+		return sound;
+	const integer firstColumn = firstAvailableSample - firstSample + 1;
+	const integer lastColumn = lastAvailableSample - firstSample + 1;
+	if (my longSound()) {
+		autoMAT samples = raw_MAT (numberOfChannels, lastColumn - firstColumn + 1);
+		LongSound_readAudioToFloat (my longSound(), samples.get(), firstAvailableSample);
+		sound -> z.verticalBand (firstColumn, lastColumn) <<= samples.all();
+	} else {
+		sound -> z.verticalBand (firstColumn, lastColumn) <<= my sound() -> z.verticalBand (firstAvailableSample, lastAvailableSample);
+	}
+	return sound;
+}
+
+static autoSampled computeTileAnalysis (SoundAnalysisArea me, int kind, integer index,
+	integer numberOfSamplesPerTile, double timeStep, double finestTimeStep)
+{
+	SampledXY soundOrLongSound = my soundOrLongSound();
+	const double dx = soundOrLongSound -> dx;
+	const double margin = tileMargin (me, kind);
+	const integer firstSampleOfTile = 1 + index * numberOfSamplesPerTile;
+	const double tileStartTime = Sampled_indexToX (soundOrLongSound, firstSampleOfTile) - 0.5 * dx;
+	const double tileEndTime = tileStartTime + numberOfSamplesPerTile * dx;
+	autoSampled tile;
+	if (timeStep <= 4.0 * margin) {
+		/*
+			Analyse the whole tile at once, with enough sound on both sides for the outer frames.
+			For pitch, the sound on both sides is longer, because the path finder chooses
+			among the candidates of a frame on the basis of its neighbours.
+			As all tiles of this level are analysed from stretches of the same length,
+			their frames all lie at the same offset from the start of the tile,
+			so that the frames of consecutive tiles together form a single time grid.
+		*/
+		const double pathContext = ( kind == TILE_PITCH ? numberOfPitchPathContextFrames * timeStep : 0.0 );
+		const integer numberOfSamplesAroundTile = Melder_iceiling ((margin + 2.0 * timeStep + pathContext) / dx);
+		autoSound sound = extractPaddedSound (me, firstSampleOfTile - numberOfSamplesAroundTile,
+				numberOfSamplesPerTile + 2 * numberOfSamplesAroundTile);
+		autoSampled analysis = computeAnalysis (me, kind, sound.get(), timeStep);
+		Melder_require (analysis -> nx >= numberOfFramesPerTile,
+			U"The analysis of a tile should have at least ", numberOfFramesPerTile, U" frames.");
+		const integer frameOffset = (analysis -> nx - numberOfFramesPerTile) / 2;
+		tile = newAnalysisLike (analysis.get(), tileStartTime, tileEndTime, numberOfFramesPerTile, timeStep,
+				Sampled_indexToX (analysis.get(), frameOffset + 1));
+		for (integer iframe = 1; iframe <= numberOfFramesPerTile; iframe ++)
+			copyAnalysisFrame (analysis.get(), frameOffset + iframe, tile.get(), iframe);
+	} else {
+		/*
+			Analyse each frame from a short stretch of sound around its own time.
+		*/
+		const double snippetTimeStep = std::min (finestTimeStep, margin);
+		const integer halfNumberOfSamplesPerSnippet = Melder_iceiling ((margin + 2.0 * snippetTimeStep) / dx);
+		for (integer iframe = 1; iframe <= numberOfFramesPerTile; iframe ++) {
+			const double time = tileStartTime + (iframe - 0.5) * timeStep;
+			const integer centralSample = Sampled_xToNearestIndex (soundOrLongSound, time);
+			autoSound sound = extractPaddedSound (me, centralSample - halfNumberOfSamplesPerSnippet, 2 * halfNumberOfSamplesPerSnippet + 1);
+			autoSampled analysis = computeAnalysis (me, kind, sound.get(), snippetTimeStep);
+			if (! tile)
+				tile = newAnalysisLike (analysis.get(), tileStartTime, tileEndTime, numberOfFramesPerTile, timeStep,
+						tileStartTime + 0.5 * timeStep);
+			copyAnalysisFrame (analysis.get(), (analysis -> nx + 1) / 2, tile.get(), iframe);
+		}
+	}
+	return tile;
+}
+
+static SoundAnalysisTile haveTile (SoundAnalysisArea me, int kind, conststring32 signature, integer level, integer index,
+	integer numberOfSamplesPerTile, double timeStep, double finestTimeStep)
+{
+	for (integer itile = 1; itile <= my d_tiles.size; itile ++) {
+		SoundAnalysisTile tile = my d_tiles.at [itile];
+		if (tile -> kind == kind && tile -> level == level && tile -> index == index) {
+			tile -> lastUse = my d_tileClock;
+			return tile;
+		}
+	}
+	autoSoundAnalysisTile tile = Thing_new (SoundAnalysisTile);
+	tile -> kind = kind;
+	tile -> signature = Melder_dup (signature);
+	tile -> level = level;
+	tile -> index = index;
+	tile -> analysis = computeTileAnalysis (me, kind, index, numberOfSamplesPerTile, timeStep, finestTimeStep);
+	tile -> numberOfBytes = numberOfBytesInAnalysis (tile -> analysis.get());
+	tile -> lastUse = my d_tileClock;
+	my d_numberOfTileBytes += tile -> numberOfBytes;
+	return my d_tiles. addItem_move (tile.move());
+}
+
+static void removeTilesOverBudget (SoundAnalysisArea me) {
+	while (my d_numberOfTileBytes > maximumNumberOfTileBytes) {
+		integer oldestTile = 0;
+		for (integer itile = 1; itile <= my d_tiles.size; itile ++) {
+			const SoundAnalysisTile tile = my d_tiles.at [itile];
+			if (tile -> lastUse < my d_tileClock && (oldestTile == 0 || tile -> lastUse < my d_tiles.at [oldestTile] -> lastUse))
+				oldestTile = itile;
+		}
+		if (oldestTile == 0)
+			return;   // all remaining tiles are visible
+		my d_numberOfTileBytes -= my d_tiles.at [oldestTile] -> numberOfBytes;
+		my d_tiles. removeItem (oldestTile);
+	}
+}
+
+/*
+	Collect the visible frames from the tiles, computing the tiles that do not exist yet.
+	Returns null if the window does not overlap with the part of the sound that can be analysed.
+*/
+static autoSampled computeTiledAnalysis (SoundAnalysisArea me, int kind) {
+	SampledXY soundOrLongSound = my soundOrLongSound();
+	if (! soundOrLongSound)
+		return autoSampled();
+	const double dx = soundOrLongSound -> dx;
+	const double margin = tileMargin (me, kind);
+	const integer numberOfSamplesPerFinestTile = std::max (1_integer,
+			Melder_iround (numberOfFramesPerTile * tileTimeStep (me, kind) / dx));
+	const double finestTimeStep = numberOfSamplesPerFinestTile * dx / numberOfFramesPerTile;
+	const integer maximumNumberOfFrames = maximumNumberOfFramesPerWindow (me, kind);
+	integer level = 0;
+	while (level < maximumTileLevel && (my endWindow() - my startWindow()) / ldexp (finestTimeStep, level) > maximumNumberOfFrames)
+		level ++;
+	const integer numberOfSamplesPerTile = numberOfSamplesPerFinestTile << level;
+	const double timeStep = numberOfSamplesPerTile * dx / numberOfFramesPerTile;
+	const double tileDuration = numberOfSamplesPerTile * dx;
+	const double startOfFirstSample = soundOrLongSound -> x1 - 0.5 * dx;
+	const integer firstIndex = std::max (0_integer, Melder_ifloor ((my startWindow() - startOfFirstSample) / tileDuration));
+	const integer lastIndex = std::min ((soundOrLongSound -> nx - 1) / numberOfSamplesPerTile,
+			Melder_ifloor ((my endWindow() - startOfFirstSample) / tileDuration));
+	if (lastIndex < firstIndex)
+		return autoSampled();
+
+	if (soundOrLongSound != my d_tiledSound) {
+		my forgetTiles ();
+		my d_tiledSound = soundOrLongSound;
+	}
+	autostring32 signature = Melder_dup (tileSignature (me, kind));
+	for (integer itile = my d_tiles.size; itile >= 1; itile --) {
+		SoundAnalysisTile tile = my d_tiles.at [itile];
+		if (tile -> kind == kind && ! str32equ (tile -> signature.get(), signature.get())) {
+			my d_numberOfTileBytes -= tile -> numberOfBytes;
+			my d_tiles. removeItem (itile);
+		}
+	}
+	my d_tileClock += 1;
+	const integer numberOfTiles = lastIndex - firstIndex + 1;
+	autovector <SoundAnalysisTile> tiles = newvectorzero <SoundAnalysisTile> (numberOfTiles);
+	for (integer itile = 1; itile <= numberOfTiles; itile ++)
+		tiles [itile] = haveTile (me, kind, signature.get(), level, firstIndex + itile - 1,
+				numberOfSamplesPerTile, timeStep, finestTimeStep);
+	removeTilesOverBudget (me);
+
+	/*
+		Skip the frames whose analysis window sticks out of the sound.
+	*/
+	const double t1 = tiles [1] -> analysis -> x1;
+	integer firstFrame = 1, lastFrame = numberOfTiles * numberOfFramesPerTile;
+	while (firstFrame <= lastFrame && t1 + (firstFrame - 1) * timeStep < soundOrLongSound -> xmin + margin)
+		firstFrame ++;
+	while (lastFrame >= firstFrame && t1 + (lastFrame - 1) * timeStep > soundOrLongSound -> xmax - margin)
+		lastFrame --;
+	if (lastFrame < firstFrame)
+		return autoSampled();
+	autoSampled result = newAnalysisLike (tiles [1] -> analysis.get(), my startWindow(), my endWindow(),
+			lastFrame - firstFrame + 1, timeStep, t1 + (firstFrame - 1) * timeStep);
+	for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++)
+		copyAnalysisFrame (tiles [(iframe - 1) / numberOfFramesPerTile + 1] -> analysis.get(),
+				(iframe - 1) % numberOfFramesPerTile + 1, result.get(), iframe - firstFrame + 1);
+	return result;
+}
+
+#pragma mark - SoundAnalysisArea analyses of the window
+
+/*
+	Some tryToCompute<Analysis>() functions.
+	The "try" means that any exceptions that are generated, will be ignored;
+	this is necessary because these functions have to be used in an editor window,
+	where they have to work in the background,
+	because they are not explicly called by a user action.
+
+	Postcondition:
+		- If a tryToCompute<Analysis>() function fails, the <Analysis> should be null;
+		  this is how tryToCompute<Analysis>() signals failure.
+*/
 static void tryToComputeSpectrogram (SoundAnalysisArea me) {
 	autoMelderProgressOff progress;
-	const double margin = ( my instancePref_spectrogram_windowShape() == kSound_to_Spectrogram_windowShape::GAUSSIAN ?
-			my instancePref_spectrogram_windowLength() : 0.5 * my instancePref_spectrogram_windowLength() );
 	try {
-		autoSound sound = extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin);
-		if (! sound)
-			return;
-		my d_spectrogram = Sound_to_Spectrogram_e (sound.get(),
-			my instancePref_spectrogram_windowLength(),
-			my instancePref_spectrogram_viewTo(),
-			(my endWindow() - my startWindow()) / my instancePref_spectrogram_timeSteps(),
-			my instancePref_spectrogram_viewTo() / my instancePref_spectrogram_frequencySteps(),
-			my instancePref_spectrogram_windowShape(), 8.0, 8.0
-		);
-		my d_spectrogram -> xmin = my startWindow();
-		my d_spectrogram -> xmax = my endWindow();
+		my d_spectrogram = computeTiledAnalysis (me, TILE_SPECTROGRAM).static_cast_move <structSpectrogram> ();
 	} catch (MelderError) {
 		my d_spectrogram. reset();   // signal a failure
 		Melder_clearError ();
@@ -160,54 +560,18 @@ static void tryToComputeSpectrogram (SoundAnalysisArea me) {
 }
 static void tryToComputePitch (SoundAnalysisArea me) {
 	autoMelderProgressOff progress;
-	const double margin = ( my dynamic_instancePref_pitch_veryAccurate() ? 3.0 : 1.5 ) / my dynamic_instancePref_pitch_floor();
 	try {
-		autoSound sound = extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin);
-		if (! sound)
-			return;
-		const double pitchTimeStep = (
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
-			0.0   // the default: determined by pitch floor
-		);
-		if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_AUTOCORRELATION)
-			my d_pitch = Sound_to_Pitch_filteredAc (sound.get(),
-				pitchTimeStep, my instancePref_pitch_filteredAC_floor(), my instancePref_pitch_filteredAC_top(),
-				my instancePref_pitch_filteredAC_maximumNumberOfCandidates(), my instancePref_pitch_filteredAC_veryAccurate(),
-				my instancePref_pitch_filteredAC_attenuationAtTop(),
-				my instancePref_pitch_filteredAC_silenceThreshold(), my instancePref_pitch_filteredAC_voicingThreshold(),
-				my instancePref_pitch_filteredAC_octaveCost(), my instancePref_pitch_filteredAC_octaveJumpCost(),
-				my instancePref_pitch_filteredAC_voicedUnvoicedCost()
-			);
-		else if	(my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::RAW_CROSS_CORRELATION)
-			my d_pitch = Sound_to_Pitch_rawCc (sound.get(),
-				pitchTimeStep, my instancePref_pitch_rawCC_floor(), my instancePref_pitch_rawCC_ceiling(),
-				my instancePref_pitch_rawCC_maximumNumberOfCandidates(), my instancePref_pitch_rawCC_veryAccurate(),
-				my instancePref_pitch_rawCC_silenceThreshold(), my instancePref_pitch_rawCC_voicingThreshold(),
-				my instancePref_pitch_rawCC_octaveCost(), my instancePref_pitch_rawCC_octaveJumpCost(),
-				my instancePref_pitch_rawCC_voicedUnvoicedCost()
-			);
-		else if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::RAW_AUTOCORRELATION)
-			my d_pitch = Sound_to_Pitch_rawAc (sound.get(),
-				pitchTimeStep, my instancePref_pitch_rawAC_floor(), my instancePref_pitch_rawAC_ceiling(),
-				my instancePref_pitch_rawAC_maximumNumberOfCandidates(), my instancePref_pitch_rawAC_veryAccurate(),
-				my instancePref_pitch_rawAC_silenceThreshold(), my instancePref_pitch_rawAC_voicingThreshold(),
-				my instancePref_pitch_rawAC_octaveCost(), my instancePref_pitch_rawAC_octaveJumpCost(),
-				my instancePref_pitch_rawAC_voicedUnvoicedCost()
-			);
-		else if (my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::FILTERED_CROSS_CORRELATION)
-			my d_pitch = Sound_to_Pitch_filteredCc (sound.get(), pitchTimeStep,
-				my instancePref_pitch_filteredCC_floor(), my instancePref_pitch_filteredCC_top(),
-				my instancePref_pitch_filteredCC_maximumNumberOfCandidates(), my instancePref_pitch_filteredCC_veryAccurate(),
-				my instancePref_pitch_filteredCC_attenuationAtTop(),
-				my instancePref_pitch_filteredCC_silenceThreshold(), my instancePref_pitch_filteredCC_voicingThreshold(),
-				my instancePref_pitch_filteredCC_octaveCost(), my instancePref_pitch_filteredCC_octaveJumpCost(),
-				my instancePref_pitch_filteredCC_voicedUnvoicedCost()
-			);
-		else
-			Melder_fatal (U"Unknown pitch method ", (int) my instancePref_pitch_method(), U".");
-		my d_pitch -> xmin = my startWindow();
-		my d_pitch -> xmax = my endWindow();
+		if (my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT) {
+			const double margin = pitchMargin (me);
+			autoSound sound = extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin);
+			if (! sound)
+				return;
+			my d_pitch = computePitch (me, sound.get(), (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView());
+			my d_pitch -> xmin = my startWindow();
+			my d_pitch -> xmax = my endWindow();
+		} else {
+			my d_pitch = computeTiledAnalysis (me, TILE_PITCH).static_cast_move <structPitch> ();
+		}
 	} catch (MelderError) {
 		my d_pitch. reset();   // signal a failure
 		Melder_clearError ();
@@ -215,17 +579,8 @@ static void tryToComputePitch (SoundAnalysisArea me) {
 }
 static void tryToComputeIntensity (SoundAnalysisArea me) {
 	autoMelderProgressOff progress;
-	const double margin = 3.2 / my dynamic_instancePref_pitch_floor();
 	try {
-		autoSound sound = extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin);
-		if (! sound)
-			return;
-		my d_intensity = Sound_to_Intensity (sound.get(), my dynamic_instancePref_pitch_floor(),
-			my endWindow() - my startWindow() > my instancePref_longestAnalysis() ? (my endWindow() - my startWindow()) / 100 : 0.0,
-			my instancePref_intensity_subtractMeanPressure()
-		);
-		my d_intensity -> xmin = my startWindow();
-		my d_intensity -> xmax = my endWindow();
+		my d_intensity = computeTiledAnalysis (me, TILE_INTENSITY).static_cast_move <structIntensity> ();
 	} catch (MelderError) {
 		my d_intensity. reset();   // signal a failure
 		Melder_clearError ();
@@ -233,28 +588,18 @@ static void tryToComputeIntensity (SoundAnalysisArea me) {
 }
 static void tryToComputeFormants (SoundAnalysisArea me) {
 	autoMelderProgressOff progress;
-	const double margin = my instancePref_formant_windowLength();
 	try {
-		autoSound sound = ( my endWindow() - my startWindow() > my instancePref_longestAnalysis() ?
-			extractSoundOrNull (me,
-				0.5 * (my startWindow() + my endWindow() - my instancePref_longestAnalysis()) - margin,
-				0.5 * (my startWindow() + my endWindow() + my instancePref_longestAnalysis()) + margin
-			) :
-			extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin)
-		);
-		if (! sound)
-			return;
-		const double formantTimeStep = (
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
-			0.0   // the default: determined by analysis window length
-		);
-		my d_formant = Sound_to_Formant_any (sound.get(), formantTimeStep,
-			Melder_iround (my instancePref_formant_numberOfFormants() * 2.0), my instancePref_formant_ceiling(),
-			my instancePref_formant_windowLength(), (int) my instancePref_formant_method(), my instancePref_formant_preemphasisFrom(), 50.0
-		);
-		my d_formant -> xmin = my startWindow();
-		my d_formant -> xmax = my endWindow();
+		if (my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT) {
+			const double margin = formantMargin (me);
+			autoSound sound = extractSoundOrNull (me, my startWindow() - margin, my endWindow() + margin);
+			if (! sound)
+				return;
+			my d_formant = computeFormants (me, sound.get(), (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView());
+			my d_formant -> xmin = my startWindow();
+			my d_formant -> xmax = my endWindow();
+		} else {
+			my d_formant = computeTiledAnalysis (me, TILE_FORMANTS).static_cast_move <structFormant> ();
+		}
 	} catch (MelderError) {
 		my d_formant. reset();   // signal a failure
 		Melder_clearError ();
@@ -283,21 +628,22 @@ static void tryToComputePulses (SoundAnalysisArea me) {
 	failure is again signalled by the Analysis being null.
 	The "have" means that these functions do nothing if the Analysis already exists,
 	but will (try to) create an Analysis if it does not exist.
+	In a long window, the Analysis is a coarse summary, which is fine for drawing into the editor window only.
 */
 static void tryToHaveSpectrogram (SoundAnalysisArea me) {
-	if (! my d_spectrogram && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+	if (! my d_spectrogram && my canShowAnalysesInWindow ())
 		tryToComputeSpectrogram (me);
 }
 static void tryToHavePitch (SoundAnalysisArea me) {
-	if (! my d_pitch && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+	if (! my d_pitch && my canShowAnalysesInWindow ())
 		tryToComputePitch (me);
 }
 static void tryToHaveIntensity (SoundAnalysisArea me) {
-	if (! my d_intensity && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+	if (! my d_intensity && my canShowAnalysesInWindow ())
 		tryToComputeIntensity (me);
 }
 static void tryToHaveFormants (SoundAnalysisArea me) {
-	if (! my d_formant && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+	if (! my d_formant && my canShowAnalysesInWindow ())
 		tryToComputeFormants (me);
 }
 static void tryToHavePulses (SoundAnalysisArea me) {
@@ -305,6 +651,15 @@ static void tryToHavePulses (SoundAnalysisArea me) {
 		tryToComputePulses (me);
 }
 
+static void checkWindowForQueries (SoundAnalysisArea me) {
+	if (my endWindow() - my startWindow() > my instancePref_longestAnalysis())
+		Melder_throw (U"Window too long to show analyses. "
+			U"Zoom in to at most ", Melder_half (my instancePref_longestAnalysis()), U" seconds "
+			U"or set the \"longest analysis\" to at least ", Melder_half (my endWindow() - my startWindow()),
+			U" seconds (with \"Show analyses\" in the Analysis menu)."
+		);
+}
+
 /*
 	Some SoundAnalysisArea_haveVisible<Analysis>() functions.
 	These add error reporting that is specific to having editor windows,
@@ -315,10 +670,12 @@ static void tryToHavePulses (SoundAnalysisArea me) {
 	because those require the user to be aware of the need to have a visible Analysis.
 	They cannot be used when drawing into the analysis part of the editor window,
 	because of the low degree of explicitness of the need to draw an Analysis there.
+	Because they require the full resolution of the Analysis, they refuse windows longer than the longest analysis.
 */
 void SoundAnalysisArea_haveVisibleSpectrogram (SoundAnalysisArea me) {
 	if (! my instancePref_spectrogram_show())
 		Melder_throw (U"No spectrogram is visible.\nFirst choose \"Show spectrogram\" from the Spectrogram menu.");
+	checkWindowForQueries (me);
 	tryToHaveSpectrogram (me);
 	if (! my d_spectrogram)
 		Melder_throw (U"The spectrogram is not defined at the edge of the sound.");
@@ -326,6 +683,7 @@ void SoundAnalysisArea_haveVisibleSpectrogram (SoundAnalysisArea me) {
 void SoundAnalysisArea_haveVisiblePitch (SoundAnalysisArea me) {
 	if (! my instancePref_pitch_show())
 		Melder_throw (U"No pitch contour is visible.\nFirst choose \"Show pitch\" from the Pitch menu.");
+	checkWindowForQueries (me);
 	tryToHavePitch (me);
 	if (! my d_pitch)
 		Melder_throw (U"The pitch contour is not defined at the edge of the sound.");
@@ -333,6 +691,7 @@ void SoundAnalysisArea_haveVisiblePitch (SoundAnalysisArea me) {
 void SoundAnalysisArea_haveVisibleIntensity (SoundAnalysisArea me) {
 	if (! my instancePref_intensity_show())
 		Melder_throw (U"No intensity contour is visible.\nFirst choose \"Show intensity\" from the Intensity menu.");
+	checkWindowForQueries (me);
 	tryToHaveIntensity (me);
 	if (! my d_intensity)
 		Melder_throw (U"The intensity curve is not defined at the edge of the sound.");
@@ -340,6 +699,7 @@ void SoundAnalysisArea_haveVisibleIntensity (SoundAnalysisArea me) {
 void SoundAnalysisArea_haveVisibleFormants (SoundAnalysisArea me) {
 	if (! my instancePref_formant_show())
 		Melder_throw (U"No formant contour is visible.\nFirst choose \"Show formants\" from the Formants menu.");
+	checkWindowForQueries (me);
 	tryToHaveFormants (me);
 	if (! my d_formant)
 		Melder_throw (U"The formants are not defined at the edge of the sound.");
@@ -347,6 +707,7 @@ void SoundAnalysisArea_haveVisibleFormants (SoundAnalysisArea me) {
 void SoundAnalysisArea_haveVisiblePulses (SoundAnalysisArea me) {
 	if (! my instancePref_pulses_show())
 		Melder_throw (U"No pulses are visible.\nFirst choose \"Show pulses\" from the Pulses menu.");
+	checkWindowForQueries (me);
 	tryToHavePulses (me);
 	if (! my d_pulses)
 		Melder_throw (U"The pulses are not defined at the edge of the sound.");
@@ -705,12 +1066,7 @@ static const conststring32 SoundAnalysisArea_partString_locative (int part) {
 }
 
 static int makeQueriable (SoundAnalysisArea me, bool allowCursor, double *tmin, double *tmax) {
-	if (my endWindow() - my startWindow() > my instancePref_longestAnalysis())
-		Melder_throw (U"Window too long to show analyses. "
-			U"Zoom in to at most ", Melder_half (my instancePref_longestAnalysis()), U" seconds "
-			U"or set the \"longest analysis\" to at least ", Melder_half (my endWindow() - my startWindow()),
-			U" seconds (with \"Show analyses\" in the Analysis menu)."
-		);
+	checkWindowForQueries (me);
 	if (my startSelection() == my endSelection()) {
 		if (allowCursor) {
 			*tmin = *tmax = my startSelection();
@@ -2556,7 +2912,7 @@ static void SoundAnalysisArea_v_draw_analysis (SoundAnalysisArea me) {
 	const double pitchViewFrom_hidden = ( verticalScaleIsLogarithmic ? log10 (pitchViewFrom_overt) : pitchViewFrom_overt );
 	const double pitchViewTo_hidden = ( verticalScaleIsLogarithmic ? log10 (pitchViewTo_overt) : pitchViewTo_overt );
 
-	if (my endWindow() - my startWindow() > my instancePref_longestAnalysis()) {
+	if (! my canShowAnalysesInWindow ()) {
 		Graphics_setWindow (my graphics(), 0.0, 1.0, 0.0, 1.0);
 		Graphics_setFont (my graphics(), kGraphics_font::HELVETICA);
 		Graphics_setFontSize (my graphics(), 10);
@@ -2580,12 +2936,7 @@ static void SoundAnalysisArea_v_draw_analysis (SoundAnalysisArea me) {
 		tryToHavePitch (me);
 	if (my instancePref_pitch_show() && my d_pitch) {
 		const double greatestNonUndersamplingTimeStep = 0.5 * periodsPerAnalysisWindow (me) / my dynamic_instancePref_pitch_floor();
-		const double defaultTimeStep = 0.5 * greatestNonUndersamplingTimeStep;
-		const double timeStep = (
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
-			defaultTimeStep
-		);
+		const double timeStep = my d_pitch -> dx;   // coarser than the time step setting if the window is long
 		const bool undersampled = ( timeStep > greatestNonUndersamplingTimeStep );
 		const integer numberOfVisiblePitchPoints = (integer) ((my endWindow() - my startWindow()) / timeStep);   // BUG: why round down?
 		Graphics_setColour (my graphics(), Melder_CYAN);
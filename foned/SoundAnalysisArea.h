@@ -2,7 +2,7 @@
 #define _SoundAnalysisArea_h_
 /* SoundAnalysisArea.h
  *
- * Copyright (C) 1992-2005,2007-2024 Paul Boersma
+ * Copyright (C) 1992-2005,2007-2024,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -28,6 +28,20 @@
 
 #include "SoundAnalysisArea_enums.h"
 
+/*
+	A stretch of a spectrogram, pitch, intensity or formant analysis,
+	computed on a fixed time grid, so that it can be reused when the window moves.
+	Level 0 has the finest time step; each higher level has twice the time step of the level below.
+*/
+Thing_define (SoundAnalysisTile, Thing) {
+	int kind;
+	autostring32 signature;   // the analysis settings that the tile was computed with
+	integer level, index;
+	autoSampled analysis;
+	integer numberOfBytes;
+	integer lastUse;
+};
+
 Thing_define (SoundAnalysisArea, FunctionArea) {
 	SampledXY soundOrLongSound() const { return static_cast <SampledXY> (our function()); }
 	Sound sound() const {
@@ -43,6 +57,14 @@ Thing_define (SoundAnalysisArea, FunctionArea) {
 	autoIntensity d_intensity;
 	autoFormant d_formant;
 	autoPointProcess d_pulses;
+	OrderedOf <structSoundAnalysisTile> d_tiles;
+	SampledXY d_tiledSound;   // the sound or long sound that the tiles were computed from
+	integer d_numberOfTileBytes, d_tileClock;
+	void forgetTiles () {
+		our d_tiles. removeAllItems ();
+		our d_tiledSound = nullptr;
+		our d_numberOfTileBytes = 0;
+	}
 	GuiMenuItem spectrogramToggle, pitchToggle, intensityToggle, formantToggle, pulsesToggle;
 	GuiMenuItem pitchFilteredAutocorrelationToggle, pitchRawCrossCorrelationToggle, pitchRawAutocorrelationToggle,
 			pitchFilteredCrossCorrelationToggle;
@@ -61,6 +83,17 @@ Thing_define (SoundAnalysisArea, FunctionArea) {
 	virtual void v_pulsesInfo      () const;
 
 protected:
+	/*
+		The analysis tiles depend on the sound only, so they survive changes in other data,
+		such as the TextGrid in a TextGridEditor, which shows a private copy of the sound.
+		If the sound is the edited data itself, any change may be a change in the samples.
+		A replaced sound is detected when the tiles are used (see computeTiledAnalysis).
+	*/
+	void v_invalidateAllDerivedDataCaches () override {
+		if (our data() == our functionEditor() -> data())
+			our forgetTiles ();
+		SoundAnalysisArea_Parent :: v_invalidateAllDerivedDataCaches ();
+	}
 	void v_computeAuxiliaryData () override {
 		our v_reset_analysis ();
 	}
@@ -73,6 +106,15 @@ public:
 		return our instancePref_spectrogram_show() || our instancePref_pitch_show() ||
 				our instancePref_intensity_show() || our instancePref_formant_show();
 	}
+	/*
+		With a view-dependent time step, the analyses are computed for the window as a whole,
+		so that they are not shown in long windows;
+		otherwise, long windows are served from coarser analysis tiles.
+	*/
+	bool canShowAnalysesInWindow () {
+		return our endWindow() - our startWindow() <= our instancePref_longestAnalysis() ||
+				our instancePref_timeStepStrategy() != kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT;
+	}
 	bool hasPulsesToShow () {
 		return our instancePref_pulses_show() && our endWindow() - our startWindow() <= our instancePref_longestAnalysis() && our d_pulses;
 	}
@@ -102,6 +144,9 @@ public:
 	integer dynamic_instancePref_pitch_maximumNumberOfCandidates ();
 	double dynamic_instancePref_pitch_silenceThreshold ();
 	double dynamic_instancePref_pitch_voicingThreshold ();
+	double dynamic_instancePref_pitch_octaveCost ();
+	double dynamic_instancePref_pitch_octaveJumpCost ();
+	double dynamic_instancePref_pitch_voicedUnvoicedCost ();
 
 	void v9_repairPreferences () override;
 };
@@ -117,7 +162,7 @@ void SoundAnalysisArea_haveVisiblePulses (SoundAnalysisArea me);
 bool SoundAnalysisArea_mouse (SoundAnalysisArea me, GuiDrawingArea_MouseEvent event, double x_world, double y_fraction);
 
 inline void SoundAnalysisArea_drawDefaultLegends (SoundAnalysisArea me) {
-	if (my hasContentToShow () && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+	if (my hasContentToShow () && my canShowAnalysesInWindow ())
 		FunctionArea_drawLegend (me,
 			my instancePref_spectrogram_show() ? FunctionArea_legend_GREYS U" %%derived spectrogram" : U"", 1.2 * Melder_BLACK,
 			my instancePref_formant_show()     ? FunctionArea_legend_SPECKLES U" %%derived formants"    : U"", 1.2 * Melder_RED,
@@ -59,22 +59,86 @@ void structSoundArea :: v_drawInside () {
 	SoundArea_draw (this);
 }
 
+static void SoundArea_getChannelExtrema (SoundArea me, const integer first, const integer last, const integer channel,
+	const constMAT& envelopeMinima, const constMAT& envelopeMaxima, double *out_minimum, double *out_maximum)
+{
+	if (envelopeMinima.nrow > 0) {
+		*out_minimum = NUMmin_u (envelopeMinima.row (channel));
+		*out_maximum = NUMmax_u (envelopeMaxima.row (channel));
+	} else if (my longSound())
+		LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), channel, out_minimum, out_maximum);
+	else
+		Matrix_getWindowExtrema (my sound(), first, last, channel, channel, out_minimum, out_maximum);
+}
+
+static void SoundArea_drawEnvelope (SoundArea me, const constVEC& minima, const constVEC& maxima, const constVEC& rootMeanSquares) {
+	const integer numberOfColumns = minima.size;
+	const double columnWidth = (my endWindow() - my startWindow()) / numberOfColumns;
+	autoVEC x = raw_VEC (2 * numberOfColumns), y = raw_VEC (2 * numberOfColumns);
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+		const double xmid = my startWindow() + (icolumn - 0.5) * columnWidth;
+		const bool downwards = ( icolumn % 2 == 0 );   // zigzag, so that the connecting lines stay within the envelope
+		x [2 * icolumn - 1] = x [2 * icolumn] = xmid;
+		y [2 * icolumn - 1] = ( downwards ? maxima [icolumn] : minima [icolumn] );
+		y [2 * icolumn] = ( downwards ? minima [icolumn] : maxima [icolumn] );
+	}
+	Graphics_polyline (my graphics(), x.size, & x [1], & y [1]);
+	/*
+		The root-mean-square values, as a band around zero.
+	*/
+	Graphics_setColour (my graphics(), Melder_SILVER);
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++)
+		y [icolumn] = rootMeanSquares [icolumn];
+	Graphics_polyline (my graphics(), numberOfColumns, & x [1], & y [1]);
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++)
+		y [icolumn] = - rootMeanSquares [icolumn];
+	Graphics_polyline (my graphics(), numberOfColumns, & x [1], & y [1]);
+	Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
+}
+
 void SoundArea_draw (SoundArea me) {
 	Melder_assert (!! my sound() != !! my longSound());
 
+	const integer numberOfChannels = my soundOrLongSound() -> ny;
+	const integer numberOfVisibleChannels = Melder_clippedRight (numberOfChannels, 8_integer);
+	const integer firstVisibleChannel = my channelOffset + 1;
+	const integer lastVisibleChannel = Melder_clippedRight (my channelOffset + numberOfVisibleChannels, numberOfChannels);
+
+	/*
+		A LongSound window that is long, or that has many more samples than there are pixel columns,
+		is drawn as an envelope that comes from the summary of the sound file, not from the samples themselves;
+		this keeps the drawing time proportional to the width of the window on the screen.
+	*/
+	autoMAT envelopeMinima, envelopeMaxima, envelopeRootMeanSquares;
 	if (my longSound()) {
+		Graphics_setWindow (my graphics(), my startWindow(), my endWindow(), 0.0, 1.0);
+		const integer numberOfColumns = Melder_clippedLeft (1_integer, Melder_iround (
+				Graphics_dxWCtoMM (my graphics(), my endWindow() - my startWindow()) * Graphics_getResolution (my graphics()) / 25.4));
+		integer first, last;
+		const integer numberOfSamples = Sampled_getWindowSamples (my longSound(), my startWindow(), my endWindow(), & first, & last);
+		const bool envelopeIsPreferable = ( my endWindow() - my startWindow() > my longSound() -> bufferLength ||
+				numberOfSamples >= 2 * LongSound_SUMMARY_BLOCK_SIZE * numberOfColumns );
 		try {
-			LongSound_haveWindow (my longSound(), my startWindow(), my endWindow());
+			if (envelopeIsPreferable) {
+				envelopeMinima = zero_MAT (numberOfChannels, numberOfColumns);
+				envelopeMaxima = zero_MAT (numberOfChannels, numberOfColumns);
+				envelopeRootMeanSquares = zero_MAT (numberOfChannels, numberOfColumns);
+				for (integer ichan = firstVisibleChannel; ichan <= lastVisibleChannel; ichan ++)
+					LongSound_getWindowEnvelope (my longSound(), my startWindow(), my endWindow(), ichan,
+						envelopeMinima.row (ichan), envelopeMaxima.row (ichan), envelopeRootMeanSquares.row (ichan));
+			} else
+				LongSound_haveWindow (my longSound(), my startWindow(), my endWindow());
 		} catch (MelderError) {
+			envelopeMinima = autoMAT ();
 			Melder_clearError ();
 		}
 	}
 
-	const integer numberOfChannels = my soundOrLongSound() -> ny;
 	const bool cursorVisible = ( my startSelection() == my endSelection() &&
 			my startSelection() >= my startWindow() && my startSelection() <= my endWindow() );
 	Graphics_setColour (my graphics(), Melder_BLACK);
-	if (my longSound() && my endWindow() - my startWindow() > my longSound() -> bufferLength) {
+	const bool drawEnvelope = ( envelopeMinima.nrow > 0 );
+	if (my longSound() && ! drawEnvelope && my endWindow() - my startWindow() > my longSound() -> bufferLength) {
 		Graphics_setWindow (my graphics(), 0.0, 1.0, 0.0, 1.0);
 		Graphics_setColour (my graphics(), Melder_BLACK);
 		Graphics_setTextAlignment (my graphics(), Graphics_CENTRE, Graphics_BOTTOM);
@@ -86,7 +150,7 @@ void SoundArea_draw (SoundArea me) {
 	}
 	bool fits;
 	try {
-		fits = ( my sound() ? true : LongSound_haveWindow (my longSound(), my startWindow(), my endWindow()) );
+		fits = ( my sound() || drawEnvelope ? true : LongSound_haveWindow (my longSound(), my startWindow(), my endWindow()) );
 	} catch (MelderError) {
 		const bool outOfMemory = !! str32str (Melder_getError (), U"memory");
 		if (Melder_debug == 9)
@@ -113,24 +177,14 @@ void SoundArea_draw (SoundArea me) {
 		Graphics_text (my graphics(), 0.5, 0.5, U"(zoom out to see the data)");
 		return;
 	}
-	const integer numberOfVisibleChannels = Melder_clippedRight (numberOfChannels, 8_integer);
-	const integer firstVisibleChannel = my channelOffset + 1;
-	const integer lastVisibleChannel = Melder_clippedRight (my channelOffset + numberOfVisibleChannels, numberOfChannels);
 	double maximumExtent = 0.0, visibleMinimum = 0.0, visibleMaximum = 0.0;
 	if (my instancePref_scalingStrategy() == kSoundArea_scalingStrategy::BY_WINDOW) {
-		if (my longSound())
-			LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), firstVisibleChannel,
-					& visibleMinimum, & visibleMaximum);
-		else
-			Matrix_getWindowExtrema (my sound(), first, last, firstVisibleChannel, firstVisibleChannel,
-					& visibleMinimum, & visibleMaximum);
+		SoundArea_getChannelExtrema (me, first, last, firstVisibleChannel, envelopeMinima.get(), envelopeMaxima.get(),
+				& visibleMinimum, & visibleMaximum);
 		for (integer ichan = firstVisibleChannel + 1; ichan <= lastVisibleChannel; ichan ++) {
 			double visibleChannelMinimum, visibleChannelMaximum;
-			if (my longSound())
-				LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), ichan,
-						& visibleChannelMinimum, & visibleChannelMaximum);
-			else
-				Matrix_getWindowExtrema (my sound(), first, last, ichan, ichan, & visibleChannelMinimum, & visibleChannelMaximum);
+			SoundArea_getChannelExtrema (me, first, last, ichan, envelopeMinima.get(), envelopeMaxima.get(),
+					& visibleChannelMinimum, & visibleChannelMaximum);
 			if (visibleChannelMinimum < visibleMinimum)
 				visibleMinimum = visibleChannelMinimum;
 			if (visibleChannelMaximum > visibleMaximum)
@@ -150,10 +204,7 @@ void SoundArea_draw (SoundArea me) {
 			my getGlobalExtrema (& minimum, & maximum);
 		} else if (my instancePref_scalingStrategy() == kSoundArea_scalingStrategy::BY_WINDOW) {
 			if (numberOfChannels > 2) {
-				if (my longSound())
-					LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), ichan, & minimum, & maximum);
-				else
-					Matrix_getWindowExtrema (my sound(), first, last, ichan, ichan, & minimum, & maximum);
+				SoundArea_getChannelExtrema (me, first, last, ichan, envelopeMinima.get(), envelopeMaxima.get(), & minimum, & maximum);
 				if (maximumExtent > 0.0) {
 					const double middle = 0.5 * (minimum + maximum);
 					minimum = middle - 0.5 * maximumExtent;
@@ -164,15 +215,9 @@ void SoundArea_draw (SoundArea me) {
 				maximum = visibleMaximum;
 			}
 		} else if (my instancePref_scalingStrategy() == kSoundArea_scalingStrategy::BY_WINDOW_AND_CHANNEL) {
-			if (my longSound())
-				LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), ichan, & minimum, & maximum);
-			else
-				Matrix_getWindowExtrema (my sound(), first, last, ichan, ichan, & minimum, & maximum);
+			SoundArea_getChannelExtrema (me, first, last, ichan, envelopeMinima.get(), envelopeMaxima.get(), & minimum, & maximum);
 		} else if (my instancePref_scalingStrategy() == kSoundArea_scalingStrategy::FIXED_HEIGHT) {
-			if (my longSound())
-				LongSound_getWindowExtrema (my longSound(), my startWindow(), my endWindow(), ichan, & minimum, & maximum);
-			else
-				Matrix_getWindowExtrema (my sound(), first, last, ichan, ichan, & minimum, & maximum);
+			SoundArea_getChannelExtrema (me, first, last, ichan, envelopeMinima.get(), envelopeMaxima.get(), & minimum, & maximum);
 			const double channelExtent = my instancePref_scaling_height();
 			const double middle = 0.5 * (minimum + maximum);
 			minimum = middle - 0.5 * channelExtent;
@@ -250,6 +295,10 @@ void SoundArea_draw (SoundArea me) {
 			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
 			Graphics_function (my graphics(), & my sound() -> z [ichan] [0], first, last,
 					Sampled_indexToX (my sound(), first), Sampled_indexToX (my sound(), last));
+		} else if (drawEnvelope) {
+			Graphics_setWindow (my graphics(), my startWindow(), my endWindow(), minimum, maximum);
+			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
+			SoundArea_drawEnvelope (me, envelopeMinima.row (ichan), envelopeMaxima.row (ichan), envelopeRootMeanSquares.row (ichan));
 		} else {
 			Graphics_setWindow (my graphics(), my startWindow(), my endWindow(), minimum * 32768, maximum * 32768);
 			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
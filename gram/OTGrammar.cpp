@@ -1106,6 +1106,294 @@ autoDistributions OTGrammar_to_Distribution (OTGrammar me, integer trialsPerInpu
 	}
 }
 
+/*
+	Simulation of many independent evaluations.
+
+	The violation marks of all candidates are copied into one contiguous integer matrix,
+	one row per candidate, the candidates of all tableaus following each other.
+	Every thread draws its own noisy rankings into its own OTGrammar_Evaluator,
+	so that the grammar itself is not changed during evaluation;
+	for a single thread, the random numbers are drawn in the same order as by
+	OTGrammar_newDisharmonies() and OTGrammar_getWinner(), so that the results are the same.
+*/
+struct OTGrammar_Violations {
+	integer numberOfConstraints, numberOfTableaus;
+	autoINTVEC candidateOffset;   // the candidates of tableau `itab` are in rows candidateOffset [itab] + 1 through candidateOffset [itab + 1]
+	autoINTMAT marks;
+	autoINTVEC canonicalCandidate;   // the first candidate in the same tableau with the same output (as a number within the tableau)
+	void init (constOTGrammar grammar) {
+		our numberOfConstraints = grammar -> numberOfConstraints;
+		our numberOfTableaus = grammar -> numberOfTableaus;
+		our candidateOffset = zero_INTVEC (numberOfTableaus + 1);
+		for (integer itab = 1; itab <= numberOfTableaus; itab ++)
+			our candidateOffset [itab + 1] = our candidateOffset [itab] + grammar -> tableaus [itab]. numberOfCandidates;
+		const integer totalNumberOfCandidates = our candidateOffset [numberOfTableaus + 1];
+		our marks = zero_INTMAT (totalNumberOfCandidates, numberOfConstraints);
+		our canonicalCandidate = zero_INTVEC (totalNumberOfCandidates);
+		for (integer itab = 1; itab <= numberOfTableaus; itab ++) {
+			const constOTGrammarTableau tableau = & grammar -> tableaus [itab];
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				const integer row = our candidateOffset [itab] + icand;
+				our marks.row (row) <<= tableau -> candidates [icand]. marks.all();
+				integer jcand = 1;
+				while (! str32equ (tableau -> candidates [jcand]. output.get(), tableau -> candidates [icand]. output.get()))
+					jcand ++;
+				our canonicalCandidate [row] = jcand;
+			}
+		}
+	}
+	integer numberOfCandidates (integer itab) const {
+		return our candidateOffset [itab + 1] - our candidateOffset [itab];
+	}
+	bool isAdultOutput (integer itab, integer icand, integer iadultCandidate) const {
+		return iadultCandidate != 0 && our canonicalCandidate [our candidateOffset [itab] + icand] == iadultCandidate;
+	}
+};
+
+struct OTGrammar_Evaluator {
+	const OTGrammar_Violations *violations;
+	kOTGrammar_decisionStrategy decisionStrategy;
+	autoVEC disharmony;   // per constraint
+	autoINTVEC index;   // constraint numbers sorted by decreasing disharmony (OPTIMALITY_THEORY only)
+	autoBOOLVEC tiedToTheRight;   // per position in `index`
+	autoVEC weight;   // per constraint, the effective weight for the harmonic decision strategies
+	autoVEC harmony, probability;   // per candidate
+	void init (const OTGrammar_Violations *violationsArg, kOTGrammar_decisionStrategy decisionStrategyArg) {
+		our violations = violationsArg;
+		our decisionStrategy = decisionStrategyArg;
+		const integer numberOfConstraints = violations -> numberOfConstraints;
+		our disharmony = zero_VEC (numberOfConstraints);
+		our index = to_INTVEC (numberOfConstraints);
+		our tiedToTheRight = zero_BOOLVEC (numberOfConstraints);
+		our weight = zero_VEC (numberOfConstraints);
+		integer maximumNumberOfCandidates = 0;
+		for (integer itab = 1; itab <= violations -> numberOfTableaus; itab ++)
+			maximumNumberOfCandidates = std::max (maximumNumberOfCandidates, violations -> numberOfCandidates (itab));
+		our harmony = zero_VEC (maximumNumberOfCandidates);
+		our probability = zero_VEC (maximumNumberOfCandidates);
+	}
+	void newDisharmonies (constOTGrammar grammar, double spreading) {
+		const integer numberOfConstraints = violations -> numberOfConstraints;
+		for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+			our disharmony [icons] = grammar -> constraints [icons]. ranking + NUMrandomGauss (0, spreading);
+		switch (our decisionStrategy) {
+			case kOTGrammar_decisionStrategy::OPTIMALITY_THEORY: {
+				/*
+					The order of tied constraints does not matter, because they count as one.
+				*/
+				std::sort (our index.begin(), our index.end(),
+					[this] (integer icons, integer jcons) { return our disharmony [icons] > our disharmony [jcons]; }
+				);
+				for (integer i = 1; i <= numberOfConstraints; i ++)
+					our tiedToTheRight [i] = ( i < numberOfConstraints &&
+							our disharmony [our index [i + 1]] == our disharmony [our index [i]] );
+			} break;
+			case kOTGrammar_decisionStrategy::HARMONIC_GRAMMAR:
+			case kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY: {
+				our weight.all()  <<=  our disharmony.all();
+			} break;
+			case kOTGrammar_decisionStrategy::EXPONENTIAL_HG:
+			case kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY: {
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					our weight [icons] = exp (our disharmony [icons]);
+			} break;
+			case kOTGrammar_decisionStrategy::LINEAR_OT: {
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					our weight [icons] = ( our disharmony [icons] > 0.0 ? our disharmony [icons] : 0.0 );
+			} break;
+			case kOTGrammar_decisionStrategy::POSITIVE_HG: {
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					our weight [icons] = std::max (our disharmony [icons], 1.0);
+			} break;
+			default: Melder_fatal (U"OTGrammar_Evaluator: unimplemented decision strategy.");
+		}
+	}
+	int compareCandidates_ot (constINTVEC const& marks1, constINTVEC const& marks2) const {
+		const integer numberOfConstraints = violations -> numberOfConstraints;
+		for (integer i = 1; i <= numberOfConstraints; i ++) {
+			integer numberOfMarks1 = marks1 [our index [i]];
+			integer numberOfMarks2 = marks2 [our index [i]];
+			while (our tiedToTheRight [i]) {
+				i ++;
+				numberOfMarks1 += marks1 [our index [i]];
+				numberOfMarks2 += marks2 [our index [i]];
+			}
+			if (numberOfMarks1 < numberOfMarks2)
+				return -1;
+			if (numberOfMarks1 > numberOfMarks2)
+				return +1;
+		}
+		return 0;
+	}
+	integer getWinner (integer itab) {
+		const integer offset = violations -> candidateOffset [itab];
+		const integer numberOfCandidates = violations -> numberOfCandidates (itab);
+		const integer numberOfConstraints = violations -> numberOfConstraints;
+		integer icand_best = 1;
+		if (our decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
+			our decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
+		{
+			double maximumHarmony = 0.0;
+			for (integer icand = 1; icand <= numberOfCandidates; icand ++) {
+				constINTVEC marks = violations -> marks.row (offset + icand);
+				longdouble candidateDisharmony = 0.0;
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					candidateDisharmony += our weight [icons] * marks [icons];
+				our harmony [icand] = - (double) candidateDisharmony;
+				if (icand == 1 || our harmony [icand] > maximumHarmony)
+					maximumHarmony = our harmony [icand];
+			}
+			longdouble sumOfProbabilities = 0.0;
+			for (integer icand = 1; icand <= numberOfCandidates; icand ++) {
+				our probability [icand] = exp (our harmony [icand] - maximumHarmony);
+				sumOfProbabilities += our probability [icand];
+			}
+			for (integer icand = 1; icand <= numberOfCandidates; icand ++)
+				our probability [icand] /= double (sumOfProbabilities);
+			const double cutOff = NUMrandomUniform (0.0, 1.0);
+			longdouble cumulativeProbability = 0.0;
+			for (integer icand = 1; icand <= numberOfCandidates; icand ++) {
+				cumulativeProbability += our probability [icand];
+				if (cumulativeProbability > cutOff) {
+					icand_best = icand;
+					break;
+				}
+			}
+			return icand_best;
+		}
+		if (our decisionStrategy != kOTGrammar_decisionStrategy::OPTIMALITY_THEORY) {
+			for (integer icand = 1; icand <= numberOfCandidates; icand ++) {
+				constINTVEC marks = violations -> marks.row (offset + icand);
+				double candidateDisharmony = 0.0;
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					candidateDisharmony += our weight [icons] * marks [icons];
+				our harmony [icand] = candidateDisharmony;   // actually the disharmony
+			}
+		}
+		integer numberOfBestCandidates = 1;
+		for (integer icand = 2; icand <= numberOfCandidates; icand ++) {
+			int comparison;
+			if (our decisionStrategy == kOTGrammar_decisionStrategy::OPTIMALITY_THEORY)
+				comparison = compareCandidates_ot (violations -> marks.row (offset + icand), violations -> marks.row (offset + icand_best));
+			else
+				comparison = ( our harmony [icand] < our harmony [icand_best] ? -1 : our harmony [icand] > our harmony [icand_best] ? +1 : 0 );
+			if (comparison == -1) {
+				icand_best = icand;
+				numberOfBestCandidates = 1;
+			} else if (comparison == 0) {
+				numberOfBestCandidates += 1;
+				if (Melder_debug == 41) {
+					;   // keep first
+				} else if (Melder_debug == 42) {
+					icand_best = icand;   // take last
+				} else if (NUMrandomUniform (0.0, numberOfBestCandidates) < 1.0) {
+					icand_best = icand;
+				}
+			}
+		}
+		return icand_best;
+	}
+};
+
+/*
+	Draws pairs from a PairDistribution with the same random numbers as PairDistribution_peekPair(),
+	but with a binary search in the cumulative weights.
+*/
+struct PairDistribution_Sampler {
+	autovector <longdouble> cumulativeWeight;
+	longdouble total;
+	void init (PairDistribution distribution) {
+		const integer numberOfPairs = distribution -> pairs.size;
+		Melder_require (numberOfPairs >= 1,
+			distribution, U": no candidates.");
+		our cumulativeWeight = newvectorraw <longdouble> (numberOfPairs);
+		longdouble sum = 0.0;
+		for (integer ipair = 1; ipair <= numberOfPairs; ipair ++) {
+			const PairProbability pair = distribution -> pairs.at [ipair];
+			Melder_require (pair -> string1 && pair -> string2,
+				distribution, U": no string in probability pair ", ipair, U".");
+			sum += pair -> weight;
+			our cumulativeWeight [ipair] = sum;
+		}
+		our total = sum;
+	}
+	integer peek () const {
+		for (;;) {
+			const double rand = NUMrandomUniform (0.0, double (our total));
+			/*
+				Find the first pair whose cumulative weight is not less than `rand`.
+			*/
+			const longdouble *first = & our cumulativeWeight [1], *last = first + our cumulativeWeight.size;
+			const longdouble *found = std::lower_bound (first, last, (longdouble) rand);
+			if (found != last)
+				return 1 + (found - first);
+			/* else guard against rounding errors */
+		}
+	}
+};
+
+static autoINTVEC PairDistribution_getTableauNumbers (PairDistribution me, constOTGrammar grammar) {
+	autoINTVEC result = zero_INTVEC (my pairs.size);
+	for (integer ipair = 1; ipair <= my pairs.size; ipair ++) {
+		const conststring32 input = my pairs.at [ipair] -> string1.get();
+		for (integer itab = 1; itab <= grammar -> numberOfTableaus; itab ++)
+			if (str32equ (grammar -> tableaus [itab]. input.get(), input)) {
+				result [ipair] = itab;
+				break;
+			}
+		if (result [ipair] == 0 && my pairs.at [ipair] -> weight > 0.0)
+			Melder_throw (U"Input \"", input, U"\" not in list of tableaus.");
+	}
+	return result;
+}
+
+/*
+	For every pair, the first candidate in the pair's tableau that has the pair's output, or 0 if there is none.
+*/
+static autoINTVEC PairDistribution_getAdultCandidates (PairDistribution me, constOTGrammar grammar, constINTVEC const& tableauNumbers) {
+	autoINTVEC result = zero_INTVEC (my pairs.size);
+	for (integer ipair = 1; ipair <= my pairs.size; ipair ++) {
+		if (tableauNumbers [ipair] == 0)
+			continue;
+		const constOTGrammarTableau tableau = & grammar -> tableaus [tableauNumbers [ipair]];
+		for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++)
+			if (str32equ (tableau -> candidates [icand]. output.get(), my pairs.at [ipair] -> string2.get())) {
+				result [ipair] = icand;
+				break;
+			}
+	}
+	return result;
+}
+
+static integer OTGrammar_thresholdNumberOfTrialsPerThread (OTGrammar_Violations const& violations) {
+	const integer numberOfMarksPerTableau = violations.marks.nrow * violations.marks.ncol / std::max (1_integer, violations.numberOfTableaus);
+	return std::max (1_integer, 100000 / std::max (1_integer, numberOfMarksPerTableau));
+}
+
+/*
+	Serial; to be called from within a thread, with the thread's own evaluator.
+*/
+static integer OTGrammar_countCorrect (constOTGrammar me, OTGrammar_Evaluator & evaluator,
+	PairDistribution_Sampler const& sampler, PairDistribution distribution,
+	constINTVEC const& tableauNumbers, constINTVEC const& adultCandidates,
+	double evaluationNoise, integer numberOfInputs, std::atomic <bool> const& errorFlag)
+{
+	integer numberOfCorrect = 0;
+	for (integer ireplication = 1; ireplication <= numberOfInputs; ireplication ++) {
+		if (errorFlag)
+			return 0;
+		const integer ipair = sampler.peek ();
+		evaluator.newDisharmonies (me, evaluationNoise);
+		const integer itab = tableauNumbers [ipair];
+		if (itab == 0)
+			Melder_throw (U"Input \"", distribution -> pairs.at [ipair] -> string1.get(), U"\" not in list of tableaus.");
+		const integer ilearnerCandidate = evaluator.getWinner (itab);
+		if (evaluator.violations -> isAdultOutput (itab, ilearnerCandidate, adultCandidates [ipair]))
+			numberOfCorrect ++;
+	}
+	return numberOfCorrect;
+}
+
 autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trialsPerInput, double noise) {
 	try {
 		integer nout = 0;
@@ -1113,6 +1401,11 @@ autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trials
 			Create the distribution. One row for every output form.
 		*/
 		autoPairDistribution thee = PairDistribution_create ();
+		OTGrammar_Violations violations;
+		violations.init (me);
+		const integer thresholdNumberOfTrialsPerThread = OTGrammar_thresholdNumberOfTrialsPerThread (violations);
+		const integer maximumNumberOfThreads = std::max (1_integer,
+				MelderThread_computeNumberOfThreads (trialsPerInput, thresholdNumberOfTrialsPerThread));
 		/*
 			Measure every input form.
 		*/
@@ -1128,11 +1421,36 @@ autoPairDistribution OTGrammar_to_PairDistribution (OTGrammar me, integer trials
 			}
 			/*
 				Compute a number of outputs and store the results.
+				Every thread counts the wins of its own trials.
 			*/
-			for (integer itrial = 1; itrial <= trialsPerInput; itrial ++) {
-				OTGrammar_newDisharmonies (me, noise);
-				integer iwinner = OTGrammar_getWinner (me, itab);
-				thy pairs.at [nout + iwinner] -> weight += 1.0;
+			autoINTMAT numberOfWins = zero_INTMAT (maximumNumberOfThreads, tableau -> numberOfCandidates);
+			if (trialsPerInput > 0) {
+				std::atomic <bool> errorFlag = false;
+				MelderThread_run (& errorFlag, trialsPerInput, thresholdNumberOfTrialsPerThread,
+					[&] (integer threadNumber, integer firstTrial, integer lastTrial) {
+						try {
+							NUMrandom_setChannel (threadNumber);
+							OTGrammar_Evaluator evaluator;
+							evaluator.init (& violations, my decisionStrategy);
+							INTVEC wins = numberOfWins.row (threadNumber + 1);
+							for (integer itrial = firstTrial; itrial <= lastTrial; itrial ++) {
+								if (errorFlag)
+									return;
+								evaluator.newDisharmonies (me, noise);
+								wins [evaluator.getWinner (itab)] += 1;
+							}
+						} catch (MelderError) {
+							errorFlag = true;
+							return;
+						}
+					}
+				);
+			}
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				integer numberOfWinsOfCandidate = 0;
+				for (integer ithread = 1; ithread <= maximumNumberOfThreads; ithread ++)
+					numberOfWinsOfCandidate += numberOfWins [ithread] [icand];
+				thy pairs.at [nout + icand] -> weight = (double) numberOfWinsOfCandidate;
 			}
 			/*
 				Update the offset.
@@ -2328,18 +2646,36 @@ double OTGrammar_PairDistribution_getFractionCorrect (OTGrammar me, PairDistribu
 	double evaluationNoise, integer numberOfInputs)
 {
 	try {
-		integer numberOfCorrect = 0;
-		for (integer ireplication = 1; ireplication <= numberOfInputs; ireplication ++) {
-			conststring32 input, adultOutput;
-			PairDistribution_peekPair (thee, & input, & adultOutput);
-			OTGrammar_newDisharmonies (me, evaluationNoise);
-			integer inputTableau = OTGrammar_getTableau (me, input);
-			const integer ilearnerCandidate = OTGrammar_getWinner (me, inputTableau);
-			OTGrammarCandidate learnerCandidate = & my tableaus [inputTableau]. candidates [ilearnerCandidate];
-			if (str32equ (learnerCandidate -> output.get(), adultOutput))
-				numberOfCorrect ++;
+		OTGrammar_Violations violations;
+		violations.init (me);
+		PairDistribution_Sampler sampler;
+		sampler.init (thee);
+		autoINTVEC tableauNumbers = PairDistribution_getTableauNumbers (thee, me);
+		autoINTVEC adultCandidates = PairDistribution_getAdultCandidates (thee, me, tableauNumbers.get());
+		const integer thresholdNumberOfInputsPerThread = OTGrammar_thresholdNumberOfTrialsPerThread (violations);
+		autoINTVEC numberOfCorrect = zero_INTVEC (std::max (1_integer,
+				MelderThread_computeNumberOfThreads (numberOfInputs, thresholdNumberOfInputsPerThread)));
+		if (numberOfInputs > 0) {
+			std::atomic <bool> errorFlag = false;
+			MelderThread_run (& errorFlag, numberOfInputs, thresholdNumberOfInputsPerThread,
+				[&] (integer threadNumber, integer firstInput, integer lastInput) {
+					try {
+						NUMrandom_setChannel (threadNumber);
+						OTGrammar_Evaluator evaluator;
+						evaluator.init (& violations, my decisionStrategy);
+						numberOfCorrect [threadNumber + 1] = OTGrammar_countCorrect (me, evaluator, sampler, thee,
+								tableauNumbers.get(), adultCandidates.get(), evaluationNoise, lastInput - firstInput + 1, errorFlag);
+					} catch (MelderError) {
+						errorFlag = true;
+						return;
+					}
+				}
+			);
 		}
-		return (double) numberOfCorrect / numberOfInputs;
+		integer totalNumberOfCorrect = 0;
+		for (integer ithread = 1; ithread <= numberOfCorrect.size; ithread ++)
+			totalNumberOfCorrect += numberOfCorrect [ithread];
+		return (double) totalNumberOfCorrect / numberOfInputs;
 	} catch (MelderError) {
 		Melder_throw (me, U" & ", thee, U": fraction correct not computed.");
 	}
@@ -2349,20 +2685,48 @@ integer OTGrammar_PairDistribution_getMinimumNumberCorrect (OTGrammar me, PairDi
 	double evaluationNoise, integer numberOfReplications)
 {
 	try {
+		OTGrammar_Violations violations;
+		violations.init (me);
+		autoINTVEC tableauNumbers = PairDistribution_getTableauNumbers (thee, me);
+		autoINTVEC adultCandidates = PairDistribution_getAdultCandidates (thee, me, tableauNumbers.get());
+		const integer thresholdNumberOfReplicationsPerThread = OTGrammar_thresholdNumberOfTrialsPerThread (violations);
+		autoINTVEC numberOfCorrectPerThread = zero_INTVEC (std::max (1_integer,
+				MelderThread_computeNumberOfThreads (numberOfReplications, thresholdNumberOfReplicationsPerThread)));
 		integer minimumNumberCorrect = numberOfReplications;
 		for (integer ipair = 1; ipair <= thy pairs.size; ipair ++) {
 			PairProbability prob = thy pairs.at [ipair];
 			if (prob -> weight > 0.0) {
-				integer numberOfCorrect = 0;
-				conststring32 input = prob -> string1.get(), adultOutput = prob -> string2.get();
-				integer inputTableau = OTGrammar_getTableau (me, input);
-				for (integer ireplication = 1; ireplication <= numberOfReplications; ireplication ++) {
-					OTGrammar_newDisharmonies (me, evaluationNoise);
-					const integer ilearnerCandidate = OTGrammar_getWinner (me, inputTableau);
-					OTGrammarCandidate learnerCandidate = & my tableaus [inputTableau]. candidates [ilearnerCandidate];
-					if (str32equ (learnerCandidate -> output.get(), adultOutput))
-						numberOfCorrect ++;
+				const integer inputTableau = tableauNumbers [ipair], adultCandidate = adultCandidates [ipair];
+				for (integer ithread = 1; ithread <= numberOfCorrectPerThread.size; ithread ++)
+					numberOfCorrectPerThread [ithread] = 0;
+				if (numberOfReplications > 0) {
+					std::atomic <bool> errorFlag = false;
+					MelderThread_run (& errorFlag, numberOfReplications, thresholdNumberOfReplicationsPerThread,
+						[&] (integer threadNumber, integer firstReplication, integer lastReplication) {
+							try {
+								NUMrandom_setChannel (threadNumber);
+								OTGrammar_Evaluator evaluator;
+								evaluator.init (& violations, my decisionStrategy);
+								integer numberOfCorrect = 0;
+								for (integer ireplication = firstReplication; ireplication <= lastReplication; ireplication ++) {
+									if (errorFlag)
+										return;
+									evaluator.newDisharmonies (me, evaluationNoise);
+									const integer ilearnerCandidate = evaluator.getWinner (inputTableau);
+									if (violations.isAdultOutput (inputTableau, ilearnerCandidate, adultCandidate))
+										numberOfCorrect ++;
+								}
+								numberOfCorrectPerThread [threadNumber + 1] = numberOfCorrect;
+							} catch (MelderError) {
+								errorFlag = true;
+								return;
+							}
+						}
+					);
 				}
+				integer numberOfCorrect = 0;
+				for (integer ithread = 1; ithread <= numberOfCorrectPerThread.size; ithread ++)
+					numberOfCorrect += numberOfCorrectPerThread [ithread];
 				if (numberOfCorrect < minimumNumberCorrect)
 					minimumNumberCorrect = numberOfCorrect;
 			}
@@ -2373,6 +2737,87 @@ integer OTGrammar_PairDistribution_getMinimumNumberCorrect (OTGrammar me, PairDi
 	}
 }
 
+autoTable OTGrammar_PairDistribution_simulateLearners (OTGrammar me, PairDistribution thee, integer numberOfLearners,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfEvaluationInputs)
+{
+	try {
+		Melder_require (numberOfLearners >= 1,
+			U"The number of learners should be at least 1.");
+		Melder_require (numberOfEvaluationInputs >= 1,
+			U"The number of evaluation inputs should be at least 1.");
+		OTGrammar_Violations violations;
+		violations.init (me);
+		PairDistribution_Sampler sampler;
+		sampler.init (thee);
+		autoINTVEC tableauNumbers = PairDistribution_getTableauNumbers (thee, me);
+		autoINTVEC adultCandidates = PairDistribution_getAdultCandidates (thee, me, tableauNumbers.get());
+		autoMAT rankings = zero_MAT (numberOfLearners, my numberOfConstraints);
+		autoVEC fractionCorrect = zero_VEC (numberOfLearners);
+		/*
+			Every learner starts from its own copy of the grammar,
+			so that the learners can be simulated in parallel.
+		*/
+		autoMelderProgress progress (U"Simulating learners...");
+		std::atomic <bool> errorFlag = false;
+		MelderThread_run (& errorFlag, numberOfLearners, 1,
+			[&] (integer threadNumber, integer firstLearner, integer lastLearner) {
+				try {
+					NUMrandom_setChannel (threadNumber);
+					OTGrammar_Evaluator evaluator;
+					evaluator.init (& violations, my decisionStrategy);
+					for (integer ilearner = firstLearner; ilearner <= lastLearner; ilearner ++) {
+						if (errorFlag)
+							return;
+						autoOTGrammar learner = Data_copy (me);
+						double plasticity = initialPlasticity;
+						for (integer iplasticity = 1; iplasticity <= numberOfPlasticities; iplasticity ++) {
+							for (integer ireplication = 1; ireplication <= replicationsPerPlasticity; ireplication ++) {
+								const PairProbability pair = thy pairs.at [sampler.peek ()];
+								for (integer ichew = 1; ichew <= numberOfChews; ichew ++)
+									OTGrammar_learnOne (learner.get(), pair -> string1.get(), pair -> string2.get(),
+										evaluationNoise, updateRule, honourLocalRankings,
+										plasticity, relativePlasticityNoise, true, false, nullptr
+									);
+							}
+							if (errorFlag)
+								return;
+							plasticity *= plasticityDecrement;
+						}
+						for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+							rankings [ilearner] [icons] = learner -> constraints [icons]. ranking;
+						const integer numberOfCorrect = OTGrammar_countCorrect (learner.get(), evaluator, sampler, thee,
+								tableauNumbers.get(), adultCandidates.get(), evaluationNoise, numberOfEvaluationInputs, errorFlag);
+						fractionCorrect [ilearner] = (double) numberOfCorrect / numberOfEvaluationInputs;
+						if (threadNumber == 0)
+							Melder_progress ((ilearner - firstLearner + 1.0) / (lastLearner - firstLearner + 1.0),
+								U"Simulating ", numberOfLearners, U" learners...");
+					}
+				} catch (MelderError) {
+					errorFlag = true;
+					return;
+				}
+			}
+		);
+		autoTable result = Table_createWithoutColumnNames (numberOfLearners, 2 + my numberOfConstraints);
+		Table_renameColumn_e (result.get(), 1, U"learner");
+		Table_renameColumn_e (result.get(), 2, U"fractionCorrect");
+		for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+			Table_renameColumn_e (result.get(), 2 + icons, my constraints [icons]. name.get());
+		for (integer ilearner = 1; ilearner <= numberOfLearners; ilearner ++) {
+			Table_setNumericValue (result.get(), ilearner, 1, ilearner);
+			Table_setNumericValue (result.get(), ilearner, 2, fractionCorrect [ilearner]);
+			for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+				Table_setNumericValue (result.get(), ilearner, 2 + icons, rankings [ilearner] [icons]);
+		}
+		return result;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": learners not simulated.");
+	}
+}
+
 double OTGrammar_Distributions_getFractionCorrect (OTGrammar me, Distributions thee, integer columnNumber,
 	double evaluationNoise, integer numberOfInputs)
 {
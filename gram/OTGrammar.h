@@ -117,6 +117,18 @@ double OTGrammar_PairDistribution_getFractionCorrect (OTGrammar me, PairDistribu
 	double evaluationNoise, integer numberOfInputs);
 integer OTGrammar_PairDistribution_getMinimumNumberCorrect (OTGrammar me, PairDistribution thee,
 	double evaluationNoise, integer numberOfReplications);
+autoTable OTGrammar_PairDistribution_simulateLearners (OTGrammar me, PairDistribution thee, integer numberOfLearners,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfEvaluationInputs);
+	/*
+		Lets `numberOfLearners` independent copies of the grammar learn from the distribution,
+		as in OTGrammar_PairDistribution_learn(), and evaluates each of them
+		as in OTGrammar_PairDistribution_getFractionCorrect().
+		The learners are simulated in parallel; the grammar itself does not change.
+		Returns a Table with one row per learner, containing its fraction correct and its final rankings.
+	*/
 double OTGrammar_Distributions_getFractionCorrect (OTGrammar me, Distributions thee, integer columnNumber,
 	double evaluationNoise, integer numberOfInputs);
 
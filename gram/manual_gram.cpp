@@ -1316,6 +1316,26 @@ DEFINITION (U"After the command finishes, the harmony of every optimal (and corr
 	"will be at least this much greater than the harmony of any competitor in the same tableau.")
 MAN_END
 
+MAN_BEGIN (U"OTGrammar & PairDistribution: Simulate learners...", U"ppgb", 20261019)
+INTRO (U"A command to create a @Table that shows how a number of independent virtual learners "
+	"would fare if each of them started out with the selected @OTGrammar and learned from the selected @PairDistribution.")
+NORMAL (U"Every learner learns from its own copy of the grammar, exactly as with "
+	"@@OT learning 6. Shortcut to grammar learning|OTGrammar & PairDistribution: Learn...@, "
+	"and is afterwards evaluated as with ##OTGrammar & PairDistribution: Get fraction correct...#. "
+	"The selected OTGrammar itself does not change. "
+	"Because the learners are independent, they are simulated in parallel on computers with multiple processors.")
+ENTRY (U"Settings")
+TERM (U"##Number of learners# (standard value: 20)")
+DEFINITION (U"the number of virtual learners, i.e. the number of rows in the resulting Table.")
+TERM (U"##Evaluation replications# (standard value: 100000)")
+DEFINITION (U"the number of input-output pairs drawn from the PairDistribution to determine the fraction correct of each learner.")
+NORMAL (U"The remaining settings are the same as those of OTGrammar & PairDistribution: Learn...")
+ENTRY (U"Result")
+NORMAL (U"The resulting Table has one row per learner. The column ##fractionCorrect# contains the fraction of correct outputs "
+	"of the learner after learning, and the remaining columns contain the learner's final ranking value of each constraint.")
+NORMAL (U"The results are reproducible for a given random seed and a given number of threads.")
+MAN_END
+
 MAN_BEGIN (U"OTGrammar & Strings: Inputs to outputs...", U"ppgb", 19981230)
 INTRO (U"An action that creates a @Strings object from a selected @OTGrammar and a selected @Strings.")
 NORMAL (U"The selected Strings object is considered as a list of inputs to the OTGrammar grammar.")
@@ -1109,6 +1109,31 @@ DO
 	MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_END
 }
 
+FORM (CONVERT_ONE_AND_ONE_TO_ONE__OTGrammar_PairDistribution_simulateLearners, U"OTGrammar & PairDistribution: Simulate learners", U"OTGrammar & PairDistribution: Simulate learners...") {
+	NATURAL (numberOfLearners, U"Number of learners", U"20")
+	REAL (evaluationNoise, U"Evaluation noise", U"2.0")
+	OPTIONMENU_ENUM (kOTGrammar_rerankingStrategy, updateRule,
+			U"Update rule", kOTGrammar_rerankingStrategy::SYMMETRIC_ALL)
+	POSITIVE (initialPlasticity, U"Initial plasticity", U"1.0")
+	NATURAL (replicationsPerPlasticity, U"Replications per plasticity", U"100000")
+	REAL (plasticityDecrement, U"Plasticity decrement", U"0.1")
+	NATURAL (numberOfPlasticities, U"Number of plasticities", U"4")
+	REAL (relativePlasticitySpreading, U"Rel. plasticity spreading", U"0.1")
+	BOOLEAN (honourLocalRankings, U"Honour local rankings", true)
+	NATURAL (numberOfChews, U"Number of chews", U"1")
+	NATURAL (evaluationReplications, U"Evaluation replications", U"100000")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_ONE (OTGrammar, PairDistribution)
+		autoTable result = OTGrammar_PairDistribution_simulateLearners (me, you, numberOfLearners,
+			evaluationNoise, updateRule, honourLocalRankings,
+			initialPlasticity, replicationsPerPlasticity,
+			plasticityDecrement, numberOfPlasticities, relativePlasticitySpreading, numberOfChews,
+			evaluationReplications
+		);
+	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get(), U"_learners")
+}
+
 DIRECT (INFO_ONE_AND_ONE__OTGrammar_PairDistribution_listObligatoryRankings) {
 	INFO_ONE_AND_ONE (OTGrammar, PairDistribution)
 		OTGrammar_PairDistribution_listObligatoryRankings (me, you);
@@ -1908,6 +1933,8 @@ void praat_uvafon_gram_init () {
 			QUERY_ONE_WEAK_AND_ONE_FOR_REAL__OTGrammar_PairDistribution_getFractionCorrect);
 	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Get minimum number correct...", nullptr, 0,
 			QUERY_ONE_WEAK_AND_ONE_FOR_INTEGER__OTGrammar_PairDistribution_getMinimumNumberCorrect);
+	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Simulate learners...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_ONE__OTGrammar_PairDistribution_simulateLearners);
 	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"List obligatory rankings", nullptr, 0,
 			INFO_ONE_AND_ONE__OTGrammar_PairDistribution_listObligatoryRankings);
 	praat_addAction2 (classOTMulti, 1, classPairDistribution, 1, U"Learn...", nullptr, 0,
@@ -1,6 +1,6 @@
 /* MAT.cpp
  *
- * Copyright (C) 2017-2021,2025 Paul Boersma
+ * Copyright (C) 2017-2021,2025,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -45,9 +45,290 @@ void doubleCentre_MAT_inout (MATVU const& x) noexcept {
 	centreEachColumn_MAT_inout (x);
 }
 
+/*
+	Cache-blocked matrix multiplication, after Goto & Van de Geijn (2008).
+
+	Target := alpha * X.Y + beta * Target is computed in blocks of GEMM_KC terms.
+	For each block, a GEMM_KC x GEMM_NC panel of Y is copied ("packed") into a contiguous buffer
+	that stays in the L3 cache, and GEMM_MC x GEMM_KC panels of X are packed into buffers
+	that stay in the L2 cache. The innermost "micro-kernel" computes a GEMM_MR x GEMM_NR tile
+	of the target in registers. Because everything is packed, the strides of X, Y and Target
+	do not matter, so that X.Y, X'.Y, X.Y' and X'.Y' are all equally fast.
+
+	The micro-kernel uses the vector extension of GCC and Clang, which compiles to SSE2 or NEON
+	by default. On Linux/x86_64 we let the compiler generate AVX2 and AVX-512 versions as well,
+	and the dynamic linker chooses the best one for the processor at hand.
+	Since we don't contract multiplications and additions (no FMA), all versions give identical results.
+
+	The tiles of the target are distributed over the threads.
+*/
+
+#define GEMM_MR  6
+#define GEMM_NR  8
+#define GEMM_MC  96
+#define GEMM_KC  256
+#define GEMM_NC  2048
+#define GEMM_THREAD_NC  256   // the number of target columns in a tile for a single thread; a multiple of GEMM_NR
+
+#if defined (__GNUC__) || defined (__clang__)
+	typedef double GemmVector __attribute__ ((vector_size (GEMM_NR * sizeof (double))));
+	#if defined (__x86_64__) && defined (linux) && defined (__has_attribute)
+		#if __has_attribute (target_clones)
+			#define GEMM_TARGET_CLONES  __attribute__ ((target_clones ("avx512f", "avx2", "default")))
+		#endif
+	#endif
+#endif
+#ifndef GEMM_TARGET_CLONES
+	#define GEMM_TARGET_CLONES
+#endif
+/*
+	In the clones that have FMA, the compilers may contract `sum += a * b` into a fused multiply-add
+	(Clang by default, GCC in GNU modes), which would make the results depend on the processor.
+	So we switch contraction off for the micro-kernel only: GCC needs an attribute, Clang a pragma in the function body.
+	GCC clears the upper halves of the vector registers after AVX code (which would otherwise make
+	subsequent SSE code, e.g. exp () from the C library, many times slower) only with -fexpensive-optimizations,
+	which is not on at -O1.
+*/
+#if defined (__GNUC__) && ! defined (__clang__)
+	#define GEMM_KERNEL_OPTIONS  __attribute__ ((optimize ("fp-contract=off", "expensive-optimizations")))
+#else
+	#define GEMM_KERNEL_OPTIONS
+#endif
+
+static void gemm_packX (constMATVU const& x, integer firstRow, integer numberOfRows, integer firstTerm, integer numberOfTerms, double *packed) {
+	/*
+		Slivers of GEMM_MR rows; within a sliver, term after term; padded with zeroes.
+	*/
+	for (integer sliverStart = 0; sliverStart < numberOfRows; sliverStart += GEMM_MR) {
+		const integer sliverSize = std::min (integer (GEMM_MR), numberOfRows - sliverStart);
+		const double *px = & x [firstRow + sliverStart] [firstTerm];
+		for (integer k = 0; k < numberOfTerms; k ++) {
+			for (integer irow = 0; irow < sliverSize; irow ++)
+				packed [irow] = px [irow * x.rowStride + k * x.colStride];
+			for (integer irow = sliverSize; irow < GEMM_MR; irow ++)
+				packed [irow] = 0.0;
+			packed += GEMM_MR;
+		}
+	}
+}
+
+static void gemm_packY (constMATVU const& y, integer firstTerm, integer numberOfTerms, integer firstColumn, integer numberOfColumns, double *packed) {
+	/*
+		Slivers of GEMM_NR columns; within a sliver, term after term; padded with zeroes.
+	*/
+	for (integer sliverStart = 0; sliverStart < numberOfColumns; sliverStart += GEMM_NR) {
+		const integer sliverSize = std::min (integer (GEMM_NR), numberOfColumns - sliverStart);
+		const double *py = & y [firstTerm] [firstColumn + sliverStart];
+		for (integer k = 0; k < numberOfTerms; k ++) {
+			for (integer icol = 0; icol < sliverSize; icol ++)
+				packed [icol] = py [k * y.rowStride + icol * y.colStride];
+			for (integer icol = sliverSize; icol < GEMM_NR; icol ++)
+				packed [icol] = 0.0;
+			packed += GEMM_NR;
+		}
+	}
+}
+
+/*
+	Target [firstRow..][firstColumn..] (numberOfRows x numberOfColumns) :=
+		alpha * packedX.packedY + ( accumulate ? Target : beta * Target )
+	If `upperTriangleOnly`, tiles that lie completely below the diagonal of the whole target are skipped.
+*/
+GEMM_TARGET_CLONES GEMM_KERNEL_OPTIONS
+static void gemm_macroKernel (MATVU const& target, integer firstRow, integer numberOfRows, integer firstColumn, integer numberOfColumns,
+	integer numberOfTerms, const double *packedX, const double *packedY,
+	double alpha, double beta, bool accumulate, bool upperTriangleOnly)
+{
+	#if defined (__clang__)
+		#pragma clang fp contract (off)
+	#endif
+	for (integer columnSliverStart = 0; columnSliverStart < numberOfColumns; columnSliverStart += GEMM_NR) {
+		const integer numberOfTileColumns = std::min (integer (GEMM_NR), numberOfColumns - columnSliverStart);
+		const double *sliverY = packedY + columnSliverStart * numberOfTerms;
+		for (integer rowSliverStart = 0; rowSliverStart < numberOfRows; rowSliverStart += GEMM_MR) {
+			const integer numberOfTileRows = std::min (integer (GEMM_MR), numberOfRows - rowSliverStart);
+			if (upperTriangleOnly && firstRow + rowSliverStart > firstColumn + columnSliverStart + numberOfTileColumns - 1)
+				continue;
+			const double *a = packedX + rowSliverStart * numberOfTerms;
+			const double *b = sliverY;
+			double tile [GEMM_MR] [GEMM_NR];
+			#if defined (__GNUC__) || defined (__clang__)
+				GemmVector sum0 = { }, sum1 = { }, sum2 = { }, sum3 = { }, sum4 = { }, sum5 = { };
+				for (integer k = 0; k < numberOfTerms; k ++) {
+					GemmVector bk;
+					memcpy (& bk, b, sizeof (GemmVector));
+					sum0 += a [0] * bk;
+					sum1 += a [1] * bk;
+					sum2 += a [2] * bk;
+					sum3 += a [3] * bk;
+					sum4 += a [4] * bk;
+					sum5 += a [5] * bk;
+					a += GEMM_MR;
+					b += GEMM_NR;
+				}
+				memcpy (tile [0], & sum0, sizeof (GemmVector));
+				memcpy (tile [1], & sum1, sizeof (GemmVector));
+				memcpy (tile [2], & sum2, sizeof (GemmVector));
+				memcpy (tile [3], & sum3, sizeof (GemmVector));
+				memcpy (tile [4], & sum4, sizeof (GemmVector));
+				memcpy (tile [5], & sum5, sizeof (GemmVector));
+			#else
+				for (integer irow = 0; irow < GEMM_MR; irow ++)
+					for (integer icol = 0; icol < GEMM_NR; icol ++)
+						tile [irow] [icol] = 0.0;
+				for (integer k = 0; k < numberOfTerms; k ++) {
+					for (integer irow = 0; irow < GEMM_MR; irow ++)
+						for (integer icol = 0; icol < GEMM_NR; icol ++)
+							tile [irow] [icol] += a [irow] * b [icol];
+					a += GEMM_MR;
+					b += GEMM_NR;
+				}
+			#endif
+			for (integer irow = 0; irow < numberOfTileRows; irow ++) {
+				double *pc = & target [firstRow + rowSliverStart + irow] [firstColumn + columnSliverStart];
+				for (integer icol = 0; icol < numberOfTileColumns; icol ++) {
+					double& cell = pc [icol * target.colStride];
+					const double product = ( alpha == 1.0 ? tile [irow] [icol] : alpha * tile [irow] [icol] );
+					if (accumulate)
+						cell += product;
+					else if (beta == 0.0)
+						cell = product;   // the target may contain garbage (even NaNs)
+					else
+						cell = product + beta * cell;
+				}
+			}
+		}
+	}
+}
+
+static inline bool gemm_isWorthwhile (integer numberOfRows, integer numberOfColumns, integer numberOfTerms) {
+	/*
+		For smaller matrices, packing costs more than it gains.
+	*/
+	return double (numberOfRows) * double (numberOfColumns) * double (numberOfTerms) >= 1e5;
+}
+
+static bool gemm (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha, double beta, bool upperTriangleOnly) noexcept {
+	const integer numberOfTerms = x.ncol;
+	if (numberOfTerms == 0) {
+		for (integer irow = 1; irow <= target.nrow; irow ++)
+			for (integer icol = 1; icol <= target.ncol; icol ++)
+				target [irow] [icol] = ( beta == 0.0 ? 0.0 : beta * target [irow] [icol] );
+		return true;
+	}
+	const integer maximumNumberOfPanelColumns = std::min (integer (GEMM_NC), target.ncol);
+	const integer maximumNumberOfBlockTerms = std::min (integer (GEMM_KC), numberOfTerms);
+	const integer numberOfRowBlocks = (target.nrow - 1) / GEMM_MC + 1;
+	const integer maximumNumberOfTiles = numberOfRowBlocks * ((maximumNumberOfPanelColumns - 1) / GEMM_THREAD_NC + 1);
+	/*
+		The BLAS (dgemm) can call us from a thread function, e.g. from a parallel loop over frames;
+		starting threads from threads would only oversubscribe the processors.
+	*/
+	const bool mustStayInThisThread = MelderThread_isInsideParallelRun ();
+	const integer maximumNumberOfThreads = ( mustStayInThisThread ? 1 : MelderThread_computeNumberOfThreads (maximumNumberOfTiles, 1) );
+	/*
+		Allocate all the workspace before touching the target,
+		so that we can return without harm if memory is short.
+	*/
+	autoVEC packedY;
+	autoMAT packedX;
+	autoBOOLVEC tileIsDone;
+	try {
+		packedY = raw_VEC ((maximumNumberOfPanelColumns + GEMM_NR) * maximumNumberOfBlockTerms);
+		packedX = raw_MAT (maximumNumberOfThreads, GEMM_MC * maximumNumberOfBlockTerms);
+		tileIsDone = raw_BOOLVEC (maximumNumberOfTiles);
+	} catch (MelderError) {
+		Melder_clearError ();
+		return false;
+	}
+	for (integer panelFirstColumn = 1; panelFirstColumn <= target.ncol; panelFirstColumn += GEMM_NC) {
+		const integer numberOfPanelColumns = std::min (integer (GEMM_NC), target.ncol - panelFirstColumn + 1);
+		for (integer firstTerm = 1; firstTerm <= numberOfTerms; firstTerm += GEMM_KC) {
+			const integer numberOfBlockTerms = std::min (integer (GEMM_KC), numberOfTerms - firstTerm + 1);
+			gemm_packY (y, firstTerm, numberOfBlockTerms, panelFirstColumn, numberOfPanelColumns, packedY.cells);
+			/*
+				The tiles of this panel, numbered row block by row block,
+				so that a thread can often reuse its packed rows of X.
+			*/
+			const integer numberOfColumnBlocks = (numberOfPanelColumns - 1) / GEMM_THREAD_NC + 1;
+			const integer numberOfTiles = numberOfRowBlocks * numberOfColumnBlocks;
+			const double numberOfFlops = 2.0 * double (target.nrow) * double (numberOfPanelColumns) * double (numberOfBlockTerms);
+			const integer thresholdNumberOfTilesPerThread = ( numberOfFlops < 1e7 ? numberOfTiles : 1 );
+			for (integer itile = 1; itile <= numberOfTiles; itile ++)
+				tileIsDone [itile] = false;
+			std::atomic <bool> errorFlag = false;
+			auto threadFunction = [&] (integer threadNumber, integer firstTile, integer lastTile) {
+				double *myPackedX = & packedX [1 + threadNumber] [1];
+				integer packedRowBlock = 0;
+				for (integer itile = firstTile; itile <= lastTile; itile ++) {
+					if (tileIsDone [itile])
+						continue;
+					const integer rowBlock = (itile - 1) / numberOfColumnBlocks + 1;
+					const integer columnBlock = (itile - 1) % numberOfColumnBlocks + 1;
+					const integer firstRow = 1 + (rowBlock - 1) * GEMM_MC;
+					const integer numberOfRows = std::min (integer (GEMM_MC), target.nrow - firstRow + 1);
+					const integer firstColumnInPanel = 1 + (columnBlock - 1) * GEMM_THREAD_NC;
+					const integer numberOfColumns = std::min (integer (GEMM_THREAD_NC), numberOfPanelColumns - firstColumnInPanel + 1);
+					if (upperTriangleOnly && firstRow > panelFirstColumn + firstColumnInPanel + numberOfColumns - 2)
+						continue;
+					if (rowBlock != packedRowBlock) {
+						gemm_packX (x, firstRow, numberOfRows, firstTerm, numberOfBlockTerms, myPackedX);
+						packedRowBlock = rowBlock;
+					}
+					gemm_macroKernel (target, firstRow, numberOfRows, panelFirstColumn + firstColumnInPanel - 1, numberOfColumns,
+						numberOfBlockTerms, myPackedX, packedY.cells + (firstColumnInPanel - 1) * numberOfBlockTerms,
+						alpha, beta, firstTerm > 1, upperTriangleOnly
+					);
+					tileIsDone [itile] = true;
+				}
+			};
+			if (mustStayInThisThread) {
+				threadFunction (0, 1, numberOfTiles);
+				continue;
+			}
+			try {
+				MelderThread_run (& errorFlag, numberOfTiles, thresholdNumberOfTilesPerThread, threadFunction);
+			} catch (MelderError) {
+				/*
+					Only thread creation can have failed. The threads that did start have been joined,
+					so we can finish their neighbours' tiles in this thread.
+				*/
+				Melder_clearError ();
+				threadFunction (0, 1, numberOfTiles);
+			}
+		}
+	}
+	return true;
+}
+
+bool _mul_blocked_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha, double beta) noexcept {
+	return gemm (target, x, y, alpha, beta, false);
+}
+
+void _mulAdd_MAT_inout (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha) noexcept {
+	if (gemm (target, x, y, alpha, 1.0, false))
+		return;
+	/*
+		Not enough memory for packing.
+	*/
+	for (integer irow = 1; irow <= target.nrow; irow ++)
+		for (integer icol = 1; icol <= target.ncol; icol ++) {
+			double sum = 0.0;
+			for (integer k = 1; k <= x.ncol; k ++)
+				sum += x [irow] [k] * y [k] [icol];
+			target [irow] [icol] += alpha * sum;
+		}
+}
+
 void mtm_MAT_out (MATVU const& target, constMATVU const& x) noexcept {
 	Melder_assert (target.nrow == x.ncol);
 	Melder_assert (target.ncol == x.ncol);
+	if (gemm_isWorthwhile (x.ncol, x.ncol, x.nrow) && gemm (target, x.transpose(), x, 1.0, 0.0, true)) {
+		for (integer irow = 2; irow <= target.nrow; irow ++)
+			for (integer icol = 1; icol < irow; icol ++)
+				target [irow] [icol] = target [icol] [irow];
+		return;
+	}
 	#if 0
 	for (integer irow = 1; irow <= target.nrow; irow ++) {
 		for (integer icol = irow; icol <= target.ncol; icol ++) {
@@ -361,6 +642,10 @@ static inline void MATmul_rough_naiveReferenceImplementation (MATVU const& targe
 void _mul_fast_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y) noexcept {
 	if ((false)) {
 		MATmul_rough_naiveReferenceImplementation (target, x, y);
+	} else if (gemm_isWorthwhile (target.nrow, target.ncol, x.ncol) && gemm (target, x, y, 1.0, 0.0, false)) {
+		/*
+			Large matrices of any strides: packed, cache-blocked and multithreaded (see above).
+		*/
 	} else if (y.colStride == 1) {
 		/*
 			This case is appropriate for the multiplication of full matrices
@@ -420,6 +420,25 @@ inline autoMAT mul_fast_MAT (constMATVU const& x, constMATVU const& y) {
 	mul_fast_MAT_out (result.all(), x, y);
 	return result;
 }
+/*
+	Cache-blocked multithreaded multiplication for large matrices of any strides:
+		target := alpha * x.y + beta * target
+	(if beta is 0, target does not have to be initialized).
+	Rough like mul_fast_MAT_out; the latter uses this for large matrices.
+	Returns false, without having touched the target, if there was not enough memory.
+*/
+extern bool _mul_blocked_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha, double beta) noexcept;
+/*
+	target += alpha * x.y, as rough as _mul_blocked_MAT_out (which it uses if there is enough memory).
+*/
+extern void _mulAdd_MAT_inout (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha) noexcept;
+inline void mulAdd_MAT_inout  (MATVU const& target, constMATVU const& x, constMATVU const& y, double alpha = 1.0) {
+	Melder_assert (target.nrow == x.nrow);
+	Melder_assert (target.ncol == y.ncol);
+	Melder_assert (x.ncol == y.nrow);
+	_mulAdd_MAT_inout (target, x, y, alpha);
+}
+
 void MATmul_forceMetal_ (MATVU const& target, constMATVU const& x, constMATVU const& y);
 void MATmul_forceOpenCL_ (MATVU const& target, constMATVU const& x, constMATVU const& y);
 
@@ -1,6 +1,6 @@
 /* MelderThread.cpp
  *
- * Copyright (C) 2025 Paul Boersma
+ * Copyright (C) 2025,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -35,6 +35,15 @@ integer Melder_thisThread_getUniqueID () {
 	return thisThread_uniqueID;
 }
 
+/*
+	Set in every thread that runs a share of a multithreaded MelderThread_run, including the master thread.
+*/
+static thread_local bool thisThread_isInsideParallelRun = false;
+
+bool MelderThread_isInsideParallelRun () {
+	return thisThread_isInsideParallelRun;
+}
+
 void MelderThread_run (
 	std::atomic <bool> *p_errorFlag,
 	const integer numberOfElements,
@@ -66,7 +75,13 @@ void MelderThread_run (
 		try {
 			for (integer ispawn1 = 1; ispawn1 <= numberOfExtraThreads; ispawn1 ++) {   // ispawn1 is base-1
 				const integer lastElement = firstElement + base - 1 + ( ispawn1 <= remainder );
-				spawns [uinteger (ispawn1 - 1)] = std::thread (threadFunction, ispawn1, firstElement, lastElement);
+				spawns [uinteger (ispawn1 - 1)] = std::thread (
+					[&threadFunction] (integer threadNumber, integer first, integer last) {
+						thisThread_isInsideParallelRun = true;
+						threadFunction (threadNumber, first, last);
+					},
+					ispawn1, firstElement, lastElement
+				);
 				firstElement = lastElement + 1;
 			}
 		} catch (...) {
@@ -77,7 +92,10 @@ void MelderThread_run (
 			Melder_throw (U"Couldn't start a thread. Contact the author.");
 		}
 		Melder_assert (firstElement + base - 1 == numberOfElements);
-		threadFunction (0, firstElement, numberOfElements);
+		const bool masterWasInsideParallelRun = thisThread_isInsideParallelRun;
+		thisThread_isInsideParallelRun = true;
+		threadFunction (0, firstElement, numberOfElements);   // not supposed to throw
+		thisThread_isInsideParallelRun = masterWasInsideParallelRun;
 		for (size_t ispawn0 = 0; ispawn0 < spawns.size(); ispawn0 ++)   // ispawn0 is base-0
 			spawns [ispawn0]. join ();
 	}
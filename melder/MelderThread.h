@@ -2,7 +2,7 @@
 #define _MelderThread_h_
 /* MelderThread.h
  *
- * Copyright (C) 2014-2018,2020,2025 Paul Boersma
+ * Copyright (C) 2014-2018,2020,2025,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -42,6 +42,13 @@ void MelderThread_run (
 	std::function <void (integer threadNumber, integer firstElement, integer lastElement)> const& threadFunction
 );
 
+bool MelderThread_isInsideParallelRun ();
+/*
+	True in the threads that run the thread function of a multithreaded MelderThread_run.
+	Code that can be reached from such a thread function, such as the matrix multiplication
+	that the BLAS uses, can check this to stay in its own thread instead of nesting threads.
+*/
+
 /*
 	Here is how these functions help you create simple parallel procedures.
 	Our example is pitch analysis in Praat (see fon/Sound_to_Pitch.cpp for details).
@@ -87,6 +87,7 @@ the behaviour of Praat will temporarily change in the following ways:
 55: trace Gui init, draw, destroy
 56: trace text styles
 57: no parabolic interpolation in Sound_Pitch_to_PointProcess_cc (March 2024)
+58: Sound_to_Harmonicity: go through the Pitch path finder instead of choosing the strongest candidate directly
 181: read and write native-endian real64
 900: use DG Meta Serif Science instead of Palatino
 1264: Mac: Sound_record_fixedTime uses microphone "FW Solo (1264)"
@@ -1,6 +1,6 @@
 /* melder_files.cpp
  *
- * Copyright (C) 1992-2008,2010-2025 Paul Boersma, 2013 Tom Naughton
+ * Copyright (C) 1992-2008,2010-2026 Paul Boersma, 2013 Tom Naughton
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -781,6 +781,27 @@ integer MelderFile_length (MelderFile file) {
 	#endif
 }
 
+double MelderFile_modificationTime (MelderFile file) {
+	#if defined (UNIX)
+		struct stat statistics;
+		if (stat (MelderFile_peekPath8 (file), & statistics) != 0)
+			return undefined;
+		#if defined (macintosh)
+			return double (statistics. st_mtimespec. tv_sec) + 1e-9 * double (statistics. st_mtimespec. tv_nsec);
+		#else
+			return double (statistics. st_mtim. tv_sec) + 1e-9 * double (statistics. st_mtim. tv_nsec);
+		#endif
+	#else
+		WIN32_FILE_ATTRIBUTE_DATA attributes;
+		if (! GetFileAttributesExW (MelderFile_peekPathW (file), GetFileExInfoStandard, & attributes))
+			return undefined;
+		ULARGE_INTEGER numberOfTicks;   // of 100 nanoseconds since 1601
+		numberOfTicks. LowPart = attributes. ftLastWriteTime. dwLowDateTime;
+		numberOfTicks. HighPart = attributes. ftLastWriteTime. dwHighDateTime;
+		return 1e-7 * double (numberOfTicks. QuadPart);
+	#endif
+}
+
 void MelderFile_delete (MelderFile file) {
 	if (! file)
 		return;
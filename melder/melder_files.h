@@ -2,7 +2,7 @@
 #define _melder_files_h_
 /* melder_files.h
  *
- * Copyright (C) 1992-2018,2020-2024 Paul Boersma
+ * Copyright (C) 1992-2018,2020-2024,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -89,6 +89,7 @@ bool MelderFile_readable (MelderFile file);
 bool Melder_tryToWriteFile (MelderFile file);
 bool Melder_tryToAppendFile (MelderFile file);
 integer MelderFile_length (MelderFile file);
+double MelderFile_modificationTime (MelderFile file);   // in seconds since some fixed moment; undefined if the file does not exist
 void MelderFile_delete (MelderFile file);
 void MelderFile_moveAndOrRename (MelderFile from, MelderFile to);
 
@@ -42,20 +42,9 @@ static int theLevel = 1;
 static int theExpressionType [1 + MAXIMUM_NUMBER_OF_LEVELS];
 static bool theOptimize;
 
-typedef struct structFormulaInstruction {
-	integer symbol;
-	integer position;
-	union {
-		double number;
-		integer label;
-		char32 *string;
-		Daata object;
-		InterpreterVariable variable;
-	} content;
-} *FormulaInstruction;
-
 static FormulaInstruction lexan, parse;
 static integer ilabel, ilexan, iparse, numberOfInstructions, numberOfStringConstants;
+static bool theLexanRefersToObjects;
 
 enum { NO_SYMBOL_,
 
@@ -453,7 +442,7 @@ static void Formula_lexan () {
 	integer itok = 0;   // position of most recent symbol in "lexan"
 #define newtok(s)  { lexan [++ itok]. symbol = s; lexan [itok]. position = ikar; }
 #define toknumber(g)  lexan [itok]. content.number = (g)
-#define tokmatrix(m)  lexan [itok]. content.object = (m)
+#define tokmatrix(m)  (theLexanRefersToObjects = true, lexan [itok]. content.object = (m))
 
 	static MelderString token;   // string to collect a symbol name in
 #define stringtokon MelderString_empty (& token);
@@ -461,6 +450,7 @@ static void Formula_lexan () {
 #define stringtokoff (void) 0
 
 	ilexan = iparse = ilabel = numberOfStringConstants = 0;
+	theLexanRefersToObjects = false;
 	do {
 		newchar;
 		if (Melder_isHorizontalOrVerticalSpace (kar)) {
@@ -2358,6 +2348,63 @@ void Formula_compile (Interpreter interpreter, Daata data, conststring32 express
 	if (Melder_debug == 17) Formula_print (parse);
 }
 
+/*
+	Reusing.
+*/
+
+Thing_implement (FormulaProgram, Thing, 0);
+
+static bool FormulaInstruction_ownsString (integer symbol) {
+	return symbol == STRING_ || symbol == INDEXED_NUMERIC_VARIABLE_ || symbol == INDEXED_STRING_VARIABLE_ || symbol == CALL_;
+}
+
+void structFormulaProgram :: v9_destroy () noexcept {
+	for (integer i = 1; i <= our instructions.size; i ++)
+		if (FormulaInstruction_ownsString (our instructions [i]. symbol))
+			Melder_free (our instructions [i]. content.string);
+	FormulaProgram_Parent :: v9_destroy ();
+}
+
+autoFormulaProgram Formula_saveProgram () {
+	/*
+		Formulas that refer to objects cannot be reused,
+		because the objects could have been removed in the meantime;
+		neither can formulas that contain names of variables that did not exist yet,
+		because the next run could have to resolve such a name to a variable.
+		After optimization, the values of variables have been frozen as constants.
+	*/
+	if (theLexanRefersToObjects || theSource || theOptimize)
+		return autoFormulaProgram();
+	for (integer itok = 1; lexan [itok]. symbol != END_; itok ++)
+		if (lexan [itok]. symbol == VARIABLE_NAME_)
+			return autoFormulaProgram();
+	autoFormulaProgram me = Thing_new (FormulaProgram);
+	my instructions = newvectorraw <structFormulaInstruction> (numberOfInstructions);
+	for (integer i = 1; i <= numberOfInstructions; i ++) {
+		my instructions [i] = parse [i];
+		if (FormulaInstruction_ownsString (parse [i]. symbol))
+			my instructions [i]. content.string = Melder_dup_f (parse [i]. content.string).transfer();
+	}
+	my expressionType = theExpressionType [theLevel];
+	return me;
+}
+
+void Formula_restoreProgram (Interpreter interpreter, FormulaProgram me, conststring32 expression) {
+	theInterpreter = interpreter;
+	theSource = nullptr;
+	theExpression = expression;
+	theExpressionType [theLevel] = my expressionType;
+	theOptimize = false;
+	if (! parse)
+		parse = Melder_calloc_f (structFormulaInstruction, Formula_MAXIMUM_STACK_SIZE);
+	/*
+		The strings are reference copies (the program is still the owner).
+	*/
+	for (integer i = 1; i <= my instructions.size; i ++)
+		parse [i] = my instructions [i];
+	numberOfInstructions = my instructions.size;
+}
+
 /*
 	Running.
 */
@@ -191,5 +191,42 @@ void Formula_compile (Interpreter interpreter, Daata data, conststring32 express
 
 void Formula_run (integer row, integer col, Formula_Result *result);
 
+typedef struct structFormulaInstruction {
+	integer symbol;
+	integer position;
+	union {
+		double number;
+		integer label;
+		char32 *string;
+		Daata object;
+		InterpreterVariable variable;
+	} content;
+} *FormulaInstruction;
+
+/*
+	A compiled formula that can be run again without lexical analysis and parsing.
+	The program owns its strings; it refers to interpreter variables,
+	but never to objects (these could be removed between runs).
+*/
+Thing_define (FormulaProgram, Thing) {
+	autovector <structFormulaInstruction> instructions;
+	int expressionType;
+
+	void v9_destroy () noexcept
+		override;
+};
+
+autoFormulaProgram Formula_saveProgram ();
+/*
+	Returns a copy of the formula most recently compiled by Formula_compile (),
+	or null if that formula cannot be reused, i.e. if it refers to objects
+	or to variables that did not exist at compile time.
+*/
+
+void Formula_restoreProgram (Interpreter interpreter, FormulaProgram program, conststring32 expression);
+/*
+	Makes `program` the formula that Formula_run () will run next, as if it had just been compiled from `expression`.
+*/
+
 /* End of file Formula.h */
 #endif
@@ -1139,28 +1139,83 @@ static void Interpreter_addNumericVectorVariable (Interpreter me, conststring32
 	variable.releaseToAmbiguousOwner();
 }
 
+/*
+	The full name of a variable, i.e. with the procedure name in front if the variable is local.
+	The key is reused from call to call, so that looking up a variable does not allocate memory.
+*/
+static const std::u32string& Interpreter_fullVariableName (Interpreter me, conststring32 key) {
+	static std::u32string fullName;
+	if (key [0] == U'.') {
+		fullName. assign (my procedureNames [my callDepth]);
+		fullName. append (key);
+	} else {
+		fullName. assign (key);
+	}
+	return fullName;
+}
+
+/*
+	Within a line of a running script, the same name in the same procedure frame always refers to the same variable,
+	so the line can remember the variables it has resolved before.
+*/
+static structInterpreterVariableSlot *Interpreter_findVariableSlot (Interpreter me, conststring32 key) {
+	if (! my compiledLines || my compiledLineNumber == 0)
+		return nullptr;
+	structInterpreterCompiledLine& compiledLine = (*my compiledLines) [my compiledLineNumber];
+	const integer numberOfSlots = uinteger_to_integer_a (compiledLine. variableSlots.size());
+	const int callDepth = ( key [0] == U'.' ? my callDepth : -1 );
+	for (integer i = 0; i < numberOfSlots; i ++) {
+		const integer islot = (compiledLine. nextVariableSlot + i) % numberOfSlots;
+		structInterpreterVariableSlot& slot = compiledLine. variableSlots [islot];
+		if (slot. callDepth == callDepth && str32equ (slot. name.get(), key)) {
+			compiledLine. nextVariableSlot = (islot + 1) % numberOfSlots;
+			return & slot;
+		}
+	}
+	return nullptr;
+}
+
+static void Interpreter_rememberVariableSlot (Interpreter me, conststring32 key, InterpreterVariable variable) {
+	if (! my compiledLines || my compiledLineNumber == 0)
+		return;
+	if (str32chr (key, U'['))
+		return;   // an indexed variable such as a[i], whose name is different each time
+	structInterpreterCompiledLine& compiledLine = (*my compiledLines) [my compiledLineNumber];
+	if (uinteger_to_integer_a (compiledLine. variableSlots.size()) >= Interpreter_MAXNUM_VARIABLE_SLOTS_PER_LINE)
+		return;
+	compiledLine. variableSlots. push_back ({ Melder_dup (key), key [0] == U'.' ? my callDepth : -1, variable });
+}
+
 InterpreterVariable Interpreter_hasVariable (Interpreter me, conststring32 key) {
 	Melder_assert (key);
-	auto it = my variablesMap. find (key [0] == U'.' ? Melder_cat (my procedureNames [my callDepth], key) : key);
-	if (it != my variablesMap.end())
-		return it -> second.get();
-	else
-		return nullptr;
+	if (structInterpreterVariableSlot *slot = Interpreter_findVariableSlot (me, key))
+		return slot -> variable;
+	auto it = my variablesMap. find (Interpreter_fullVariableName (me, key));
+	if (it == my variablesMap.end())
+		return nullptr;   // not remembered, because the variable may be created later
+	InterpreterVariable variable = it -> second.get();
+	Interpreter_rememberVariableSlot (me, key, variable);
+	return variable;
 }
 
 InterpreterVariable Interpreter_lookUpVariable (Interpreter me, conststring32 key) {
 	Melder_assert (key);
-	conststring32 variableNameIncludingProcedureName =
-		key [0] == U'.' ? Melder_cat (my procedureNames [my callDepth], key) : key;
+	if (structInterpreterVariableSlot *slot = Interpreter_findVariableSlot (me, key))
+		return slot -> variable;
+	const std::u32string& variableNameIncludingProcedureName = Interpreter_fullVariableName (me, key);
+	InterpreterVariable variable_ref;
 	auto it = my variablesMap. find (variableNameIncludingProcedureName);
-	if (it != my variablesMap.end())
-		return it -> second.get();
-	/*
-		The variable doesn't yet exist: create a new one.
-	*/
-	autoInterpreterVariable variable = InterpreterVariable_create (variableNameIncludingProcedureName);
-	InterpreterVariable variable_ref = variable.get();
-	my variablesMap [variableNameIncludingProcedureName] = variable.move();
+	if (it != my variablesMap.end()) {
+		variable_ref = it -> second.get();
+	} else {
+		/*
+			The variable doesn't yet exist: create a new one.
+		*/
+		autoInterpreterVariable variable = InterpreterVariable_create (variableNameIncludingProcedureName.c_str());
+		variable_ref = variable.get();
+		my variablesMap [variableNameIncludingProcedureName] = variable.move();
+	}
+	Interpreter_rememberVariableSlot (me, key, variable_ref);
 	return variable_ref;
 }
 
@@ -2036,6 +2091,8 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 	autovector <mutablestring32> lines;   // not autostringvector, because the elements are reference copies
 	integer lineNumber = 0;
 	bool assertionFailed = false;
+	std::vector <structInterpreterCompiledLine> *const callersCompiledLines = my compiledLines;
+	const integer callersCompiledLineNumber = my compiledLineNumber;
 	try {
 		static MelderString valueString;   // to divert the info
 		static MelderString assertErrorString;
@@ -2110,6 +2167,12 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 				lines [lineNumber] = emptyLine;
 			}
 		}
+		/*
+			Prepare the compiled lines, which are filled in as the lines are executed.
+		*/
+		std::vector <structInterpreterCompiledLine> compiledLines (numberOfLines + 1);
+		my compiledLines = & compiledLines;
+		my compiledLineNumber = 0;
 		/*
 			Copy the parameter names and argument values into the array of variables.
 		*/
@@ -2213,7 +2276,8 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 			//}
 			try {
 				char32 c0;
-				bool fail = false;
+				bool fail = false, substituted = false;
+				my compiledLineNumber = 0;
 				MelderString_copy (& command2, lines [lineNumber]);
 				c0 = command2.string [0];
 				if (c0 == U'\0')
@@ -2264,11 +2328,17 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 						MelderString_append (& buffer, string, q + 1);
 						MelderString_copy (& command2, buffer.string);   // This invalidates p!! (really bad bug 20070203)
 						p = command2.string + headlen + arglen - 1;
+						substituted = true;
 					} else {
 						p = q - 1;   // go to before next quote
 					}
 				}
 				trace (U"resume");
+				/*
+					The expressions in a line with substituted variables can differ from run to run,
+					so they should not be cached.
+				*/
+				my compiledLineNumber = ( substituted ? 0 : lineNumber );
 				c0 = command2.string [0];   // resume in order to allow things like 'c$' = 5
 				if ((! Melder_isLetter (c0) || Melder_isUpperCaseLetter (c0)) && c0 != U'@' &&
 						! (c0 == U'.' && Melder_isLetter (command2.string [1]) && ! Melder_isUpperCaseLetter (command2.string [1])))
@@ -2330,42 +2400,57 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 								const char32 *startOfInk = Melder_findInk (command2.string + 6);
 								if (startOfInk && *startOfInk != U';')
 									Melder_throw (U"Stray text after 'endfor'.");
-								int depth = 0;
-								integer iline;
-								for (iline = lineNumber - 1; iline > 0; iline --) {
-									char32 *line = lines [iline];
-									if (line [0] == U'f' && line [1] == U'o' && line [2] == U'r' && line [3] == U' ') {
-										if (depth == 0) { lineNumber = iline - 1; fromendfor = true; break; }   // go before 'for'
-										else depth --;
-									} else if (str32nequ (lines [iline], U"endfor", 6) &&
-											(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
-									{
-										depth ++;
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+									fromendfor = true;
+								} else {
+									int depth = 0;
+									integer iline;
+									for (iline = lineNumber - 1; iline > 0; iline --) {
+										char32 *line = lines [iline];
+										if (line [0] == U'f' && line [1] == U'o' && line [2] == U'r' && line [3] == U' ') {
+											if (depth == 0) { lineNumber = iline - 1; fromendfor = true; break; }   // go before 'for'
+											else depth --;
+										} else if (str32nequ (lines [iline], U"endfor", 6) &&
+												(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
+										{
+											depth ++;
+										}
 									}
+									if (iline <= 0) Melder_throw (U"Unmatched 'endfor'.");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline <= 0) Melder_throw (U"Unmatched 'endfor'.");
 							} else if (str32nequ (command2.string, U"endwhile", 8) &&
 									(! Melder_staysWithinInk (command2.string [8]) || command2.string [8] == U';'))
 							{
 								const char32 *startOfInk = Melder_findInk (command2.string + 8);
 								if (startOfInk && *startOfInk != U';')
 									Melder_throw (U"Stray text after 'endwhile'.");
-								int depth = 0;
-								integer iline;
-								for (iline = lineNumber - 1; iline > 0; iline --) {
-									if (str32nequ (lines [iline], U"while ", 6)) {
-										if (depth == 0) {
-											lineNumber = iline - 1;
-											break;   // go before 'while'
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"endwhile", 8) &&
-											(! Melder_staysWithinInk (lines [iline] [8]) || lines [iline] [8] == U';'))
-									{
-										depth ++;
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+								} else {
+									int depth = 0;
+									integer iline;
+									for (iline = lineNumber - 1; iline > 0; iline --) {
+										if (str32nequ (lines [iline], U"while ", 6)) {
+											if (depth == 0) {
+												lineNumber = iline - 1;
+												break;   // go before 'while'
+											} else
+												depth --;
+										} else if (str32nequ (lines [iline], U"endwhile", 8) &&
+												(! Melder_staysWithinInk (lines [iline] [8]) || lines [iline] [8] == U';'))
+										{
+											depth ++;
+										}
 									}
+									if (iline <= 0) Melder_throw (U"Unmatched 'endwhile'.");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline <= 0) Melder_throw (U"Unmatched 'endwhile'.");
 							} else if (str32nequ (command2.string, U"endproc", 7) &&
 									(! Melder_staysWithinInk (command2.string [7]) || command2.string [7] == U';'))
 							{
@@ -2383,31 +2468,94 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 							const char32 *startOfInk = Melder_findInk (command2.string + 4);
 							if (startOfInk && *startOfInk != U';')
 								Melder_throw (U"Stray text after 'else'.");
-							int depth = 0;
-							integer iline;
-							for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-								if (str32nequ (lines [iline], U"endif", 5) &&
-										(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
-								{
-									startOfInk = Melder_findInk (lines [iline] + 5);
-									if (startOfInk && *startOfInk != U';') {
-										lineNumber = iline;   // on behalf of the error message
-										Melder_throw (U"Stray text after 'endif'.");
+							structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+							if (compiledLine. jumpIsKnown) {
+								lineNumber = compiledLine. jumpTarget;
+							} else {
+								int depth = 0;
+								integer iline;
+								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+									if (str32nequ (lines [iline], U"endif", 5) &&
+											(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
+									{
+										startOfInk = Melder_findInk (lines [iline] + 5);
+										if (startOfInk && *startOfInk != U';') {
+											lineNumber = iline;   // on behalf of the error message
+											Melder_throw (U"Stray text after 'endif'.");
+										}
+										if (depth == 0) { lineNumber = iline; break; }   // go after `endif`
+										else depth --;
+									} else if (str32nequ (lines [iline], U"if ", 3)) {
+										depth ++;
 									}
-									if (depth == 0) { lineNumber = iline; break; }   // go after `endif`
-									else depth --;
-								} else if (str32nequ (lines [iline], U"if ", 3)) {
-									depth ++;
 								}
+								if (iline > numberOfLines)
+									Melder_throw (U"Unmatched 'else'.");
+								compiledLine. jumpTarget = lineNumber;
+								compiledLine. jumpIsKnown = true;
 							}
-							if (iline > numberOfLines)
-								Melder_throw (U"Unmatched 'else'.");
 						} else if (str32nequ (command2.string, U"elsif ", 6) || str32nequ (command2.string, U"elif ", 5)) {
 							if (fromif) {
 								double value;
 								fromif = false;
 								Interpreter_numericExpression (me, command2.string + 5, & value);
 								if (value == 0.0) {
+									structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+									if (compiledLine. jumpIsKnown) {
+										lineNumber = compiledLine. jumpTarget;
+										fromif = compiledLine. jumpGoesToElsif;
+									} else {
+										int depth = 0;
+										integer iline;
+										for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+											if (str32nequ (lines [iline], U"endif", 5) &&
+													(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
+											{
+												const char32 *startOfInk = Melder_findInk (lines [iline] + 5);
+												if (startOfInk && *startOfInk != U';') {
+													lineNumber = iline;   // on behalf of error message
+													Melder_throw (U"Stray text after 'endif'.");
+												}
+												if (depth == 0) {
+													lineNumber = iline;
+													break;   // go after `endif`
+												} else
+													depth --;
+											} else if (str32nequ (lines [iline], U"else", 4) &&
+													(! Melder_staysWithinInk (lines [iline] [4]) || lines [iline] [4] == U';'))
+											{
+												const char32 *startOfInk = Melder_findInk (lines [iline] + 4);
+												if (startOfInk && *startOfInk != U';') {
+													lineNumber = iline;   // on behalf of error message
+													Melder_throw (U"Stray text after 'else'.");
+												}
+												if (depth == 0) {
+													lineNumber = iline;
+													break;   // go after `else`
+												}
+											} else if ((str32nequ (lines [iline], U"elsif", 5) && ! Melder_staysWithinInk (lines [iline] [5]))
+												|| (str32nequ (lines [iline], U"elif", 4) && ! Melder_staysWithinInk (lines [iline] [4]))) {
+												if (depth == 0) {
+													lineNumber = iline - 1;
+													fromif = true;
+													break;   // go at next 'elsif' or 'elif'
+												}
+											} else if (str32nequ (lines [iline], U"if ", 3)) {
+												depth ++;
+											}
+										}
+										if (iline > numberOfLines)
+											Melder_throw (U"Unmatched 'elsif'.");
+										compiledLine. jumpTarget = lineNumber;
+										compiledLine. jumpGoesToElsif = fromif;
+										compiledLine. jumpIsKnown = true;
+									}
+								}
+							} else {
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. endifJumpIsKnown) {
+									lineNumber = compiledLine. endifJumpTarget;
+								} else {
 									int depth = 0;
 									integer iline;
 									for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
@@ -2424,55 +2572,15 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 												break;   // go after `endif`
 											} else
 												depth --;
-										} else if (str32nequ (lines [iline], U"else", 4) &&
-												(! Melder_staysWithinInk (lines [iline] [4]) || lines [iline] [4] == U';'))
-										{
-											const char32 *startOfInk = Melder_findInk (lines [iline] + 4);
-											if (startOfInk && *startOfInk != U';') {
-												lineNumber = iline;   // on behalf of error message
-												Melder_throw (U"Stray text after 'else'.");
-											}
-											if (depth == 0) {
-												lineNumber = iline;
-												break;   // go after `else`
-											}
-										} else if ((str32nequ (lines [iline], U"elsif", 5) && ! Melder_staysWithinInk (lines [iline] [5]))
-											|| (str32nequ (lines [iline], U"elif", 4) && ! Melder_staysWithinInk (lines [iline] [4]))) {
-											if (depth == 0) {
-												lineNumber = iline - 1;
-												fromif = true;
-												break;   // go at next 'elsif' or 'elif'
-											}
 										} else if (str32nequ (lines [iline], U"if ", 3)) {
 											depth ++;
 										}
 									}
 									if (iline > numberOfLines)
-										Melder_throw (U"Unmatched 'elsif'.");
+										Melder_throw (U"'elsif' not matched with 'endif'.");
+									compiledLine. endifJumpTarget = lineNumber;
+									compiledLine. endifJumpIsKnown = true;
 								}
-							} else {
-								int depth = 0;
-								integer iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endif", 5) &&
-											(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
-									{
-										const char32 *startOfInk = Melder_findInk (lines [iline] + 5);
-										if (startOfInk && *startOfInk != U';') {
-											lineNumber = iline;   // on behalf of error message
-											Melder_throw (U"Stray text after 'endif'.");
-										}
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after `endif`
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"if ", 3)) {
-										depth ++;
-									}
-								}
-								if (iline > numberOfLines)
-									Melder_throw (U"'elsif' not matched with 'endif'.");
 							}
 						} else if (str32nequ (command2.string, U"exit", 4)) {
 							if (command2.string [4] == U'\0') {
@@ -2519,28 +2627,35 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 							}
 							var -> numericValue = loopVariable;
 							if (loopVariable > toValue) {
-								int depth = 0;
-								integer iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endfor", 6) &&
-											(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
-									{
-										const char32 *startOfInk = Melder_findInk (lines [iline] + 6);
-										if (startOfInk && *startOfInk != U';') {
-											lineNumber = iline;   // on behalf of error message
-											Melder_throw (U"Stray text after 'endfor'.");
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+								} else {
+									int depth = 0;
+									integer iline;
+									for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+										if (str32nequ (lines [iline], U"endfor", 6) &&
+												(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
+										{
+											const char32 *startOfInk = Melder_findInk (lines [iline] + 6);
+											if (startOfInk && *startOfInk != U';') {
+												lineNumber = iline;   // on behalf of error message
+												Melder_throw (U"Stray text after 'endfor'.");
+											}
+											if (depth == 0) {
+												lineNumber = iline;
+												break;   // go after 'endfor'
+											} else
+												depth --;
+										} else if (str32nequ (lines [iline], U"for ", 4)) {
+											depth ++;
 										}
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after 'endfor'
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"for ", 4)) {
-										depth ++;
 									}
+									if (iline > numberOfLines)
+										Melder_throw (U"Unmatched 'for' (matching 'endfor' not found).");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline > numberOfLines)
-									Melder_throw (U"Unmatched 'for' (matching 'endfor' not found).");
 							}
 						} else if (str32nequ (command2.string, U"form", 4) &&
 								(command2.string [4] == U':' || Melder_isEndOfInk (command2.string [4])))
@@ -2600,46 +2715,55 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 							double value;
 							Interpreter_numericExpression (me, command2.string + 3, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								integer iline;
-								for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endif", 5) &&
-											(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
-									{
-										const char32 *startOfInk = Melder_findInk (lines [iline] + 5);
-										if (startOfInk && *startOfInk != U';') {
-											lineNumber = iline;   // on behalf of error message
-											Melder_throw (U"Stray text after 'endif'.");
-										}
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after 'endif'
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"else", 4) &&
-											(! Melder_staysWithinInk (lines [iline] [4]) || lines [iline] [4] == U';'))
-									{
-										const char32 *startOfInk = Melder_findInk (lines [iline] + 4);
-										if (startOfInk && *startOfInk != U';') {
-											lineNumber = iline;   // on behalf of error message
-											Melder_throw (U"Stray text after 'else'.");
-										}
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after 'else'
-										}
-									} else if (str32nequ (lines [iline], U"elsif ", 6) || str32nequ (lines [iline], U"elif ", 5)) {
-										if (depth == 0) {
-											lineNumber = iline - 1;
-											fromif = true;
-											break;   // go at 'elsif'
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+									fromif = compiledLine. jumpGoesToElsif;
+								} else {
+									int depth = 0;
+									integer iline;
+									for (iline = lineNumber + 1; iline <= numberOfLines; iline ++) {
+										if (str32nequ (lines [iline], U"endif", 5) &&
+												(! Melder_staysWithinInk (lines [iline] [5]) || lines [iline] [5] == U';'))
+										{
+											const char32 *startOfInk = Melder_findInk (lines [iline] + 5);
+											if (startOfInk && *startOfInk != U';') {
+												lineNumber = iline;   // on behalf of error message
+												Melder_throw (U"Stray text after 'endif'.");
+											}
+											if (depth == 0) {
+												lineNumber = iline;
+												break;   // go after 'endif'
+											} else
+												depth --;
+										} else if (str32nequ (lines [iline], U"else", 4) &&
+												(! Melder_staysWithinInk (lines [iline] [4]) || lines [iline] [4] == U';'))
+										{
+											const char32 *startOfInk = Melder_findInk (lines [iline] + 4);
+											if (startOfInk && *startOfInk != U';') {
+												lineNumber = iline;   // on behalf of error message
+												Melder_throw (U"Stray text after 'else'.");
+											}
+											if (depth == 0) {
+												lineNumber = iline;
+												break;   // go after 'else'
+											}
+										} else if (str32nequ (lines [iline], U"elsif ", 6) || str32nequ (lines [iline], U"elif ", 5)) {
+											if (depth == 0) {
+												lineNumber = iline - 1;
+												fromif = true;
+												break;   // go at 'elsif'
+											}
+										} else if (str32nequ (lines [iline], U"if ", 3)) {
+											depth ++;
 										}
-									} else if (str32nequ (lines [iline], U"if ", 3)) {
-										depth ++;
 									}
+									if (iline > numberOfLines)
+										Melder_throw (U"Unmatched 'if'.");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpGoesToElsif = fromif;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline > numberOfLines)
-									Melder_throw (U"Unmatched 'if'.");
 							} else if (isundef (value)) {
 								Melder_throw (U"The value of the 'if' condition is undefined.");
 							}
@@ -2728,23 +2852,30 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 							double value;
 							Interpreter_numericExpression (me, command2.string + 6, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								integer iline = lineNumber - 1;
-								for (; iline > 0; iline --) {
-									if (str32nequ (lines [iline], U"repeat", 6) &&
-											(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
-									{
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after `repeat`
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"until ", 6)) {
-										depth ++;
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+								} else {
+									int depth = 0;
+									integer iline = lineNumber - 1;
+									for (; iline > 0; iline --) {
+										if (str32nequ (lines [iline], U"repeat", 6) &&
+												(! Melder_staysWithinInk (lines [iline] [6]) || lines [iline] [6] == U';'))
+										{
+											if (depth == 0) {
+												lineNumber = iline;
+												break;   // go after `repeat`
+											} else
+												depth --;
+										} else if (str32nequ (lines [iline], U"until ", 6)) {
+											depth ++;
+										}
 									}
+									if (iline <= 0)
+										Melder_throw (U"Unmatched 'until'.");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline <= 0)
-									Melder_throw (U"Unmatched 'until'.");
 							}
 						} else
 							fail = true;
@@ -2757,28 +2888,35 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 							double value;
 							Interpreter_numericExpression (me, command2.string + 6, & value);
 							if (value == 0.0) {
-								int depth = 0;
-								integer iline = lineNumber + 1;
-								for (; iline <= numberOfLines; iline ++) {
-									if (str32nequ (lines [iline], U"endwhile", 8) &&
-											(! Melder_staysWithinInk (lines [iline] [8]) || lines [iline] [8] == U';'))
-									{
-										const char32 *startOfInk = Melder_findInk (lines [iline] + 8);
-										if (startOfInk && *startOfInk != U';') {
-											lineNumber = iline;
-											Melder_throw (U"Stray text after 'endwhile'.");
+								structInterpreterCompiledLine& compiledLine = compiledLines [lineNumber];
+								if (compiledLine. jumpIsKnown) {
+									lineNumber = compiledLine. jumpTarget;
+								} else {
+									int depth = 0;
+									integer iline = lineNumber + 1;
+									for (; iline <= numberOfLines; iline ++) {
+										if (str32nequ (lines [iline], U"endwhile", 8) &&
+												(! Melder_staysWithinInk (lines [iline] [8]) || lines [iline] [8] == U';'))
+										{
+											const char32 *startOfInk = Melder_findInk (lines [iline] + 8);
+											if (startOfInk && *startOfInk != U';') {
+												lineNumber = iline;
+												Melder_throw (U"Stray text after 'endwhile'.");
+											}
+											if (depth == 0) {
+												lineNumber = iline;
+												break;   // go after `endwhile`
+											} else
+												depth --;
+										} else if (str32nequ (lines [iline], U"while ", 6)) {
+											depth ++;
 										}
-										if (depth == 0) {
-											lineNumber = iline;
-											break;   // go after `endwhile`
-										} else
-											depth --;
-									} else if (str32nequ (lines [iline], U"while ", 6)) {
-										depth ++;
 									}
+									if (iline > numberOfLines)
+										Melder_throw (U"Unmatched 'while'.");
+									compiledLine. jumpTarget = lineNumber;
+									compiledLine. jumpIsKnown = true;
 								}
-								if (iline > numberOfLines)
-									Melder_throw (U"Unmatched 'while'.");
 							}
 						} else
 							fail = true;
@@ -3464,7 +3602,11 @@ void Interpreter_run (Interpreter me, char32 *text, const bool reuseVariables) {
 		my numberOfLabels = 0;
 		my running = false;
 		my stopped = false;
+		my compiledLines = callersCompiledLines;
+		my compiledLineNumber = callersCompiledLineNumber;
 	} catch (MelderError) {
+		my compiledLines = callersCompiledLines;
+		my compiledLineNumber = callersCompiledLineNumber;
 		if (lineNumber > 0) {
 			const bool normalExplicitExit = str32nequ (lines [lineNumber], U"exit ", 5) || Melder_hasError (U"Script exited.");
 			if (! normalExplicitExit && ! assertionFailed) {   // don't show the message twice!
@@ -3494,21 +3636,49 @@ void Interpreter_stop (Interpreter me) {
 //Melder_casual (U"Interpreter_stop out: ", Melder_pointer (me));
 }
 
+static void Interpreter_compileExpression (Interpreter me, conststring32 expression, int expressionType) {
+	if (! my compiledLines || my compiledLineNumber == 0) {
+		Formula_compile (me, nullptr, expression, expressionType, false);
+		return;
+	}
+	/*
+		Look for the expression among the ones compiled earlier on the same line,
+		starting after the one that was found most recently.
+	*/
+	structInterpreterCompiledLine& compiledLine = (*my compiledLines) [my compiledLineNumber];
+	const integer numberOfExpressions = uinteger_to_integer_a (compiledLine. expressions.size());
+	for (integer i = 0; i < numberOfExpressions; i ++) {
+		const integer iexpression = (compiledLine. nextExpression + i) % numberOfExpressions;
+		structInterpreterCompiledExpression& compiledExpression = compiledLine. expressions [iexpression];
+		if (compiledExpression. expressionType == expressionType && str32equ (compiledExpression. expression.get(), expression)) {
+			Formula_restoreProgram (me, compiledExpression. program.get(), expression);
+			compiledLine. nextExpression = (iexpression + 1) % numberOfExpressions;
+			return;
+		}
+	}
+	Formula_compile (me, nullptr, expression, expressionType, false);
+	if (numberOfExpressions >= Interpreter_MAXNUM_COMPILED_EXPRESSIONS_PER_LINE)
+		return;   // e.g. an `evaluate` with a different argument each time
+	autoFormulaProgram program = Formula_saveProgram ();
+	if (program)
+		compiledLine. expressions. push_back ({ Melder_dup (expression), expressionType, program.move() });
+}
+
 void Interpreter_voidExpression (Interpreter me, conststring32 expression) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_NUMERIC, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_NUMERIC);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 }
 
 void Interpreter_numericExpression (Interpreter me, conststring32 expression, double *out_value) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_NUMERIC, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_NUMERIC);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 	*out_value = result. numericResult;
 }
 
 void Interpreter_numericVectorExpression (Interpreter me, conststring32 expression, VEC *out_value, bool *out_owned) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_NUMERIC_VECTOR, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_NUMERIC_VECTOR);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 	*out_value = result. numericVectorResult;
@@ -3517,7 +3687,7 @@ void Interpreter_numericVectorExpression (Interpreter me, conststring32 expressi
 }
 
 void Interpreter_numericMatrixExpression (Interpreter me, conststring32 expression, MAT *out_value, bool *out_owned) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_NUMERIC_MATRIX, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_NUMERIC_MATRIX);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 	*out_value = result. numericMatrixResult;
@@ -3526,14 +3696,14 @@ void Interpreter_numericMatrixExpression (Interpreter me, conststring32 expressi
 }
 
 autostring32 Interpreter_stringExpression (Interpreter me, conststring32 expression) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_STRING, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_STRING);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 	return result. stringResult.move();
 }
 
 void Interpreter_stringArrayExpression (Interpreter me, conststring32 expression, STRVEC *out_value, bool *out_owned) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_STRING_ARRAY, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_STRING_ARRAY);
 	Formula_Result result;
 	Formula_run (0, 0, & result);
 	*out_value = result. stringArrayResult;
@@ -3542,7 +3712,7 @@ void Interpreter_stringArrayExpression (Interpreter me, conststring32 expression
 }
 
 void Interpreter_anyExpression (Interpreter me, conststring32 expression, Formula_Result *out_result) {
-	Formula_compile (me, nullptr, expression, kFormula_EXPRESSION_TYPE_UNKNOWN, false);
+	Interpreter_compileExpression (me, expression, kFormula_EXPRESSION_TYPE_UNKNOWN);
 	Formula_run (0, 0, out_result);
 }
 
@@ -24,6 +24,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 Thing_define (InterpreterVariable, SimpleString) {
 	double numericValue;   // a variable whose name has no suffix: a real, an integer, or a boolean
@@ -33,6 +34,36 @@ Thing_define (InterpreterVariable, SimpleString) {
 	autoSTRVEC stringArrayValue;   // a variable whose name has the suffix "$#"
 };
 
+/*
+	The compiled form of a script line: the targets of its jumps
+	(which depend only on the text of the script, so they can be computed once),
+	and its expressions and variables, which are resolved at their first use
+	and then stay valid as long as the line contains no variable substitutions ('var$').
+	Variables are never removed during a run, so a resolved variable is a stable slot.
+*/
+struct structInterpreterCompiledExpression {
+	autostring32 expression;
+	int expressionType;
+	autoFormulaProgram program;
+};
+struct structInterpreterVariableSlot {
+	autostring32 name;
+	int callDepth;   // relevant only for local variables, whose names start with a period
+	InterpreterVariable variable;
+};
+struct structInterpreterCompiledLine {
+	bool jumpIsKnown, jumpGoesToElsif;
+	integer jumpTarget;   // the line number after which a loop ends, or a failing condition continues
+	bool endifJumpIsKnown;
+	integer endifJumpTarget;   // the line number of the `endif` that ends an `elsif` that was not taken
+	std::vector <structInterpreterCompiledExpression> expressions;
+	integer nextExpression;   // expressions tend to be evaluated in the same order each time
+	std::vector <structInterpreterVariableSlot> variableSlots;
+	integer nextVariableSlot;
+};
+#define Interpreter_MAXNUM_COMPILED_EXPRESSIONS_PER_LINE  20
+#define Interpreter_MAXNUM_VARIABLE_SLOTS_PER_LINE  20
+
 #define Interpreter_MAXNUM_PARAMETERS  400
 #define Interpreter_MAXNUM_LABELS  1000
 #define Interpreter_MAX_CALL_DEPTH  50
@@ -165,6 +196,8 @@ Thing_define (Interpreter, Thing) {
 	autostring32 dialogTitle;
 	char32 procedureNames [1+Interpreter_MAX_CALL_DEPTH] [100];
 	std::unordered_map <std::u32string, autoInterpreterVariable> variablesMap;
+	std::vector <structInterpreterCompiledLine> *compiledLines;   // during Interpreter_run () only
+	integer compiledLineNumber;   // 0 if the current expressions cannot be cached
 	bool running, stopped;
 
 	kInterpreter_ReturnType returnType;   // automatically initialized as kInterpreter_ReturnType::VOID_
@@ -59,7 +59,7 @@ Thing_implement (Praat_Command, Thing, 0);
 */
 structPraatApplication theForegroundPraatApplication;
 PraatApplication theCurrentPraatApplication = & theForegroundPraatApplication;
-structPraatObjects theForegroundPraatObjects;
+structPraatObjects theForegroundPraatObjects { };   // brace-initialized, so that it is zeroed statically rather than at start-up (it is 40 MB)
 PraatObjects theCurrentPraatObjects = & theForegroundPraatObjects;
 structPraatPicture theForegroundPraatPicture;
 PraatPicture theCurrentPraatPicture = & theForegroundPraatPicture;
@@ -834,13 +834,36 @@ void praat_dataChanged (Daata object) {
 	}
 }
 
+constexpr integer MAXNUM_DEFERRED_MANUALS = 100;
+static void (*theDeferredManuals [1 + MAXNUM_DEFERRED_MANUALS]) (ManPages me);
+static integer theNumberOfDeferredManuals = 0;
+
+void praat_includeManPages (void (*manual_xxx_init) (ManPages me)) {
+	if (Melder_batch) {
+		Melder_assert (theNumberOfDeferredManuals < MAXNUM_DEFERRED_MANUALS);
+		theDeferredManuals [++ theNumberOfDeferredManuals] = manual_xxx_init;
+		return;
+	}
+	manual_xxx_init (theCurrentPraatApplication -> manPages);
+}
+
+ManPages praat_manPages () {
+	if (theNumberOfDeferredManuals > 0) {
+		const integer numberOfDeferredManuals = theNumberOfDeferredManuals;
+		theNumberOfDeferredManuals = 0;   // before calling, in case a manual asks for the pages
+		for (integer imanual = 1; imanual <= numberOfDeferredManuals; imanual ++)
+			theDeferredManuals [imanual] (theForegroundPraatApplication. manPages);
+	}
+	return theCurrentPraatApplication -> manPages;
+}
+
 static void helpProc (conststring32 query) {
 	if (theCurrentPraatApplication -> batch) {
 		Melder_flushError (U"Cannot view manual from batch.");
 		return;
 	}
 	try {
-		autoManual manual = Manual_create (query, nullptr, theCurrentPraatApplication -> manPages, false, true);
+		autoManual manual = Manual_create (query, nullptr, praat_manPages (), false, true);
 		manual.releaseToUser();
 	} catch (MelderError) {
 		Melder_flushError (U"help: no help on \"", query, U"\".");
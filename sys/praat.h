@@ -237,7 +237,13 @@ void praat_picture_close ();
 #define INCLUDE_LIBRARY(praat_xxx_init)  \
    { extern void praat_xxx_init (); praat_xxx_init (); }
 #define INCLUDE_MANPAGES(manual_xxx_init)  \
-   { extern void manual_xxx_init (ManPages me); manual_xxx_init (theCurrentPraatApplication -> manPages); }
+   { extern void manual_xxx_init (ManPages me); praat_includeManPages (manual_xxx_init); }
+void praat_includeManPages (void (*manual_xxx_init) (ManPages me));
+/*
+	In batch, where nobody is going to read them, the manual pages are not added at start-up;
+	they are added only when somebody asks for them with praat_manPages ().
+*/
+ManPages praat_manPages ();
 
 /* For text-only applications that do not want to see that irritating Picture window. */
 /* Works only if called before praat_init. */
@@ -1,6 +1,6 @@
 /* praatP.h
  *
- * Copyright (C) 1992-2007,2009-2025 Paul Boersma
+ * Copyright (C) 1992-2007,2009-2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -17,6 +17,9 @@
  */
 
 #include "praat.h"
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 void praat_addActionScript (conststring32 className1, integer n1, conststring32 className2, integer n2, conststring32 className3, integer n3,
 	conststring32 title, conststring32 after, integer depth, conststring32 script);
@@ -89,6 +92,98 @@ Thing_define (Praat_Command, Thing) {
 	autostring32 after;   // title of previous command, often null; if starting with an asterisk (deprecation), then a reference to the replacement
 	integer uniqueID;   // for sorting the added commands
 	integer sortingTail;
+	integer positionInList;   // kept up to date by the list that owns the command, for the look-ups in the Praat_CommandIndex
+};
+
+/*
+	An index to the commands, so that a command is found by hashing instead of by comparing all ~3000 titles.
+	A command is fully specified by its environment (the selected classes for an action,
+	the window and the menu for a menu command) and its title; this is the key for registration and removal.
+	A command called from a script is looked up by its title only.
+	The keys point into the strings owned by the commands, so a command has to be removed
+	from the index before it is destroyed.
+*/
+struct Praat_CommandKey {
+	ClassInfo class1, class2, class3, class4;
+	std::u32string_view window, menu, title;
+	bool operator== (const Praat_CommandKey& other) const {
+		return class1 == other.class1 && class2 == other.class2 && class3 == other.class3 && class4 == other.class4 &&
+				window == other.window && menu == other.menu && title == other.title;
+	}
+};
+struct Praat_CommandKeyHash {
+	size_t operator() (const Praat_CommandKey& key) const {
+		const std::hash <std::u32string_view> hashString;
+		const std::hash <ClassInfo> hashClass;
+		size_t result = hashString (key.title);
+		for (size_t part : { hashString (key.window), hashString (key.menu),
+				hashClass (key.class1), hashClass (key.class2), hashClass (key.class3), hashClass (key.class4) })
+			result = result * 31 + part;
+		return result;
+	}
+};
+inline std::u32string_view Praat_CommandKey_view (conststring32 string) {
+	return string ? std::u32string_view (string) : std::u32string_view ();
+}
+inline Praat_CommandKey Praat_CommandKey_ofAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, ClassInfo class4, conststring32 title) {
+	return { class1, class2, class3, class4, std::u32string_view (), std::u32string_view (), Praat_CommandKey_view (title) };
+}
+inline Praat_CommandKey Praat_CommandKey_ofMenuCommand (conststring32 window, conststring32 menu, conststring32 title) {
+	return { nullptr, nullptr, nullptr, nullptr, Praat_CommandKey_view (window), Praat_CommandKey_view (menu), Praat_CommandKey_view (title) };
+}
+inline Praat_CommandKey Praat_CommandKey_of (Praat_Command command) {
+	return { command -> class1, command -> class2, command -> class3, command -> class4,
+			Praat_CommandKey_view (command -> window.get()), Praat_CommandKey_view (command -> menu.get()),
+			Praat_CommandKey_view (command -> title.get()) };
+}
+
+struct Praat_CommandIndex {
+	std::unordered_map <Praat_CommandKey, std::vector <Praat_Command>, Praat_CommandKeyHash> commandsByKey;
+	std::unordered_map <std::u32string_view, std::vector <Praat_Command>> commandsByTitle;
+	void add (Praat_Command command) {
+		commandsByKey [Praat_CommandKey_of (command)]. push_back (command);
+		if (command -> title)
+			commandsByTitle [command -> title.get()]. push_back (command);
+	}
+	void remove (Praat_Command command) {
+		removeFrom (commandsByKey, Praat_CommandKey_of (command), command);
+		if (command -> title)
+			removeFrom (commandsByTitle, std::u32string_view (command -> title.get()), command);
+	}
+	/*
+		The first command in the list with this key or title and (for the title) satisfying the condition;
+		null if there is none.
+	*/
+	Praat_Command lookUp (Praat_CommandKey const& key) const {
+		const auto found = commandsByKey. find (key);
+		return found == commandsByKey. end () ? nullptr : first (found -> second, [] (Praat_Command) { return true; });
+	}
+	template <typename Condition>
+	Praat_Command lookUp (conststring32 title, Condition condition) const {
+		if (! title)
+			return nullptr;
+		const auto found = commandsByTitle. find (title);
+		return found == commandsByTitle. end () ? nullptr : first (found -> second, condition);
+	}
+private:
+	template <typename Map, typename Key>
+	static void removeFrom (Map& map, Key const& key, Praat_Command command) {
+		const auto found = map. find (key);
+		if (found == map. end ())
+			return;
+		std::vector <Praat_Command> & commands = found -> second;
+		commands. erase (std::remove (commands. begin (), commands. end (), command), commands. end ());
+		if (commands. empty ())
+			map. erase (found);
+	}
+	template <typename Condition>
+	static Praat_Command first (std::vector <Praat_Command> const& commands, Condition condition) {
+		Praat_Command result = nullptr;
+		for (Praat_Command command : commands)   // usually only one
+			if (condition (command) && (! result || command -> positionInList < result -> positionInList))
+				result = command;
+		return result;
+	}
 };
 
 #define praat_STARTING_UP  1
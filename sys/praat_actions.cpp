@@ -1,6 +1,6 @@
 /* praat_actions.cpp
  *
- * Copyright (C) 1992-2018,2020-2024 Paul Boersma
+ * Copyright (C) 1992-2018,2020-2024,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -26,6 +26,7 @@
 #define BUTTON_RIGHT -5
 
 static OrderedOf <structPraat_Command> theActions;
+static Praat_CommandIndex theActionIndex;
 void praat_actions_exit_optimizeByLeaking () { theActions. _ownItems = false; }
 static GuiMenu praat_writeMenu;
 static GuiMenuItem praat_writeMenuSeparator;
@@ -84,21 +85,37 @@ static void fixSelectionSpecification (ClassInfo *class1, integer *n1, ClassInfo
 	}
 }
 
+static void renumberActions (integer fromPosition) {
+	for (integer i = fromPosition; i <= theActions.size; i ++)
+		theActions.at [i] -> positionInList = i;
+}
+
+static void insertAction (autoPraat_Command action, integer position) {
+	Praat_Command inserted = theActions. addItemAtPosition_move (action.move(), position);
+	renumberActions (position == 0 ? theActions.size : position);
+	theActionIndex. add (inserted);
+}
+
+static void removeAction (integer position) {
+	theActionIndex. remove (theActions.at [position]);
+	theActions. removeItem (position);
+	renumberActions (position);
+}
+
 static integer lookUpMatchingAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, ClassInfo class4, conststring32 title) {
 /*
 	An action command is fully specified by its environment (the selected classes) and its title.
 	Precondition:
 		class1, class2, and class3 must be in sorted order.
 */
-	for (integer i = 1; i <= theActions.size; i ++) {
-		Praat_Command action = theActions.at [i];
-		if (class1 == action -> class1 && class2 == action -> class2 &&
-			class3 == action -> class3 && class4 == action -> class4 &&
-			title && action -> title && str32equ (action -> title.get(), title)
-		)
-			return i;
-	}
-	return 0;   // not found
+	if (! title)
+		return 0;
+	const Praat_Command action = theActionIndex. lookUp (Praat_CommandKey_ofAction (class1, class2, class3, class4, title));
+	return action ? action -> positionInList : 0;   // 0 = not found
+}
+
+static Praat_Command lookUpExecutableAction (conststring32 title) {
+	return theActionIndex. lookUp (title, [] (Praat_Command action) { return action -> executable; });
 }
 
 void praat_addAction1_ (ClassInfo class1, integer n1,
@@ -180,7 +197,7 @@ static void praat_addAction4__ (ClassInfo class1, integer n1, ClassInfo class2,
 		/*
 			Insert new command.
 		*/
-		theActions. addItemAtPosition_move (action.move(), position);
+		insertAction (action.move(), position);
 	} catch (MelderError) {
 		Melder_flushError ();
 	}
@@ -347,7 +364,7 @@ void praat_addActionScript (conststring32 className1, integer n1, conststring32
 		{// scope
 			integer found = lookUpMatchingAction (class1, class2, class3, nullptr, title);
 			if (found)
-				theActions. removeItem (found);
+				removeAction (found);
 		}
 
 		/*
@@ -396,7 +413,7 @@ void praat_addActionScript (conststring32 className1, integer n1, conststring32
 		/*
 			Insert new command.
 		*/
-		theActions. addItemAtPosition_move (action.move(), position);
+		insertAction (action.move(), position);
 		updateDynamicMenu ();
 	} catch (MelderError) {
 		Melder_throw (U"Praat: script action not added.");
@@ -415,7 +432,7 @@ void praat_removeAction (ClassInfo class1, ClassInfo class2, ClassInfo class3, c
 				U": ", title, U"\" not found."
 			);
 		}
-		theActions. removeItem (found);
+		removeAction (found);
 	} catch (MelderError) {
 		Melder_throw (U"Praat: action not removed.");
 	}
@@ -553,6 +570,7 @@ void praat_sortActions () {
 			return my sortingTail < thy sortingTail;
 		}
 	);
+	renumberActions (1);
 }
 
 static conststring32 numberString (integer number) {
@@ -844,14 +862,7 @@ void praat_saveToggledActions (MelderString *buffer) {
 }
 
 int praat_doAction (conststring32 title, conststring32 arguments, Interpreter interpreter) {
-	Praat_Command actionFound = nullptr;
-	for (integer i = 1; i <= theActions.size; i ++) {
-		Praat_Command action = theActions.at [i];
-		if (action -> executable && str32equ (action -> title.get(), title)) {
-			actionFound = action;
-			break;
-		}
-	}
+	Praat_Command actionFound = lookUpExecutableAction (title);
 	if (! actionFound)
 		return 0;
 	if (actionFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -874,14 +885,7 @@ int praat_doAction (conststring32 title, conststring32 arguments, Interpreter in
 }
 
 int praat_doAction (conststring32 title, integer narg, Stackel args, Interpreter interpreter) {
-	Praat_Command actionFound = nullptr;
-	for (integer i = 1; i <= theActions.size; i ++) {
-		Praat_Command action = theActions.at [i];
-		if (action -> executable && str32equ (action -> title.get(), title)) {
-			actionFound = action;
-			break;
-		}
-	}
+	Praat_Command actionFound = lookUpExecutableAction (title);
 	if (! actionFound)
 		return 0;
 	if (actionFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -1,6 +1,6 @@
 /* praat_menuCommands.cpp
  *
- * Copyright (C) 1992-2018,2020-2024 Paul Boersma
+ * Copyright (C) 1992-2018,2020-2024,2026 Paul Boersma
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -21,8 +21,14 @@
 #include "GuiP.h"
 
 static OrderedOf <structPraat_Command> theCommands;
+static Praat_CommandIndex theCommandIndex;
 void praat_menuCommands_exit_optimizeByLeaking () { theCommands. _ownItems = false; }
 
+static void renumberMenuCommands (integer fromPosition) {
+	for (integer i = fromPosition; i <= theCommands.size; i ++)
+		theCommands.at [i] -> positionInList = i;
+}
+
 void praat_sortMenuCommands () {
 	for (integer i = 1; i <= theCommands.size; i ++) {
 		Praat_Command command = theCommands.at [i];
@@ -49,25 +55,28 @@ void praat_sortMenuCommands () {
 			return my sortingTail < thy sortingTail;
 		}
 	);
+	renumberMenuCommands (1);
+}
+
+static void insertMenuCommand (autoPraat_Command command, integer position) {
+	Praat_Command inserted = theCommands. addItemAtPosition_move (command.move(), position);
+	renumberMenuCommands (position == 0 ? theCommands.size : position);
+	theCommandIndex. add (inserted);
 }
 
 static integer lookUpMatchingMenuCommand_0 (conststring32 window, conststring32 menu, conststring32 title) {
 	/*
 		A menu command is fully specified by its environment (window + menu) and its title.
 	*/
-	for (integer i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		conststring32 tryWindow = command -> window.get();
-		conststring32 tryMenu = command -> menu.get();
-		conststring32 tryTitle = command -> title.get();
-		if (
-			(window == tryWindow || (window && tryWindow && str32equ (window, tryWindow))) &&
-			(menu == tryMenu || (menu && tryMenu && str32equ (menu, tryMenu))) &&
-			(title == tryTitle || (title && tryTitle && str32equ (title, tryTitle)))
-		)
-			return i;
-	}
-	return 0;   // not found
+	const Praat_Command command = theCommandIndex. lookUp (Praat_CommandKey_ofMenuCommand (window, menu, title));
+	return command ? command -> positionInList : 0;   // 0 = not found
+}
+
+static Praat_Command lookUpExecutableMenuCommand (conststring32 title) {
+	return theCommandIndex. lookUp (title, [] (Praat_Command command) {
+		return command -> executable &&
+			(str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture"));
+	});
 }
 
 static void do_menu (Praat_Command me, bool isModified) {
@@ -229,7 +238,7 @@ static GuiMenuItem praat_addMenuCommand__ (conststring32 window, conststring32 m
 			GuiThing_hide (command -> button);
 	}
 	Thing_cast (GuiMenuItem, button_as_GuiMenuItem, command -> button);
-	theCommands. addItemAtPosition_move (command.move(), position);
+	insertMenuCommand (command.move(), position);
 	return button_as_GuiMenuItem;
 }
 GuiMenuItem praat_addMenuCommand_ (conststring32 window, conststring32 menu, conststring32 title /* cattable */,
@@ -349,7 +358,7 @@ void praat_addMenuCommandScript (conststring32 window, conststring32 menu, const
 				}
 			}
 		}
-		theCommands. addItemAtPosition_move (command.move(), position);
+		insertMenuCommand (command.move(), position);
 
 		if (praatP.phase >= praat_HANDLING_EVENTS)
 			praat_sortMenuCommands ();
@@ -441,18 +450,11 @@ void praat_addFixedButtonCommand_ (GuiForm parent, conststring32 title, UiCallba
 		GuiThing_show (button);
 	}
 	my executable = false;
-	theCommands. addItemAtPosition_move (me.move(), 0);
+	insertMenuCommand (me.move(), 0);
 }
 
 void praat_sensitivizeFixedButtonCommand (conststring32 title, bool sensitive) {
-	Praat_Command commandFound = nullptr;
-	for (integer i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		if (str32equ (command -> title.get(), title)) {
-			commandFound = command;
-			break;
-		}
-	}
+	Praat_Command commandFound = theCommandIndex. lookUp (title, [] (Praat_Command) { return true; });
 	if (! commandFound)
 		Melder_fatal (U"Unkown fixed button <<", title, U">>");
 	commandFound -> executable = sensitive;
@@ -461,16 +463,7 @@ void praat_sensitivizeFixedButtonCommand (conststring32 title, bool sensitive) {
 }
 
 int praat_doMenuCommand (conststring32 title, conststring32 arguments, Interpreter interpreter) {
-	Praat_Command commandFound = nullptr;
-	for (integer i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		if (command -> executable && str32equ (command -> title.get(), title) &&
-			(str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture")))
-		{
-			commandFound = command;
-			break;
-		}
-	}
+	Praat_Command commandFound = lookUpExecutableMenuCommand (title);
 	if (! commandFound)
 		return 0;
 	if (commandFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -493,16 +486,7 @@ int praat_doMenuCommand (conststring32 title, conststring32 arguments, Interpret
 }
 
 int praat_doMenuCommand (conststring32 title, integer narg, Stackel args, Interpreter interpreter) {
-	Praat_Command commandFound = nullptr;
-	for (integer i = 1; i <= theCommands.size; i ++) {
-		Praat_Command command = theCommands.at [i];
-		if (command -> executable && str32equ (command -> title.get(), title) &&
-			(str32equ (command -> window.get(), U"Objects") || str32equ (command -> window.get(), U"Picture")))
-		{
-			commandFound = command;
-			break;
-		}
-	}
+	Praat_Command commandFound = lookUpExecutableMenuCommand (title);
 	if (! commandFound)
 		return 0;
 	if (commandFound -> callback == DO_RunTheScriptFromAnyAddedMenuCommand) {
@@ -641,20 +641,20 @@ DO
 	PRAAT
 		if (theCurrentPraatApplication -> batch)
 			Melder_throw (U"Cannot view a manual from batch.");
-		autoManual manual = Manual_create (U"Intro", nullptr, theCurrentPraatApplication -> manPages, false, true);
+		autoManual manual = Manual_create (U"Intro", nullptr, praat_manPages (), false, true);
 		Manual_search (manual.get(), query);
 		manual.releaseToUser();
 	PRAAT_END
 }
 
 FORM (PRAAT__GoToManualPage, U"Go to manual page", nullptr) {
-	LIST (goToPageNumber, U"Page", ManPages_getTitles (theCurrentPraatApplication -> manPages), 1)
+	LIST (goToPageNumber, U"Page", ManPages_getTitles (praat_manPages ()), 1)
 	OK
 DO
 	PRAAT
 		if (theCurrentPraatApplication -> batch)
 			Melder_throw (U"Cannot view a manual from batch.");
-		autoManual manual = Manual_create (U"Intro", nullptr, theCurrentPraatApplication -> manPages, false, true);
+		autoManual manual = Manual_create (U"Intro", nullptr, praat_manPages (), false, true);
 		HyperPage_goToPage_number (manual.get(), goToPageNumber);
 		manual.releaseToUser();
 	PRAAT_END
@@ -667,7 +667,7 @@ OK
 	Melder_getCurrentFolder (& currentFolder);
 	SET_STRING (folder, MelderFolder_peekPath (& currentFolder))
 DO
-	ManPages_writeAllToHtmlDir (theCurrentPraatApplication -> manPages, nullptr, folder);
+	ManPages_writeAllToHtmlDir (praat_manPages (), nullptr, folder);
 	END_NO_NEW_DATA
 }
 